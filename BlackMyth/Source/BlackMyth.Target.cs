@@ -11,5 +11,11 @@ public class BlackMythTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
 		ExtraModuleNames.Add("BlackMyth");
+
+		// 自动化测试与基准测试，Shipping 不包含
+		if (Configuration != UnrealTargetConfiguration.Shipping)
+		{
+			ExtraModuleNames.Add("BlackMythTests");
+		}
 	}
 }
@@ -3,11 +3,11 @@
 #include "AnimNotify_PoleStanceAOE.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Character.h"
-#include "Kismet/GameplayStatics.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
-#include "Engine/OverlapResult.h"
-#include "../EnemyBase.h"
+#include "../Combat/AreaEffectSubsystem.h"
+#include "../Subsystems/SpatialGridSubsystem.h"
+#include "../BlackMythLog.h"
 
 UAnimNotify_PoleStanceAOE::UAnimNotify_PoleStanceAOE()
 {
@@ -25,12 +25,11 @@ void UAnimNotify_PoleStanceAOE::Notify(USkeletalMeshComponent* MeshComp, UAnimSe
 {
 	Super::Notify(MeshComp, Animation, EventReference);
 
-	// 明确的触发日志
-	UE_LOG(LogTemp, Error, TEXT("========== [PoleStanceAOE] NOTIFY TRIGGERED! =========="));
+	UE_LOG(LogBMCombat, Verbose, TEXT("[PoleStanceAOE] Notify triggered"));
 
 	if (!MeshComp || !MeshComp->GetWorld())
 	{
-		UE_LOG(LogTemp, Error, TEXT("[PoleStanceAOE] ERROR: Invalid MeshComp or World!"));
+		UE_LOG(LogBMCombat, Warning, TEXT("[PoleStanceAOE] ERROR: Invalid MeshComp or World!"));
 		return;
 	}
 
@@ -38,7 +37,7 @@ void UAnimNotify_PoleStanceAOE::Notify(USkeletalMeshComponent* MeshComp, UAnimSe
 	ACharacter* OwnerCharacter = Cast<ACharacter>(MeshComp->GetOwner());
 	if (!OwnerCharacter)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[PoleStanceAOE] ERROR: Owner is not a Character!"));
+		UE_LOG(LogBMCombat, Warning, TEXT("[PoleStanceAOE] ERROR: Owner is not a Character!"));
 		return;
 	}
 
@@ -46,7 +45,7 @@ void UAnimNotify_PoleStanceAOE::Notify(USkeletalMeshComponent* MeshComp, UAnimSe
 	FVector AOECenter = OwnerCharacter->GetActorLocation();
 	UWorld* World = MeshComp->GetWorld();
 
-	UE_LOG(LogTemp, Warning, TEXT("[PoleStanceAOE] Center: %s, Radius: %.1f, Damage: %.1f"), 
+	UE_LOG(LogBMCombat, Verbose, TEXT("[PoleStanceAOE] Center: %s, Radius: %.1f, Damage: %.1f"), 
 		*AOECenter.ToString(), AOERadius, Damage);
 
 	// 绘制调试球体（更明显）
@@ -62,88 +61,50 @@ void UAnimNotify_PoleStanceAOE::Notify(USkeletalMeshComponent* MeshComp, UAnimSe
 		}
 	}
 
-	// 球形范围检测（使用OverlapMulti更可靠）
-	TArray<FOverlapResult> OverlapResults;
-	FCollisionShape Sphere = FCollisionShape::MakeSphere(AOERadius);
-	
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(OwnerCharacter);
-	QueryParams.bTraceComplex = false;
-
-	// 使用 OverlapMultiByChannel 检测所有Pawn
-	bool bHit = World->OverlapMultiByChannel(
-		OverlapResults,
-		AOECenter,
-		FQuat::Identity,
-		ECC_Pawn,
-		Sphere,
-		QueryParams
-	);
-
-	UE_LOG(LogTemp, Warning, TEXT("[PoleStanceAOE] Overlap check returned: %d results"), OverlapResults.Num());
-
-	if (!bHit || OverlapResults.Num() == 0)
+	UAreaEffectSubsystem* AreaEffects = UAreaEffectSubsystem::Get(World);
+	if (!AreaEffects)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[PoleStanceAOE] No targets found in radius %.1f"), AOERadius);
-		
-		if (GEngine)
-		{
-			GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, TEXT("立棍AOE: 范围内无敌人"));
-		}
 		return;
 	}
 
-	// 统计命中敌人数量
-	int32 EnemyHitCount = 0;
+	// 立棍作为AOE技能，直接造成伤害，无视闪避
+	// 伤害会触发敌人正常的受击硬直动画，产生自然的控制效果
+	FAreaEffectRequest Request;
+	Request.Instigator = OwnerCharacter;
+	Request.Center = AOECenter;
+	Request.Radius = AOERadius;
+	Request.TeamMask = SpatialGrid::TeamBit(ETeam::Enemy);
+	Request.Damage = Damage;
+	Request.bCanBeDodged = false;
 
-	// 遍历所有命中对象
-	for (const FOverlapResult& Overlap : OverlapResults)
-	{
-		AActor* HitActor = Overlap.GetActor();
-		if (!HitActor)
-		{
-			continue;
-		}
+	TArray<AActor*> Targets;
+	const int32 EnemyHitCount = AreaEffects->Apply(Request, bDrawDebug ? &Targets : nullptr);
 
-		UE_LOG(LogTemp, Log, TEXT("[PoleStanceAOE] Found actor: %s"), *HitActor->GetName());
+	UE_LOG(LogBMCombat, Verbose, TEXT("[PoleStanceAOE] Total enemies hit: %d"), EnemyHitCount);
 
-		// 只处理敌人
-		AEnemyBase* Enemy = Cast<AEnemyBase>(HitActor);
-		if (!Enemy)
-		{
-			UE_LOG(LogTemp, Log, TEXT("[PoleStanceAOE]   -> Not an enemy, skipping"));
-			continue;
-		}
+	if (!bDrawDebug)
+	{
+		return;
+	}
 
-		if (Enemy->IsDead())
+	// 绘制命中线
+	for (const AActor* Target : Targets)
+	{
+		DrawDebugLine(World, AOECenter, Target->GetActorLocation(), FColor::Red, false, DebugDrawDuration, 0, 5.0f);
+		DrawDebugSphere(World, Target->GetActorLocation(), 50.0f, 12, FColor::Red, false, DebugDrawDuration, 0, 3.0f);
+	}
+
+	if (GEngine)
+	{
+		if (EnemyHitCount > 0)
 		{
-			UE_LOG(LogTemp, Log, TEXT("[PoleStanceAOE]   -> Enemy is dead, skipping"));
-			continue;
+			GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, 
+				FString::Printf(TEXT("立棍AOE命中 %d 个敌人!"), EnemyHitCount));
 		}
-
-		// 立棍作为AOE技能，直接造成伤害，无视闪避
-		// 伤害会触发敌人正常的受击硬直动画，产生自然的控制效果
-		Enemy->ReceiveDamage(Damage, OwnerCharacter, false); // false = 不允许闪避
-
-		EnemyHitCount++;
-
-		// 绘制命中线
-		if (bDrawDebug)
+		else
 		{
-			DrawDebugLine(World, AOECenter, Enemy->GetActorLocation(), FColor::Red, false, DebugDrawDuration, 0, 5.0f);
-			DrawDebugSphere(World, Enemy->GetActorLocation(), 50.0f, 12, FColor::Red, false, DebugDrawDuration, 0, 3.0f);
+			GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Yellow, TEXT("立棍AOE: 范围内无敌人"));
 		}
-
-		UE_LOG(LogTemp, Error, TEXT("[PoleStanceAOE] >>> HIT ENEMY: %s, Damage: %.1f"), 
-			*Enemy->GetName(), Damage);
-	}
-
-	UE_LOG(LogTemp, Error, TEXT("[PoleStanceAOE] ===== TOTAL ENEMIES HIT: %d ====="), EnemyHitCount);
-
-	if (GEngine && EnemyHitCount > 0)
-	{
-		GEngine->AddOnScreenDebugMessage(-1, 3.0f, FColor::Green, 
-			FString::Printf(TEXT("立棍AOE命中 %d 个敌人!"), EnemyHitCount));
 	}
 }
 
@@ -9,6 +9,7 @@
 /**
  * 立棍技能AOE伤害通知
  * 在立棍落地瞬间触发，对范围内所有敌人造成伤害并破坏韧性
+ * 目标收集和伤害结算交给 UAreaEffectSubsystem（空间网格查询 + 合批结算）
  */
 UCLASS()
 class BLACKMYTH_API UAnimNotify_PoleStanceAOE : public UAnimNotify
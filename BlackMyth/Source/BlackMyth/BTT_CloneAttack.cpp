@@ -0,0 +1,87 @@
+#include "BTT_CloneAttack.h"
+#include "WukongClone.h"
+#include "WukongCloneAIController.h"
+#include "AIController.h"
+#include "BehaviorTree/BlackboardComponent.h"
+
+UBTT_CloneAttack::UBTT_CloneAttack()
+{
+	NodeName = "Clone Attack";
+	bNotifyTick = true;
+
+	BlackboardKey.SelectedKeyName = AWukongCloneAIController::TargetActorKey;
+	BlackboardKey.AddObjectFilter(this, GET_MEMBER_NAME_CHECKED(UBTT_CloneAttack, BlackboardKey), AActor::StaticClass());
+}
+
+uint16 UBTT_CloneAttack::GetInstanceMemorySize() const
+{
+	return sizeof(FCloneAttackMemory);
+}
+
+EBTNodeResult::Type UBTT_CloneAttack::ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory)
+{
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	AWukongClone* Clone = AIController ? Cast<AWukongClone>(AIController->GetPawn()) : nullptr;
+	UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	AActor* Target = BlackboardComp ? Cast<AActor>(BlackboardComp->GetValueAsObject(BlackboardKey.SelectedKeyName)) : nullptr;
+	if (!Clone || !Target)
+	{
+		return EBTNodeResult::Failed;
+	}
+
+	FCloneAttackMemory* Memory = CastInstanceNodeMemory<FCloneAttackMemory>(NodeMemory);
+	Memory->bAttackStarted = TryAttack(Clone, Target);
+
+	// 冷却中或攻击动作进行中，在 TickTask 中等待
+	return EBTNodeResult::InProgress;
+}
+
+void UBTT_CloneAttack::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds)
+{
+	AAIController* AIController = OwnerComp.GetAIOwner();
+	AWukongClone* Clone = AIController ? Cast<AWukongClone>(AIController->GetPawn()) : nullptr;
+	if (!Clone)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	FCloneAttackMemory* Memory = CastInstanceNodeMemory<FCloneAttackMemory>(NodeMemory);
+	if (Memory->bAttackStarted)
+	{
+		// 攻击动作结束即完成
+		if (!Clone->IsAttacking())
+		{
+			FinishLatentTask(OwnerComp, EBTNodeResult::Succeeded);
+		}
+		return;
+	}
+
+	// 等待冷却期间，目标失效或离开攻击范围则交回行为树
+	UBlackboardComponent* BlackboardComp = OwnerComp.GetBlackboardComponent();
+	AActor* Target = BlackboardComp ? Cast<AActor>(BlackboardComp->GetValueAsObject(BlackboardKey.SelectedKeyName)) : nullptr;
+	if (!Target || FVector::Dist(Clone->GetActorLocation(), Target->GetActorLocation()) > Clone->GetAttackRange() * RangeTolerance)
+	{
+		FinishLatentTask(OwnerComp, EBTNodeResult::Failed);
+		return;
+	}
+
+	Memory->bAttackStarted = TryAttack(Clone, Target);
+}
+
+bool UBTT_CloneAttack::TryAttack(AWukongClone* Clone, AActor* Target)
+{
+	if (Clone->IsAttacking())
+	{
+		return false;
+	}
+
+	Clone->FaceTarget(Target);
+	if (!Clone->CanAttack())
+	{
+		return false;
+	}
+
+	Clone->PerformAttack();
+	return true;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BehaviorTree/Tasks/BTTask_BlackboardBase.h"
+#include "BTT_CloneAttack.generated.h"
+
+/**
+ * 行为树任务：分身攻击
+ * 面向黑板中的目标，冷却结束后发动一次攻击，攻击动作结束时返回成功
+ * 等待期间目标失效或离开攻击范围则返回失败，交回行为树重新追击
+ */
+UCLASS()
+class BLACKMYTH_API UBTT_CloneAttack : public UBTTask_BlackboardBase
+{
+	GENERATED_BODY()
+
+public:
+	UBTT_CloneAttack();
+
+	virtual EBTNodeResult::Type ExecuteTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory) override;
+	virtual void TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeMemory, float DeltaSeconds) override;
+	virtual uint16 GetInstanceMemorySize() const override;
+
+protected:
+	/** 目标超出攻击范围的容差倍数（超出 AttackRange * 此值时放弃攻击） */
+	UPROPERTY(EditAnywhere, Category = "Clone")
+	float RangeTolerance = 1.2f;
+
+private:
+	struct FCloneAttackMemory
+	{
+		/** 本次任务是否已经发动了攻击 */
+		bool bAttackStarted = false;
+	};
+
+	/** 尝试发动攻击，返回是否已发动 */
+	static bool TryAttack(class AWukongClone* Clone, AActor* Target);
+};
@@ -2,6 +2,8 @@
 #include "AIController.h"
 #include "BehaviorTree/BlackboardComponent.h"
 #include "GameFramework/Actor.h"
+#include "GameFramework/Pawn.h"
+#include "Subsystems/LineOfSightSubsystem.h"
 
 UBTT_RangedMoveTo::UBTT_RangedMoveTo()
 {
@@ -30,8 +32,20 @@ void UBTT_RangedMoveTo::TickTask(UBehaviorTreeComponent& OwnerComp, uint8* NodeM
 		if (DistSq <= AcceptableRadiusSq)
 		{
 			// 2. 检查视野 (Line Of Sight)
-			// LineOfSightTo 会进行射线检测，检查是否有墙壁阻挡
-			if (AIController->LineOfSightTo(TargetActor))
+			// 通过视线子系统查询（异步射线 + 缓存），尚无结果时继续移动，下一帧再判断
+			bool bHasLineOfSight = false;
+			if (ULineOfSightSubsystem* LineOfSight = ULineOfSightSubsystem::Get(AIController))
+			{
+				APawn* Pawn = AIController->GetPawn();
+				bHasLineOfSight = LineOfSight->QueryLineOfSight(Pawn, TargetActor, Pawn->GetPawnViewLocation(),
+					TargetActor->GetActorLocation()) == ELineOfSightResult::Visible;
+			}
+			else
+			{
+				bHasLineOfSight = AIController->LineOfSightTo(TargetActor);
+			}
+
+			if (bHasLineOfSight)
 			{
 				// 满足条件：在射程内且看得到目标
 				// 停止移动
@@ -0,0 +1,102 @@
+// 日志实现
+
+#include "BlackMythLog.h"
+#include "GameFramework/Actor.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+
+DEFINE_LOG_CATEGORY(LogBMCombat);
+DEFINE_LOG_CATEGORY(LogBMAI);
+DEFINE_LOG_CATEGORY(LogBMSave);
+DEFINE_LOG_CATEGORY(LogBMDialogue);
+
+#if BLACKMYTH_COMBAT_EVENT_LOG
+
+namespace BlackMythCombatLog
+{
+	static FCombatEventRecord Events[Capacity];
+
+	/** 累计写入的条数（下一条写到 NumWritten % Capacity） */
+	static uint64 NumWritten = 0;
+
+	void Record(ECombatEvent Type, const AActor* Source, const AActor* Target, float Value)
+	{
+		checkSlow(IsInGameThread());
+
+		FCombatEventRecord& Event = Events[NumWritten % Capacity];
+		Event.Frame = GFrameCounter;
+		Event.Time = FPlatformTime::Seconds();
+		Event.Source = Source ? Source->GetFName() : NAME_None;
+		Event.Target = Target ? Target->GetFName() : NAME_None;
+		Event.Value = Value;
+		Event.Type = Type;
+		++NumWritten;
+	}
+
+	void GetRecent(TArray<FCombatEventRecord>& OutEvents, int32 MaxCount)
+	{
+		const uint64 Count = FMath::Min<uint64>(NumWritten, FMath::Clamp(MaxCount, 0, Capacity));
+
+		OutEvents.Reset(static_cast<int32>(Count));
+		for (uint64 Index = NumWritten - Count; Index < NumWritten; ++Index)
+		{
+			OutEvents.Add(Events[Index % Capacity]);
+		}
+	}
+
+	void Clear()
+	{
+		NumWritten = 0;
+	}
+
+	static const TCHAR* GetEventName(ECombatEvent Type)
+	{
+		switch (Type)
+		{
+		case ECombatEvent::WeaponHit: return TEXT("WeaponHit");
+		case ECombatEvent::Damage:    return TEXT("Damage");
+		case ECombatEvent::AOEHit:    return TEXT("AOEHit");
+		case ECombatEvent::Alert:     return TEXT("Alert");
+		case ECombatEvent::Stun:      return TEXT("Stun");
+		case ECombatEvent::Death:     return TEXT("Death");
+		case ECombatEvent::Freeze:    return TEXT("Freeze");
+		case ECombatEvent::Dodge:     return TEXT("Dodge");
+		}
+		return TEXT("Unknown");
+	}
+
+	static void Dump(const TArray<FString>& Args)
+	{
+		const int32 MaxCount = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 64;
+
+		TArray<FCombatEventRecord> Recent;
+		GetRecent(Recent, MaxCount);
+
+		UE_LOG(LogBMCombat, Display, TEXT("[CombatLog] %d of %llu events"), Recent.Num(), NumWritten);
+		if (Recent.Num() == 0)
+		{
+			return;
+		}
+
+		// 时间相对最后一条事件，便于对照"刚才那一下"
+		const double LastTime = Recent.Last().Time;
+		for (const FCombatEventRecord& Event : Recent)
+		{
+			UE_LOG(LogBMCombat, Display, TEXT("[CombatLog] %8.3fs  frame %llu  %-9s %s -> %s  %.1f"),
+				Event.Time - LastTime, Event.Frame, GetEventName(Event.Type),
+				*Event.Source.ToString(), *Event.Target.ToString(), Event.Value);
+		}
+	}
+
+	static FAutoConsoleCommand DumpCommand(
+		TEXT("BlackMyth.CombatLog.Dump"),
+		TEXT("Print the most recent combat events (hits, damage, alerts, stuns). Args: [Count=64]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Dump));
+
+	static FAutoConsoleCommand ClearCommand(
+		TEXT("BlackMyth.CombatLog.Clear"),
+		TEXT("Discard all recorded combat events."),
+		FConsoleCommandDelegate::CreateStatic(&Clear));
+}
+
+#endif
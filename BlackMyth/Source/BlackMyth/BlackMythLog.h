@@ -0,0 +1,93 @@
+// 日志 - BlackMyth 的日志分类（带编译期上限）和战斗事件环形缓冲
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/LogMacros.h"
+
+class AActor;
+
+/**
+ * 编译期日志上限：超过上限的 UE_LOG 连同参数求值和字符串格式化一起被编译掉
+ * - Shipping：只保留 Warning 及以上
+ * - 其他构建：保留到 Log；逐次命中、逐帧状态切换等 Verbose 日志需要 BLACKMYTH_VERBOSE_LOGS=1 才编译进来
+ *   （Build.cs 中 PublicDefinitions.Add("BLACKMYTH_VERBOSE_LOGS=1")）
+ * 上限之内的级别仍可在运行时用 "Log LogBMCombat Warning" 或 -LogCmds= 调整
+ */
+#ifndef BLACKMYTH_VERBOSE_LOGS
+#define BLACKMYTH_VERBOSE_LOGS 0
+#endif
+
+#if UE_BUILD_SHIPPING
+#define BLACKMYTH_LOG_COMPILE_CAP Warning
+#elif BLACKMYTH_VERBOSE_LOGS
+#define BLACKMYTH_LOG_COMPILE_CAP All
+#else
+#define BLACKMYTH_LOG_COMPILE_CAP Log
+#endif
+
+/** 命中检测、伤害结算、AOE */
+BLACKMYTH_API DECLARE_LOG_CATEGORY_EXTERN(LogBMCombat, Log, BLACKMYTH_LOG_COMPILE_CAP);
+
+/** 敌人状态机、感知、警戒 */
+BLACKMYTH_API DECLARE_LOG_CATEGORY_EXTERN(LogBMAI, Log, BLACKMYTH_LOG_COMPILE_CAP);
+
+/** 存档读写和关卡恢复 */
+BLACKMYTH_API DECLARE_LOG_CATEGORY_EXTERN(LogBMSave, Log, BLACKMYTH_LOG_COMPILE_CAP);
+
+/** 对话 */
+BLACKMYTH_API DECLARE_LOG_CATEGORY_EXTERN(LogBMDialogue, Log, BLACKMYTH_LOG_COMPILE_CAP);
+
+// ========== 战斗事件环形缓冲 ==========
+
+/**
+ * 战斗中每次命中/伤害都打日志代价太高，这些事件改为写入定长环形缓冲：
+ * 记录时只复制几个数值和 FName，不格式化字符串、不做 I/O，需要时用
+ * BlackMyth.CombatLog.Dump [Count] 把最近的事件输出到 LogBMCombat。
+ * 只在游戏线程记录；Shipping 构建中为空操作。
+ */
+#define BLACKMYTH_COMBAT_EVENT_LOG (!UE_BUILD_SHIPPING)
+
+enum class ECombatEvent : uint8
+{
+	WeaponHit,   // 武器轨迹命中（伤害另记一条 Damage）
+	Damage,      // 伤害生效（Value = 伤害）
+	AOEHit,      // 范围技能命中（Value = 伤害）
+	Alert,       // 敌人广播警戒（Target = 警戒目标，Value = 被通知的敌人数）
+	Stun,        // 韧性被打破（Value = 硬直时长）
+	Death,       // 死亡（Source = 击杀者）
+	Freeze,      // 定身（Value = 时长）
+	Dodge,       // 敌人闪避成功（Source = 闪避者，Value = 随机判定值）
+};
+
+/** 一条战斗事件（定长） */
+struct FCombatEventRecord
+{
+	/** 记录时的帧号和 FPlatformTime::Seconds() */
+	uint64 Frame = 0;
+	double Time = 0.0;
+
+	FName Source;
+	FName Target;
+	float Value = 0.0f;
+	ECombatEvent Type = ECombatEvent::WeaponHit;
+};
+
+namespace BlackMythCombatLog
+{
+	/** 缓冲容量（条），写满后覆盖最旧的事件 */
+	constexpr int32 Capacity = 4096;
+
+#if BLACKMYTH_COMBAT_EVENT_LOG
+	BLACKMYTH_API void Record(ECombatEvent Type, const AActor* Source, const AActor* Target, float Value = 0.0f);
+
+	/** 按时间顺序复制出最近的 MaxCount 条事件 */
+	BLACKMYTH_API void GetRecent(TArray<FCombatEventRecord>& OutEvents, int32 MaxCount = Capacity);
+
+	BLACKMYTH_API void Clear();
+#else
+	FORCEINLINE void Record(ECombatEvent, const AActor*, const AActor*, float = 0.0f) {}
+	FORCEINLINE void GetRecent(TArray<FCombatEventRecord>& OutEvents, int32 = Capacity) { OutEvents.Reset(); }
+	FORCEINLINE void Clear() {}
+#endif
+}
@@ -0,0 +1,7 @@
+// 基准测试计数器实现
+
+#include "BlackMythPerfCounters.h"
+
+#if !UE_BUILD_SHIPPING
+int32 BlackMythPerf::Counters[static_cast<int32>(BlackMythPerf::ECounter::Num)] = {};
+#endif
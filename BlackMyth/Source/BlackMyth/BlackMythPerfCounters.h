@@ -0,0 +1,45 @@
+// 基准测试计数器 - 非 Shipping 构建中按帧累计物理查询和空间网格查询次数，供无头基准测试直接读取
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 基准测试计数器
+ * - stat 计数器只在统计系统开启时可读，-nullrhi 下跑的基准测试需要能直接读取的计数
+ * - 只在游戏线程累加，由读取方每帧读取后清零
+ * - Shipping 构建中全部为空操作
+ */
+namespace BlackMythPerf
+{
+	enum class ECounter : uint8
+	{
+		PhysicsQueries,  // 发往物理场景的查询（射线、Sweep、Overlap，含异步）
+		SpatialQueries,  // 空间网格查询
+
+		Num
+	};
+
+#if !UE_BUILD_SHIPPING
+	extern BLACKMYTH_API int32 Counters[static_cast<int32>(ECounter::Num)];
+
+	FORCEINLINE void Add(ECounter Counter, int32 Amount = 1)
+	{
+		Counters[static_cast<int32>(Counter)] += Amount;
+	}
+
+	FORCEINLINE int32 Get(ECounter Counter)
+	{
+		return Counters[static_cast<int32>(Counter)];
+	}
+
+	FORCEINLINE void Reset()
+	{
+		FMemory::Memzero(Counters);
+	}
+#else
+	FORCEINLINE void Add(ECounter, int32 = 1) {}
+	FORCEINLINE int32 Get(ECounter) { return 0; }
+	FORCEINLINE void Reset() {}
+#endif
+}
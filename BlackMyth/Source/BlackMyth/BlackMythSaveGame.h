@@ -11,15 +11,27 @@ struct FEnemySaveData
     GENERATED_BODY()
 
 public:
-    // 唯一标识敌人
-    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Save")
-    FGuid EnemyID = FGuid::NewGuid();
+    // 稳定存档键 = (SpawnerKey << 32) | SpawnIndex
+    static uint64 MakeSaveKey(uint32 InSpawnerKey, int32 InSpawnIndex)
+    {
+        return (static_cast<uint64>(InSpawnerKey) << 32) | static_cast<uint32>(InSpawnIndex);
+    }
+
+    uint64 GetSaveKey() const { return MakeSaveKey(SpawnerKey, SpawnIndex); }
+
+    // 生成此敌人的Spawner存档键
+    UPROPERTY()
+    uint32 SpawnerKey = 0;
+
+    // 在所属Spawner中的生成序号
+    UPROPERTY()
+    int32 SpawnIndex = INDEX_NONE;
 
     // 敌人蓝图类
     UPROPERTY()
     TSubclassOf<AEnemyBase> EnemyClass = nullptr;
 
-    // 生成此敌人的Spawner名称
+    // 旧版存档（UBlackMythSaveGame）中的Spawner名称，仅用于兼容读取
     UPROPERTY()
     FString SpawnerName;
 
@@ -0,0 +1,9 @@
+// 性能统计实现
+
+#include "BlackMythStats.h"
+
+DEFINE_STAT(STAT_WidgetsTicking);
+
+#if !UE_BUILD_SHIPPING && CPUPROFILERTRACE_ENABLED
+UE_TRACE_CHANNEL_DEFINE(BlackMythChannel);
+#endif
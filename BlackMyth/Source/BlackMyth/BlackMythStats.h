@@ -0,0 +1,41 @@
+// 性能统计 - BlackMyth 的 stat 分组、跨文件共享的计数器和 Unreal Insights 跟踪通道
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+
+/**
+ * stat BlackMyth 查看；各文件用 DECLARE_CYCLE_STAT / DECLARE_DWORD_COUNTER_STAT 声明到此分组。
+ * Shipping 构建中 STATS 为 0，所有 stat 宏为空。
+ */
+DECLARE_STATS_GROUP(TEXT("BlackMyth"), STATGROUP_BlackMyth, STATCAT_Advanced);
+
+/** 本帧更新的 UI 控件数（Boss 血条、敌人头顶血条与警觉图标），多个文件累加 */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Widgets Ticking"), STAT_WidgetsTicking, STATGROUP_BlackMyth, BLACKMYTH_API);
+
+/**
+ * Insights 跟踪通道：-trace=cpu,BlackMyth 录制时，BLACKMYTH_SCOPE_CYCLE 的区间出现在 BlackMyth 通道，
+ * BLACKMYTH_TRACE_BOOKMARK 在时间轴上留下玩法事件标记（存档、对话、Boss 战等）。
+ * Shipping 构建中全部为空。
+ */
+#if !UE_BUILD_SHIPPING && CPUPROFILERTRACE_ENABLED
+UE_TRACE_CHANNEL_EXTERN(BlackMythChannel, BLACKMYTH_API);
+
+#define BLACKMYTH_TRACE_SCOPE(Name) TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR(Name, BlackMythChannel)
+#else
+#define BLACKMYTH_TRACE_SCOPE(Name)
+#endif
+
+#if !UE_BUILD_SHIPPING
+#define BLACKMYTH_TRACE_BOOKMARK(Format, ...) TRACE_BOOKMARK(Format, ##__VA_ARGS__)
+#else
+#define BLACKMYTH_TRACE_BOOKMARK(Format, ...)
+#endif
+
+/** stat 计时与 Insights 区间一起记录（Name 为 Insights 中显示的名字） */
+#define BLACKMYTH_SCOPE_CYCLE(Stat, Name) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	BLACKMYTH_TRACE_SCOPE(Name)
@@ -10,7 +10,10 @@
 #include "Dialogue/DialogueComponent.h"
 #include "Dialogue/DialogueData.h"
 #include "XiaoTian.h"
+#include "Subsystems/ActorPoolSubsystem.h"
 #include "UObject/ConstructorHelpers.h"
+#include "Combat/CombatActorInterface.h"
+#include "BlackMythStats.h"
 
 ABossCombatTrigger::ABossCombatTrigger()
 {
@@ -79,6 +82,12 @@ void ABossCombatTrigger::NotifyActorBeginOverlap(AActor* OtherActor)
 
 	bHasTriggered = true;
 
+	// 过场对话在延迟后开始，先预取前几句的语音和蒙太奇
+	if (DialogueComponent)
+	{
+		DialogueComponent->PrefetchDialogue();
+	}
+
 	// [New] 延迟开始过场动画，给玩家一点走位时间进入中心，避免卡在门口
 	UE_LOG(LogTemp, Warning, TEXT("[BossArea] Player entered. Delaying CG for %.1f seconds..."), CutsceneStartDelay);
 	
@@ -116,6 +125,13 @@ void ABossCombatTrigger::OnCutsceneFinished(bool bIsPlaying)
 	if (bIsPlaying) return; // 只处理“结束”消息
 
 	UE_LOG(LogTemp, Log, TEXT("[BossCombatTrigger] Cutscene finished. Starting combat logic."));
+	BLACKMYTH_TRACE_BOOKMARK(TEXT("Boss combat start"));
+
+	// 过场对话不会再播放，释放预取的资源
+	if (DialogueComponent)
+	{
+		DialogueComponent->ReleasePrefetchedDialogue();
+	}
 
 	// 1. 切换镜头回玩家
 	APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0);
@@ -189,7 +205,7 @@ void ABossCombatTrigger::BindBossDeathEvent()
 	if (LinkedBoss)
 	{
 		// 获取Boss的HealthComponent并绑定死亡事件
-		if (UHealthComponent* BossHealth = LinkedBoss->FindComponentByClass<UHealthComponent>())
+		if (UHealthComponent* BossHealth = ICombatActor::GetHealth(LinkedBoss))
 		{
 			BossHealth->OnDeath.AddDynamic(this, &ABossCombatTrigger::OnBossDeath);
 			UE_LOG(LogTemp, Log, TEXT("BossCombatTrigger: Bound to Boss death event"));
@@ -200,6 +216,7 @@ void ABossCombatTrigger::BindBossDeathEvent()
 void ABossCombatTrigger::OnBossDeath(AActor* Killer)
 {
 	UE_LOG(LogTemp, Log, TEXT("BossCombatTrigger: Boss died, ending Boss combat"));
+	BLACKMYTH_TRACE_BOOKMARK(TEXT("Boss defeated"));
 
 	// Boss死亡时自动切换回探索状态
 	if (AGameStateBase* GameState = GetWorld()->GetGameState())
@@ -309,7 +326,11 @@ void ABossCombatTrigger::HandleDialogueEvent(const FString& EventTag)
 		SpawnParams.Owner = LinkedBoss.Get();
 		SpawnParams.Instigator = LinkedBoss.Get();
 
-		if (AActor* DogActor = GetWorld()->SpawnActor<AActor>(LinkedBoss->DogClass, SpawnLocation, SpawnRotation, SpawnParams))
+		UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this);
+		AActor* DogActor = Pool
+			? Pool->Acquire<AActor>(LinkedBoss->DogClass, SpawnLocation, SpawnRotation, SpawnParams)
+			: GetWorld()->SpawnActor<AActor>(LinkedBoss->DogClass, SpawnLocation, SpawnRotation, SpawnParams);
+		if (DogActor)
 		{
 			// 3. 通知哮天犬播放 End 动作并消失 (即过场动画模式)
 			if (AXiaoTian* Dog = Cast<AXiaoTian>(DogActor))
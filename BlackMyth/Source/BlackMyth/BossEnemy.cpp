@@ -11,6 +11,9 @@
 #include "NiagaraComponent.h"
 #include "NiagaraFunctionLibrary.h"
 #include "XiaoTian.h"
+#include "Subsystems/ActorRegistrySubsystem.h"
+#include "Subsystems/ActorPoolSubsystem.h"
+#include "BlackMythLog.h"
 
 ABossEnemy::ABossEnemy()
 {
@@ -27,6 +30,10 @@ ABossEnemy::ABossEnemy()
 	AttackMin = 0.1f;
 	AttackMax = 0.4f;
 
+	// 追击中也保持较快地面向目标
+	FacingInterpSpeed = 10.0f;
+	bFaceTargetWhileChasing = true;
+
 	// 设置超高韧性，防止被打出硬直 (Stunned)
 	// Float 能够轻松容纳 1,000,000 (10^6)，不会溢出
 	MaxPoise = 1000000.0f;
@@ -43,7 +50,7 @@ void ABossEnemy::BeginPlay()
 	{
 		DodgeComponent->DestroyComponent();
 		DodgeComponent = nullptr;
-		UE_LOG(LogTemp, Warning, TEXT("[%s] Inherited DodgeComponent Destroyed to prevent conflict."), *GetName());
+		UE_LOG(LogBMAI, Warning, TEXT("[%s] Inherited DodgeComponent Destroyed to prevent conflict."), *GetName());
 	}
 	
 	// 创建 Boss 血条 UI
@@ -52,7 +59,7 @@ void ABossEnemy::BeginPlay()
 		BossHealthBarWidget = CreateWidget<UBossHealthBar>(GetWorld(), BossHealthBarClass);
 		if (BossHealthBarWidget)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[%s] Health Bar Widget Created Successfully!"), *GetName());
+			UE_LOG(LogBMAI, Warning, TEXT("[%s] Health Bar Widget Created Successfully!"), *GetName());
 			// 初始化 Widget，传入 HealthComponent
 			BossHealthBarWidget->InitializeWidget(HealthComponent);
 			
@@ -61,12 +68,12 @@ void ABossEnemy::BeginPlay()
 		}
 		else
 		{
-			UE_LOG(LogTemp, Error, TEXT("[%s] Failed to create Health Bar Widget!"), *GetName());
+			UE_LOG(LogBMAI, Error, TEXT("[%s] Failed to create Health Bar Widget!"), *GetName());
 		}
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s] BossHealthBarClass is NONE! Please set it in Blueprint Class Defaults."), *GetName());
+		UE_LOG(LogBMAI, Error, TEXT("[%s] BossHealthBarClass is NONE! Please set it in Blueprint Class Defaults."), *GetName());
 	}
 }
 
@@ -100,12 +107,7 @@ void ABossEnemy::Tick(float DeltaTime)
 			// 使用AI控制器移动到目标
 			if (AAIController* AIController = Cast<AAIController>(GetController()))
 			{
-				// [Fix] 始终面向目标，即便是在移动中也保持平滑转向
-				FVector Direction = (CombatTarget->GetActorLocation() - GetActorLocation()).GetSafeNormal();
-				Direction.Z = 0.f;
-				FRotator TargetRot = Direction.Rotation();
-				FRotator NewRot = FMath::RInterpTo(GetActorRotation(), TargetRot, DeltaTime, 10.0f); // 较快的转向速度
-				SetActorRotation(NewRot);
+				// 转向由 UpdateFacing 统一处理（bFaceTargetWhileChasing，移动中也保持面向目标）
 
 				// 只在没有移动时才重新请求移动，避免每帧重置路径
 				if (AIController->GetMoveStatus() == EPathFollowingStatus::Idle)
@@ -152,7 +154,7 @@ void ABossEnemy::PerformLightAttack()
 
 	if (MontageToPlay)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[%s] Performing Light Attack: %s"), *GetName(), *MontageToPlay->GetName());
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Performing Light Attack: %s"), *GetName(), *MontageToPlay->GetName());
 		
 		if (CombatTarget)
 		{
@@ -201,7 +203,7 @@ void ABossEnemy::PerformHeavyAttack()
 
 	if (MontageToPlay)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[%s] Performing Heavy Attack: %s"), *GetName(), *MontageToPlay->GetName());
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Performing Heavy Attack: %s"), *GetName(), *MontageToPlay->GetName());
 		
 		if (CombatTarget)
 		{
@@ -246,15 +248,15 @@ void ABossEnemy::ActivateBoss(AActor* Target)
 {
 	if (IsDead()) return;
 
-	UE_LOG(LogTemp, Warning, TEXT("[%s] Boss Activated! Target: %s"), *GetName(), *Target->GetName());
+	UE_LOG(LogBMAI, Warning, TEXT("[%s] Boss Activated! Target: %s"), *GetName(), *Target->GetName());
 
 	// [Legacy] 激活外部空气墙已迁移至 BossCombatTrigger
 
 	// 1. 显示血条
 	SetBossHealthVisibility(true);
 
-	// 2. 设置仇恨目标
-	CombatTarget = Target;
+	// 2. 设置仇恨目标（同时写入黑板 TargetActor，开启控制器转向）
+	AssignCombatTarget(Target);
 
 	// 3. 通知 AI 控制器
 	if (AAIController* AI = Cast<AAIController>(GetController()))
@@ -291,12 +293,12 @@ void ABossEnemy::ReceiveDamage(float Damage, AActor* DamageInstigator, bool bCan
 		float HealthAfterDamage = HealthComponent->GetCurrentHealth() - Damage;
 		if (HealthAfterDamage / HealthComponent->GetMaxHealth() <= Phase2Threshold)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[%s] Triggering Phase Transition Lock."), *GetName());
+			UE_LOG(LogBMAI, Warning, TEXT("[%s] Triggering Phase Transition Lock."), *GetName());
 
 			// [Fix Restore] 如果当前处于定身状态，强制解除定身以播放转阶段动画
 			if (IsFrozen())
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[%s] Breaking out of Freeze for Phase 2 Transition!"), *GetName());
+				UE_LOG(LogBMAI, Warning, TEXT("[%s] Breaking out of Freeze for Phase 2 Transition!"), *GetName());
 				RemoveFreeze();
 			}
 
@@ -313,9 +315,9 @@ void ABossEnemy::ReceiveDamage(float Damage, AActor* DamageInstigator, bool bCan
 		// 基础闪避率 40%
 		if (Roll < 0.4f) 
 		{
-			UE_LOG(LogTemp, Log, TEXT("[%s] Masterful Evasion (Dodge Cancel)!"), *GetName());
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] Masterful Evasion (Dodge Cancel)!"), *GetName());
 			
-			if (DamageInstigator) CombatTarget = DamageInstigator;
+			if (DamageInstigator) AssignCombatTarget(DamageInstigator);
 
 			// 如果正在出招，立即停止当前攻击蒙太奇
 			if (IsEngaged())
@@ -367,17 +369,17 @@ void ABossEnemy::Die()
 	// [Legacy] 解除空气墙已迁移至 BossCombatTrigger
 
 	// [New] Boss 死亡，清理所有的哮天犬（防止死后继续咬人）
-	TArray<AActor*> FoundDogs;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AXiaoTian::StaticClass(), FoundDogs);
-	for (AActor* DogActor : FoundDogs)
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
 	{
-		if (DogActor->GetOwner() == this)
+		TArray<AActor*> FoundDogs;
+		Registry->GetSummonsOwnedBy(this, AXiaoTian::StaticClass(), FoundDogs);
+		for (AActor* DogActor : FoundDogs)
 		{
-			DogActor->Destroy();
+			UActorPoolSubsystem::ReleaseOrDestroy(DogActor);
 		}
 	}
 	
-	UE_LOG(LogTemp, Warning, TEXT("[%s] Boss is dead. Keeping corpse for %.1f seconds."), *GetName(), DeathLifeSpan);
+	UE_LOG(LogBMAI, Warning, TEXT("[%s] Boss is dead. Keeping corpse for %.1f seconds."), *GetName(), DeathLifeSpan);
 }
 
 void ABossEnemy::EnterPhase2()
@@ -385,7 +387,7 @@ void ABossEnemy::EnterPhase2()
 	bHasEnteredPhase2 = true;
 	CurrentPhase = EBossPhase::Phase2;
 	
-	UE_LOG(LogTemp, Warning, TEXT("[%s] Entering Phase 2!"), *GetName());
+	UE_LOG(LogBMAI, Warning, TEXT("[%s] Entering Phase 2!"), *GetName());
 
 	// 1. 开启无敌 (防止转阶段被打断)
 	bIsInvulnerable = true;
@@ -462,7 +464,7 @@ void ABossEnemy::PerformDodge()
 
 	if (DodgeMontage)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[%s] Boss Dodging! Montage: %s"), *GetName(), *DodgeMontage->GetName());
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Boss Dodging! Montage: %s"), *GetName(), *DodgeMontage->GetName());
 
 		// 停止当前移动，防止滑步，并允许蒙太奇RootMotion完全控制（如果有）
 		if (AAIController* AI = Cast<AAIController>(GetController()))
@@ -474,11 +476,11 @@ void ABossEnemy::PerformDodge()
 		
 		if (Duration > 0.0f)
 		{
-			UE_LOG(LogTemp, Warning, TEXT(">>> Dodge Montage Started! Duration: %.2f sec. If you don't see it, CHECK ANIM GRAPH SLOT NODE! <<<"), Duration);
+			UE_LOG(LogBMAI, Verbose, TEXT(">>> Dodge Montage Started! Duration: %.2f sec. If you don't see it, CHECK ANIM GRAPH SLOT NODE! <<<"), Duration);
 		}
 		else
 		{
-			UE_LOG(LogTemp, Error, TEXT(">>> Dodge Montage Failed to Play! Duration = 0. Check if Montage is valid. <<<"));
+			UE_LOG(LogBMAI, Error, TEXT(">>> Dodge Montage Failed to Play! Duration = 0. Check if Montage is valid. <<<"));
 		}
 
 		// 闪避期间不再硬性设置无敌，交给 ReceiveDamage 进行动作判断
@@ -495,7 +497,7 @@ void ABossEnemy::PerformDodge()
 			if (!IsDead() && !IsStunned())
 			{
 				EnemyState = EEnemyState::EES_Chasing;
-				UE_LOG(LogTemp, Log, TEXT("[%s] Dodge Finished. Resuming Chase."), *GetName());
+				UE_LOG(LogBMAI, Verbose, TEXT("[%s] Dodge Finished. Resuming Chase."), *GetName());
 			}
 		}, Duration, false);
 	}
@@ -509,11 +511,11 @@ void ABossEnemy::SummonDog()
 	// [Debug] 如果忘记在蓝图中给 DogClass 赋值，这里会报警
 	if (!DogClass)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s] SummonDog FAILED: DogClass is NULL! Please set it in Blueprint defaults."), *GetName());
+		UE_LOG(LogBMAI, Warning, TEXT("[%s] SummonDog FAILED: DogClass is NULL! Please set it in Blueprint defaults."), *GetName());
 		return;
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("[%s] Summoning Dog!"), *GetName());
+	UE_LOG(LogBMAI, Warning, TEXT("[%s] Summoning Dog!"), *GetName());
 
 	// 1. 设置攻击状态（防止被其它招式中断）
 	EnemyState = EEnemyState::EES_Engaged;
@@ -533,7 +535,14 @@ void ABossEnemy::SummonDog()
 	SpawnParams.Owner = this;
 	SpawnParams.Instigator = this;
 	
-	GetWorld()->SpawnActor<AActor>(DogClass, SpawnLocation, SpawnRotation, SpawnParams);
+	if (UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this))
+	{
+		Pool->Acquire<AActor>(DogClass, SpawnLocation, SpawnRotation, SpawnParams);
+	}
+	else
+	{
+		GetWorld()->SpawnActor<AActor>(DogClass, SpawnLocation, SpawnRotation, SpawnParams);
+	}
 
 	// 4. 为收招设置计时器
 	GetWorldTimerManager().SetTimer(AttackEndTimer, [this]()
@@ -563,7 +572,7 @@ void ABossEnemy::Attack()
 
 	float Roll = FMath::RandRange(0.0f, 1.0f);
 
-	UE_LOG(LogTemp, Log, TEXT("[%s] Boss Attack - CurrentPhase: %d, Roll: %.2f"), *GetName(), (int32)CurrentPhase, Roll);
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] Boss Attack - CurrentPhase: %d, Roll: %.2f"), *GetName(), (int32)CurrentPhase, Roll);
 
 	// ========== 二阶段专属 AI 逻辑 ==========
 	if (CurrentPhase == EBossPhase::Phase2)
@@ -575,7 +584,7 @@ void ABossEnemy::Attack()
 			// 二阶段核心：距离远就放狗 (提高由于距离触发的概率)
 			if (Distance > 600.0f)
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[%s] Phase 2 Distance Attack (Dist: %.1f)"), *GetName(), Distance);
+				UE_LOG(LogBMAI, Verbose, TEXT("[%s] Phase 2 Distance Attack (Dist: %.1f)"), *GetName(), Distance);
 				SummonDog();
 				return;
 			}
@@ -1,5 +1,6 @@
 #include "BossHealthBar.h"
 #include "Components/ProgressBar.h"
+#include "BlackMythStats.h"
 
 void UBossHealthBar::InitializeWidget(UHealthComponent* NewHealthComponent)
 {
@@ -10,6 +11,8 @@ void UBossHealthBar::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
 {
 	Super::NativeTick(MyGeometry, InDeltaTime);
 
+	INC_DWORD_STAT(STAT_WidgetsTicking);
+
 	if (HealthComponent && HealthProgressBar)
 	{
 		// 实时更新进度条百分比
@@ -4,6 +4,7 @@
 #include "../Components/CombatComponent.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Actor.h"
+#include "CombatActorInterface.h"
 
 UAnimNotify_OpenComboWindow::UAnimNotify_OpenComboWindow()
 {
@@ -24,7 +25,7 @@ void UAnimNotify_OpenComboWindow::Notify(USkeletalMeshComponent* MeshComp, UAnim
 	AActor* Owner = MeshComp->GetOwner();
 
 	// 查找 CombatComponent
-	UCombatComponent* CombatComp = Owner->FindComponentByClass<UCombatComponent>();
+	UCombatComponent* CombatComp = ICombatActor::GetCombat(Owner);
 	if (!CombatComp)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[AnimNotify] No CombatComponent found on %s"), *Owner->GetName());
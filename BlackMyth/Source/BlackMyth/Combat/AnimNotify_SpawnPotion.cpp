@@ -3,6 +3,7 @@
 #include "AnimNotify_SpawnPotion.h"
 #include "../Items/PotionActor.h"
 #include "../WukongCharacter.h"
+#include "../Subsystems/ActorPoolSubsystem.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/Actor.h"
 
@@ -44,8 +45,10 @@ void UAnimNotify_SpawnPotion::Notify(USkeletalMeshComponent* MeshComp,
 	SpawnParams.Owner = Wukong;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-	APotionActor* Potion = Wukong->GetWorld()->SpawnActor<APotionActor>(
-		PotionClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
+	UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(Wukong);
+	APotionActor* Potion = Pool
+		? Pool->Acquire<APotionActor>(PotionClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams)
+		: Wukong->GetWorld()->SpawnActor<APotionActor>(PotionClass, FVector::ZeroVector, FRotator::ZeroRotator, SpawnParams);
 
 	if (Potion)
 	{
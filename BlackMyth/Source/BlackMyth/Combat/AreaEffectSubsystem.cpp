@@ -0,0 +1,275 @@
+// 范围效果子系统实现
+
+#include "AreaEffectSubsystem.h"
+#include "CombatActorInterface.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "../EnemyBase.h"
+#include "../WukongCharacter.h"
+#include "../Components/HealthComponent.h"
+#include "../Components/StatusEffectComponent.h"
+#include "../Components/TeamComponent.h"
+#include "../Subsystems/SpatialGridSubsystem.h"
+#include "../BlackMythStats.h"
+#include "../BlackMythLog.h"
+
+DECLARE_CYCLE_STAT(TEXT("AreaEffect Apply"), STAT_AreaEffectApply, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("AreaEffect Targets"), STAT_AreaEffectTargets, STATGROUP_BlackMyth);
+
+namespace AreaEffect
+{
+	/** 当前批处理剩余的表现名额 */
+	struct FBatchBudget
+	{
+		int32 Sounds = 0;
+		int32 AttachedEffects = 0;
+	};
+
+	/** 正在结算的批处理（只在游戏线程访问；为空表示不在批处理中） */
+	static FBatchBudget* ActiveBatch = nullptr;
+
+	/** 按距离排序用 */
+	struct FCandidate
+	{
+		AActor* Actor = nullptr;
+		float DistSquared = 0.0f;
+	};
+
+	/**
+	 * 水平扇形与目标（水平投影为圆）是否相交
+	 * 中心在角度内时只看距离；否则看目标圆是否碰到扇形两条边
+	 */
+	static bool OverlapsCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, const FVector& TargetLocation, float TargetRadius)
+	{
+		const FVector2D Forward = FVector2D(Direction).GetSafeNormal();
+		const FVector2D ToTarget = FVector2D(TargetLocation - Origin);
+		const float HalfAngleRad = FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f));
+
+		if (ToTarget.IsNearlyZero() || FVector2D::DotProduct(Forward, ToTarget.GetSafeNormal()) >= FMath::Cos(HalfAngleRad))
+		{
+			return true;
+		}
+
+		for (const float EdgeAngle : { HalfAngleRad, -HalfAngleRad })
+		{
+			const FVector2D Edge = Forward.GetRotated(FMath::RadiansToDegrees(EdgeAngle));
+			const float Along = FMath::Clamp(FVector2D::DotProduct(ToTarget, Edge), 0.0f, Radius);
+			if (FVector2D::DistSquared(ToTarget, Edge * Along) <= FMath::Square(TargetRadius))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static bool Claim(int32 FBatchBudget::* Budget)
+	{
+		checkSlow(IsInGameThread());
+
+		if (!ActiveBatch)
+		{
+			return true;
+		}
+
+		int32& Remaining = ActiveBatch->*Budget;
+		if (Remaining <= 0)
+		{
+			return false;
+		}
+		--Remaining;
+		return true;
+	}
+}
+
+// ========== USubsystem ==========
+
+void UAreaEffectSubsystem::Deinitialize()
+{
+	QueryResults.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UAreaEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+UAreaEffectSubsystem* UAreaEffectSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UAreaEffectSubsystem>() : nullptr;
+}
+
+// ========== 结算 ==========
+
+int32 UAreaEffectSubsystem::Apply(const FAreaEffectRequest& Request, TArray<AActor*>* OutTargets)
+{
+	BLACKMYTH_SCOPE_CYCLE(STAT_AreaEffectApply, TEXT("AreaEffect::Apply"));
+
+	if (OutTargets)
+	{
+		OutTargets->Reset();
+	}
+
+	USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this);
+	if (!Grid || Request.Radius <= 0.0f)
+	{
+		return 0;
+	}
+
+	// 默认阵营：发起者的敌对阵营
+	uint8 TeamMask = Request.TeamMask;
+	if (TeamMask == 0)
+	{
+		ETeam InstigatorTeam = ETeam::Player;
+		Grid->GetRegisteredTeam(Request.Instigator, InstigatorTeam);
+		TeamMask = TeamHostility::HostileMask(InstigatorTeam);
+	}
+
+	// ========== 1. 一次空间查询 ==========
+	// 网格只按中心点判定，半径放宽到能覆盖最大的目标；扇形的角度放到下面逐个精确判定
+	const float MaxTargetRadius = FMath::Max(0.0f, Request.MaxTargetRadius);
+	Grid->QueryRadius(Request.Center, Request.Radius + MaxTargetRadius, TeamMask, QueryResults);
+
+	// ========== 2. 过滤、排序、截断 ==========
+	TArray<AreaEffect::FCandidate, TInlineAllocator<64>> Candidates;
+	for (AActor* Actor : QueryResults)
+	{
+		if (!Actor || Actor == Request.Instigator)
+		{
+			continue;
+		}
+
+		// 精确判定：目标碰撞半径（角色为胶囊半径）与范围相交
+		const FVector ActorLocation = Actor->GetActorLocation();
+		const float TargetRadius = FMath::Min(Actor->GetSimpleCollisionRadius(), MaxTargetRadius);
+		const float DistSquared = static_cast<float>(FVector::DistSquared(Request.Center, ActorLocation));
+		if (DistSquared > FMath::Square(Request.Radius + TargetRadius))
+		{
+			continue;
+		}
+
+		if (Request.ConeHalfAngle > 0.0f
+			&& !AreaEffect::OverlapsCone(Request.Center, Request.Direction, Request.Radius, Request.ConeHalfAngle, ActorLocation, TargetRadius))
+		{
+			continue;
+		}
+
+		const UHealthComponent* Health = ICombatActor::GetHealth(Actor);
+		if (!Health || Health->IsDead())
+		{
+			continue;
+		}
+
+		if (Request.bSkipFrozen)
+		{
+			const AEnemyBase* Enemy = Cast<AEnemyBase>(Actor);
+			if (Enemy && Enemy->IsFrozen())
+			{
+				continue;
+			}
+		}
+
+		Candidates.Add({ Actor, DistSquared });
+	}
+	QueryResults.Reset();
+
+	Candidates.Sort([](const AreaEffect::FCandidate& A, const AreaEffect::FCandidate& B)
+	{
+		return A.DistSquared < B.DistSquared;
+	});
+
+	if (Request.MaxTargets > 0 && Candidates.Num() > Request.MaxTargets)
+	{
+		Candidates.SetNum(Request.MaxTargets, EAllowShrinking::No);
+	}
+
+	if (Candidates.Num() == 0)
+	{
+		return 0;
+	}
+
+	// ========== 3. 合批结算 ==========
+	// 请求自带音效时目标自身的音效全部省略，否则只保留最近目标的一次
+	AreaEffect::FBatchBudget Budget;
+	Budget.Sounds = Request.Sound ? 0 : 1;
+	Budget.AttachedEffects = FMath::Max(0, Request.MaxAttachedEffects);
+
+	{
+		TGuardValue<AreaEffect::FBatchBudget*> BatchGuard(AreaEffect::ActiveBatch, &Budget);
+
+		for (const AreaEffect::FCandidate& Candidate : Candidates)
+		{
+			AActor* Target = Candidate.Actor;
+
+			if (Request.Damage > 0.0f)
+			{
+				if (AEnemyBase* Enemy = Cast<AEnemyBase>(Target))
+				{
+					Enemy->ReceiveDamage(Request.Damage, Request.Instigator, Request.bCanBeDodged);
+				}
+				else if (AWukongCharacter* Wukong = Cast<AWukongCharacter>(Target))
+				{
+					Wukong->ReceiveDamage(Request.Damage, Request.Instigator);
+				}
+				else if (UHealthComponent* Health = ICombatActor::GetHealth(Target))
+				{
+					Health->TakeDamage(Request.Damage, Request.Instigator);
+				}
+
+				BlackMythCombatLog::Record(ECombatEvent::AOEHit, Request.Instigator, Target, Request.Damage);
+			}
+
+			if (Request.FreezeDuration > 0.0f)
+			{
+				AEnemyBase* Enemy = Cast<AEnemyBase>(Target);
+				if (Enemy && !Enemy->IsDead())
+				{
+					Enemy->ApplyFreeze(Request.FreezeDuration);
+				}
+			}
+
+			if (Request.StatusEffect)
+			{
+				if (UStatusEffectComponent* StatusEffects = ICombatActor::GetStatusEffects(Target))
+				{
+					StatusEffects->ApplyEffect(Request.StatusEffect, Request.Instigator, Request.StatusEffectDuration);
+				}
+			}
+
+			if (OutTargets)
+			{
+				OutTargets->Add(Target);
+			}
+		}
+	}
+
+	if (Request.Sound)
+	{
+		UGameplayStatics::PlaySoundAtLocation(this, Request.Sound, Request.Center);
+	}
+
+	INC_DWORD_STAT_BY(STAT_AreaEffectTargets, Candidates.Num());
+	UE_LOG(LogBMCombat, Verbose, TEXT("[AreaEffect] %s hit %d targets (R:%.0f D:%.1f Freeze:%.1f)"),
+		*GetNameSafe(Request.Instigator), Candidates.Num(), Request.Radius, Request.Damage, Request.FreezeDuration);
+
+	return Candidates.Num();
+}
+
+// ========== 表现合并 ==========
+
+bool UAreaEffectSubsystem::ClaimSound()
+{
+	return AreaEffect::Claim(&AreaEffect::FBatchBudget::Sounds);
+}
+
+bool UAreaEffectSubsystem::ClaimAttachedEffect()
+{
+	return AreaEffect::Claim(&AreaEffect::FBatchBudget::AttachedEffects);
+}
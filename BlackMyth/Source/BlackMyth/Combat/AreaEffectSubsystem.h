@@ -0,0 +1,110 @@
+// 范围效果子系统 - 一次空间查询收集目标，合批结算伤害/定身/状态效果，并合并音效和特效
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "AreaEffectSubsystem.generated.h"
+
+class USoundBase;
+class UStatusEffectBase;
+
+/** 一次范围效果：形状 + 过滤条件 + 效果 */
+struct FAreaEffectRequest
+{
+	/** 发起者（不会命中自己；伤害来源；默认阵营过滤依据） */
+	AActor* Instigator = nullptr;
+
+	// ========== 形状 ==========
+
+	FVector Center = FVector::ZeroVector;
+	float Radius = 0.0f;
+
+	/** 大于 0 时为水平扇形（半角，度），朝向 Direction */
+	float ConeHalfAngle = 0.0f;
+	FVector Direction = FVector::ForwardVector;
+
+	/**
+	 * 目标碰撞半径上限：网格只记录 Actor 中心，查询半径放宽这么多，
+	 * 再按目标自身碰撞半径（角色为胶囊半径，超过上限按上限算）精确判定是否与范围相交
+	 */
+	float MaxTargetRadius = 120.0f;
+
+	// ========== 过滤 ==========
+
+	/** 目标阵营掩码；0 表示发起者注册阵营的敌对阵营（未注册按玩家阵营处理） */
+	uint8 TeamMask = 0;
+
+	/** 最多命中的目标数（按距离由近到远），0 为不限 */
+	int32 MaxTargets = 0;
+
+	/** 跳过已被定身的敌人 */
+	bool bSkipFrozen = false;
+
+	// ========== 效果 ==========
+
+	float Damage = 0.0f;
+
+	/** 伤害是否可被闪避（范围技能默认不可） */
+	bool bCanBeDodged = false;
+
+	/** 定身时长（秒），0 为不定身；只对敌人生效 */
+	float FreezeDuration = 0.0f;
+
+	TSubclassOf<UStatusEffectBase> StatusEffect;
+	float StatusEffectDuration = 0.0f;
+
+	// ========== 表现合并 ==========
+
+	/** 命中至少一个目标时在 Center 播放一次；设置后目标自身的受击/定身音效全部省略 */
+	USoundBase* Sound = nullptr;
+
+	/** 本次结算中允许目标生成的附着特效数量（离中心最近的目标优先） */
+	int32 MaxAttachedEffects = 8;
+};
+
+/**
+ * 范围效果子系统
+ * 立棍 AOE、范围定身、战技 AOE 等统一走这里：
+ * 1. 用空间网格做一次半径查询收集候选（不访问物理场景），半径放宽 MaxTargetRadius
+ * 2. 按目标碰撞半径精确判定是否与圆/扇形相交，过滤掉发起者、已死亡和（可选）已定身的目标，按距离排序并截断
+ * 3. 在一次批处理中依次结算伤害、定身和状态效果
+ *
+ * 批处理期间目标的受击音效、定身音效和附着特效先通过 ClaimSound / ClaimAttachedEffect
+ * 申请名额，50 个敌人同时被定身时只播放一次音效、生成有限数量的特效。
+ */
+UCLASS()
+class BLACKMYTH_API UAreaEffectSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	/** 获取世界的范围效果子系统（可能为空） */
+	static UAreaEffectSubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 结算 ==========
+
+	/**
+	 * 收集目标并结算效果
+	 * @param OutTargets 非空时输出本次命中的目标（按距离升序）
+	 * @return 命中的目标数
+	 */
+	int32 Apply(const FAreaEffectRequest& Request, TArray<AActor*>* OutTargets = nullptr);
+
+	// ========== 表现合并 ==========
+
+	/** 目标播放自身音效前调用；不在批处理中时总是返回 true */
+	static bool ClaimSound();
+
+	/** 目标生成附着特效前调用；不在批处理中时总是返回 true */
+	static bool ClaimAttachedEffect();
+
+private:
+	/** 空间查询结果缓冲（复用） */
+	TArray<AActor*> QueryResults;
+};
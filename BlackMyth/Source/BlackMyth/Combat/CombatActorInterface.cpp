@@ -0,0 +1,146 @@
+// 战斗角色接口实现
+
+#include "CombatActorInterface.h"
+#include "../Components/HealthComponent.h"
+#include "../Components/TeamComponent.h"
+#include "../Components/StatusEffectComponent.h"
+#include "../Components/CombatComponent.h"
+#include "EngineUtils.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "../BlackMythLog.h"
+
+namespace CombatActorPrivate
+{
+	/** 实现接口时读取缓存，否则回退到组件查找 */
+	template <typename ComponentType>
+	ComponentType* Resolve(const AActor* Actor, ComponentType* (ICombatActor::*CachedGetter)() const)
+	{
+		if (!Actor)
+		{
+			return nullptr;
+		}
+
+		if (const ICombatActor* CombatActor = Cast<ICombatActor>(Actor))
+		{
+			return (CombatActor->*CachedGetter)();
+		}
+
+		return Actor->FindComponentByClass<ComponentType>();
+	}
+}
+
+UHealthComponent* ICombatActor::GetHealth(const AActor* Actor)
+{
+	return CombatActorPrivate::Resolve(Actor, &ICombatActor::GetCachedHealthComponent);
+}
+
+UTeamComponent* ICombatActor::GetTeam(const AActor* Actor)
+{
+	return CombatActorPrivate::Resolve(Actor, &ICombatActor::GetCachedTeamComponent);
+}
+
+UStatusEffectComponent* ICombatActor::GetStatusEffects(const AActor* Actor)
+{
+	return CombatActorPrivate::Resolve(Actor, &ICombatActor::GetCachedStatusEffectComponent);
+}
+
+UCombatComponent* ICombatActor::GetCombat(const AActor* Actor)
+{
+	return CombatActorPrivate::Resolve(Actor, &ICombatActor::GetCachedCombatComponent);
+}
+
+// ========== 性能测试 ==========
+
+#if !UE_BUILD_SHIPPING
+
+namespace CombatActorBenchmark
+{
+	/**
+	 * 控制台命令：BlackMyth.CombatActor.Benchmark [轮数=10000]
+	 * 对当前世界中所有实现 ICombatActor 的 Actor 两两模拟一次命中检查
+	 * （双方的 Health + Team，与 UTraceHitboxComponent::IsValidTarget 相同），
+	 * 对比 FindComponentByClass 与接口缓存的单次耗时，并校验两者取到的组件一致。
+	 */
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World)
+		{
+			return;
+		}
+
+		const int32 NumRounds = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 10000;
+
+		TArray<AActor*> Actors;
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			if (Cast<ICombatActor>(*It))
+			{
+				Actors.Add(*It);
+			}
+		}
+
+		if (Actors.Num() < 2)
+		{
+			UE_LOG(LogBMCombat, Warning, TEXT("[CombatActor] Benchmark needs at least 2 combat actors in the world (found %d)"), Actors.Num());
+			return;
+		}
+
+		// 每轮取一对（攻击者, 目标），与命中检测一样各取 Health 和 Team
+		int64 FoundByScan = 0;
+		int64 FoundByInterface = 0;
+
+		double StartTime = FPlatformTime::Seconds();
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			const AActor* Attacker = Actors[Round % Actors.Num()];
+			const AActor* Target = Actors[(Round + 1) % Actors.Num()];
+			FoundByScan += (Attacker->FindComponentByClass<UTeamComponent>() != nullptr)
+				+ (Target->FindComponentByClass<UTeamComponent>() != nullptr)
+				+ (Target->FindComponentByClass<UHealthComponent>() != nullptr);
+		}
+		const double ScanTime = FPlatformTime::Seconds() - StartTime;
+
+		StartTime = FPlatformTime::Seconds();
+		for (int32 Round = 0; Round < NumRounds; ++Round)
+		{
+			const AActor* Attacker = Actors[Round % Actors.Num()];
+			const AActor* Target = Actors[(Round + 1) % Actors.Num()];
+			FoundByInterface += (ICombatActor::GetTeam(Attacker) != nullptr)
+				+ (ICombatActor::GetTeam(Target) != nullptr)
+				+ (ICombatActor::GetHealth(Target) != nullptr);
+		}
+		const double InterfaceTime = FPlatformTime::Seconds() - StartTime;
+
+		// 校验缓存与实际组件一致
+		int32 NumMismatches = 0;
+		for (const AActor* Actor : Actors)
+		{
+			if (ICombatActor::GetHealth(Actor) != Actor->FindComponentByClass<UHealthComponent>()
+				|| ICombatActor::GetTeam(Actor) != Actor->FindComponentByClass<UTeamComponent>()
+				|| ICombatActor::GetStatusEffects(Actor) != Actor->FindComponentByClass<UStatusEffectComponent>()
+				|| ICombatActor::GetCombat(Actor) != Actor->FindComponentByClass<UCombatComponent>())
+			{
+				UE_LOG(LogBMCombat, Error, TEXT("[CombatActor] Cached components of %s do not match its component list"), *Actor->GetName());
+				++NumMismatches;
+			}
+		}
+
+		const double ToNanosPerHit = 1.0e9 / NumRounds;
+		UE_LOG(LogBMCombat, Display, TEXT("[CombatActor] Benchmark: %d combat actors, %d simulated hits"), Actors.Num(), NumRounds);
+		UE_LOG(LogBMCombat, Display, TEXT("[CombatActor]   FindComponentByClass %.1f ns/hit (%lld found)"), ScanTime * ToNanosPerHit, FoundByScan);
+		UE_LOG(LogBMCombat, Display, TEXT("[CombatActor]   ICombatActor         %.1f ns/hit (%lld found)"), InterfaceTime * ToNanosPerHit, FoundByInterface);
+
+		if (FoundByScan != FoundByInterface || NumMismatches > 0)
+		{
+			UE_LOG(LogBMCombat, Error, TEXT("[CombatActor] Benchmark mismatch: scan %lld vs interface %lld, %d actors differ"), FoundByScan, FoundByInterface, NumMismatches);
+		}
+	}
+
+	static FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+		TEXT("BlackMyth.CombatActor.Benchmark"),
+		TEXT("Benchmark per-hit component lookup: FindComponentByClass vs ICombatActor cache. Args: [NumRounds=10000]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
@@ -0,0 +1,69 @@
+// 战斗角色接口 - 缓存战斗相关组件指针，热路径上不再调用 FindComponentByClass
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "CombatActorInterface.generated.h"
+
+class UHealthComponent;
+class UTeamComponent;
+class UStatusEffectComponent;
+class UCombatComponent;
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UCombatActor : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * 战斗角色接口
+ * 玩家、敌人、分身、测试靶子实现此接口，在构造函数中调用 SetCombatComponents 登记自己的组件。
+ * 命中检测、锁定、AI 等热路径通过下面的静态函数取组件：
+ * 实现了接口的 Actor 只做一次接口转换和一次读取，其余 Actor 回退到 FindComponentByClass。
+ *
+ * 组件由 Actor 自身的 UPROPERTY 持有，这里只保存裸指针，不参与 GC。
+ */
+class BLACKMYTH_API ICombatActor
+{
+	GENERATED_BODY()
+
+public:
+	// ========== 缓存的组件 ==========
+
+	UHealthComponent* GetCachedHealthComponent() const { return CachedHealth; }
+	UTeamComponent* GetCachedTeamComponent() const { return CachedTeam; }
+	UStatusEffectComponent* GetCachedStatusEffectComponent() const { return CachedStatusEffect; }
+	UCombatComponent* GetCachedCombatComponent() const { return CachedCombat; }
+
+	// ========== 静态辅助函数 ==========
+
+	/** 获取 Actor 的生命组件（实现接口时直接返回缓存，可能为空） */
+	static UHealthComponent* GetHealth(const AActor* Actor);
+
+	/** 获取 Actor 的阵营组件 */
+	static UTeamComponent* GetTeam(const AActor* Actor);
+
+	/** 获取 Actor 的状态效果组件 */
+	static UStatusEffectComponent* GetStatusEffects(const AActor* Actor);
+
+	/** 获取 Actor 的战斗组件 */
+	static UCombatComponent* GetCombat(const AActor* Actor);
+
+protected:
+	/** 登记组件（实现类在构造函数中创建组件后调用，没有的组件传 nullptr） */
+	void SetCombatComponents(UHealthComponent* Health, UTeamComponent* Team, UStatusEffectComponent* StatusEffect, UCombatComponent* Combat)
+	{
+		CachedHealth = Health;
+		CachedTeam = Team;
+		CachedStatusEffect = StatusEffect;
+		CachedCombat = Combat;
+	}
+
+private:
+	UHealthComponent* CachedHealth = nullptr;
+	UTeamComponent* CachedTeam = nullptr;
+	UStatusEffectComponent* CachedStatusEffect = nullptr;
+	UCombatComponent* CachedCombat = nullptr;
+};
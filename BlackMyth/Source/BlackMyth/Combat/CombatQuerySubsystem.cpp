@@ -0,0 +1,285 @@
+// 战斗查询调度子系统实现
+
+#include "CombatQuerySubsystem.h"
+#include "Engine/World.h"
+#include "Engine/OverlapResult.h"
+#include "Components/PrimitiveComponent.h"
+#include "../BlackMythStats.h"
+#include "../BlackMythPerfCounters.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("CombatQuery Requests"), STAT_CombatQueryRequests, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CombatQuery Async Sweeps"), STAT_CombatQueryIssued, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("CombatQuery Culled"), STAT_CombatQueryCulled, STATGROUP_BlackMyth);
+
+namespace CombatQuery
+{
+	// 粗筛包围盒超过此尺寸（厘米）时放弃粗筛，直接发出全部请求
+	// 攻击者分散在地图两端时，一个巨大的包围盒反而比逐个 Sweep 更贵
+	constexpr float MaxBroadphaseExtent = 6000.0f;
+
+	// UserData 编码：最低位为双缓冲索引，其余为请求下标
+	FORCEINLINE uint32 EncodeUserData(uint32 BufferIndex, int32 RequestIndex)
+	{
+		return (static_cast<uint32>(RequestIndex) << 1) | (BufferIndex & 1u);
+	}
+}
+
+FBox FCombatQueryRequest::GetSweptBounds() const
+{
+	const FVector Extent = Shape.GetExtent();
+	// 形状可能带旋转，使用外接球半径保守估计
+	const float Radius = Extent.Size();
+
+	FBox Bounds(ForceInit);
+	Bounds += Start;
+	Bounds += End;
+	return Bounds.ExpandBy(Radius);
+}
+
+// ========== USubsystem ==========
+
+void UCombatQuerySubsystem::Deinitialize()
+{
+	PendingRequests.Empty();
+	InFlightRequests[0].Empty();
+	InFlightRequests[1].Empty();
+	AsyncSweepDelegate.Unbind();
+
+	Super::Deinitialize();
+}
+
+bool UCombatQuerySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UCombatQuerySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCombatQuerySubsystem, STATGROUP_BlackMyth);
+}
+
+UCombatQuerySubsystem* UCombatQuerySubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UCombatQuerySubsystem>() : nullptr;
+}
+
+// ========== 提交查询 ==========
+
+void UCombatQuerySubsystem::EnqueueSweep(FCombatQueryRequest&& Request)
+{
+	PendingRequests.Add(MoveTemp(Request));
+}
+
+void UCombatQuerySubsystem::EnqueueOverlap(UObject* Requester, AActor* IgnoredActor, const FVector& Location, const FQuat& Rotation,
+	const FCollisionShape& Shape, ECollisionChannel Channel, FCombatQueryCallback&& Callback)
+{
+	FCombatQueryRequest Request;
+	Request.Requester = Requester;
+	Request.IgnoredActor = IgnoredActor;
+	Request.Start = Location;
+	Request.End = Location;
+	Request.Rotation = Rotation;
+	Request.Shape = Shape;
+	Request.Channel = Channel;
+	Request.Callback = MoveTemp(Callback);
+
+	EnqueueSweep(MoveTemp(Request));
+}
+
+// ========== 批处理 ==========
+
+void UCombatQuerySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	BLACKMYTH_TRACE_SCOPE(TEXT("BlackMyth.CombatQuery.Tick"));
+
+	FlushPendingRequests();
+}
+
+void UCombatQuerySubsystem::FlushPendingRequests()
+{
+	LastBatchRequestCount = PendingRequests.Num();
+	LastBatchIssuedCount = 0;
+
+	if (PendingRequests.Num() == 0)
+	{
+		return;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		PendingRequests.Reset();
+		return;
+	}
+
+	if (!AsyncSweepDelegate.IsBound())
+	{
+		AsyncSweepDelegate.BindUObject(this, &UCombatQuerySubsystem::OnAsyncSweepComplete);
+	}
+
+	// 切换到另一个缓冲：它保存的是两帧前的请求，结果早已分发
+	InFlightIndex ^= 1u;
+	TArray<FCombatQueryRequest>& InFlight = InFlightRequests[InFlightIndex];
+	InFlight.Reset();
+
+	INC_DWORD_STAT_BY(STAT_CombatQueryRequests, PendingRequests.Num());
+
+	// ========== 按碰撞通道分组处理 ==========
+	TArray<bool, TInlineAllocator<64>> Handled;
+	Handled.SetNumZeroed(PendingRequests.Num());
+
+	for (int32 GroupStart = 0; GroupStart < PendingRequests.Num(); ++GroupStart)
+	{
+		if (Handled[GroupStart])
+		{
+			continue;
+		}
+
+		const ECollisionChannel Channel = PendingRequests[GroupStart].Channel;
+
+		// 计算本组所有请求的合并包围盒
+		FBox GroupBounds(ForceInit);
+		int32 GroupCount = 0;
+		for (int32 i = GroupStart; i < PendingRequests.Num(); ++i)
+		{
+			if (!Handled[i] && PendingRequests[i].Channel == Channel)
+			{
+				GroupBounds += PendingRequests[i].GetSweptBounds();
+				++GroupCount;
+			}
+		}
+
+		// 单个请求或包围盒过大时粗筛没有收益
+		const bool bUseBroadphase = GroupCount > 1
+			&& GroupBounds.GetExtent().GetMax() <= CombatQuery::MaxBroadphaseExtent;
+
+		CandidateBounds.Reset();
+		CandidateActors.Reset();
+
+		if (bUseBroadphase)
+		{
+			BroadphaseResults.Reset();
+			World->OverlapMultiByChannel(
+				BroadphaseResults,
+				GroupBounds.GetCenter(),
+				FQuat::Identity,
+				Channel,
+				FCollisionShape::MakeBox(GroupBounds.GetExtent())
+			);
+			BlackMythPerf::Add(BlackMythPerf::ECounter::PhysicsQueries);
+
+			for (const FOverlapResult& Overlap : BroadphaseResults)
+			{
+				if (UPrimitiveComponent* Component = Overlap.GetComponent())
+				{
+					CandidateBounds.Add(Component->Bounds.GetBox());
+					CandidateActors.Add(Overlap.GetActor());
+				}
+			}
+		}
+
+		// 逐个请求检查是否与候选目标相交，只对相交的发出异步 Sweep
+		for (int32 i = GroupStart; i < PendingRequests.Num(); ++i)
+		{
+			FCombatQueryRequest& Request = PendingRequests[i];
+			if (Handled[i] || Request.Channel != Channel)
+			{
+				continue;
+			}
+			Handled[i] = true;
+
+			if (!Request.Requester.IsValid())
+			{
+				continue;
+			}
+
+			if (bUseBroadphase)
+			{
+				const FBox RequestBounds = Request.GetSweptBounds();
+				const AActor* Ignored = Request.IgnoredActor.Get();
+
+				bool bHasCandidate = false;
+				for (int32 c = 0; c < CandidateBounds.Num(); ++c)
+				{
+					if (CandidateActors[c].Get() != Ignored && CandidateBounds[c].Intersect(RequestBounds))
+					{
+						bHasCandidate = true;
+						break;
+					}
+				}
+
+				if (!bHasCandidate)
+				{
+					INC_DWORD_STAT(STAT_CombatQueryCulled);
+					continue;
+				}
+			}
+
+			FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(CombatQuery), false);
+			QueryParams.bReturnPhysicalMaterial = false;
+			if (AActor* Ignored = Request.IgnoredActor.Get())
+			{
+				QueryParams.AddIgnoredActor(Ignored);
+			}
+
+			const int32 InFlightSlot = InFlight.Add(MoveTemp(Request));
+			const FCombatQueryRequest& Issued = InFlight[InFlightSlot];
+
+			World->AsyncSweepByChannel(
+				EAsyncTraceType::Multi,
+				Issued.Start,
+				Issued.End,
+				Issued.Rotation,
+				Issued.Channel,
+				Issued.Shape,
+				QueryParams,
+				FCollisionResponseParams::DefaultResponseParam,
+				&AsyncSweepDelegate,
+				CombatQuery::EncodeUserData(InFlightIndex, InFlightSlot)
+			);
+
+			++LastBatchIssuedCount;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_CombatQueryIssued, LastBatchIssuedCount);
+	BlackMythPerf::Add(BlackMythPerf::ECounter::PhysicsQueries, LastBatchIssuedCount);
+
+	PendingRequests.Reset();
+}
+
+void UCombatQuerySubsystem::OnAsyncSweepComplete(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	const uint32 BufferIndex = Datum.UserData & 1u;
+	const int32 RequestIndex = static_cast<int32>(Datum.UserData >> 1);
+
+	TArray<FCombatQueryRequest>& InFlight = InFlightRequests[BufferIndex];
+	if (!InFlight.IsValidIndex(RequestIndex))
+	{
+		return;
+	}
+
+	FCombatQueryRequest& Request = InFlight[RequestIndex];
+
+	// 发起者已销毁，丢弃结果
+	if (!Request.Requester.IsValid() || !Request.Callback)
+	{
+		return;
+	}
+
+	if (Datum.OutHits.Num() > 0)
+	{
+		Request.Callback(Datum.OutHits);
+	}
+
+	// 每个请求只分发一次
+	Request.Callback = nullptr;
+}
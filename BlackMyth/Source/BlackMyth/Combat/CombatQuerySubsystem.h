@@ -0,0 +1,119 @@
+// 战斗查询调度子系统 - 合批所有攻击者的命中检测
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CollisionQueryParams.h"
+#include "WorldCollision.h"
+#include "CombatQuerySubsystem.generated.h"
+
+/** 查询完成回调（游戏线程，下一帧开始时调用） */
+using FCombatQueryCallback = TFunction<void(const TArray<FHitResult>&)>;
+
+/**
+ * 一次待处理的攻击体积
+ * Start == End 时等价于在该位置做重叠检测（命中带 bStartPenetrating）
+ */
+struct FCombatQueryRequest
+{
+	/** 发起者（失效后结果直接丢弃） */
+	TWeakObjectPtr<UObject> Requester;
+
+	/** 不参与检测的 Actor（通常是攻击者自己） */
+	TWeakObjectPtr<AActor> IgnoredActor;
+
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FCollisionShape Shape;
+	TEnumAsByte<ECollisionChannel> Channel = ECC_Pawn;
+
+	/** 命中回调 */
+	FCombatQueryCallback Callback;
+
+	/** 扫掠包围盒（粗筛用） */
+	FBox GetSweptBounds() const;
+};
+
+/**
+ * 战斗查询调度子系统
+ * 收集本帧所有攻击者（TraceHitbox / Hitbox / AOE 通知）提交的攻击体积，
+ * 在帧末统一处理：
+ * 1. 按碰撞通道分组，每组只做一次包围盒重叠作为粗筛（Broadphase）
+ * 2. 只有与候选目标包围盒相交的请求才发出异步 Sweep（AsyncSweepByChannel）
+ * 3. 下一帧开始时异步结果返回，再分发给各自的回调
+ *
+ * 这样游戏线程上的开销与"攻击体积和目标的重叠对数"成正比，而不是与攻击者数量成正比。
+ * 代价是命中结果延迟一帧。
+ */
+UCLASS()
+class BLACKMYTH_API UCombatQuerySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// ========== FTickableGameObject ==========
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// ========== 提交查询 ==========
+
+	/** 提交一次扫掠（本帧末统一处理） */
+	void EnqueueSweep(FCombatQueryRequest&& Request);
+
+	/** 提交一次重叠检测（零长度扫掠） */
+	void EnqueueOverlap(UObject* Requester, AActor* IgnoredActor, const FVector& Location, const FQuat& Rotation,
+		const FCollisionShape& Shape, ECollisionChannel Channel, FCombatQueryCallback&& Callback);
+
+	/** 获取世界的调度子系统（可能为空） */
+	static UCombatQuerySubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 统计 ==========
+
+	/** 上一次批处理收到的请求数 */
+	int32 GetLastBatchRequestCount() const { return LastBatchRequestCount; }
+
+	/** 上一次批处理实际发出的异步 Sweep 数 */
+	int32 GetLastBatchIssuedCount() const { return LastBatchIssuedCount; }
+
+private:
+	/** 对本帧请求做粗筛并发出异步 Sweep */
+	void FlushPendingRequests();
+
+	/** 异步 Sweep 完成回调 */
+	void OnAsyncSweepComplete(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	/** 本帧收集到的请求 */
+	TArray<FCombatQueryRequest> PendingRequests;
+
+	/**
+	 * 已发出、等待结果的请求（双缓冲）
+	 * 异步结果在下一帧开始时返回，因此两帧前的缓冲一定已经处理完，可以复用
+	 */
+	TArray<FCombatQueryRequest> InFlightRequests[2];
+
+	/** 当前写入的缓冲索引 */
+	uint32 InFlightIndex = 0;
+
+	/** 粗筛用的重叠结果缓冲（复用） */
+	TArray<FOverlapResult> BroadphaseResults;
+
+	/** 粗筛得到的候选包围盒缓冲（复用） */
+	TArray<FBox> CandidateBounds;
+
+	/** 粗筛得到的候选 Actor 缓冲（与 CandidateBounds 一一对应） */
+	TArray<TWeakObjectPtr<AActor>> CandidateActors;
+
+	/** 共享的异步回调 */
+	FTraceDelegate AsyncSweepDelegate;
+
+	int32 LastBatchRequestCount = 0;
+	int32 LastBatchIssuedCount = 0;
+};
@@ -1,16 +1,24 @@
 // Hitbox组件实现
 
 #include "HitboxComponent.h"
+#include "CombatQuerySubsystem.h"
 #include "../Components/HealthComponent.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
+#include "../BlackMythStats.h"
+#include "../BlackMythLog.h"
+#include "CombatActorInterface.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Hitbox Ticks"), STAT_HitboxTicks, STATGROUP_BlackMyth);
 
 UHitboxComponent::UHitboxComponent()
 {
+	// 只在激活期间（或开启调试绘制时）注册 Tick，放在动画更新之后，挂点位置为本帧姿势
 	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
 
 	// 设置碰撞通道和响应
 	SetCollisionEnabled(ECollisionEnabled::NoCollision);  // 默认禁用
@@ -41,20 +49,35 @@ void UHitboxComponent::BeginPlay()
 	// 绑定碰撞事件
 	OnComponentBeginOverlap.AddDynamic(this, &UHitboxComponent::OnHitboxBeginOverlap);
 
+	// 挂在骨骼网格上时，等待其动画评估完成后再 Tick
+	if (USceneComponent* Parent = GetAttachParent())
+	{
+		AddTickPrerequisiteComponent(Parent);
+	}
+
 	// 确保初始状态是禁用的
 	DeactivateHitbox();
+	RefreshTickEnabled();
 }
 
 void UHitboxComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	INC_DWORD_STAT(STAT_HitboxTicks);
+
 	// 更新命中闪烁
 	if (HitFlashTimer > 0.0f)
 	{
 		HitFlashTimer -= DeltaTime;
 	}
 
+	// 调度器模式：提交本帧扫掠
+	if (bIsActive && IsUsingQueryScheduler())
+	{
+		EnqueueScheduledSweep();
+	}
+
 	// 绘制调试形状
 	if (bDebugDraw)
 	{
@@ -70,10 +93,22 @@ void UHitboxComponent::ActivateHitbox()
 	}
 
 	bIsActive = true;
-	SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	++ActivationGeneration;
 	HitActors.Empty();  // 清除上次的命中记录
 
-	UE_LOG(LogTemp, Log, TEXT("[Hitbox] %s Activated"), *GetOwner()->GetName());
+	if (IsUsingQueryScheduler())
+	{
+		// 由调度器检测，不需要物理重叠
+		LastScheduledLocation = GetComponentLocation();
+	}
+	else
+	{
+		SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	}
+
+	RefreshTickEnabled();
+
+	UE_LOG(LogBMCombat, Verbose, TEXT("[Hitbox] %s Activated"), *GetOwner()->GetName());
 
 	OnHitboxStateChanged.Broadcast(true);
 }
@@ -87,8 +122,9 @@ void UHitboxComponent::DeactivateHitbox()
 
 	bIsActive = false;
 	SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	RefreshTickEnabled();
 
-	UE_LOG(LogTemp, Log, TEXT("[Hitbox] %s Deactivated. Hit %d actors."), *GetOwner()->GetName(), HitActors.Num());
+	UE_LOG(LogBMCombat, Verbose, TEXT("[Hitbox] %s Deactivated. Hit %d actors."), *GetOwner()->GetName(), HitActors.Num());
 
 	OnHitboxStateChanged.Broadcast(false);
 }
@@ -110,8 +146,80 @@ void UHitboxComponent::ClearHitActors()
 	HitActors.Empty();
 }
 
+void UHitboxComponent::SetDebugDrawEnabled(bool bEnabled)
+{
+	bDebugDraw = bEnabled;
+	RefreshTickEnabled();
+}
+
+void UHitboxComponent::RefreshTickEnabled()
+{
+	bool bNeedsTick = bIsActive;
+
+#if ENABLE_DRAW_DEBUG
+	// 调试绘制需要在未激活时也画出 Hitbox
+	bNeedsTick |= bDebugDraw;
+#endif
+
+	SetComponentTickEnabled(bNeedsTick);
+}
+
 void UHitboxComponent::OnHitboxBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 	UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	HandleHit(OtherActor, SweepResult);
+}
+
+void UHitboxComponent::EnqueueScheduledSweep()
+{
+	UCombatQuerySubsystem* Scheduler = UCombatQuerySubsystem::Get(this);
+	if (!Scheduler)
+	{
+		return;
+	}
+
+	const FVector CurrentLocation = GetComponentLocation();
+
+	FCombatQueryRequest Request;
+	Request.Requester = this;
+	Request.IgnoredActor = bIgnoreOwner ? GetOwner() : nullptr;
+	Request.Start = LastScheduledLocation;
+	Request.End = CurrentLocation;
+	Request.Rotation = GetComponentQuat();
+	Request.Shape = FCollisionShape::MakeBox(GetScaledBoxExtent());
+	Request.Channel = ScheduledQueryChannel;
+
+	TWeakObjectPtr<UHitboxComponent> WeakThis(this);
+	const uint32 Generation = ActivationGeneration;
+	Request.Callback = [WeakThis, Generation](const TArray<FHitResult>& Hits)
+	{
+		// 结果晚一帧返回，最后一帧的结果通常在停用之后才到；只要还是同一次激活就结算
+		UHitboxComponent* This = WeakThis.Get();
+		if (!This || This->ActivationGeneration != Generation)
+		{
+			return;
+		}
+
+		for (const FHitResult& Hit : Hits)
+		{
+			if (AActor* HitActor = Hit.GetActor())
+			{
+				This->ProcessHit(HitActor, Hit);
+			}
+		}
+	};
+
+	Scheduler->EnqueueSweep(MoveTemp(Request));
+
+	LastScheduledLocation = CurrentLocation;
+}
+
+bool UHitboxComponent::IsUsingQueryScheduler() const
+{
+	return bUseQueryScheduler && UCombatQuerySubsystem::Get(this) != nullptr;
+}
+
+void UHitboxComponent::HandleHit(AActor* OtherActor, const FHitResult& SweepResult)
 {
 	// 不激活时不处理
 	if (!bIsActive)
@@ -119,6 +227,16 @@ void UHitboxComponent::OnHitboxBeginOverlap(UPrimitiveComponent* OverlappedCompo
 		return;
 	}
 
+	ProcessHit(OtherActor, SweepResult);
+}
+
+void UHitboxComponent::ProcessHit(AActor* OtherActor, const FHitResult& SweepResult)
+{
+	if (!OtherActor)
+	{
+		return;
+	}
+
 	// 忽略自己
 	if (bIgnoreOwner && OtherActor == GetOwner())
 	{
@@ -135,7 +253,8 @@ void UHitboxComponent::OnHitboxBeginOverlap(UPrimitiveComponent* OverlappedCompo
 	HitActors.Add(OtherActor);
 	HitFlashTimer = 0.2f;  // 命中闪烁
 
-	UE_LOG(LogTemp, Warning, TEXT("[Hitbox] %s HIT: %s"), *GetOwner()->GetName(), *OtherActor->GetName());
+	BlackMythCombatLog::Record(ECombatEvent::WeaponHit, GetOwner(), OtherActor);
+	UE_LOG(LogBMCombat, Verbose, TEXT("[Hitbox] %s HIT: %s"), *GetOwner()->GetName(), *OtherActor->GetName());
 
 	// 构建命中信息
 	FHitResult HitResult = SweepResult;
@@ -164,7 +283,7 @@ void UHitboxComponent::ApplyDamageToTarget(AActor* Target, const FHitResult& Hit
 	}
 
 	// 查找目标的 HealthComponent
-	UHealthComponent* TargetHealth = Target->FindComponentByClass<UHealthComponent>();
+	UHealthComponent* TargetHealth = ICombatActor::GetHealth(Target);
 	if (TargetHealth)
 	{
 		// 更新伤害信息
@@ -176,21 +295,24 @@ void UHitboxComponent::ApplyDamageToTarget(AActor* Target, const FHitResult& Hit
 		float ActualDamage = FinalDamage.GetFinalDamage();
 		TargetHealth->TakeDamage(ActualDamage, GetOwner());
 
-		UE_LOG(LogTemp, Warning, TEXT("[Hitbox] Applied %.1f damage to %s (Health: %.1f)"), 
+		BlackMythCombatLog::Record(ECombatEvent::Damage, GetOwner(), Target, ActualDamage);
+		UE_LOG(LogBMCombat, Verbose, TEXT("[Hitbox] Applied %.1f damage to %s (Health: %.1f)"), 
 			ActualDamage, *Target->GetName(), TargetHealth->GetCurrentHealth());
 	}
 	else
 	{
 		// 目标没有 HealthComponent，使用 UE 内置伤害系统
+		const float ActualDamage = DamageInfo.GetFinalDamage();
 		UGameplayStatics::ApplyDamage(
 			Target,
-			DamageInfo.GetFinalDamage(),
+			ActualDamage,
 			GetOwner()->GetInstigatorController(),
 			GetOwner(),
 			nullptr
 		);
 
-		UE_LOG(LogTemp, Log, TEXT("[Hitbox] Applied UE damage to %s (no HealthComponent)"), *Target->GetName());
+		BlackMythCombatLog::Record(ECombatEvent::Damage, GetOwner(), Target, ActualDamage);
+		UE_LOG(LogBMCombat, Verbose, TEXT("[Hitbox] Applied %.1f UE damage to %s (no HealthComponent)"), ActualDamage, *Target->GetName());
 	}
 }
 
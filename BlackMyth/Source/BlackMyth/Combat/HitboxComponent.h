@@ -79,7 +79,7 @@ public:
 
 	/** 设置是否显示调试绘制 */
 	UFUNCTION(BlueprintCallable, Category = "Hitbox|Debug")
-	void SetDebugDrawEnabled(bool bEnabled) { bDebugDraw = bEnabled; }
+	void SetDebugDrawEnabled(bool bEnabled);
 
 	// ========== 委托 ==========
 
@@ -97,12 +97,27 @@ protected:
 	void OnHitboxBeginOverlap(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor,
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 
+	/** 处理一次命中（去重、广播、伤害），重叠事件与调度器结果共用 */
+	void HandleHit(AActor* OtherActor, const FHitResult& SweepResult);
+
+	/** 记录一次有效命中（去重、广播、伤害），不检查激活状态 */
+	void ProcessHit(AActor* OtherActor, const FHitResult& SweepResult);
+
+	/** 把本帧的 Box 扫掠提交给战斗查询调度器 */
+	void EnqueueScheduledSweep();
+
+	/** 是否交给战斗查询调度器（开关打开且世界有调度子系统） */
+	bool IsUsingQueryScheduler() const;
+
 	/** 对目标应用伤害 */
 	void ApplyDamageToTarget(AActor* Target, const FHitResult& HitResult);
 
 	/** 绘制调试形状 */
 	void DrawDebugHitbox();
 
+	/** 根据激活状态和调试开关注册/注销 Tick */
+	void RefreshTickEnabled();
+
 protected:
 	// ========== 配置属性 ==========
 
@@ -134,14 +149,32 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hitbox")
 	bool bIgnoreOwner = true;
 
+	/**
+	 * 是否改用战斗查询调度器检测命中（不开启碰撞，不产生重叠事件）
+	 * 激活期间每帧把上一帧到当前帧的 Box 扫掠提交给 UCombatQuerySubsystem，命中延迟一帧；
+	 * 停用后才返回的结果仍属于同一次激活，照常结算
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hitbox")
+	bool bUseQueryScheduler = true;
+
+	/** 调度器模式下使用的检测通道 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Hitbox", meta = (EditCondition = "bUseQueryScheduler"))
+	TEnumAsByte<ECollisionChannel> ScheduledQueryChannel = ECC_Pawn;
+
 private:
 	/** Hitbox 是否激活 */
 	bool bIsActive = false;
 
+	/** 每次激活递增；调度器结果只结算提交时同一次激活的命中 */
+	uint32 ActivationGeneration = 0;
+
 	/** 本次激活期间已命中的 Actor 列表（防止重复伤害） */
 	UPROPERTY()
 	TArray<AActor*> HitActors;
 
 	/** 命中闪烁计时器 */
 	float HitFlashTimer = 0.0f;
+
+	/** 上一帧的位置（调度器模式下用于扫掠） */
+	FVector LastScheduledLocation = FVector::ZeroVector;
 };
@@ -41,6 +41,9 @@ ATargetDummy::ATargetDummy()
 
 	// 生命组件
 	HealthComponent = CreateDefaultSubobject<UHealthComponent>(TEXT("HealthComponent"));
+
+	// 登记战斗组件（靶子只有生命组件）
+	SetCombatComponents(HealthComponent, nullptr, nullptr, nullptr);
 }
 
 void ATargetDummy::BeginPlay()
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "CombatActorInterface.h"
 #include "TargetDummy.generated.h"
 
 class UHealthComponent;
@@ -16,7 +17,7 @@ class UBoxComponent;
  * 带有 HealthComponent，受击时显示反馈
  */
 UCLASS()
-class BLACKMYTH_API ATargetDummy : public AActor
+class BLACKMYTH_API ATargetDummy : public AActor, public ICombatActor
 {
 	GENERATED_BODY()
 	
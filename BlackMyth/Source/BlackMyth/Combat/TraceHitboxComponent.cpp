@@ -1,6 +1,7 @@
 // 射线扫描 TraceHitbox 组件实现
 
 #include "TraceHitboxComponent.h"
+#include "CombatQuerySubsystem.h"
 #include "../Components/HealthComponent.h"
 #include "../Components/CombatComponent.h"
 #include "../Components/TeamComponent.h"
@@ -11,11 +12,24 @@
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
 #include "CollisionQueryParams.h"
+#include "../BlackMythStats.h"
+#include "CombatActorInterface.h"
+#include "../BlackMythPerfCounters.h"
+#include "../BlackMythLog.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("TraceHitbox Sweeps"), STAT_TraceHitboxSweeps, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("TraceHitbox Ticks"), STAT_TraceHitboxTicks, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("TraceHitbox Hits Processed"), STAT_TraceHitboxHitsProcessed, STATGROUP_BlackMyth);
+DECLARE_CYCLE_STAT(TEXT("TraceHitbox PerformTrace"), STAT_TraceHitboxPerformTrace, STATGROUP_BlackMyth);
+DECLARE_CYCLE_STAT(TEXT("TraceHitbox ProcessHits"), STAT_TraceHitboxProcessHits, STATGROUP_BlackMyth);
 
 UTraceHitboxComponent::UTraceHitboxComponent()
 {
+	// 只在 ActivateTrace / DeactivateTrace 之间注册 Tick
+	// 放在动画更新之后（TG_PostPhysics），读取到的 Socket 位置就是本帧姿势，无需额外评估
 	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
 
 	// 默认伤害配置
 	DamageInfo.BaseDamage = 10.0f;
@@ -39,9 +53,12 @@ void UTraceHitboxComponent::BeginPlay()
 	{
 		CachedMesh = OwnerChar->GetMesh();
 
+		// 确保在角色网格（含并行动画评估）完成后才执行扫描
+		AddTickPrerequisiteComponent(OwnerChar->GetMesh());
+
 		if (CachedMesh.IsValid())
 		{
-			UE_LOG(LogTemp, Log, TEXT("[TraceHitbox] Found SkeletalMesh on %s"), *GetOwner()->GetName());
+			UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] Found SkeletalMesh on %s"), *GetOwner()->GetName());
 
 			// 检查配置的骨骼/Socket是否存在
 			bool bStartExists = DoesBoneOrSocketExist(StartSocketName);
@@ -49,12 +66,12 @@ void UTraceHitboxComponent::BeginPlay()
 
 			if (bStartExists && bEndExists)
 			{
-				UE_LOG(LogTemp, Log, TEXT("[TraceHitbox] Configured: Start=%s, End=%s, Radius=%.1f"),
+				UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] Configured: Start=%s, End=%s, Radius=%.1f"),
 					*StartSocketName.ToString(), *EndSocketName.ToString(), TraceRadius);
 			}
 			else
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[TraceHitbox] Bone/Socket not found! Start(%s): %s, End(%s): %s. Will use fallback."),
+				UE_LOG(LogBMCombat, Warning, TEXT("[TraceHitbox] Bone/Socket not found! Start(%s): %s, End(%s): %s. Will use fallback."),
 					*StartSocketName.ToString(), bStartExists ? TEXT("YES") : TEXT("NO"),
 					*EndSocketName.ToString(), bEndExists ? TEXT("YES") : TEXT("NO"));
 			}
@@ -66,10 +83,10 @@ void UTraceHitboxComponent::BeginPlay()
 	{
 		if (AActor* Owner = GetOwner())
 		{
-			CachedCombatComponent = Owner->FindComponentByClass<UCombatComponent>();
+			CachedCombatComponent = ICombatActor::GetCombat(Owner);
 			if (CachedCombatComponent.IsValid())
 			{
-				UE_LOG(LogTemp, Log, TEXT("[TraceHitbox] Found CombatComponent on %s"), *Owner->GetName());
+				UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] Found CombatComponent on %s"), *Owner->GetName());
 			}
 		}
 	}
@@ -79,6 +96,8 @@ void UTraceHitboxComponent::TickComponent(float DeltaTime, ELevelTick TickType,
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	INC_DWORD_STAT(STAT_TraceHitboxTicks);
+
 	// 只在激活状态下执行扫描
 	if (bIsActive)
 	{
@@ -96,6 +115,7 @@ void UTraceHitboxComponent::ActivateTrace()
 	}
 
 	bIsActive = true;
+	++TraceGeneration;
 	HitActors.Empty();
 	bHasLastFrameData = false;
 
@@ -104,7 +124,10 @@ void UTraceHitboxComponent::ActivateTrace()
 	LastEndLocation = GetSocketLocation(EndSocketName);
 	bHasLastFrameData = true;
 
-	UE_LOG(LogTemp, Log, TEXT("[TraceHitbox] %s Activated (Heavy: %s, Air: %s)"),
+	// 激活期间才需要 Tick，扫描从下一次 Tick 开始，覆盖从初始位置起的整段挥动
+	SetComponentTickEnabled(true);
+
+	UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] %s Activated (Heavy: %s, Air: %s)"),
 		*GetOwner()->GetName(),
 		bIsHeavyAttack ? TEXT("YES") : TEXT("NO"),
 		bIsAirAttack ? TEXT("YES") : TEXT("NO"));
@@ -127,12 +150,13 @@ void UTraceHitboxComponent::DeactivateTrace()
 
 	bIsActive = false;
 	bHasLastFrameData = false;
+	SetComponentTickEnabled(false);
 
 	// 重置攻击类型
 	bIsHeavyAttack = false;
 	bIsAirAttack = false;
 
-	UE_LOG(LogTemp, Log, TEXT("[TraceHitbox] %s Deactivated. Hit %d actors."),
+	UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] %s Deactivated. Hit %d actors."),
 		*GetOwner()->GetName(), HitActors.Num());
 
 	OnStateChanged.Broadcast(false);
@@ -159,6 +183,8 @@ UCombatComponent* UTraceHitboxComponent::GetCombatComponent() const
 
 void UTraceHitboxComponent::PerformTrace()
 {
+	BLACKMYTH_SCOPE_CYCLE(STAT_TraceHitboxPerformTrace, TEXT("BlackMyth.TraceHitbox.PerformTrace"));
+
 	if (!GetWorld())
 	{
 		return;
@@ -174,15 +200,145 @@ void UTraceHitboxComponent::PerformTrace()
 	QueryParams.bTraceComplex = false;
 	QueryParams.bReturnPhysicalMaterial = false;
 
-	TArray<FHitResult> HitResults;
+	// 复用缓冲，Reset 不释放内存
+	FrameHitResults.Reset();
+	LastFrameSweepCount = 0;
+
+	bool bHit = false;
+
+	if (TraceMode == ETraceHitboxMode::SweptVolume)
+	{
+		bHit = PerformSweptVolumeTrace(CurrentStart, CurrentEnd, QueryParams);
+	}
+	else
+	{
+		bHit = PerformInterpolatedTrace(CurrentStart, CurrentEnd, QueryParams);
+	}
+
+	INC_DWORD_STAT_BY(STAT_TraceHitboxSweeps, LastFrameSweepCount);
+
+	// 处理命中结果
+	if (bHit)
+	{
+		ProcessHitResults(FrameHitResults);
+	}
+
+	// 更新上一帧位置
+	LastStartLocation = CurrentStart;
+	LastEndLocation = CurrentEnd;
+	bHasLastFrameData = true;
+}
+
+void UTraceHitboxComponent::ProcessHitResults(const TArray<FHitResult>& HitResults)
+{
+	BLACKMYTH_SCOPE_CYCLE(STAT_TraceHitboxProcessHits, TEXT("BlackMyth.TraceHitbox.ProcessHits"));
+	INC_DWORD_STAT_BY(STAT_TraceHitboxHitsProcessed, HitResults.Num());
+
+	for (const FHitResult& Hit : HitResults)
+	{
+		AActor* HitActor = Hit.GetActor();
+		if (!HitActor)
+		{
+			continue;
+		}
+
+		// 检查是否为有效目标
+		if (!IsValidTarget(HitActor))
+		{
+			continue;
+		}
+
+		// 添加到已命中列表
+		HitActors.Add(HitActor);
+
+		// 播放命中音效
+		if (HitImpactSound)
+		{
+			UGameplayStatics::PlaySoundAtLocation(this, HitImpactSound, Hit.ImpactPoint);
+		}
+
+		BlackMythCombatLog::Record(ECombatEvent::WeaponHit, GetOwner(), HitActor);
+		UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] %s HIT: %s at (%.1f, %.1f, %.1f)"),
+			*GetOwner()->GetName(),
+			*HitActor->GetName(),
+			Hit.ImpactPoint.X, Hit.ImpactPoint.Y, Hit.ImpactPoint.Z);
+
+		// 广播命中事件
+		OnHitDetected.Broadcast(HitActor, Hit);
+
+		// 自动应用伤害
+		if (bAutoApplyDamage)
+		{
+			ApplyDamageToTarget(HitActor, Hit);
+		}
+	}
+}
+
+bool UTraceHitboxComponent::SweepAndAppend(const FVector& Start, const FVector& End, const FQuat& Rotation, const FCollisionShape& Shape, const FCollisionQueryParams& QueryParams)
+{
+	++LastFrameSweepCount;
+
+	// 交给调度器合批，结果下一帧返回
+	if (bUseQueryScheduler)
+	{
+		if (UCombatQuerySubsystem* Scheduler = UCombatQuerySubsystem::Get(this))
+		{
+			FCombatQueryRequest Request;
+			Request.Requester = this;
+			Request.IgnoredActor = GetOwner();
+			Request.Start = Start;
+			Request.End = End;
+			Request.Rotation = Rotation;
+			Request.Shape = Shape;
+			Request.Channel = TraceChannel;
+
+			TWeakObjectPtr<UTraceHitboxComponent> WeakThis(this);
+			const uint32 Generation = TraceGeneration;
+			const bool bHeavy = bIsHeavyAttack;
+			const bool bAir = bIsAirAttack;
+			Request.Callback = [WeakThis, Generation, bHeavy, bAir](const TArray<FHitResult>& Hits)
+			{
+				// 结果晚一帧返回，挥动最后一帧的结果通常在停用之后才到，只要还是同一次挥动就结算；
+				// 停用时攻击类型已重置，按提交时的类型计算伤害
+				UTraceHitboxComponent* This = WeakThis.Get();
+				if (This && This->TraceGeneration == Generation)
+				{
+					TGuardValue<bool> HeavyGuard(This->bIsHeavyAttack, bHeavy);
+					TGuardValue<bool> AirGuard(This->bIsAirAttack, bAir);
+					This->ProcessHitResults(Hits);
+				}
+			};
+
+			Scheduler->EnqueueSweep(MoveTemp(Request));
+			return false;
+		}
+	}
+
+	// SweepMultiByChannel 内部会先 Reset 输出数组，复用同一缓冲即可
+	BlackMythPerf::Add(BlackMythPerf::ECounter::PhysicsQueries);
+	if (GetWorld()->SweepMultiByChannel(SweepHitBuffer, Start, End, Rotation, TraceChannel, Shape, QueryParams))
+	{
+		FrameHitResults.Append(SweepHitBuffer);
+		return true;
+	}
+	return false;
+}
+
+bool UTraceHitboxComponent::PerformInterpolatedTrace(const FVector& CurrentStart, const FVector& CurrentEnd, const FCollisionQueryParams& QueryParams)
+{
+	const FCollisionShape Sphere = FCollisionShape::MakeSphere(TraceRadius);
 	bool bHit = false;
 
 	// 如果启用插值且有上一帧数据，执行多步扫描以覆盖挥动轨迹
 	if (bUseInterpolation && bHasLastFrameData)
 	{
 		// 步数越多，检测越精确。5步通常足够覆盖快速挥动。
-		const int32 NumSteps = 5;
-		
+		// 三条轨迹都是直线插值，子步共线：交给调度器时每条轨迹合并成一次扫掠，异步结果不依赖子步顺序
+		const int32 NumSteps = IsUsingQueryScheduler() ? 1 : 5;
+
+		const FVector LastMid = (LastStartLocation + LastEndLocation) * 0.5f;
+		const FVector CurrentMid = (CurrentStart + CurrentEnd) * 0.5f;
+
 		for (int32 i = 0; i < NumSteps; ++i)
 		{
 			float AlphaStart = (float)i / (float)NumSteps;
@@ -191,118 +347,107 @@ void UTraceHitboxComponent::PerformTrace()
 			// 1. 扫描 Tip (最重要)
 			FVector TipStart = FMath::Lerp(LastEndLocation, CurrentEnd, AlphaStart);
 			FVector TipEnd = FMath::Lerp(LastEndLocation, CurrentEnd, AlphaEnd);
-			
-			TArray<FHitResult> StepHits;
-			if (GetWorld()->SweepMultiByChannel(StepHits, TipStart, TipEnd, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(TraceRadius), QueryParams))
-			{
-				HitResults.Append(StepHits);
-				bHit = true;
-			}
+			bHit |= SweepAndAppend(TipStart, TipEnd, FQuat::Identity, Sphere, QueryParams);
 
 			// 2. 扫描 Mid (中间点)
-			FVector LastMid = (LastStartLocation + LastEndLocation) * 0.5f;
-			FVector CurrentMid = (CurrentStart + CurrentEnd) * 0.5f;
 			FVector MidStart = FMath::Lerp(LastMid, CurrentMid, AlphaStart);
 			FVector MidEnd = FMath::Lerp(LastMid, CurrentMid, AlphaEnd);
-
-			if (GetWorld()->SweepMultiByChannel(StepHits, MidStart, MidEnd, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(TraceRadius), QueryParams))
-			{
-				HitResults.Append(StepHits);
-				bHit = true;
-			}
+			bHit |= SweepAndAppend(MidStart, MidEnd, FQuat::Identity, Sphere, QueryParams);
 
 			// 3. 扫描 Handle (握把附近)
 			FVector HandleStart = FMath::Lerp(LastStartLocation, CurrentStart, AlphaStart);
 			FVector HandleEnd = FMath::Lerp(LastStartLocation, CurrentStart, AlphaEnd);
-
-			if (GetWorld()->SweepMultiByChannel(StepHits, HandleStart, HandleEnd, FQuat::Identity, TraceChannel, FCollisionShape::MakeSphere(TraceRadius), QueryParams))
-			{
-				HitResults.Append(StepHits);
-				bHit = true;
-			}
-
-			// 调试绘制
-			// if (bDebugDraw)
-			// {
-			// 	DrawDebugLine(GetWorld(), TipStart, TipEnd, bHit ? DebugColorHit : DebugColorMiss, false, DebugDrawDuration, 0, 2.0f);
-			// }
+			bHit |= SweepAndAppend(HandleStart, HandleEnd, FQuat::Identity, Sphere, QueryParams);
 		}
 	}
 	else
 	{
 		// 没有上一帧数据，只扫描当前位置 (Handle -> Tip)
 		// 这实际上是检测当前棒身是否与物体重叠
-		bHit = GetWorld()->SweepMultiByChannel(
-			HitResults,
-			CurrentStart,
-			CurrentEnd,
-			FQuat::Identity,
-			TraceChannel,
-			FCollisionShape::MakeSphere(TraceRadius),
-			QueryParams
-		);
-
-		// 绘制调试
-		// if (bDebugDraw)
-		// {
-		// 	DrawDebugTrace(CurrentStart, CurrentEnd, bHit);
-		// }
+		bHit = SweepAndAppend(CurrentStart, CurrentEnd, FQuat::Identity, Sphere, QueryParams);
 	}
 
-	// 处理命中结果
-	if (bHit)
-	{
-		for (const FHitResult& Hit : HitResults)
-		{
-			AActor* HitActor = Hit.GetActor();
-			if (!HitActor)
-			{
-				continue;
-			}
+	return bHit;
+}
 
-			// 检查是否为有效目标
-			if (!IsValidTarget(HitActor))
-			{
-				continue;
-			}
+bool UTraceHitboxComponent::IsUsingQueryScheduler() const
+{
+	return bUseQueryScheduler && UCombatQuerySubsystem::Get(this) != nullptr;
+}
 
-			// 添加到已命中列表
-			HitActors.Add(HitActor);
+int32 UTraceHitboxComponent::ComputeSweptStepCount(const FVector& CurrentStart, const FVector& CurrentEnd) const
+{
+	const FVector LastAxis = (LastEndLocation - LastStartLocation).GetSafeNormal();
+	const FVector CurrentAxis = (CurrentEnd - CurrentStart).GetSafeNormal();
 
-			// 播放命中音效
-			if (HitImpactSound)
-			{
-				UGameplayStatics::PlaySoundAtLocation(this, HitImpactSound, Hit.ImpactPoint);
-			}
+	// 角位移：两帧武器朝向的夹角
+	const float CosAngle = FMath::Clamp(FVector::DotProduct(LastAxis, CurrentAxis), -1.0f, 1.0f);
+	const float AngleDeg = FMath::RadiansToDegrees(FMath::Acos(CosAngle));
 
-			UE_LOG(LogTemp, Warning, TEXT("[TraceHitbox] %s HIT: %s at (%.1f, %.1f, %.1f)"),
-				*GetOwner()->GetName(),
-				*HitActor->GetName(),
-				Hit.ImpactPoint.X, Hit.ImpactPoint.Y, Hit.ImpactPoint.Z);
+	// 线位移：握把与棍尖中移动较大者
+	const float LinearDist = FMath::Max(
+		FVector::Dist(LastStartLocation, CurrentStart),
+		FVector::Dist(LastEndLocation, CurrentEnd));
 
-			// 广播命中事件
-			OnHitDetected.Broadcast(HitActor, Hit);
+	const int32 AngleSteps = FMath::CeilToInt(AngleDeg / FMath::Max(SweptMaxStepAngle, 1.0f));
+	const int32 LinearSteps = FMath::CeilToInt(LinearDist / FMath::Max(SweptMaxStepDistance, 1.0f));
 
-			// 自动应用伤害
-			if (bAutoApplyDamage)
-			{
-				ApplyDamageToTarget(HitActor, Hit);
-			}
-		}
+	return FMath::Clamp(FMath::Max(AngleSteps, LinearSteps), 1, FMath::Max(SweptMaxSteps, 1));
+}
+
+bool UTraceHitboxComponent::PerformSweptVolumeTrace(const FVector& CurrentStart, const FVector& CurrentEnd, const FCollisionQueryParams& QueryParams)
+{
+	const FVector PrevStart = (bUseInterpolation && bHasLastFrameData) ? LastStartLocation : CurrentStart;
+	const FVector PrevEnd = (bUseInterpolation && bHasLastFrameData) ? LastEndLocation : CurrentEnd;
+
+	const int32 NumSteps = (bUseInterpolation && bHasLastFrameData)
+		? ComputeSweptStepCount(CurrentStart, CurrentEnd)
+		: 1;
+
+	const float HalfLength = FVector::Dist(CurrentStart, CurrentEnd) * 0.5f;
+
+	// 形状的局部 Z 轴对齐武器方向
+	const FCollisionShape Shape = (SweepShape == ETraceSweepShape::Box)
+		? FCollisionShape::MakeBox(FVector(TraceRadius, TraceRadius, HalfLength + TraceRadius))
+		: FCollisionShape::MakeCapsule(TraceRadius, HalfLength + TraceRadius);
+
+	const FQuat PrevRot = FQuat::FindBetweenNormals(FVector::UpVector, (PrevEnd - PrevStart).GetSafeNormal(KINDA_SMALL_NUMBER, FVector::UpVector));
+	const FQuat CurrentRot = FQuat::FindBetweenNormals(FVector::UpVector, (CurrentEnd - CurrentStart).GetSafeNormal(KINDA_SMALL_NUMBER, FVector::UpVector));
+
+	const FVector PrevCenter = (PrevStart + PrevEnd) * 0.5f;
+	const FVector CurrentCenter = (CurrentStart + CurrentEnd) * 0.5f;
+
+	bool bHit = false;
+
+	for (int32 i = 0; i < NumSteps; ++i)
+	{
+		const float AlphaStart = (float)i / (float)NumSteps;
+		const float AlphaEnd = (float)(i + 1) / (float)NumSteps;
+
+		// 单次 Sweep 只能使用一个朝向，取子区间中点的朝向
+		const FQuat StepRot = FQuat::Slerp(PrevRot, CurrentRot, (AlphaStart + AlphaEnd) * 0.5f);
+		const FVector StepStart = FMath::Lerp(PrevCenter, CurrentCenter, AlphaStart);
+		const FVector StepEnd = FMath::Lerp(PrevCenter, CurrentCenter, AlphaEnd);
+
+		bHit |= SweepAndAppend(StepStart, StepEnd, StepRot, Shape, QueryParams);
 	}
 
-	// 更新上一帧位置
-	LastStartLocation = CurrentStart;
-	LastEndLocation = CurrentEnd;
-	bHasLastFrameData = true;
+	return bHit;
 }
 
 void UTraceHitboxComponent::SetMeshToTrace(USceneComponent* NewMesh)
 {
 	if (NewMesh)
 	{
+		// 扫描依赖的网格换了，Tick 依赖随之切换
+		if (USceneComponent* OldMesh = CachedMesh.Get())
+		{
+			RemoveTickPrerequisiteComponent(OldMesh);
+		}
+		AddTickPrerequisiteComponent(NewMesh);
+
 		CachedMesh = NewMesh;
-		UE_LOG(LogTemp, Log, TEXT("[TraceHitbox] SetMeshToTrace: %s"), *NewMesh->GetName());
+		UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] SetMeshToTrace: %s"), *NewMesh->GetName());
 	}
 }
 
@@ -415,13 +560,12 @@ bool UTraceHitboxComponent::IsValidTarget(AActor* Target) const
 	}
 
 	// ========== 阵营判断：同阵营不互相伤害 ==========
-	UTeamComponent* OwnerTeam = GetOwner()->FindComponentByClass<UTeamComponent>();
-	UTeamComponent* TargetTeam = Target->FindComponentByClass<UTeamComponent>();
-	
-	if (OwnerTeam && TargetTeam)
+	// 玩家、敌人、分身都实现了 ITeamMember，这里只读缓存的阵营，不查找组件
+	ETeam OwnerTeam, TargetTeam;
+	if (UTeamComponent::TryGetActorTeam(GetOwner(), OwnerTeam) && UTeamComponent::TryGetActorTeam(Target, TargetTeam))
 	{
 		// 同阵营不造成伤害（玩家不伤害玩家/分身，敌人不伤害敌人）
-		if (OwnerTeam->GetTeam() == TargetTeam->GetTeam())
+		if (OwnerTeam == TargetTeam)
 		{
 			return false;
 		}
@@ -443,7 +587,7 @@ bool UTraceHitboxComponent::IsValidTarget(AActor* Target) const
 	}
 
 	// 必须有 HealthComponent 才是可攻击目标
-	UHealthComponent* TargetHealth = Target->FindComponentByClass<UHealthComponent>();
+	UHealthComponent* TargetHealth = ICombatActor::GetHealth(Target);
 	if (!TargetHealth)
 	{
 		// 没有 HealthComponent 的不是可攻击目标（如地形、道具等）
@@ -451,7 +595,7 @@ bool UTraceHitboxComponent::IsValidTarget(AActor* Target) const
 		static bool bWarnedOnce = false;
 		if (!bWarnedOnce && Target->GetName().Contains("Wukong"))
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[TraceHitbox] Target %s REJECTED: No HealthComponent found!"), *Target->GetName());
+			UE_LOG(LogBMCombat, Warning, TEXT("[TraceHitbox] Target %s REJECTED: No HealthComponent found!"), *Target->GetName());
 			bWarnedOnce = true;
 		}
 		return false;
@@ -492,13 +636,13 @@ void UTraceHitboxComponent::ApplyDamageToTarget(AActor* Target, const FHitResult
 			bIsHeavyAttack,
 			bIsAirAttack
 		);
-		UE_LOG(LogTemp, Log, TEXT("[TraceHitbox] Damage calculated by CombatComponent: %.1f"), ActualDamage);
+		UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] Damage calculated by CombatComponent: %.1f"), ActualDamage);
 	}
 	else
 	{
 		ActualDamage = DamageInfo.GetFinalDamage();
 		FinalDamageInfo = DamageInfo;
-		UE_LOG(LogTemp, Warning, TEXT("[TraceHitbox] No CombatComponent, using base damage: %.1f"), ActualDamage);
+		UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] No CombatComponent, using base damage: %.1f"), ActualDamage);
 	}
 
 	// 填充命中信息（Trace 提供精确的命中点！）
@@ -507,6 +651,8 @@ void UTraceHitboxComponent::ApplyDamageToTarget(AActor* Target, const FHitResult
 	FinalDamageInfo.Instigator = GetOwner();
 	FinalDamageInfo.DamageCauser = GetOwner();
 
+	BlackMythCombatLog::Record(ECombatEvent::Damage, GetOwner(), Target, ActualDamage);
+
 	// 优先处理 EnemyBase
 	AEnemyBase* Enemy = Cast<AEnemyBase>(Target);
 	if (Enemy)
@@ -527,7 +673,7 @@ void UTraceHitboxComponent::ApplyDamageToTarget(AActor* Target, const FHitResult
 	{
 		Wukong->ReceiveDamage(ActualDamage, GetOwner());
 
-		UE_LOG(LogTemp, Warning, TEXT("[TraceHitbox] Applied %.1f damage to Wukong %s via ReceiveDamage"),
+		UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] Applied %.1f damage to Wukong %s via ReceiveDamage"),
 			ActualDamage, *Wukong->GetName());
 
 		if (CachedCombatComponent.IsValid())
@@ -538,12 +684,12 @@ void UTraceHitboxComponent::ApplyDamageToTarget(AActor* Target, const FHitResult
 	}
 
 	// 通过 HealthComponent
-	UHealthComponent* TargetHealth = Target->FindComponentByClass<UHealthComponent>();
+	UHealthComponent* TargetHealth = ICombatActor::GetHealth(Target);
 	if (TargetHealth)
 	{
 		TargetHealth->TakeDamage(ActualDamage, GetOwner());
 
-		UE_LOG(LogTemp, Warning, TEXT("[TraceHitbox] Applied %.1f damage to %s (Remaining: %.1f)"),
+		UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] Applied %.1f damage to %s (Remaining: %.1f)"),
 			ActualDamage, *Target->GetName(), TargetHealth->GetCurrentHealth());
 
 		if (CachedCombatComponent.IsValid())
@@ -562,7 +708,7 @@ void UTraceHitboxComponent::ApplyDamageToTarget(AActor* Target, const FHitResult
 		nullptr
 	);
 
-	UE_LOG(LogTemp, Log, TEXT("[TraceHitbox] Applied %.1f UE damage to %s (no HealthComponent)"),
+	UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] Applied %.1f UE damage to %s (no HealthComponent)"),
 		ActualDamage, *Target->GetName());
 }
 
@@ -575,7 +721,7 @@ bool UTraceHitboxComponent::TryApplyDamageToEnemy(AEnemyBase* Enemy, float Final
 
 	Enemy->ReceiveDamage(FinalDamage, GetOwner());
 
-	UE_LOG(LogTemp, Warning, TEXT("[TraceHitbox] Applied %.1f damage to Enemy %s via ReceiveDamage"),
+	UE_LOG(LogBMCombat, Verbose, TEXT("[TraceHitbox] Applied %.1f damage to Enemy %s via ReceiveDamage"),
 		FinalDamage, *Enemy->GetName());
 
 	return true;
@@ -18,6 +18,26 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTraceHitDetected, AActor*, HitAc
 // 状态变化委托
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTraceStateChanged, bool, bIsActive);
 
+/**
+ * 扫描模式
+ */
+UENUM(BlueprintType)
+enum class ETraceHitboxMode : uint8
+{
+	Interpolated    UMETA(DisplayName = "固定插值（球形）"),   // 固定 5 步 × 棍尖/中段/握把 球形扫描
+	SweptVolume     UMETA(DisplayName = "自适应扫掠（胶囊/盒）") // 沿武器朝向的胶囊/盒扫掠，步数按移动量自适应
+};
+
+/**
+ * 扫掠形状（仅 SweptVolume 模式）
+ */
+UENUM(BlueprintType)
+enum class ETraceSweepShape : uint8
+{
+	Capsule     UMETA(DisplayName = "胶囊"),
+	Box         UMETA(DisplayName = "盒")
+};
+
 /**
  * 射线扫描 Hitbox 组件
  * 每帧从武器起点到终点进行球形扫描，精确检测攻击命中
@@ -67,6 +87,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "TraceHitbox|Config")
 	void SetTraceRadius(float Radius) { TraceRadius = Radius; }
 
+	/** 设置扫描模式 */
+	UFUNCTION(BlueprintCallable, Category = "TraceHitbox|Config")
+	void SetTraceMode(ETraceHitboxMode Mode) { TraceMode = Mode; }
+
+	/** 上一次 PerformTrace 发出的 Sweep 次数（用于对比两种模式的开销） */
+	UFUNCTION(BlueprintPure, Category = "TraceHitbox|Stats")
+	int32 GetLastFrameSweepCount() const { return LastFrameSweepCount; }
+
 	// ========== CombatComponent 对接 ==========
 
 	/** 设置关联的战斗组件 */
@@ -135,6 +163,27 @@ protected:
 	/** 执行一次扫描（每帧调用） */
 	void PerformTrace();
 
+	/** 固定插值模式：5 步 × 棍尖/中段/握把 球形扫描，结果写入 FrameHitResults */
+	bool PerformInterpolatedTrace(const FVector& CurrentStart, const FVector& CurrentEnd, const FCollisionQueryParams& QueryParams);
+
+	/** 自适应扫掠模式：沿武器朝向的胶囊/盒扫掠，结果写入 FrameHitResults */
+	bool PerformSweptVolumeTrace(const FVector& CurrentStart, const FVector& CurrentEnd, const FCollisionQueryParams& QueryParams);
+
+	/** 根据本帧武器的角位移与线位移计算扫掠步数 */
+	int32 ComputeSweptStepCount(const FVector& CurrentStart, const FVector& CurrentEnd) const;
+
+	/**
+	 * 发出一次 Sweep，命中追加到 FrameHitResults，并计入本帧 Sweep 次数
+	 * 启用调度器时改为提交给 UCombatQuerySubsystem，结果在下一帧通过 ProcessHitResults 返回
+	 */
+	bool SweepAndAppend(const FVector& Start, const FVector& End, const FQuat& Rotation, const FCollisionShape& Shape, const FCollisionQueryParams& QueryParams);
+
+	/** 是否交给战斗查询调度器（开关打开且世界有调度子系统） */
+	bool IsUsingQueryScheduler() const;
+
+	/** 处理一批命中结果（过滤、广播 OnHitDetected、应用伤害） */
+	void ProcessHitResults(const TArray<FHitResult>& HitResults);
+
 	/** 获取 Socket/Bone 世界位置 */
 	FVector GetSocketLocation(FName SocketName) const;
 
@@ -188,6 +237,35 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TraceHitbox|Trace")
 	bool bUseInterpolation = true;
 
+	/** 扫描模式（Interpolated 为原有固定 5 步路径） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TraceHitbox|Trace")
+	ETraceHitboxMode TraceMode = ETraceHitboxMode::Interpolated;
+
+	/** 扫掠形状（仅 SweptVolume 模式） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TraceHitbox|Trace", meta = (EditCondition = "TraceMode == ETraceHitboxMode::SweptVolume"))
+	ETraceSweepShape SweepShape = ETraceSweepShape::Capsule;
+
+	/** 单步允许的最大旋转角度（度），超过则细分 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TraceHitbox|Trace", meta = (ClampMin = "1.0", EditCondition = "TraceMode == ETraceHitboxMode::SweptVolume"))
+	float SweptMaxStepAngle = 30.0f;
+
+	/** 单步允许的最大棍尖位移（厘米），超过则细分 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TraceHitbox|Trace", meta = (ClampMin = "1.0", EditCondition = "TraceMode == ETraceHitboxMode::SweptVolume"))
+	float SweptMaxStepDistance = 120.0f;
+
+	/** 每帧最多扫掠步数 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TraceHitbox|Trace", meta = (ClampMin = "1", ClampMax = "8", EditCondition = "TraceMode == ETraceHitboxMode::SweptVolume"))
+	int32 SweptMaxSteps = 4;
+
+	// ========== 查询调度 ==========
+
+	/**
+	 * 是否把扫描提交给战斗查询调度器合批执行（命中延迟一帧）
+	 * 停用后才返回的结果仍按提交时的攻击类型结算，挥动最后一帧的命中不会丢失
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "TraceHitbox|Scheduler")
+	bool bUseQueryScheduler = true;
+
 	// ========== 伤害配置 ==========
 
 	/** 默认伤害信息 */
@@ -244,6 +322,9 @@ private:
 	/** 是否正在扫描 */
 	bool bIsActive = false;
 
+	/** 每次激活递增；调度器结果只结算提交时同一次挥动的命中 */
+	uint32 TraceGeneration = 0;
+
 	/** 已命中的 Actor 列表（防止重复伤害） */
 	UPROPERTY()
 	TArray<AActor*> HitActors;
@@ -257,6 +338,15 @@ private:
 	/** 是否有上一帧数据 */
 	bool bHasLastFrameData = false;
 
+	/** 单次 Sweep 的命中缓冲（复用，避免每次 Sweep 分配） */
+	TArray<FHitResult> SweepHitBuffer;
+
+	/** 本帧累计的命中结果（复用） */
+	TArray<FHitResult> FrameHitResults;
+
+	/** 上一次 PerformTrace 发出的 Sweep 次数 */
+	int32 LastFrameSweepCount = 0;
+
 	/** 缓存的战斗组件 */
 	UPROPERTY()
 	TWeakObjectPtr<UCombatComponent> CachedCombatComponent;
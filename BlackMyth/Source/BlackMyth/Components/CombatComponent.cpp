@@ -1,6 +1,7 @@
 // 战斗属性组件实现
 
 #include "CombatComponent.h"
+#include "../BlackMythLog.h"
 #include "Engine/World.h"
 
 UCombatComponent::UCombatComponent()
@@ -122,7 +123,7 @@ float UCombatComponent::CalculateFinalDamage(FDamageInfo& OutDamageInfo, bool bI
 	OutDamageInfo.bCanBeBlocked = true;
 	OutDamageInfo.bCanBeDodged = true;
 
-	UE_LOG(LogTemp, Log, TEXT("[CombatComponent] CalculateFinalDamage: %.1f (Crit: %s, Combo: %d/%d)"),
+	UE_LOG(LogBMCombat, Verbose, TEXT("[CombatComponent] CalculateFinalDamage: %.1f (Crit: %s, Combo: %d/%d)"),
 		FinalDamage, bIsCritical ? TEXT("YES") : TEXT("NO"), ActiveComboIndex + 1, MaxComboCount);
 
 	return FinalDamage;
@@ -166,7 +167,7 @@ void UCombatComponent::AdvanceCombo()
 	// 广播连击变化
 	OnComboChanged.Broadcast(CurrentComboIndex);
 
-	UE_LOG(LogTemp, Log, TEXT("[CombatComponent] AdvanceCombo: %d -> %d"), OldIndex, CurrentComboIndex);
+	UE_LOG(LogBMCombat, Verbose, TEXT("[CombatComponent] AdvanceCombo: %d -> %d"), OldIndex, CurrentComboIndex);
 }
 
 void UCombatComponent::ResetCombo()
@@ -179,7 +180,7 @@ void UCombatComponent::ResetCombo()
 		// 广播连击重置
 		OnComboReset.Broadcast();
 
-		UE_LOG(LogTemp, Log, TEXT("[CombatComponent] Combo Reset"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("[CombatComponent] Combo Reset"));
 	}
 }
 
@@ -190,7 +191,7 @@ void UCombatComponent::OpenComboWindow()
 	if (!bComboWindowOpen)
 	{
 		bComboWindowOpen = true;
-		UE_LOG(LogTemp, Verbose, TEXT("[CombatComponent] Combo Window Opened"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("[CombatComponent] Combo Window Opened"));
 	}
 }
 
@@ -199,7 +200,7 @@ void UCombatComponent::CloseComboWindow()
 	if (bComboWindowOpen)
 	{
 		bComboWindowOpen = false;
-		UE_LOG(LogTemp, Verbose, TEXT("[CombatComponent] Combo Window Closed"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("[CombatComponent] Combo Window Closed"));
 	}
 }
 
@@ -1,17 +1,14 @@
 #include "EnemyAlertComponent.h"
 #include "../EnemyBase.h"
-#include "Components/WidgetComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
-#include "CollisionQueryParams.h"
-#include "CollisionShape.h"
-#include "Engine/OverlapResult.h"
+#include "../Subsystems/SpatialGridSubsystem.h"
+#include "../UI/EnemyOverlaySubsystem.h"
+#include "../BlackMythLog.h"
 #include "TimerManager.h"
-#include "Blueprint/UserWidget.h"
 
 UEnemyAlertComponent::UEnemyAlertComponent()
 {
-	// 创建警戒图标 Widget 组件
 	PrimaryComponentTick.bCanEverTick = false;
 	bIsAlerted = false;
 	CurrentTarget = nullptr;
@@ -25,31 +22,14 @@ void UEnemyAlertComponent::BeginPlay()
 	OwnerEnemy = Cast<AEnemyBase>(GetOwner());
 	if (!OwnerEnemy)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s] EnemyAlertComponent: Owner is not an EnemyBase!"), *GetOwner()->GetName());
+		UE_LOG(LogBMAI, Error, TEXT("[%s] EnemyAlertComponent: Owner is not an EnemyBase!"), *GetOwner()->GetName());
 		return;
 	}
 
-	// 动态创建警戒图标 Widget 组件
-	if (AlertIconWidgetClass)
+	// 警戒图标由 UEnemyOverlaySubsystem 的叠加层统一绘制，敌人注册时会提供图标类和高度
+	if (!AlertIconWidgetClass)
 	{
-		AlertIconWidget = NewObject<UWidgetComponent>(OwnerEnemy, UWidgetComponent::StaticClass(), TEXT("AlertIconWidget"));
-		if (AlertIconWidget)
-		{
-			AlertIconWidget->RegisterComponent();
-			AlertIconWidget->AttachToComponent(OwnerEnemy->GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
-			AlertIconWidget->SetRelativeLocation(FVector(0.0f, 0.0f, AlertIconHeightOffset));
-			AlertIconWidget->SetWidgetSpace(EWidgetSpace::Screen); // 屏幕空间，始终面向摄像机
-			AlertIconWidget->SetDrawSize(FVector2D(64.0f, 64.0f)); // 警戒图标大小
-			AlertIconWidget->SetWidgetClass(AlertIconWidgetClass);
-			AlertIconWidget->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-			AlertIconWidget->SetVisibility(false); // 默认隐藏
-
-			UE_LOG(LogTemp, Log, TEXT("[%s] AlertIconWidget created and attached"), *OwnerEnemy->GetName());
-		}
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s] AlertIconWidgetClass not set!"), *OwnerEnemy->GetName());
+		UE_LOG(LogBMAI, Warning, TEXT("[%s] AlertIconWidgetClass not set!"), *OwnerEnemy->GetName());
 	}
 }
 
@@ -60,44 +40,43 @@ void UEnemyAlertComponent::BroadcastAlert(AActor* Target, float AlertRadius)
 		return;
 	}
 
-	// 使用球形重叠检测找到范围内的所有敌人
-	TArray<FOverlapResult> OverlapResults;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(OwnerEnemy);
-
+	// 从空间网格中查询范围内的同阵营单位，不再做物理重叠检测
 	const FVector OwnerLocation = OwnerEnemy->GetActorLocation();
-	const bool bHasOverlaps = GetWorld()->OverlapMultiByChannel(
-		OverlapResults,
-		OwnerLocation,
-		FQuat::Identity,
-		ECC_Pawn, // 只检测 Pawn
-		FCollisionShape::MakeSphere(AlertRadius),
-		QueryParams
-	);
-
-	if (bHasOverlaps)
+	USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this);
+
+	if (Grid)
 	{
+		ETeam OwnerTeam = ETeam::Enemy;
+		Grid->GetRegisteredTeam(OwnerEnemy, OwnerTeam);
+
+		TArray<AActor*> NearbyActors;
+		Grid->QueryRadius(OwnerLocation, AlertRadius, SpatialGrid::TeamBit(OwnerTeam), NearbyActors);
+
 		int32 AlertCount = 0;
-		for (const FOverlapResult& Result : OverlapResults)
+		for (AActor* NearbyActor : NearbyActors)
 		{
-			if (AEnemyBase* NearbyEnemy = Cast<AEnemyBase>(Result.GetActor()))
+			AEnemyBase* NearbyEnemy = Cast<AEnemyBase>(NearbyActor);
+			if (!NearbyEnemy || NearbyEnemy == OwnerEnemy)
 			{
-				// 确保附近的敌人没有死亡
-				if (NearbyEnemy->IsDead())
-				{
-					continue;
-				}
-
-				// 通知附近的敌人
-				if (UEnemyAlertComponent* NearbyAlertComp = NearbyEnemy->FindComponentByClass<UEnemyAlertComponent>())
-				{
-					NearbyAlertComp->ReceiveAlert(Target);
-					AlertCount++;
-				}
+				continue;
+			}
+
+			// 确保附近的敌人没有死亡
+			if (NearbyEnemy->IsDead())
+			{
+				continue;
+			}
+
+			// 通知附近的敌人
+			if (UEnemyAlertComponent* NearbyAlertComp = NearbyEnemy->FindComponentByClass<UEnemyAlertComponent>())
+			{
+				NearbyAlertComp->ReceiveAlert(Target);
+				AlertCount++;
 			}
 		}
 
-		UE_LOG(LogTemp, Warning, TEXT("[%s] Broadcast alert to %d nearby enemies (Radius: %.1f)"),
+		BlackMythCombatLog::Record(ECombatEvent::Alert, OwnerEnemy, Target, AlertCount);
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Broadcast alert to %d nearby enemies (Radius: %.1f)"),
 			*OwnerEnemy->GetName(), AlertCount, AlertRadius);
 	}
 
@@ -131,7 +110,7 @@ void UEnemyAlertComponent::ReceiveAlert(AActor* AlertTarget)
 	bIsAlerted = true;
 	CurrentTarget = AlertTarget;
 
-	UE_LOG(LogTemp, Warning, TEXT("[%s] Received alert! Target: %s"),
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] Received alert! Target: %s"),
 		*OwnerEnemy->GetName(), *AlertTarget->GetName());
 
 	// 显示警戒图标
@@ -155,10 +134,15 @@ void UEnemyAlertComponent::ReceiveAlert(AActor* AlertTarget)
 
 void UEnemyAlertComponent::ShowAlertIcon(bool bShow)
 {
-	if (AlertIconWidget)
+	if (!OwnerEnemy)
+	{
+		return;
+	}
+
+	if (UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this))
 	{
-		AlertIconWidget->SetVisibility(bShow);
-		UE_LOG(LogTemp, Log, TEXT("[%s] Alert icon %s"),
+		Overlay->SetAlertIconVisible(OwnerEnemy, bShow);
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Alert icon %s"),
 			*OwnerEnemy->GetName(), bShow ? TEXT("shown") : TEXT("hidden"));
 	}
 }
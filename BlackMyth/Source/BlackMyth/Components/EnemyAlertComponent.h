@@ -4,7 +4,6 @@
 #include "Components/ActorComponent.h"
 #include "EnemyAlertComponent.generated.h"
 
-class UWidgetComponent;
 class UUserWidget;
 class AEnemyBase;
 
@@ -41,6 +40,12 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Alert")
 	AActor* GetCurrentTarget() const { return CurrentTarget; }
 
+	/** 警戒图标 Widget 类（由敌人提供给 UEnemyOverlaySubsystem） */
+	TSubclassOf<UUserWidget> GetAlertIconWidgetClass() const { return AlertIconWidgetClass; }
+
+	/** 警戒图标高度偏移 */
+	float GetAlertIconHeightOffset() const { return AlertIconHeightOffset; }
+
 protected:
 	/** 警戒图标 Widget 类 */
 	UPROPERTY(EditDefaultsOnly, Category = "Alert|UI")
@@ -71,10 +76,6 @@ private:
 	UPROPERTY()
 	TObjectPtr<AEnemyBase> OwnerEnemy;
 
-	/** 警戒图标 Widget 组件 */
-	UPROPERTY()
-	TObjectPtr<UWidgetComponent> AlertIconWidget;
-
 	/** 是否处于警戒状态 */
 	bool bIsAlerted;
 
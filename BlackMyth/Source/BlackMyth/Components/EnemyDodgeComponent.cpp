@@ -4,6 +4,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "Animation/AnimInstance.h"
 #include "TimerManager.h"
+#include "../BlackMythLog.h"
 
 UEnemyDodgeComponent::UEnemyDodgeComponent()
 {
@@ -23,7 +24,7 @@ void UEnemyDodgeComponent::BeginPlay()
 	OwnerEnemy = Cast<AEnemyBase>(GetOwner());
 	if (!OwnerEnemy)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s] EnemyDodgeComponent: Owner is not an EnemyBase!"), *GetOwner()->GetName());
+		UE_LOG(LogBMAI, Error, TEXT("[%s] EnemyDodgeComponent: Owner is not an EnemyBase!"), *GetOwner()->GetName());
 	}
 }
 
@@ -51,7 +52,7 @@ bool UEnemyDodgeComponent::TryDodge(const FVector& ThreatDirection)
 	const float CurrentTime = GetWorld()->GetTimeSeconds();
 	if (CurrentTime - LastDodgeTime < DodgeCooldown)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[%s] Dodge on cooldown. Remaining: %.2f s"),
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Dodge on cooldown. Remaining: %.2f s"),
 			*OwnerEnemy->GetName(), DodgeCooldown - (CurrentTime - LastDodgeTime));
 		return false;
 	}
@@ -60,7 +61,7 @@ bool UEnemyDodgeComponent::TryDodge(const FVector& ThreatDirection)
 	const float RandomValue = FMath::FRand(); // 0.0 ~ 1.0
 	if (RandomValue > DodgeChance)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[%s] Dodge check failed (Roll: %.2f > Chance: %.2f)"),
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Dodge check failed (Roll: %.2f > Chance: %.2f)"),
 			*OwnerEnemy->GetName(), RandomValue, DodgeChance);
 		return false;
 	}
@@ -69,8 +70,9 @@ bool UEnemyDodgeComponent::TryDodge(const FVector& ThreatDirection)
 	bIsInDodge = true;
 	LastDodgeTime = CurrentTime;
 
-	UE_LOG(LogTemp, Warning, TEXT("[%s] Dodge triggered! (Roll: %.2f <= Chance: %.2f)"),
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] Dodge triggered (Roll: %.2f <= Chance: %.2f)"),
 		*OwnerEnemy->GetName(), RandomValue, DodgeChance);
+	BlackMythCombatLog::Record(ECombatEvent::Dodge, OwnerEnemy, nullptr, RandomValue);
 
 	// 计算闪避方向：垂直于威胁方向（左右随机）
 	FVector DodgeDirection;
@@ -95,7 +97,7 @@ bool UEnemyDodgeComponent::TryDodge(const FVector& ThreatDirection)
 	if (DodgeMontage)
 	{
 		AnimDuration = OwnerEnemy->PlayAnimMontage(DodgeMontage);
-		UE_LOG(LogTemp, Log, TEXT("[%s] Playing dodge montage: %s (Duration: %.2f)"),
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Playing dodge montage: %s (Duration: %.2f)"),
 			*OwnerEnemy->GetName(), *DodgeMontage->GetName(), AnimDuration);
 	}
 
@@ -142,6 +144,6 @@ void UEnemyDodgeComponent::OnDodgeEnd()
 {
 	bIsInDodge = false;
 
-	UE_LOG(LogTemp, Log, TEXT("[%s] Dodge ended."),
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] Dodge ended."),
 		OwnerEnemy ? *OwnerEnemy->GetName() : TEXT("Unknown"));
 }
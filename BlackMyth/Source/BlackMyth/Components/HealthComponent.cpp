@@ -1,6 +1,7 @@
 // 生命值组件实现
 
 #include "HealthComponent.h"
+#include "../Subsystems/ActorRegistrySubsystem.h"
 
 UHealthComponent::UHealthComponent()
 {
@@ -14,6 +15,40 @@ void UHealthComponent::BeginPlay()
 	// 初始化生命值为满
 	CurrentHealth = MaxHealth;
 	OnHealthChanged.Broadcast(CurrentHealth, MaxHealth);
+
+	// 注册为可受伤 Actor（供锁定、AOE 等查询使用）
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterDamageable(GetOwner(), this);
+	}
+}
+
+void UHealthComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterDamageable(GetOwner());
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UHealthComponent::OnAcquiredFromPool()
+{
+	Revive();
+
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterDamageable(GetOwner(), this);
+	}
+}
+
+void UHealthComponent::OnReleasedToPool()
+{
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterDamageable(GetOwner());
+	}
 }
 
 void UHealthComponent::TakeDamage(float Damage, AActor* Instigator)
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "../Subsystems/PoolableInterface.h"
 #include "HealthComponent.generated.h"
 
 // 生命值变化委托
@@ -24,7 +25,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnHealed, float, HealAmount, float
  * 可挂载到任何需要生命值的 Actor 上
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
-class BLACKMYTH_API UHealthComponent : public UActorComponent
+class BLACKMYTH_API UHealthComponent : public UActorComponent, public IPoolable
 {
 	GENERATED_BODY()
 
@@ -33,6 +34,13 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// ========== IPoolable ==========
+
+	/** 复用时满血复活并重新注册为可受伤 Actor */
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
 
 public:
 	// ========== 伤害与治疗 ==========
@@ -9,6 +9,7 @@
 #include "../StatusEffect/DefenseBuffEffect.h"
 #include "../StatusEffect/HealingIndicatorEffect.h"
 #include "../StatusEffect/StaminaIndicatorEffect.h"
+#include "../Combat/CombatActorInterface.h"
 
 FItemSlot UInventoryComponent::EmptySlot;
 
@@ -180,13 +181,13 @@ void UInventoryComponent::ApplyItemEffect(const FItemSlot& Item)
 	AWukongCharacter* Owner = Cast<AWukongCharacter>(GetOwner());
 	if (!Owner) return;
 
-	UStatusEffectComponent* StatusEffect = Owner->FindComponentByClass<UStatusEffectComponent>();
+	UStatusEffectComponent* StatusEffect = ICombatActor::GetStatusEffects(Owner);
 
 	switch (Item.ItemType)
 	{
 	case EItemType::HealthPotion:
 		// 先应用治疗效果
-		if (UHealthComponent* Health = Owner->FindComponentByClass<UHealthComponent>())
+		if (UHealthComponent* Health = ICombatActor::GetHealth(Owner))
 		{
 			Health->Heal(Item.EffectValue);
 		}
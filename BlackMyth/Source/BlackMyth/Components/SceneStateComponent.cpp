@@ -6,6 +6,7 @@
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/PlayerController.h"
 #include "Engine/OverlapResult.h"
+#include "../BlackMythPerfCounters.h"
 
 USceneStateComponent::USceneStateComponent()
 {
@@ -229,6 +230,7 @@ bool USceneStateComponent::AreAllEnemiesDeadInRange()
 	QueryParams.AddIgnoredActor(PlayerPawn);
 
 	// 检测所有Pawn
+	BlackMythPerf::Add(BlackMythPerf::ECounter::PhysicsQueries);
 	if (GetWorld()->OverlapMultiByObjectType(
 		OverlapResults,
 		PlayerPawn->GetActorLocation(),
@@ -243,7 +245,7 @@ bool USceneStateComponent::AreAllEnemiesDeadInRange()
 			if (AEnemyBase* Enemy = Cast<AEnemyBase>(Result.GetActor()))
 			{
 				// 检查敌人是否存活
-				if (UHealthComponent* Health = Enemy->FindComponentByClass<UHealthComponent>())
+				if (UHealthComponent* Health = Enemy->GetCachedHealthComponent())
 				{
 					if (Health->IsAlive())
 					{
@@ -2,20 +2,27 @@
 
 #include "StatusEffectComponent.h"
 #include "../StatusEffect/StatusEffectBase.h"
+#include "../StatusEffect/StatusEffectSubsystem.h"
+#include "HealthComponent.h"
 #include "GameFramework/Character.h"
 #include "Components/SkeletalMeshComponent.h"
 #include "Materials/MaterialInstanceDynamic.h"
+#include "../Combat/CombatActorInterface.h"
 
 UStatusEffectComponent::UStatusEffectComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
-	PrimaryComponentTick.bStartWithTickEnabled = true;
+	// 效果计时由 UStatusEffectSubsystem 统一推进，组件不需要 Tick
+	PrimaryComponentTick.bCanEverTick = false;
+
+	ResetEffectIndices();
 }
 
 void UStatusEffectComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
+	CachedHealth = ICombatActor::GetHealth(GetOwner());
+
 	// 初始化动态材质
 	SetupDynamicMaterials();
 }
@@ -28,197 +35,169 @@ void UStatusEffectComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 	Super::EndPlay(EndPlayReason);
 }
 
-void UStatusEffectComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+void UStatusEffectComponent::ResetEffectIndices()
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	// 没有激活效果时跳过
-	if (ActiveEffects.Num() == 0)
-	{
-		return;
-	}
-
-	// 倒序遍历，方便移除过期效果
-	for (int32 i = ActiveEffects.Num() - 1; i >= 0; --i)
+	for (int32& Index : EffectIndices)
 	{
-		UStatusEffectBase* Effect = ActiveEffects[i];
-		if (!Effect)
-		{
-			ActiveEffects.RemoveAt(i);
-			continue;
-		}
-
-		// 更新效果
-		Effect->OnTick(DeltaTime);
-
-		// 广播更新事件
-		OnEffectUpdated.Broadcast(Effect->GetEffectType(), Effect->GetRemainingTime());
-
-		// 检查是否过期
-		if (Effect->IsExpired())
-		{
-			// 调用效果的移除回调
-			Effect->OnRemoved();
-
-			// 获取类型用于广播
-			EStatusEffectType EffectType = Effect->GetEffectType();
-
-			// 从列表中移除
-			ActiveEffects.RemoveAt(i);
-
-			// 广播移除事件
-			OnEffectRemoved.Broadcast(EffectType);
-
-			UE_LOG(LogTemp, Log, TEXT("StatusEffectComponent: Effect [%s] expired and removed"),
-				*StaticEnum<EStatusEffectType>()->GetNameStringByValue(static_cast<int64>(EffectType)));
-		}
+		Index = INDEX_NONE;
 	}
+}
 
-	// 更新材质视觉效果
-	UpdateMaterialEffects();
+UStatusEffectSubsystem* UStatusEffectComponent::GetSubsystem() const
+{
+	return UStatusEffectSubsystem::Get(this);
 }
 
-UStatusEffectBase* UStatusEffectComponent::ApplyEffect(TSubclassOf<UStatusEffectBase> EffectClass, AActor* InInstigator, float Duration)
+bool UStatusEffectComponent::ApplyEffect(TSubclassOf<UStatusEffectBase> EffectClass, AActor* InInstigator, float Duration)
 {
 	if (!EffectClass)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("StatusEffectComponent::ApplyEffect - EffectClass is null!"));
-		return nullptr;
+		return false;
 	}
 
-	// 获取效果类型（从 CDO 获取）
-	UStatusEffectBase* CDO = EffectClass->GetDefaultObject<UStatusEffectBase>();
-	if (!CDO)
+	UStatusEffectSubsystem* Subsystem = GetSubsystem();
+	if (!Subsystem)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("StatusEffectComponent::ApplyEffect - Failed to get CDO!"));
-		return nullptr;
+		UE_LOG(LogTemp, Warning, TEXT("StatusEffectComponent::ApplyEffect - No StatusEffectSubsystem in this world!"));
+		return false;
 	}
 
-	EStatusEffectType EffectType = CDO->GetEffectType();
+	const EStatusEffectType EffectType = EffectClass->GetDefaultObject<UStatusEffectBase>()->GetEffectType();
+	const bool bIsNew = Subsystem->ApplyEffect(this, EffectClass, InInstigator, Duration);
 
-	// 检查是否已存在同类型效果
-	UStatusEffectBase* ExistingEffect = GetEffect(EffectType);
-	if (ExistingEffect)
+	// 刷新也视为施加（新施加的效果已在 HandleEffectAdded 中广播）
+	if (!bIsNew && HasEffect(EffectType))
 	{
-		// 已存在同类型效果，刷新持续时间
-		ExistingEffect->RefreshDuration(Duration);
-
-		// 广播事件（刷新也视为施加）
 		OnEffectApplied.Broadcast(EffectType, Duration);
 
 		UE_LOG(LogTemp, Log, TEXT("StatusEffectComponent: Effect [%s] refreshed to %.1f seconds"),
 			*StaticEnum<EStatusEffectType>()->GetNameStringByValue(static_cast<int64>(EffectType)),
 			Duration);
-
-		return ExistingEffect;
 	}
 
-	// 创建新效果实例
-	UStatusEffectBase* NewEffect = NewObject<UStatusEffectBase>(this, EffectClass);
-	if (!NewEffect)
-	{
-		UE_LOG(LogTemp, Error, TEXT("StatusEffectComponent::ApplyEffect - Failed to create effect instance!"));
-		return nullptr;
-	}
-
-	// 初始化效果
-	NewEffect->SetOwnerComponent(this);
-	NewEffect->Initialize(GetOwner(), InInstigator, Duration);
-
-	// 添加到列表
-	ActiveEffects.Add(NewEffect);
-
-	// 调用效果的施加回调
-	NewEffect->OnApplied();
-
-	// 更新材质视觉效果
-	UpdateMaterialEffects();
-
-	// 广播施加事件
-	OnEffectApplied.Broadcast(EffectType, Duration);
-
-	UE_LOG(LogTemp, Log, TEXT("StatusEffectComponent: Effect [%s] applied for %.1f seconds"),
-		*StaticEnum<EStatusEffectType>()->GetNameStringByValue(static_cast<int64>(EffectType)),
-		Duration);
-
-	return NewEffect;
+	return HasEffect(EffectType);
 }
 
 bool UStatusEffectComponent::RemoveEffect(EStatusEffectType EffectType)
 {
-	for (int32 i = 0; i < ActiveEffects.Num(); ++i)
+	if (!HasEffect(EffectType))
 	{
-		if (ActiveEffects[i] && ActiveEffects[i]->GetEffectType() == EffectType)
-		{
-			// 调用效果的移除回调
-			ActiveEffects[i]->OnRemoved();
-
-			// 从列表中移除
-			ActiveEffects.RemoveAt(i);
-
-			// 更新材质视觉效果
-			UpdateMaterialEffects();
-
-			// 广播移除事件
-			OnEffectRemoved.Broadcast(EffectType);
-
-			UE_LOG(LogTemp, Log, TEXT("StatusEffectComponent: Effect [%s] manually removed"),
-				*StaticEnum<EStatusEffectType>()->GetNameStringByValue(static_cast<int64>(EffectType)));
+		return false;
+	}
 
-			return true;
-		}
+	UStatusEffectSubsystem* Subsystem = GetSubsystem();
+	if (!Subsystem || !Subsystem->RemoveEffect(this, EffectType))
+	{
+		return false;
 	}
 
-	return false;
+	UE_LOG(LogTemp, Log, TEXT("StatusEffectComponent: Effect [%s] manually removed"),
+		*StaticEnum<EStatusEffectType>()->GetNameStringByValue(static_cast<int64>(EffectType)));
+
+	return true;
 }
 
 void UStatusEffectComponent::RemoveAllEffects()
 {
-	for (UStatusEffectBase* Effect : ActiveEffects)
+	if (ActiveEffectMask != 0)
 	{
-		if (Effect)
+		if (UStatusEffectSubsystem* Subsystem = GetSubsystem())
 		{
-			Effect->OnRemoved();
-			OnEffectRemoved.Broadcast(Effect->GetEffectType());
+			Subsystem->RemoveAllEffects(this);
 		}
+
+		UE_LOG(LogTemp, Log, TEXT("StatusEffectComponent: All effects removed"));
 	}
 
-	ActiveEffects.Empty();
+	// 子系统已销毁（世界拆除）时直接清空记录
+	ActiveEffectMask = 0;
+	AttackDisabledMask = 0;
+	ResetEffectIndices();
 
 	// 重置材质
 	ResetMaterialEffects();
-
-	UE_LOG(LogTemp, Log, TEXT("StatusEffectComponent: All effects removed"));
 }
 
 bool UStatusEffectComponent::HasEffect(EStatusEffectType EffectType) const
 {
-	return GetEffect(EffectType) != nullptr;
+	return (ActiveEffectMask & StatusEffectBit(EffectType)) != 0;
 }
 
-UStatusEffectBase* UStatusEffectComponent::GetEffect(EStatusEffectType EffectType) const
+const UStatusEffectBase* UStatusEffectComponent::GetEffectConfig(EStatusEffectType EffectType) const
 {
-	for (UStatusEffectBase* Effect : ActiveEffects)
+	if (!HasEffect(EffectType))
 	{
-		if (Effect && Effect->GetEffectType() == EffectType)
-		{
-			return Effect;
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	const UStatusEffectSubsystem* Subsystem = GetSubsystem();
+	return Subsystem ? Subsystem->GetConfig(EffectIndices[static_cast<int32>(EffectType)]) : nullptr;
 }
 
-bool UStatusEffectComponent::IsAttackDisabled() const
+float UStatusEffectComponent::GetEffectRemainingTime(EStatusEffectType EffectType) const
 {
-	for (UStatusEffectBase* Effect : ActiveEffects)
+	if (!HasEffect(EffectType))
 	{
-		if (Effect && Effect->IsAttackDisabled())
+		return 0.0f;
+	}
+
+	const UStatusEffectSubsystem* Subsystem = GetSubsystem();
+	return Subsystem ? Subsystem->GetRemainingTime(EffectIndices[static_cast<int32>(EffectType)]) : 0.0f;
+}
+
+TArray<EStatusEffectType> UStatusEffectComponent::GetActiveEffectTypes() const
+{
+	TArray<EStatusEffectType> Result;
+	for (int32 TypeIndex = 0; TypeIndex < NumStatusEffectTypes; ++TypeIndex)
+	{
+		if (ActiveEffectMask & (1u << TypeIndex))
 		{
-			return true;
+			Result.Add(static_cast<EStatusEffectType>(TypeIndex));
 		}
 	}
-	return false;
+	return Result;
+}
+
+// ========== 子系统回调 ==========
+
+void UStatusEffectComponent::HandleEffectAdded(EStatusEffectType EffectType, int32 Index, const UStatusEffectBase* Config, float Duration)
+{
+	const uint32 Bit = StatusEffectBit(EffectType);
+	EffectIndices[static_cast<int32>(EffectType)] = Index;
+	ActiveEffectMask |= Bit;
+	if (Config->IsAttackDisabled())
+	{
+		AttackDisabledMask |= Bit;
+	}
+	else
+	{
+		AttackDisabledMask &= ~Bit;
+	}
+
+	// 颜色只在效果增减时变化，不需要逐帧更新材质
+	UpdateMaterialEffects();
+
+	// 广播施加事件
+	OnEffectApplied.Broadcast(EffectType, Duration);
+
+	UE_LOG(LogTemp, Log, TEXT("StatusEffectComponent: Effect [%s] applied for %.1f seconds"),
+		*StaticEnum<EStatusEffectType>()->GetNameStringByValue(static_cast<int64>(EffectType)),
+		Duration);
+}
+
+void UStatusEffectComponent::HandleEffectRemoved(EStatusEffectType EffectType)
+{
+	const uint32 Bit = StatusEffectBit(EffectType);
+	EffectIndices[static_cast<int32>(EffectType)] = INDEX_NONE;
+	ActiveEffectMask &= ~Bit;
+	AttackDisabledMask &= ~Bit;
+
+	// 更新材质视觉效果
+	UpdateMaterialEffects();
+
+	// 广播移除事件
+	OnEffectRemoved.Broadcast(EffectType);
 }
 
 void UStatusEffectComponent::SetupDynamicMaterials()
@@ -278,20 +257,32 @@ void UStatusEffectComponent::UpdateMaterialEffects()
 	}
 
 	// 如果没有激活效果，重置材质
-	if (ActiveEffects.Num() == 0)
+	if (ActiveEffectMask == 0)
 	{
 		ResetMaterialEffects();
 		return;
 	}
 
+	const UStatusEffectSubsystem* Subsystem = GetSubsystem();
+	if (!Subsystem)
+	{
+		return;
+	}
+
 	// 计算混合后的颜色（简单叠加/取最强效果）
 	FLinearColor FinalTintColor = FLinearColor::White;
 	FLinearColor FinalEmissiveColor = FLinearColor::Black;
 	float FinalEmissiveIntensity = 0.0f;
 	float MaxIntensity = 0.0f;
 
-	for (UStatusEffectBase* Effect : ActiveEffects)
+	for (int32 TypeIndex = 0; TypeIndex < NumStatusEffectTypes; ++TypeIndex)
 	{
+		if (!(ActiveEffectMask & (1u << TypeIndex)))
+		{
+			continue;
+		}
+
+		const UStatusEffectBase* Effect = Subsystem->GetConfig(EffectIndices[TypeIndex]);
 		if (Effect && Effect->HasVisualEffect())
 		{
 			// 使用最强效果的颜色
@@ -340,16 +331,3 @@ void UStatusEffectComponent::ResetMaterialEffects()
 		}
 	}
 }
-
-void UStatusEffectComponent::RemoveEffectInternal(int32 Index)
-{
-	if (ActiveEffects.IsValidIndex(Index))
-	{
-		UStatusEffectBase* Effect = ActiveEffects[Index];
-		if (Effect)
-		{
-			Effect->OnRemoved();
-		}
-		ActiveEffects.RemoveAt(Index);
-	}
-}
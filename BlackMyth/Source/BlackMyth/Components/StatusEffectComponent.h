@@ -1,4 +1,4 @@
-// 状态效果管理组件 - 管理角色身上所有激活的状态效果
+// 状态效果管理组件 - 角色身上状态效果的接口与视觉表现（计时由 UStatusEffectSubsystem 批量处理）
 
 #pragma once
 
@@ -8,6 +8,8 @@
 #include "StatusEffectComponent.generated.h"
 
 class UStatusEffectBase;
+class UStatusEffectSubsystem;
+class UHealthComponent;
 class USkeletalMeshComponent;
 class UMaterialInstanceDynamic;
 
@@ -19,15 +21,21 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnStatusEffectApplied, EStatusEffe
 /** 效果移除时广播 */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnStatusEffectRemoved, EStatusEffectType, EffectType);
 
-/** 效果更新时广播（每帧） */
+/** 效果更新时广播（每帧，仅在有监听者时广播） */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnStatusEffectUpdated, EStatusEffectType, EffectType, float, RemainingTime);
 
-// 将状态效果挂载到角色上，管理所有激活的状态效果
+/**
+ * 将状态效果挂载到角色上，提供施加/移除/查询接口
+ * 组件本身不 Tick：效果数据存放在 UStatusEffectSubsystem 中统一推进，
+ * 组件只按类型记录效果下标（O(1) 查询）并负责材质表现和事件广播
+ */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class BLACKMYTH_API UStatusEffectComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
+	friend class UStatusEffectSubsystem;
+
 public:
 	UStatusEffectComponent();
 
@@ -36,13 +44,14 @@ protected:
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
 	// ========== 效果管理接口 ==========
 
-	// 施加状态效果
+	/**
+	 * 施加状态效果（同类型已存在时刷新持续时间）
+	 * @return 施加或刷新成功返回 true
+	 */
 	UFUNCTION(BlueprintCallable, Category = "StatusEffect")
-	UStatusEffectBase* ApplyEffect(TSubclassOf<UStatusEffectBase> EffectClass, AActor* InInstigator, float Duration);
+	bool ApplyEffect(TSubclassOf<UStatusEffectBase> EffectClass, AActor* InInstigator, float Duration);
 
 	// 移除指定类型的效果
 	UFUNCTION(BlueprintCallable, Category = "StatusEffect")
@@ -56,21 +65,25 @@ public:
 	UFUNCTION(BlueprintPure, Category = "StatusEffect")
 	bool HasEffect(EStatusEffectType EffectType) const;
 
-	// 获取指定类型的效果实例
+	// 获取指定类型效果的配置（效果类的 CDO，只读）
+	UFUNCTION(BlueprintPure, Category = "StatusEffect")
+	const UStatusEffectBase* GetEffectConfig(EStatusEffectType EffectType) const;
+
+	// 获取指定类型效果的剩余时间（没有该效果时返回 0）
 	UFUNCTION(BlueprintPure, Category = "StatusEffect")
-	UStatusEffectBase* GetEffect(EStatusEffectType EffectType) const;
+	float GetEffectRemainingTime(EStatusEffectType EffectType) const;
 
-	// 获取所有激活的效果
+	// 获取所有激活的效果类型
 	UFUNCTION(BlueprintPure, Category = "StatusEffect")
-	TArray<UStatusEffectBase*> GetActiveEffects() const { return ActiveEffects; }
+	TArray<EStatusEffectType> GetActiveEffectTypes() const;
 
 	// 获取激活效果数量
 	UFUNCTION(BlueprintPure, Category = "StatusEffect")
-	int32 GetActiveEffectCount() const { return ActiveEffects.Num(); }
+	int32 GetActiveEffectCount() const { return FMath::CountBits(ActiveEffectMask); }
 
 	// 检查是否有任何效果禁用了攻击
 	UFUNCTION(BlueprintPure, Category = "StatusEffect")
-	bool IsAttackDisabled() const;
+	bool IsAttackDisabled() const { return (ActiveEffectMask & AttackDisabledMask) != 0; }
 
 	// ========== 委托 ==========
 
@@ -82,16 +95,24 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "StatusEffect|Events")
 	FOnStatusEffectRemoved OnEffectRemoved;
 
-	/** 效果更新时广播 */
+	/** 效果剩余时间每帧更新时广播（无人绑定时子系统跳过广播；HUD 按开始时间自行计算，不再绑定） */
 	UPROPERTY(BlueprintAssignable, Category = "StatusEffect|Events")
 	FOnStatusEffectUpdated OnEffectUpdated;
 
 protected:
 	// ========== 内部数据 ==========
 
-	/** 当前激活的效果列表 */
-	UPROPERTY()
-	TArray<UStatusEffectBase*> ActiveEffects;
+	/** 各类型效果在子系统 SoA 中的下标（INDEX_NONE 表示没有该效果） */
+	int32 EffectIndices[NumStatusEffectTypes];
+
+	/** 激活效果的类型位掩码 */
+	uint32 ActiveEffectMask = 0;
+
+	/** 禁用攻击的效果类型位掩码 */
+	uint32 AttackDisabledMask = 0;
+
+	/** 缓存的生命值组件（周期伤害直接结算，不再逐次查找） */
+	TWeakObjectPtr<UHealthComponent> CachedHealth;
 
 	/** 缓存的骨骼网格体组件（用于材质修改） */
 	UPROPERTY()
@@ -119,6 +140,17 @@ protected:
 	/** 重置材质到原始状态 */
 	void ResetMaterialEffects();
 
-	/** 内部移除效果（不广播事件） */
-	void RemoveEffectInternal(int32 Index);
+	/** 清空所有类型的效果下标 */
+	void ResetEffectIndices();
+
+	/** 获取子系统（世界正在销毁时可能为空） */
+	UStatusEffectSubsystem* GetSubsystem() const;
+
+	// ========== 子系统回调 ==========
+
+	/** 效果已加入子系统 */
+	void HandleEffectAdded(EStatusEffectType EffectType, int32 Index, const UStatusEffectBase* Config, float Duration);
+
+	/** 效果已从子系统移除 */
+	void HandleEffectRemoved(EStatusEffectType EffectType);
 };
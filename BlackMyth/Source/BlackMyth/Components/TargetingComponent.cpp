@@ -2,9 +2,9 @@
 
 #include "TargetingComponent.h"
 #include "HealthComponent.h"
+#include "TeamComponent.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/PlayerController.h"
-#include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Camera/CameraComponent.h"
 #include "DrawDebugHelpers.h"
@@ -12,6 +12,16 @@
 #include "Blueprint/UserWidget.h"
 #include "Components/Image.h"
 #include "Components/CanvasPanelSlot.h"
+#include "../EnemyBase.h"
+#include "../NPCCharacter.h"
+#include "../Subsystems/ActorRegistrySubsystem.h"
+#include "../Subsystems/SpatialGridSubsystem.h"
+#include "../Subsystems/LineOfSightSubsystem.h"
+#include "../Combat/CombatActorInterface.h"
+#include "../BlackMythStats.h"
+
+DECLARE_CYCLE_STAT(TEXT("Targeting Tick"), STAT_TargetingTick, STATGROUP_BlackMyth);
+DECLARE_CYCLE_STAT(TEXT("Targeting FindAllTargets"), STAT_TargetingFindAllTargets, STATGROUP_BlackMyth);
 
 UTargetingComponent::UTargetingComponent()
 {
@@ -34,6 +44,11 @@ void UTargetingComponent::TickComponent(float DeltaTime, ELevelTick TickType, FA
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
+	BLACKMYTH_SCOPE_CYCLE(STAT_TargetingTick, TEXT("BlackMyth.Targeting.Tick"));
+
+	// 未锁定时也保持候选集合更新，按下锁定键时可以直接使用
+	UpdateCandidates(DeltaTime);
+
 	if (bIsTargeting)
 	{
 		// 验证当前目标是否有效
@@ -67,7 +82,7 @@ void UTargetingComponent::ToggleLockOn()
 			LineOfSightLostTimer = 0.0f;
 
 			// 绑定目标死亡事件
-			if (UHealthComponent* TargetHealth = NewTarget->FindComponentByClass<UHealthComponent>())
+			if (UHealthComponent* TargetHealth = ICombatActor::GetHealth(NewTarget))
 			{
 				TargetHealth->OnDeath.AddDynamic(this, &UTargetingComponent::OnTargetDeath);
 			}
@@ -94,15 +109,15 @@ void UTargetingComponent::SwitchTarget(bool bRight)
 	}
 
 	TArray<AActor*> AllTargets = FindAllTargets();
-	
-	if (AllTargets.Num() <= 1)
-	{
-		return; // 没有其他目标可切换
-	}
 
 	// 移除当前目标
 	AllTargets.Remove(LockedTarget);
 
+	if (AllTargets.Num() == 0)
+	{
+		return; // 没有其他目标可切换
+	}
+
 	// 根据方向计算每个目标的得分
 	AActor* BestTarget = nullptr;
 	float BestScore = -FLT_MAX;
@@ -120,7 +135,7 @@ void UTargetingComponent::SwitchTarget(bool bRight)
 	if (BestTarget && BestTarget != LockedTarget)
 	{
 		// 解绑旧目标的死亡事件
-		if (UHealthComponent* OldHealth = LockedTarget->FindComponentByClass<UHealthComponent>())
+		if (UHealthComponent* OldHealth = ICombatActor::GetHealth(LockedTarget))
 		{
 			OldHealth->OnDeath.RemoveDynamic(this, &UTargetingComponent::OnTargetDeath);
 		}
@@ -130,7 +145,7 @@ void UTargetingComponent::SwitchTarget(bool bRight)
 		LineOfSightLostTimer = 0.0f;
 
 		// 绑定新目标的死亡事件
-		if (UHealthComponent* NewHealth = BestTarget->FindComponentByClass<UHealthComponent>())
+		if (UHealthComponent* NewHealth = ICombatActor::GetHealth(BestTarget))
 		{
 			NewHealth->OnDeath.AddDynamic(this, &UTargetingComponent::OnTargetDeath);
 		}
@@ -145,7 +160,7 @@ void UTargetingComponent::ClearTarget()
 	if (LockedTarget)
 	{
 		// 解绑死亡事件
-		if (UHealthComponent* TargetHealth = LockedTarget->FindComponentByClass<UHealthComponent>())
+		if (UHealthComponent* TargetHealth = ICombatActor::GetHealth(LockedTarget))
 		{
 			TargetHealth->OnDeath.RemoveDynamic(this, &UTargetingComponent::OnTargetDeath);
 		}
@@ -185,7 +200,7 @@ float UTargetingComponent::GetDistanceToTarget() const
 	return FVector::Dist(GetOwner()->GetActorLocation(), LockedTarget->GetActorLocation());
 }
 
-AActor* UTargetingComponent::FindBestTarget() const
+AActor* UTargetingComponent::FindBestTarget()
 {
 	TArray<AActor*> AllTargets = FindAllTargets();
 	
@@ -201,33 +216,26 @@ AActor* UTargetingComponent::FindBestTarget() const
 	}
 
 	// 获取摄像机前方向（优先使用摄像机方向，而非角色朝向）
-	FVector LookDirection = Owner->GetActorForwardVector();
-	if (OwnerController)
-	{
-		FRotator ControlRotation = OwnerController->GetControlRotation();
-		LookDirection = ControlRotation.Vector();
-	}
-
-	FVector OwnerLocation = Owner->GetActorLocation();
+	const FVector LookDirection2D = GetLookDirection().GetSafeNormal2D();
+	const FVector OwnerLocation = Owner->GetActorLocation();
 	
 	AActor* BestTarget = nullptr;
 	float BestScore = -FLT_MAX;
 
 	for (AActor* Target : AllTargets)
 	{
-		FVector ToTarget = Target->GetActorLocation() - OwnerLocation;
-		float Distance = ToTarget.Size();
-		FVector DirectionToTarget = ToTarget.GetSafeNormal();
+		const FVector ToTarget = Target->GetActorLocation() - OwnerLocation;
+		const float Distance = ToTarget.Size();
 
 		// 计算与视线的夹角
-		float DotProduct = FVector::DotProduct(LookDirection.GetSafeNormal2D(), DirectionToTarget.GetSafeNormal2D());
+		const float DotProduct = FVector::DotProduct(LookDirection2D, ToTarget.GetSafeNormal2D());
 		
 		// 综合评分：距离越近、越靠近屏幕中央得分越高
 		// DotProduct 范围 [-1, 1]，1 表示正前方
-		float AngleScore = DotProduct * 100.0f; // 角度权重
-		float DistanceScore = (TargetingDistance - Distance) / TargetingDistance * 50.0f; // 距离权重
+		const float AngleScore = DotProduct * 100.0f; // 角度权重
+		const float DistanceScore = (TargetingDistance - Distance) / TargetingDistance * 50.0f; // 距离权重
 
-		float Score = AngleScore + DistanceScore;
+		const float Score = AngleScore + DistanceScore;
 
 		if (Score > BestScore)
 		{
@@ -239,102 +247,276 @@ AActor* UTargetingComponent::FindBestTarget() const
 	return BestTarget;
 }
 
-TArray<AActor*> UTargetingComponent::FindAllTargets() const
+TArray<AActor*> UTargetingComponent::FindAllTargets()
 {
+	BLACKMYTH_SCOPE_CYCLE(STAT_TargetingFindAllTargets, TEXT("BlackMyth.Targeting.FindAllTargets"));
+
+	// 还没有完成过刷新（刚进入关卡就按下锁定键），立即完整刷新一次
+	if (!bHasCandidates)
+	{
+		BeginCandidateRefresh();
+		ProcessPendingCandidates(MAX_int32);
+	}
+
 	TArray<AActor*> ValidTargets;
-	
 	AActor* Owner = GetOwner();
 	if (!Owner)
 	{
 		return ValidTargets;
 	}
 
-	FVector OwnerLocation = Owner->GetActorLocation();
+	// 候选集合最多旧 CandidateRefreshInterval 秒，这里只复查会快速变化的条件
+	const FVector OwnerLocation = Owner->GetActorLocation();
+	const float MaxDistanceSq = FMath::Square(TargetingDistance);
+	for (const TWeakObjectPtr<AActor>& Candidate : CandidateTargets)
+	{
+		AActor* Target = Candidate.Get();
+		if (!Target || FVector::DistSquared(OwnerLocation, Target->GetActorLocation()) > MaxDistanceSq)
+		{
+			continue;
+		}
 
-	// 获取视线方向
-	FVector LookDirection = Owner->GetActorForwardVector();
-	if (OwnerController)
+		if (!IsTargetAlive(Target))
+		{
+			continue;
+		}
+
+		if (bCheckLineOfSight && !HasLineOfSight(Target))
+		{
+			continue;
+		}
+
+		ValidTargets.Add(Target);
+	}
+
+	return ValidTargets;
+}
+
+// ========== 候选目标缓存 ==========
+
+void UTargetingComponent::UpdateCandidates(float DeltaTime)
+{
+	if (PendingCandidates.Num() > 0)
+	{
+		ProcessPendingCandidates(MaxCandidateChecksPerTick);
+		return;
+	}
+
+	CandidateRefreshTimer -= DeltaTime;
+	if (CandidateRefreshTimer <= 0.0f)
+	{
+		CandidateRefreshTimer = CandidateRefreshInterval;
+		BeginCandidateRefresh();
+		ProcessPendingCandidates(MaxCandidateChecksPerTick);
+	}
+}
+
+void UTargetingComponent::BeginCandidateRefresh()
+{
+	PendingCandidates.Reset();
+	BuildingCandidates.Reset();
+
+	AActor* Owner = GetOwner();
+	if (!Owner)
 	{
-		FRotator ControlRotation = OwnerController->GetControlRotation();
-		LookDirection = ControlRotation.Vector();
+		return;
 	}
 
-	// 收集所有潜在目标
+	const FVector LookDirection = GetLookDirection();
+	RefreshLookDirection2D = LookDirection.GetSafeNormal2D();
+
 	TArray<AActor*> PotentialTargets;
+	GatherPotentialTargets(Owner->GetActorLocation(), LookDirection, PotentialTargets);
 
-	if (TargetableClasses.Num() > 0)
+	PendingCandidates.Reserve(PotentialTargets.Num());
+	for (AActor* Target : PotentialTargets)
 	{
-		// 使用指定的类
-		for (TSubclassOf<AActor> TargetClass : TargetableClasses)
+		if (Target && Target != Owner)
 		{
-			TArray<AActor*> FoundActors;
-			UGameplayStatics::GetAllActorsOfClass(GetWorld(), TargetClass, FoundActors);
-			PotentialTargets.Append(FoundActors);
+			PendingCandidates.Add(Target);
 		}
 	}
-	else
+}
+
+void UTargetingComponent::ProcessPendingCandidates(int32 MaxChecks)
+{
+	AActor* Owner = GetOwner();
+	if (!Owner)
 	{
-		// 默认：查找所有带 HealthComponent 的 Actor
-		TArray<AActor*> AllActors;
-		UGameplayStatics::GetAllActorsOfClass(GetWorld(), AActor::StaticClass(), AllActors);
-		
-		for (AActor* Actor : AllActors)
+		PendingCandidates.Reset();
+		return;
+	}
+
+	const FVector OwnerLocation = Owner->GetActorLocation();
+	const float CosTargetingAngle = FMath::Cos(FMath::DegreesToRadians(TargetingAngle));
+
+	// 从尾部取，避免移动数组
+	int32 NumChecked = 0;
+	while (PendingCandidates.Num() > 0 && NumChecked < MaxChecks)
+	{
+		AActor* Target = PendingCandidates.Pop(EAllowShrinking::No).Get();
+		++NumChecked;
+
+		if (Target && PassesCandidateFilter(Target, OwnerLocation, CosTargetingAngle))
 		{
-			if (Actor->FindComponentByClass<UHealthComponent>())
+			BuildingCandidates.Add(Target);
+
+			// 预先发起视线检测，锁定/切换时通常已经有结果
+			if (bCheckLineOfSight)
 			{
-				PotentialTargets.Add(Actor);
+				HasLineOfSight(Target);
 			}
 		}
 	}
 
-	// 筛选有效目标
-	for (AActor* Target : PotentialTargets)
+	if (PendingCandidates.Num() == 0)
 	{
-		// 排除自己
-		if (Target == Owner)
-		{
-			continue;
-		}
+		Swap(CandidateTargets, BuildingCandidates);
+		BuildingCandidates.Reset();
+		bHasCandidates = true;
+	}
+}
 
-		// 检查标签
-		if (TargetTag != NAME_None && !Target->ActorHasTag(TargetTag))
-		{
-			continue;
-		}
+void UTargetingComponent::GatherPotentialTargets(const FVector& OwnerLocation, const FVector& LookDirection, TArray<AActor*>& OutTargets) const
+{
+	AActor* Owner = GetOwner();
+	UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this);
+	USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this);
+
+	ETeam OwnerTeam = ETeam::Neutral;
+	if (Grid && Grid->GetRegisteredTeam(Owner, OwnerTeam) && SpatialGrid::HostileTeamMask(OwnerTeam) != 0)
+	{
+		// 有阵营的拥有者：直接从空间网格取扇形内的敌对单位
+		Grid->QueryCone(OwnerLocation, LookDirection, TargetingDistance, TargetingAngle,
+			SpatialGrid::HostileTeamMask(OwnerTeam), OutTargets);
 
-		// 检查距离
-		float Distance = FVector::Dist(OwnerLocation, Target->GetActorLocation());
-		if (Distance > TargetingDistance)
+		// 没有阵营的可受伤 Actor（训练靶子等）不在网格的阵营桶里，从注册表按半径补充
+		if (Registry)
 		{
-			continue;
+			TArray<AActor*> Damageables;
+			Registry->GetDamageablesInRadius(OwnerLocation, TargetingDistance, true, Damageables);
+			for (AActor* Damageable : Damageables)
+			{
+				ETeam DamageableTeam;
+				if (!Grid->GetRegisteredTeam(Damageable, DamageableTeam) && !UTeamComponent::TryGetActorTeam(Damageable, DamageableTeam))
+				{
+					OutTargets.Add(Damageable);
+				}
+			}
 		}
 
-		// 检查角度（是否在前方扇形区域内）
-		FVector ToTarget = (Target->GetActorLocation() - OwnerLocation).GetSafeNormal2D();
-		float DotProduct = FVector::DotProduct(LookDirection.GetSafeNormal2D(), ToTarget);
-		float AngleDegrees = FMath::RadiansToDegrees(FMath::Acos(DotProduct));
-		
-		if (AngleDegrees > TargetingAngle)
+		if (TargetableClasses.Num() > 0)
 		{
-			continue;
+			OutTargets.RemoveAllSwap([this](const AActor* Target)
+			{
+				for (const TSubclassOf<AActor>& TargetClass : TargetableClasses)
+				{
+					if (TargetClass && Target->IsA(TargetClass))
+					{
+						return false;
+					}
+				}
+				return true;
+			}, EAllowShrinking::No);
 		}
+	}
+	else if (TargetableClasses.Num() > 0 && Registry)
+	{
+		// 非敌人类从注册表的可受伤 Actor（半径内）、NPC 和召唤物中筛选，不扫描关卡
+		TArray<AActor*> RegisteredActors;
+		bool bGatheredRegistered = false;
 
-		// 检查是否存活
-		if (!IsTargetAlive(Target))
+		// 使用指定的类
+		for (TSubclassOf<AActor> TargetClass : TargetableClasses)
 		{
-			continue;
-		}
+			if (!TargetClass)
+			{
+				continue;
+			}
 
-		// 检查视线（可选）
-		if (bCheckLineOfSight && !HasLineOfSight(Target))
+			if (TargetClass->IsChildOf(AEnemyBase::StaticClass()))
+			{
+				// 敌人类直接从注册表中筛选
+				for (AEnemyBase* Enemy : Registry->GetEnemies())
+				{
+					if (Enemy && Enemy->IsA(TargetClass))
+					{
+						OutTargets.Add(Enemy);
+					}
+				}
+			}
+			else
+			{
+				if (!bGatheredRegistered)
+				{
+					Registry->GetDamageablesInRadius(OwnerLocation, TargetingDistance, false, RegisteredActors);
+					for (ANPCCharacter* NPC : Registry->GetNPCs())
+					{
+						RegisteredActors.Add(NPC);
+					}
+					for (AActor* Summon : Registry->GetSummons())
+					{
+						RegisteredActors.Add(Summon);
+					}
+					bGatheredRegistered = true;
+				}
+
+				for (AActor* Actor : RegisteredActors)
+				{
+					if (Actor && Actor->IsA(TargetClass) && !Actor->IsA(AEnemyBase::StaticClass()))
+					{
+						OutTargets.AddUnique(Actor);
+					}
+				}
+			}
+		}
+	}
+	else if (Registry)
+	{
+		// 默认：所有带 HealthComponent 的 Actor（由 HealthComponent 注册）
+		for (const auto& Pair : Registry->GetDamageables())
 		{
-			continue;
+			if (Pair.Key)
+			{
+				OutTargets.Add(Pair.Key);
+			}
 		}
+	}
+}
 
-		ValidTargets.Add(Target);
+bool UTargetingComponent::PassesCandidateFilter(AActor* Target, const FVector& OwnerLocation, float CosTargetingAngle) const
+{
+	// 检查标签
+	if (TargetTag != NAME_None && !Target->ActorHasTag(TargetTag))
+	{
+		return false;
 	}
 
-	return ValidTargets;
+	// 检查距离
+	const FVector ToTarget = Target->GetActorLocation() - OwnerLocation;
+	if (ToTarget.SizeSquared() > FMath::Square(TargetingDistance))
+	{
+		return false;
+	}
+
+	// 检查角度（是否在前方扇形区域内），直接比较点积与 cos(TargetingAngle)
+	if (FVector::DotProduct(RefreshLookDirection2D, ToTarget.GetSafeNormal2D()) < CosTargetingAngle)
+	{
+		return false;
+	}
+
+	// 检查是否存活
+	return IsTargetAlive(Target);
+}
+
+FVector UTargetingComponent::GetLookDirection() const
+{
+	if (OwnerController)
+	{
+		return OwnerController->GetControlRotation().Vector();
+	}
+
+	return GetOwner() ? GetOwner()->GetActorForwardVector() : FVector::ForwardVector;
 }
 
 bool UTargetingComponent::IsTargetValid(AActor* Target) const
@@ -351,8 +533,7 @@ bool UTargetingComponent::IsTargetValid(AActor* Target) const
 	}
 
 	// 检查距离
-	float Distance = FVector::Dist(Owner->GetActorLocation(), Target->GetActorLocation());
-	if (Distance > LoseTargetDistance)
+	if (FVector::DistSquared(Owner->GetActorLocation(), Target->GetActorLocation()) > FMath::Square(LoseTargetDistance))
 	{
 		return false;
 	}
@@ -373,24 +554,17 @@ bool UTargetingComponent::HasLineOfSight(AActor* Target) const
 		return false;
 	}
 
-	FVector Start = GetOwner()->GetActorLocation() + FVector(0, 0, 50.0f); // 从眼睛高度
-	FVector End = Target->GetActorLocation() + FVector(0, 0, TargetHeightOffset);
-
-	FHitResult HitResult;
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(GetOwner());
-	QueryParams.AddIgnoredActor(Target);
+	const FVector Start = GetOwner()->GetActorLocation() + FVector(0, 0, 50.0f); // 从眼睛高度
+	const FVector End = Target->GetActorLocation() + FVector(0, 0, TargetHeightOffset);
 
-	bool bHit = GetWorld()->LineTraceSingleByChannel(
-		HitResult,
-		Start,
-		End,
-		ECC_Visibility,
-		QueryParams
-	);
+	ULineOfSightSubsystem* LineOfSight = ULineOfSightSubsystem::Get(this);
+	if (!LineOfSight)
+	{
+		return true;
+	}
 
-	// 如果没有命中任何东西，说明视线畅通
-	return !bHit;
+	// 尚无结果时视为可见
+	return LineOfSight->QueryLineOfSight(GetOwner(), Target, Start, End, LineOfSightCacheTTL) != ELineOfSightResult::Blocked;
 }
 
 bool UTargetingComponent::IsTargetAlive(AActor* Target) const
@@ -400,7 +574,7 @@ bool UTargetingComponent::IsTargetAlive(AActor* Target) const
 		return false;
 	}
 
-	if (UHealthComponent* HealthComp = Target->FindComponentByClass<UHealthComponent>())
+	if (UHealthComponent* HealthComp = ICombatActor::GetHealth(Target))
 	{
 		return !HealthComp->IsDead();
 	}
@@ -543,7 +717,7 @@ void UTargetingComponent::OnTargetDeath(AActor* DeadActor)
 			LineOfSightLostTimer = 0.0f;
 
 			// 绑定新目标死亡事件
-			if (UHealthComponent* NewHealth = NewTarget->FindComponentByClass<UHealthComponent>())
+			if (UHealthComponent* NewHealth = ICombatActor::GetHealth(NewTarget))
 			{
 				NewHealth->OnDeath.AddDynamic(this, &UTargetingComponent::OnTargetDeath);
 			}
@@ -23,6 +23,11 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnTargetLost);
  * - 左右切换目标
  * - 自动追踪目标（摄像机平滑跟随）
  * - 目标丢失检测（距离过远、障碍物遮挡、目标死亡）
+ *
+ * 候选目标以小集合形式缓存：每隔 CandidateRefreshInterval 从空间网格/注册表取一次潜在目标，
+ * 之后每帧最多筛选 MaxCandidateChecksPerTick 个，筛选完再整体替换候选集合。
+ * 视线检测交给 ULineOfSightSubsystem（异步射线，结果按目标缓存 LineOfSightCacheTTL 秒），
+ * 因此锁定、切换目标和每帧验证的开销与场景中的敌人数量无关。
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class BLACKMYTH_API UTargetingComponent : public UActorComponent
@@ -129,7 +134,22 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting|Config")
 	float LineOfSightLostTolerance = 1.0f;
 
-	/** 可被锁定的Actor类（留空则锁定所有带HealthComponent的） */
+	/** 候选目标集合的刷新间隔（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting|Performance", meta = (ClampMin = "0.0"))
+	float CandidateRefreshInterval = 0.2f;
+
+	/** 每帧最多筛选的潜在目标数量（刷新分摊到多帧完成） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting|Performance", meta = (ClampMin = "1"))
+	int32 MaxCandidateChecksPerTick = 16;
+
+	/** 视线检测结果的缓存时间（秒），过期后发起新的异步射线 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting|Performance", meta = (ClampMin = "0.0"))
+	float LineOfSightCacheTTL = 0.15f;
+
+	/**
+	 * 可被锁定的Actor类（留空则锁定所有带HealthComponent的；拥有者有阵营时排除非敌对阵营，没有阵营的仍可锁定）
+	 * 只在 Actor 注册表中查找：敌人、带 HealthComponent 的 Actor、NPC 和召唤物，未注册的类不会被锁定
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Targeting|Config")
 	TArray<TSubclassOf<AActor>> TargetableClasses;
 
@@ -172,6 +192,26 @@ protected:
 	/** 视线遮挡计时器 */
 	float LineOfSightLostTimer = 0.0f;
 
+	// ========== 候选目标缓存 ==========
+
+	/** 当前候选目标（最近一次完整刷新的结果） */
+	TArray<TWeakObjectPtr<AActor>> CandidateTargets;
+
+	/** 本轮刷新中待筛选的潜在目标 */
+	TArray<TWeakObjectPtr<AActor>> PendingCandidates;
+
+	/** 本轮刷新中已通过筛选的目标 */
+	TArray<TWeakObjectPtr<AActor>> BuildingCandidates;
+
+	/** 距离下一轮刷新的时间 */
+	float CandidateRefreshTimer = 0.0f;
+
+	/** 本轮刷新开始时的视线方向（2D 单位向量），同一轮内的筛选使用同一方向 */
+	FVector RefreshLookDirection2D = FVector::ForwardVector;
+
+	/** 是否已经完成过至少一次刷新 */
+	bool bHasCandidates = false;
+
 	/** 拥有者的 PlayerController */
 	UPROPERTY()
 	TObjectPtr<APlayerController> OwnerController;
@@ -192,15 +232,36 @@ protected:
 	void UpdateTargetIndicator();
 
 	/** 寻找最佳目标 */
-	AActor* FindBestTarget() const;
+	AActor* FindBestTarget();
+
+	/** 获取当前可锁定的目标（候选集合中仍然存活、在范围内且视线未被遮挡的） */
+	TArray<AActor*> FindAllTargets();
+
+	/** 推进候选集合的分帧刷新 */
+	void UpdateCandidates(float DeltaTime);
+
+	/** 从空间网格/注册表取潜在目标，开始新一轮刷新 */
+	void BeginCandidateRefresh();
+
+	/** 筛选最多 MaxChecks 个待筛选目标，全部筛选完后替换候选集合 */
+	void ProcessPendingCandidates(int32 MaxChecks);
+
+	/** 收集潜在目标（宽筛：阵营扇形查询或注册表） */
+	void GatherPotentialTargets(const FVector& OwnerLocation, const FVector& LookDirection, TArray<AActor*>& OutTargets) const;
+
+	/** 候选筛选：标签、距离、角度（点积阈值）、存活 */
+	bool PassesCandidateFilter(AActor* Target, const FVector& OwnerLocation, float CosTargetingAngle) const;
 
-	/** 寻找所有可锁定目标 */
-	TArray<AActor*> FindAllTargets() const;
+	/** 获取视线方向（优先摄像机方向） */
+	FVector GetLookDirection() const;
 
 	/** 检查Actor是否可被锁定 */
 	bool IsTargetValid(AActor* Target) const;
 
-	/** 检查目标是否在视线内 */
+	/**
+	 * 检查目标是否在视线内（查询 ULineOfSightSubsystem 的缓存，过期时由子系统发起异步射线）
+	 * 尚无结果时视为可见，被遮挡由之后返回的结果和 LineOfSightLostTolerance 处理
+	 */
 	bool HasLineOfSight(AActor* Target) const;
 
 	/** 检查目标是否存活 */
@@ -1,53 +1,76 @@
 // 阵营管理组件实现
 
 #include "TeamComponent.h"
+#include "TeamMemberInterface.h"
+#include "../Subsystems/SpatialGridSubsystem.h"
 
 UTeamComponent::UTeamComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
-	
-	// 初始化默认敌对关系
-	InitializeDefaultHostility();
+}
+
+void UTeamComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	// 编辑器/蓝图中配置的 CurrentTeam 在此时已经加载完成
+	SyncOwnerTeam();
 }
 
 void UTeamComponent::BeginPlay()
 {
 	Super::BeginPlay();
+
+	// 注册到空间网格，阵营变化由网格每帧从本组件读取
+	if (USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this))
+	{
+		Grid->RegisterActor(GetOwner(), CurrentTeam, this);
+	}
 }
 
-void UTeamComponent::SetTeam(ETeam NewTeam)
+void UTeamComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	if (CurrentTeam != NewTeam)
+	if (USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this))
 	{
-		ETeam OldTeam = CurrentTeam;
-		CurrentTeam = NewTeam;
-		OnTeamChanged.Broadcast(OldTeam, NewTeam);
+		Grid->UnregisterActor(GetOwner());
 	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
-bool UTeamComponent::IsHostileTo(ETeam OtherTeam) const
+void UTeamComponent::OnAcquiredFromPool()
 {
-	// 中立阵营不主动敌对任何人
-	if (CurrentTeam == ETeam::Neutral || OtherTeam == ETeam::Neutral)
+	if (USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this))
 	{
-		return false;
+		Grid->RegisterActor(GetOwner(), CurrentTeam, this);
 	}
+}
 
-	// 相同阵营不敌对
-	if (CurrentTeam == OtherTeam)
+void UTeamComponent::OnReleasedToPool()
+{
+	if (USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this))
 	{
-		return false;
+		Grid->UnregisterActor(GetOwner());
 	}
+}
 
-	// 检查敌对关系表
-	if (const TArray<ETeam>* HostileList = HostileTeams.Find(CurrentTeam))
+void UTeamComponent::SetTeam(ETeam NewTeam)
+{
+	if (CurrentTeam != NewTeam)
 	{
-		return HostileList->Contains(OtherTeam);
+		ETeam OldTeam = CurrentTeam;
+		CurrentTeam = NewTeam;
+		SyncOwnerTeam();
+		OnTeamChanged.Broadcast(OldTeam, NewTeam);
 	}
+}
 
-	// 默认：不同阵营就敌对（Player vs Enemy）
-	return (CurrentTeam == ETeam::Player && OtherTeam == ETeam::Enemy) ||
-	       (CurrentTeam == ETeam::Enemy && OtherTeam == ETeam::Player);
+void UTeamComponent::SyncOwnerTeam()
+{
+	if (ITeamMember* TeamMember = Cast<ITeamMember>(GetOwner()))
+	{
+		TeamMember->CachedTeam = CurrentTeam;
+	}
 }
 
 bool UTeamComponent::IsHostileToActor(AActor* OtherActor) const
@@ -57,13 +80,13 @@ bool UTeamComponent::IsHostileToActor(AActor* OtherActor) const
 		return false;
 	}
 
-	UTeamComponent* OtherTeamComp = GetTeamComponent(OtherActor);
-	if (!OtherTeamComp)
+	ETeam OtherTeam;
+	if (!TryGetActorTeam(OtherActor, OtherTeam))
 	{
 		return false; // 没有阵营组件的 Actor 默认不敌对
 	}
 
-	return IsHostileTo(OtherTeamComp->GetTeam());
+	return IsHostileTo(OtherTeam);
 }
 
 bool UTeamComponent::IsAllyOf(AActor* OtherActor) const
@@ -73,27 +96,45 @@ bool UTeamComponent::IsAllyOf(AActor* OtherActor) const
 		return false;
 	}
 
-	UTeamComponent* OtherTeamComp = GetTeamComponent(OtherActor);
-	if (!OtherTeamComp)
+	ETeam OtherTeam;
+	if (!TryGetActorTeam(OtherActor, OtherTeam))
 	{
 		return false;
 	}
 
 	// 相同阵营是友军
-	return CurrentTeam == OtherTeamComp->GetTeam();
+	return CurrentTeam == OtherTeam;
 }
 
 // ========== 静态辅助函数 ==========
 
 ETeam UTeamComponent::GetActorTeam(AActor* Actor)
+{
+	ETeam Team;
+	return TryGetActorTeam(Actor, Team) ? Team : ETeam::Neutral;
+}
+
+bool UTeamComponent::TryGetActorTeam(const AActor* Actor, ETeam& OutTeam)
 {
 	if (!Actor)
 	{
-		return ETeam::Neutral;
+		return false;
+	}
+
+	if (const ITeamMember* TeamMember = Cast<ITeamMember>(Actor))
+	{
+		OutTeam = TeamMember->GetCachedTeam();
+		return true;
+	}
+
+	// 未实现 ITeamMember 的 Actor（蓝图或第三方类）回退到组件查找
+	if (const UTeamComponent* TeamComp = Actor->FindComponentByClass<UTeamComponent>())
+	{
+		OutTeam = TeamComp->GetTeam();
+		return true;
 	}
 
-	UTeamComponent* TeamComp = GetTeamComponent(Actor);
-	return TeamComp ? TeamComp->GetTeam() : ETeam::Neutral;
+	return false;
 }
 
 bool UTeamComponent::AreActorsHostile(AActor* ActorA, AActor* ActorB)
@@ -103,13 +144,13 @@ bool UTeamComponent::AreActorsHostile(AActor* ActorA, AActor* ActorB)
 		return false;
 	}
 
-	UTeamComponent* TeamCompA = GetTeamComponent(ActorA);
-	if (!TeamCompA)
+	ETeam TeamA, TeamB;
+	if (!TryGetActorTeam(ActorA, TeamA) || !TryGetActorTeam(ActorB, TeamB))
 	{
 		return false;
 	}
 
-	return TeamCompA->IsHostileToActor(ActorB);
+	return TeamHostility::AreHostile(TeamA, TeamB);
 }
 
 bool UTeamComponent::AreActorsAllies(AActor* ActorA, AActor* ActorB)
@@ -119,13 +160,13 @@ bool UTeamComponent::AreActorsAllies(AActor* ActorA, AActor* ActorB)
 		return false;
 	}
 
-	UTeamComponent* TeamCompA = GetTeamComponent(ActorA);
-	if (!TeamCompA)
+	ETeam TeamA, TeamB;
+	if (!TryGetActorTeam(ActorA, TeamA) || !TryGetActorTeam(ActorB, TeamB))
 	{
 		return false;
 	}
 
-	return TeamCompA->IsAllyOf(ActorB);
+	return TeamA == TeamB;
 }
 
 UTeamComponent* UTeamComponent::GetTeamComponent(AActor* Actor)
@@ -137,15 +178,3 @@ UTeamComponent* UTeamComponent::GetTeamComponent(AActor* Actor)
 
 	return Actor->FindComponentByClass<UTeamComponent>();
 }
-
-void UTeamComponent::InitializeDefaultHostility()
-{
-	// 玩家阵营敌对敌人阵营
-	HostileTeams.Add(ETeam::Player, { ETeam::Enemy });
-	
-	// 敌人阵营敌对玩家阵营
-	HostileTeams.Add(ETeam::Enemy, { ETeam::Player });
-	
-	// 环境对所有人都可能造成伤害（但不是主动敌对）
-	// Environment 不在敌对列表中
-}
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "../Subsystems/PoolableInterface.h"
 #include "TeamComponent.generated.h"
 
 /**
@@ -18,6 +19,51 @@ enum class ETeam : uint8
 	Environment UMETA(DisplayName = "Environment")   // 环境（陷阱等）
 };
 
+/**
+ * 阵营敌对关系表（编译期常量，所有实例共享）
+ * 每个阵营一个掩码，第 N 位表示是否敌对 ETeam(N)；判定敌对只需一次查表和一次按位与
+ */
+namespace TeamHostility
+{
+	/** ETeam 枚举数量 */
+	constexpr int32 NumTeams = static_cast<int32>(ETeam::Environment) + 1;
+
+	/** 阵营对应的掩码位 */
+	constexpr uint8 TeamBit(ETeam Team)
+	{
+		return static_cast<uint8>(1u << static_cast<uint8>(Team));
+	}
+
+	/**
+	 * 按 ETeam 下标的敌对掩码
+	 * - 玩家阵营（包括分身）与敌人阵营互相敌对
+	 * - 中立不敌对任何人；环境对所有人都可能造成伤害，但不是主动敌对
+	 */
+	constexpr uint8 HostileMasks[NumTeams] =
+	{
+		/* Player      */ TeamBit(ETeam::Enemy),
+		/* Enemy       */ TeamBit(ETeam::Player),
+		/* Neutral     */ 0,
+		/* Environment */ 0,
+	};
+
+	/** 与 Team 敌对的阵营掩码 */
+	constexpr uint8 HostileMask(ETeam Team)
+	{
+		return HostileMasks[static_cast<uint8>(Team)];
+	}
+
+	/** 两个阵营是否敌对 */
+	constexpr bool AreHostile(ETeam A, ETeam B)
+	{
+		return (HostileMask(A) & TeamBit(B)) != 0;
+	}
+
+	static_assert(NumTeams <= 8, "Team masks are stored in a uint8");
+	static_assert(AreHostile(ETeam::Player, ETeam::Enemy) && AreHostile(ETeam::Enemy, ETeam::Player), "Player and Enemy must be mutually hostile");
+	static_assert(!AreHostile(ETeam::Player, ETeam::Player) && !AreHostile(ETeam::Enemy, ETeam::Enemy), "A team is never hostile to itself");
+}
+
 // 阵营变化委托
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTeamChanged, ETeam, OldTeam, ETeam, NewTeam);
 
@@ -27,7 +73,7 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnTeamChanged, ETeam, OldTeam, ETe
  * 用于敌我识别、仇恨系统等
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
-class BLACKMYTH_API UTeamComponent : public UActorComponent
+class BLACKMYTH_API UTeamComponent : public UActorComponent, public IPoolable
 {
 	GENERATED_BODY()
 
@@ -36,6 +82,13 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// ========== IPoolable ==========
+
+	/** 池化的 Actor 在池中时不参与空间网格查询 */
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
 
 public:
 	// ========== 核心接口 ==========
@@ -48,9 +101,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Team")
 	void SetTeam(ETeam NewTeam);
 
-	/** 检查是否与另一个阵营敌对 */
+	/** 检查是否与另一个阵营敌对（查 TeamHostility 表） */
 	UFUNCTION(BlueprintPure, Category = "Team")
-	bool IsHostileTo(ETeam OtherTeam) const;
+	bool IsHostileTo(ETeam OtherTeam) const { return TeamHostility::AreHostile(CurrentTeam, OtherTeam); }
 
 	/** 检查是否与另一个 Actor 敌对（通过其 TeamComponent） */
 	UFUNCTION(BlueprintPure, Category = "Team")
@@ -78,6 +131,13 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Team", meta = (DisplayName = "Are Actors Allies"))
 	static bool AreActorsAllies(AActor* ActorA, AActor* ActorB);
 
+	/**
+	 * 获取 Actor 的阵营（C++ 快速路径）
+	 * 实现 ITeamMember 的 Actor 直接读取缓存的阵营，其余 Actor 回退到查找 TeamComponent
+	 * @return Actor 没有阵营时返回 false
+	 */
+	static bool TryGetActorTeam(const AActor* Actor, ETeam& OutTeam);
+
 	/** 从 Actor 获取 TeamComponent */
 	UFUNCTION(BlueprintPure, Category = "Team", meta = (DisplayName = "Get Team Component"))
 	static UTeamComponent* GetTeamComponent(AActor* Actor);
@@ -89,14 +149,13 @@ public:
 	FOnTeamChanged OnTeamChanged;
 
 protected:
-	/** 当前阵营 */
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Team")
-	ETeam CurrentTeam = ETeam::Neutral;
+	virtual void OnRegister() override;
 
-	/** 阵营敌对关系表（内部使用，不暴露给反射系统） */
-	TMap<ETeam, TArray<ETeam>> HostileTeams;
+	/** 当前阵营（修改请通过 SetTeam，以便同步 Owner 缓存的阵营） */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Team")
+	ETeam CurrentTeam = ETeam::Neutral;
 
 private:
-	/** 初始化默认敌对关系 */
-	void InitializeDefaultHostility();
+	/** 把当前阵营写入 Owner 的 ITeamMember 缓存 */
+	void SyncOwnerTeam();
 };
@@ -0,0 +1,36 @@
+// 阵营成员接口 - 在 Actor 上缓存阵营，敌我判定不再查找 TeamComponent
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "TeamComponent.h"
+#include "TeamMemberInterface.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UTeamMember : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * 阵营成员接口
+ * 挂载 UTeamComponent 的 Actor（玩家、敌人、分身）实现此接口，
+ * 组件注册和 SetTeam 时把阵营写入这里，热路径上的敌我判定
+ * （UTeamComponent::TryGetActorTeam、命中盒目标检查）只需读一个字节。
+ *
+ * 实现类只需继承，不需要重写任何函数；阵营的唯一写入方是 UTeamComponent。
+ */
+class BLACKMYTH_API ITeamMember
+{
+	GENERATED_BODY()
+
+	friend class UTeamComponent;
+
+public:
+	/** 缓存的阵营（与 TeamComponent::GetTeam 保持一致） */
+	ETeam GetCachedTeam() const { return CachedTeam; }
+
+private:
+	ETeam CachedTeam = ETeam::Neutral;
+};
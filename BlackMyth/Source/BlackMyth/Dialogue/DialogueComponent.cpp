@@ -11,7 +11,14 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "TimerManager.h"
 #include "Engine/DataTable.h"
+#include "Engine/AssetManager.h"
 #include "../XiaoTian.h"
+#include "../Subsystems/ActorRegistrySubsystem.h"
+#include "../BlackMythStats.h"
+#include "../BlackMythLog.h"
+
+DECLARE_CYCLE_STAT(TEXT("Dialogue Load Rows"), STAT_DialogueLoadRows, STATGROUP_BlackMyth);
+DECLARE_CYCLE_STAT(TEXT("Dialogue Play Line"), STAT_DialoguePlayLine, STATGROUP_BlackMyth);
 
 UDialogueComponent::UDialogueComponent()
 {
@@ -38,48 +45,140 @@ void UDialogueComponent::BeginPlay()
 		{
 			DialogueWidgetInstance->AddToViewport(500);
 			DialogueWidgetInstance->SetVisibility(ESlateVisibility::Collapsed);
-			UE_LOG(LogTemp, Log, TEXT("DialogueComponent: DialogueWidget created"));
+			UE_LOG(LogBMDialogue, Log, TEXT("DialogueComponent: DialogueWidget created"));
 		}
 	}
 }
 
+void UDialogueComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (GetWorld())
+	{
+		GetWorld()->GetTimerManager().ClearTimer(AutoPlayTimerHandle);
+	}
+
+	ReleasePrefetchedDialogue();
+	if (StreamAheadHandle.IsValid())
+	{
+		StreamAheadHandle->ReleaseHandle();
+		StreamAheadHandle.Reset();
+	}
+	if (CurrentLineHandle.IsValid())
+	{
+		CurrentLineHandle->CancelHandle();
+		CurrentLineHandle.Reset();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void UDialogueComponent::LoadDialogueData()
 {
-	CachedDialogueSequence.Empty();
+	BLACKMYTH_SCOPE_CYCLE(STAT_DialogueLoadRows, TEXT("BlackMyth.Dialogue.LoadRows"));
+
+	DialogueRows.Reset();
 
 	if (DialogueConfig.bUseDataTable && DialogueConfig.DialogueDataTable)
 	{
-		// 从DataTable加载
+		// 从DataTable收集行指针（行数据由DataTable持有，这里不复制）
 		TArray<FDialogueEntry*> AllRows;
 		DialogueConfig.DialogueDataTable->GetAllRows<FDialogueEntry>(TEXT("LoadDialogue"), AllRows);
-		
-		for (FDialogueEntry* Row : AllRows)
+
+		DialogueRows.Reserve(AllRows.Num());
+		for (const FDialogueEntry* Row : AllRows)
 		{
 			if (Row)
 			{
-				CachedDialogueSequence.Add(*Row);
+				DialogueRows.Add(Row);
 			}
 		}
-		
-		UE_LOG(LogTemp, Log, TEXT("DialogueComponent: Loaded %d dialogues from DataTable"), CachedDialogueSequence.Num());
+
+		UE_LOG(LogBMDialogue, Log, TEXT("DialogueComponent: Loaded %d dialogues from DataTable"), DialogueRows.Num());
 	}
 	else
 	{
 		// 使用手动配置
-		CachedDialogueSequence = DialogueConfig.ManualDialogueSequence;
-		UE_LOG(LogTemp, Log, TEXT("DialogueComponent: Using %d manual dialogues"), CachedDialogueSequence.Num());
+		DialogueRows.Reserve(DialogueConfig.ManualDialogueSequence.Num());
+		for (const FDialogueEntry& Entry : DialogueConfig.ManualDialogueSequence)
+		{
+			DialogueRows.Add(&Entry);
+		}
+		UE_LOG(LogBMDialogue, Log, TEXT("DialogueComponent: Using %d manual dialogues"), DialogueRows.Num());
+	}
+}
+
+TSharedPtr<FStreamableHandle> UDialogueComponent::RequestLineAssets(int32 FirstIndex, int32 Count, TAsyncLoadPriority Priority, FStreamableDelegate OnLoaded)
+{
+	TArray<FSoftObjectPath> AssetPaths;
+	const int32 EndIndex = FMath::Min(FirstIndex + Count, DialogueRows.Num());
+	for (int32 Index = FMath::Max(FirstIndex, 0); Index < EndIndex; ++Index)
+	{
+		DialogueRows[Index]->AppendAssetPaths(AssetPaths);
+	}
+
+	if (AssetPaths.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(MoveTemp(AssetPaths), MoveTemp(OnLoaded), Priority);
+}
+
+void UDialogueComponent::PrefetchDialogue()
+{
+	if (PrefetchHandle.IsValid())
+	{
+		return;
+	}
+
+	// 对话进行中行指针正在使用，不重新收集
+	if (!bIsPlaying)
+	{
+		LoadDialogueData();
+	}
+
+	PrefetchHandle = RequestLineAssets(0, PrefetchLineCount, FStreamableManager::DefaultAsyncLoadPriority);
+}
+
+void UDialogueComponent::ReleasePrefetchedDialogue()
+{
+	// 释放句柄只是不再持有引用，已在播放的语音和蒙太奇由播放方引用
+	if (PrefetchHandle.IsValid())
+	{
+		PrefetchHandle->ReleaseHandle();
+		PrefetchHandle.Reset();
+	}
+}
+
+void UDialogueComponent::StreamAhead()
+{
+	// 先请求新窗口再释放旧窗口，两者重叠的资源不会被卸载
+	TSharedPtr<FStreamableHandle> PreviousHandle = MoveTemp(StreamAheadHandle);
+	StreamAheadHandle = RequestLineAssets(CurrentDialogueIndex + 1, StreamAheadLineCount, FStreamableManager::DefaultAsyncLoadPriority);
+
+	if (PreviousHandle.IsValid())
+	{
+		PreviousHandle->ReleaseHandle();
 	}
 }
 
 void UDialogueComponent::StartDialogue()
 {
-	if (bIsPlaying || CachedDialogueSequence.Num() == 0 || !PlayerController)
+	if (bIsPlaying || !PlayerController)
+	{
+		return;
+	}
+
+	// 重新收集行指针，蓝图在 BeginPlay 之后修改的配置也能生效
+	LoadDialogueData();
+	if (DialogueRows.Num() == 0)
 	{
 		return;
 	}
 
 	CurrentDialogueIndex = 0;
 	bIsPlaying = true;
+	BLACKMYTH_TRACE_BOOKMARK(TEXT("Dialogue start %s"), *GetNameSafe(GetOwner()));
 
 	// 禁用玩家移动和视角输入
 	PlayerController->SetIgnoreMoveInput(true);
@@ -101,8 +200,8 @@ void UDialogueComponent::StartDialogue()
 	// 播放第一句
 	PlayCurrentDialogue();
 
-	UE_LOG(LogTemp, Log, TEXT("DialogueComponent: Started dialogue '%s' with %d lines"), 
-		*DialogueConfig.TableName.ToString(), CachedDialogueSequence.Num());
+	UE_LOG(LogBMDialogue, Log, TEXT("DialogueComponent: Started dialogue '%s' with %d lines"), 
+		*DialogueConfig.TableName.ToString(), DialogueRows.Num());
 }
 
 void UDialogueComponent::NextDialogue()
@@ -120,7 +219,7 @@ void UDialogueComponent::NextDialogue()
 
 	CurrentDialogueIndex++;
 
-	if (CurrentDialogueIndex >= CachedDialogueSequence.Num())
+	if (CurrentDialogueIndex >= DialogueRows.Num())
 	{
 		EndDialogue();
 		return;
@@ -144,6 +243,18 @@ void UDialogueComponent::EndDialogue()
 		GetWorld()->GetTimerManager().ClearTimer(AutoPlayTimerHandle);
 	}
 
+	// 释放流送中的资源（前几句仍由预取句柄持有，玩家可以再次对话）
+	if (StreamAheadHandle.IsValid())
+	{
+		StreamAheadHandle->ReleaseHandle();
+		StreamAheadHandle.Reset();
+	}
+	if (CurrentLineHandle.IsValid())
+	{
+		CurrentLineHandle->CancelHandle();
+		CurrentLineHandle.Reset();
+	}
+
 	// 隐藏对话UI
 	if (DialogueWidgetInstance)
 	{
@@ -170,17 +281,19 @@ void UDialogueComponent::EndDialogue()
 	// 广播事件
 	OnDialogueStateChanged.Broadcast(false);
 
-	UE_LOG(LogTemp, Log, TEXT("DialogueComponent: Dialogue ended"));
+	UE_LOG(LogBMDialogue, Log, TEXT("DialogueComponent: Dialogue ended"));
 }
 
 void UDialogueComponent::PlayCurrentDialogue()
 {
-	if (CurrentDialogueIndex < 0 || CurrentDialogueIndex >= CachedDialogueSequence.Num())
+	BLACKMYTH_SCOPE_CYCLE(STAT_DialoguePlayLine, TEXT("BlackMyth.Dialogue.PlayLine"));
+
+	if (CurrentDialogueIndex < 0 || CurrentDialogueIndex >= DialogueRows.Num())
 	{
 		return;
 	}
 
-	const FDialogueEntry& CurrentDialogue = CachedDialogueSequence[CurrentDialogueIndex];
+	const FDialogueEntry& CurrentDialogue = *DialogueRows[CurrentDialogueIndex];
 
 	// 显示对话UI
 	if (DialogueWidgetInstance)
@@ -188,7 +301,7 @@ void UDialogueComponent::PlayCurrentDialogue()
 		DialogueWidgetInstance->ShowDialogue(
 			CurrentDialogue,
 			CurrentDialogueIndex,
-			CachedDialogueSequence.Num()
+			DialogueRows.Num()
 		);
 	}
 
@@ -199,7 +312,7 @@ void UDialogueComponent::PlayCurrentDialogue()
 	if (!CurrentDialogue.EventTag.IsEmpty())
 	{
 		OnDialogueEvent.Broadcast(CurrentDialogue.EventTag);
-		UE_LOG(LogTemp, Log, TEXT("Dialogue Event Triggered: %s"), *CurrentDialogue.EventTag);
+		UE_LOG(LogBMDialogue, Log, TEXT("Dialogue Event Triggered: %s"), *CurrentDialogue.EventTag);
 	}
 
 	// 处理镜头切换逻辑
@@ -225,10 +338,10 @@ void UDialogueComponent::PlayCurrentDialogue()
 			else
 			{
 				// 特殊处理：如果 tag 是 XiaoTian 且地图里有哮天犬
-				UGameplayStatics::GetAllActorsOfClass(GetWorld(), AXiaoTian::StaticClass(), FoundActors);
-				if (FoundActors.Num() > 0)
+				UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this);
+				if (AActor* Dog = Registry ? Registry->FindFirstSummonOfClass(AXiaoTian::StaticClass()) : nullptr)
 				{
-					CameraActor = FoundActors[0];
+					CameraActor = Dog;
 				}
 			}
 		}
@@ -236,7 +349,7 @@ void UDialogueComponent::PlayCurrentDialogue()
 		if (CameraActor)
 		{
 			OnCameraTargetChanged.Broadcast(CameraActor);
-			UE_LOG(LogTemp, Log, TEXT("Dialogue Camera Target Changed to: %s"), *CameraActor->GetName());
+			UE_LOG(LogBMDialogue, Verbose, TEXT("Dialogue Camera Target Changed to: %s"), *CameraActor->GetName());
 		}
 	}
 
@@ -252,13 +365,52 @@ void UDialogueComponent::PlayCurrentDialogue()
 		);
 	}
 
+	// 语音和蒙太奇（软引用，未就绪时等待加载），并流送后续几句
+	PlayLineAssets();
+	StreamAhead();
+
+	UE_LOG(LogBMDialogue, Verbose, TEXT("DialogueComponent: [%d/%d] %s: %s"), 
+		CurrentDialogueIndex + 1, 
+		DialogueRows.Num(),
+		*CurrentDialogue.SpeakerName.ToString(),
+		*CurrentDialogue.DialogueText.ToString());
+}
+
+void UDialogueComponent::AutoPlayNextDialogue()
+{
+	NextDialogue();
+}
+
+void UDialogueComponent::PlayLineAssets()
+{
+	if (CurrentLineHandle.IsValid())
+	{
+		CurrentLineHandle->CancelHandle();
+		CurrentLineHandle.Reset();
+	}
+
+	const FDialogueEntry& CurrentDialogue = *DialogueRows[CurrentDialogueIndex];
+
+	// 玩家跳过太快、预取尚未完成时，以高优先级加载本句，完成后再播放
+	if (!CurrentDialogue.AreAssetsLoaded())
+	{
+		CurrentLineHandle = RequestLineAssets(CurrentDialogueIndex, 1, FStreamableManager::AsyncLoadHighPriority,
+			FStreamableDelegate::CreateUObject(this, &UDialogueComponent::OnLineAssetsLoaded, CurrentDialogueIndex));
+		return;
+	}
+
+	PlayLoadedLineAssets(CurrentDialogue);
+}
+
+void UDialogueComponent::PlayLoadedLineAssets(const FDialogueEntry& CurrentDialogue)
+{
 	// [New] 播放语音/音效
-	if (CurrentDialogue.VoiceSound)
+	if (USoundBase* VoiceSound = CurrentDialogue.VoiceSound.Get())
 	{
 		if (CurrentDialogue.bPlaySound2D)
 		{
 			// 作为 2D 声音播放（无视距离，声音清晰）
-			UGameplayStatics::PlaySound2D(this, CurrentDialogue.VoiceSound, CurrentDialogue.SoundVolumeMultiplier);
+			UGameplayStatics::PlaySound2D(this, VoiceSound, CurrentDialogue.SoundVolumeMultiplier);
 		}
 		else
 		{
@@ -266,13 +418,13 @@ void UDialogueComponent::PlayCurrentDialogue()
 			AActor* SoundLocationActor = AlternativeSpeaker.Get() ? AlternativeSpeaker.Get() : GetOwner();
 			if (SoundLocationActor)
 			{
-				UGameplayStatics::PlaySoundAtLocation(this, CurrentDialogue.VoiceSound, SoundLocationActor->GetActorLocation(), CurrentDialogue.SoundVolumeMultiplier);
+				UGameplayStatics::PlaySoundAtLocation(this, VoiceSound, SoundLocationActor->GetActorLocation(), CurrentDialogue.SoundVolumeMultiplier);
 			}
 		}
 	}
 
 	// 播放动画蒙太奇 (如果指定了备选说话人，或者拥有者是角色)
-	if (CurrentDialogue.DialogueMontage)
+	if (UAnimMontage* DialogueMontage = CurrentDialogue.DialogueMontage.Get())
 	{
 		AActor* AnimTargetActor = AlternativeSpeaker.Get() ? AlternativeSpeaker.Get() : GetOwner();
 		if (ACharacter* TargetChar = Cast<ACharacter>(AnimTargetActor))
@@ -283,18 +435,21 @@ void UDialogueComponent::PlayCurrentDialogue()
 				MoveComp->SetDefaultMovementMode(); // 刷新状态
 			}
 			
-			TargetChar->PlayAnimMontage(CurrentDialogue.DialogueMontage);
+			TargetChar->PlayAnimMontage(DialogueMontage);
 		}
 	}
-
-	UE_LOG(LogTemp, Log, TEXT("DialogueComponent: [%d/%d] %s: %s"), 
-		CurrentDialogueIndex + 1, 
-		CachedDialogueSequence.Num(),
-		*CurrentDialogue.SpeakerName.ToString(),
-		*CurrentDialogue.DialogueText.ToString());
 }
 
-void UDialogueComponent::AutoPlayNextDialogue()
+void UDialogueComponent::OnLineAssetsLoaded(int32 LineIndex)
 {
-	NextDialogue();
+	CurrentLineHandle.Reset();
+
+	// 加载期间已切到下一句或对话已结束，不再补播
+	if (!bIsPlaying || LineIndex != CurrentDialogueIndex || !DialogueRows.IsValidIndex(LineIndex))
+	{
+		return;
+	}
+
+	// 加载失败的资源 Get() 为空，直接跳过，不再重试
+	PlayLoadedLineAssets(*DialogueRows[LineIndex]);
 }
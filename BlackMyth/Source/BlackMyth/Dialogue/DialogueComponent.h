@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "DialogueData.h"
+#include "Engine/StreamableManager.h"
 #include "DialogueComponent.generated.h"
 
 class APlayerController;
@@ -27,6 +28,8 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCameraTargetChanged, AActor*, New
  * - 挂载在NPC身上
  * - 支持DataTable(CSV)导入对话数据
  * - 保持玩家原视角，不做相机切换
+ * - 语音和蒙太奇为软引用：玩家进入交互范围时预取前几句，播放时向后流送，
+ *   对话结束、玩家离开后释放
  */
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class BLACKMYTH_API UDialogueComponent : public UActorComponent
@@ -50,6 +53,14 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|UI")
 	TSubclassOf<UDialogueWidget> DialogueWidgetClass;
 
+	// 玩家进入交互范围时预取的句数
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Streaming", meta = (ClampMin = "0"))
+	int32 PrefetchLineCount = 3;
+
+	// 播放时提前流送的句数（不含当前句）
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue|Streaming", meta = (ClampMin = "0"))
+	int32 StreamAheadLineCount = 2;
+
 	// [New] 备选说话人（如果组件挂在触发器上，可以指定Boss为说话人来播放动画）
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
 	TObjectPtr<AActor> AlternativeSpeaker;
@@ -82,15 +93,40 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
 	bool IsDialoguePlaying() const { return bIsPlaying; }
 
+	/** 异步预取前 PrefetchLineCount 句的语音和蒙太奇（玩家进入交互范围时调用） */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Streaming")
+	void PrefetchDialogue();
+
+	/** 释放预取的资源（玩家离开交互范围时调用，对话进行中不影响播放） */
+	UFUNCTION(BlueprintCallable, Category = "Dialogue|Streaming")
+	void ReleasePrefetchedDialogue();
+
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
 	int32 GetCurrentDialogueIndex() const { return CurrentDialogueIndex; }
 
 	UFUNCTION(BlueprintPure, Category = "Dialogue")
-	int32 GetTotalDialogueCount() const { return CachedDialogueSequence.Num(); }
+	int32 GetTotalDialogueCount() const { return DialogueRows.Num(); }
 
 protected:
-	// 加载对话数据（从DataTable或手动配置）
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// 收集对话行（从DataTable或手动配置，只记录行指针）
 	void LoadDialogueData();
+
+	// 异步加载 [FirstIndex, FirstIndex + Count) 范围内各句的资源
+	TSharedPtr<FStreamableHandle> RequestLineAssets(int32 FirstIndex, int32 Count, TAsyncLoadPriority Priority, FStreamableDelegate OnLoaded = FStreamableDelegate());
+
+	// 流送当前句之后的几句
+	void StreamAhead();
+
+	// 播放当前句的语音和蒙太奇（资源未就绪时等加载完成再播）
+	void PlayLineAssets();
+
+	// 播放本句已加载的语音和蒙太奇
+	void PlayLoadedLineAssets(const FDialogueEntry& CurrentDialogue);
+
+	// 当前句资源加载完成
+	void OnLineAssetsLoaded(int32 LineIndex);
 	
 	// 播放当前对话
 	void PlayCurrentDialogue();
@@ -102,9 +138,17 @@ protected:
 	bool bIsPlaying;
 	int32 CurrentDialogueIndex;
 
-	// 缓存的对话序列（从DataTable或手动配置加载）
-	UPROPERTY()
-	TArray<FDialogueEntry> CachedDialogueSequence;
+	// 对话行（指向 DataTable 的行或 ManualDialogueSequence 的元素，不复制；二者由 DialogueConfig 持有）
+	TArray<const FDialogueEntry*> DialogueRows;
+
+	// 交互范围内预取的前几句
+	TSharedPtr<FStreamableHandle> PrefetchHandle;
+
+	// 播放中提前流送的后续几句
+	TSharedPtr<FStreamableHandle> StreamAheadHandle;
+
+	// 当前句资源未就绪时的加载请求
+	TSharedPtr<FStreamableHandle> CurrentLineHandle;
 
 	UPROPERTY()
 	APlayerController* PlayerController;
@@ -6,6 +6,9 @@
 #include "Engine/DataTable.h"
 #include "DialogueData.generated.h"
 
+class USoundBase;
+class UAnimMontage;
+
 /**
  * 单条对话数据
  * 支持从CSV导入（通过DataTable）
@@ -44,13 +47,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
 	FText DialogueText;
 
-	// [New] 语音/音效
+	// [New] 语音/音效（软引用，由 UDialogueComponent 在玩家靠近时预取、播放时提前流送）
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
-	TObjectPtr<USoundBase> VoiceSound;
+	TSoftObjectPtr<USoundBase> VoiceSound;
 
-	// [New] 动画蒙太奇 (通常由说话人播放)
+	// [New] 动画蒙太奇 (通常由说话人播放，软引用同上)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
-	TObjectPtr<UAnimMontage> DialogueMontage;
+	TSoftObjectPtr<UAnimMontage> DialogueMontage;
 
 	// [New] 音量倍率 (1.0 为原始音量)
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Dialogue")
@@ -83,6 +86,26 @@ public:
 		, DisplayDuration(0.0f)
 	{
 	}
+
+	/** 追加本句需要加载的资源路径（未配置的跳过） */
+	void AppendAssetPaths(TArray<FSoftObjectPath>& OutPaths) const
+	{
+		if (!VoiceSound.IsNull())
+		{
+			OutPaths.AddUnique(VoiceSound.ToSoftObjectPath());
+		}
+		if (!DialogueMontage.IsNull())
+		{
+			OutPaths.AddUnique(DialogueMontage.ToSoftObjectPath());
+		}
+	}
+
+	/** 本句配置的资源是否都已在内存中 */
+	bool AreAssetsLoaded() const
+	{
+		return (VoiceSound.IsNull() || VoiceSound.IsValid())
+			&& (DialogueMontage.IsNull() || DialogueMontage.IsValid());
+	}
 };
 
 /**
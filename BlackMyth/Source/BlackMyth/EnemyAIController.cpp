@@ -4,18 +4,25 @@
 #include "EnemyBase.h"
 #include "BossEnemy.h"
 #include "WukongCharacter.h"
-#include "WukongClone.h"
 #include "BehaviorTree/BehaviorTree.h"
 #include "BehaviorTree/BlackboardComponent.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Bool.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Object.h"
+#include "BehaviorTree/Blackboard/BlackboardKeyType_Vector.h"
 #include "Perception/AIPerceptionComponent.h"
 #include "Perception/AISenseConfig_Sight.h"
 #include "Perception/AISense_Sight.h"
 #include "Components/TeamComponent.h"
 #include "Components/HealthComponent.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "Combat/CombatActorInterface.h"
+#include "BlackMythLog.h"
 
 AEnemyAIController::AEnemyAIController()
 {
+	// 只在黑板上有目标时 Tick（见 WatchTarget）
 	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
 
 	// 初始化感知组件
 	AIPerceptionComponent = CreateDefaultSubobject<UAIPerceptionComponent>(TEXT("AIPerceptionComponent"));
@@ -44,7 +51,7 @@ void AEnemyAIController::OnPossess(APawn* InPawn)
 	// 绑定感知更新事件
 	if (AIPerceptionComponent)
 	{
-		AIPerceptionComponent->OnPerceptionUpdated.AddDynamic(this, &AEnemyAIController::OnPerceptionUpdated);
+		AIPerceptionComponent->OnPerceptionUpdated.AddUniqueDynamic(this, &AEnemyAIController::OnPerceptionUpdated);
 	}
 
 	// 如果有行为树，优先运行行为树
@@ -55,93 +62,148 @@ void AEnemyAIController::OnPossess(APawn* InPawn)
 			RunBehaviorTree(Enemy->GetBehaviorTree());
 		}
 	}
+
+	CacheBlackboardKeys(GetBlackboardComponent());
 }
 
-void AEnemyAIController::Tick(float DeltaTime)
+void AEnemyAIController::OnUnPossess()
 {
-	Super::Tick(DeltaTime);
-	
-	// 如果有目标，平滑旋转朝向目标
 	if (UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
 	{
-		if (AActor* Target = Cast<AActor>(BlackboardComp->GetValueAsObject(TEXT("TargetActor"))))
+		BlackboardComp->UnregisterObserversFrom(this);
+	}
+	WatchTarget(nullptr);
+
+	Super::OnUnPossess();
+}
+
+void AEnemyAIController::CacheBlackboardKeys(UBlackboardComponent* BlackboardComp)
+{
+	if (!BlackboardComp)
+	{
+		return;
+	}
+
+	TargetActorKeyID = BlackboardComp->GetKeyID(TEXT("TargetActor"));
+	TargetLocationKeyID = BlackboardComp->GetKeyID(TEXT("TargetLocation"));
+	IsInvestigatingKeyID = BlackboardComp->GetKeyID(TEXT("IsInvestigating"));
+
+	if (TargetActorKeyID != FBlackboard::InvalidKey)
+	{
+		// EnemyBase、Boss 等处也会直接写 TargetActor，统一在观察回调里处理
+		BlackboardComp->RegisterObserver(TargetActorKeyID, this,
+			FOnBlackboardChangeNotification::CreateUObject(this, &AEnemyAIController::OnTargetKeyChanged));
+		WatchTarget(Cast<AActor>(BlackboardComp->GetValue<UBlackboardKeyType_Object>(TargetActorKeyID)));
+	}
+}
+
+EBlackboardNotificationResult AEnemyAIController::OnTargetKeyChanged(const UBlackboardComponent& BlackboardComp, FBlackboard::FKey ChangedKeyID)
+{
+	WatchTarget(Cast<AActor>(BlackboardComp.GetValue<UBlackboardKeyType_Object>(ChangedKeyID)));
+	return EBlackboardNotificationResult::ContinueObserving;
+}
+
+void AEnemyAIController::WatchTarget(AActor* NewTarget)
+{
+	if (WatchedTarget.Get() != NewTarget)
+	{
+		if (UHealthComponent* OldHealth = WatchedHealth.Get())
 		{
-			// 检查目标是否已经死亡（玩家或分身）
-			bool bTargetIsDead = false;
-			
-			if (AWukongCharacter* WukongTarget = Cast<AWukongCharacter>(Target))
-			{
-				bTargetIsDead = WukongTarget->IsDead();
-			}
-			else if (AWukongClone* CloneTarget = Cast<AWukongClone>(Target))
-			{
-				// 检查分身是否有效（可能已被销毁或生命值归零）
-				if (UHealthComponent* CloneHealth = CloneTarget->FindComponentByClass<UHealthComponent>())
-				{
-					bTargetIsDead = CloneHealth->IsDead();
-				}
-			}
-			
-			if (bTargetIsDead)
-			{
-				// 目标已死亡，清除目标并尝试寻找新目标
-				BlackboardComp->ClearValue(TEXT("TargetActor"));
-				BlackboardComp->SetValueAsBool(TEXT("IsInvestigating"), false);
-				
-				// 尝试寻找新的敌对目标
-				AActor* NewTarget = FindNearestHostileTarget();
-				if (NewTarget)
-				{
-					BlackboardComp->SetValueAsObject(TEXT("TargetActor"), NewTarget);
-					UE_LOG(LogTemp, Log, TEXT("Tick: Previous target dead, switching to new target"));
-				}
-				else
-				{
-					if (AEnemyBase* Enemy = Cast<AEnemyBase>(GetPawn()))
-					{
-						Enemy->StartPatrolling();
-					}
-					UE_LOG(LogTemp, Log, TEXT("Tick: Target is dead, no other targets, returning to patrol"));
-				}
-				return;
-			}
+			OldHealth->OnDeath.RemoveDynamic(this, &AEnemyAIController::HandleTargetDeath);
+		}
 
-			if (APawn* ControlledPawn = GetPawn())
-			{
-				// 修复：如果控制的 Pawn 已经死亡、眩晕或定身，不再执行旋转逻辑
-				if (AEnemyBase* Enemy = Cast<AEnemyBase>(ControlledPawn))
-				{
-					if (Enemy->IsDead() || Enemy->IsStunned() || Enemy->IsFrozen()) return;
-				}
+		WatchedTarget = NewTarget;
+		WatchedHealth = ICombatActor::GetHealth(NewTarget);
 
-				FVector Direction = Target->GetActorLocation() - ControlledPawn->GetActorLocation();
-				Direction.Z = 0.0f; // 忽略高度差
-				
-				if (!Direction.IsNearlyZero())
-				{
-					FRotator TargetRotation = Direction.Rotation();
-					// 使用 RInterpTo 进行平滑插值，速度设为 5.0f (可调整)
-					FRotator NewRotation = FMath::RInterpTo(ControlledPawn->GetActorRotation(), TargetRotation, DeltaTime, 5.0f);
-					ControlledPawn->SetActorRotation(NewRotation);
-				}
-			}
+		if (UHealthComponent* NewHealth = WatchedHealth.Get())
+		{
+			NewHealth->OnDeath.AddUniqueDynamic(this, &AEnemyAIController::HandleTargetDeath);
 		}
 	}
+
+	// 没有目标时不需要转向，关闭 Tick
+	SetActorTickEnabled(NewTarget != nullptr);
 }
 
-void AEnemyAIController::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActors)
+void AEnemyAIController::SetTargetActor(AActor* NewTarget)
+{
+	UBlackboardComponent* BlackboardComp = GetBlackboardComponent();
+	if (BlackboardComp && TargetActorKeyID != FBlackboard::InvalidKey)
+	{
+		// 值变化时观察者回调 WatchTarget
+		BlackboardComp->SetValue<UBlackboardKeyType_Object>(TargetActorKeyID, NewTarget);
+	}
+
+	// 没有黑板（或值未变化、观察者未触发）时也要开关转向
+	WatchTarget(NewTarget);
+}
+
+void AEnemyAIController::HandleTargetDeath(AActor* Killer)
+{
+	SwitchToNextTarget();
+}
+
+void AEnemyAIController::SwitchToNextTarget()
 {
-	// 获取黑板组件
 	UBlackboardComponent* BlackboardComp = GetBlackboardComponent();
 	if (!BlackboardComp) return;
 
-	// 获取自身的阵营组件
-	UTeamComponent* MyTeamComp = nullptr;
-	if (APawn* MyPawn = GetPawn())
+	// 清除目标并尝试寻找新的敌对目标
+	BlackboardComp->ClearValue(TargetActorKeyID);
+	BlackboardComp->SetValue<UBlackboardKeyType_Bool>(IsInvestigatingKeyID, false);
+	GetWorldTimerManager().ClearTimer(LoseAggroTimer);
+
+	if (AActor* NewTarget = FindNearestHostileTarget())
+	{
+		BlackboardComp->SetValue<UBlackboardKeyType_Object>(TargetActorKeyID, NewTarget);
+		UE_LOG(LogBMAI, Log, TEXT("SwitchToNextTarget: Previous target dead, switching to %s"), *NewTarget->GetName());
+	}
+	else
+	{
+		if (AEnemyBase* Enemy = Cast<AEnemyBase>(GetPawn()))
+		{
+			Enemy->StartPatrolling();
+		}
+		UE_LOG(LogBMAI, Log, TEXT("SwitchToNextTarget: Target is dead, no other targets, returning to patrol"));
+	}
+}
+
+void AEnemyAIController::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AActor* Target = WatchedTarget.Get();
+	AEnemyBase* Enemy = Cast<AEnemyBase>(GetPawn());
+	if (!Target || !Enemy)
 	{
-		MyTeamComp = MyPawn->FindComponentByClass<UTeamComponent>();
+		SetActorTickEnabled(false);
+		return;
+	}
+
+	// 自身已死亡（或已回收到对象池）时放下目标，Tick 随之关闭
+	if (Enemy->IsDead())
+	{
+		if (UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
+		{
+			BlackboardComp->ClearValue(TargetActorKeyID);
+		}
+		return;
 	}
 
+	// 转向目标（唯一的转向路径，条件判断在 EnemyBase 中）
+	Enemy->UpdateFacing(Target, DeltaTime);
+}
+
+void AEnemyAIController::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActors)
+{
+	// 获取黑板组件
+	UBlackboardComponent* BlackboardComp = GetBlackboardComponent();
+	if (!BlackboardComp) return;
+
+	// 获取自身的阵营
+	ETeam MyTeam = ETeam::Neutral;
+	const bool bHasTeam = UTeamComponent::TryGetActorTeam(GetPawn(), MyTeam);
+
 	for (AActor* Actor : UpdatedActors)
 	{
 		FActorPerceptionBlueprintInfo Info;
@@ -155,10 +217,11 @@ void AEnemyAIController::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActor
 					// 使用阵营组件判断是否是敌对目标
 					bool bIsHostile = false;
 					
-					if (MyTeamComp)
+					if (bHasTeam)
 					{
-						// 使用阵营组件判断敌对关系
-						bIsHostile = MyTeamComp->IsHostileToActor(Actor);
+						// 查阵营敌对表判断敌对关系
+						ETeam OtherTeam;
+						bIsHostile = UTeamComponent::TryGetActorTeam(Actor, OtherTeam) && TeamHostility::AreHostile(MyTeam, OtherTeam);
 					}
 					else
 					{
@@ -170,47 +233,26 @@ void AEnemyAIController::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActor
 					if (bIsHostile)
 					{
 						// 检查目标是否已经死亡或处于变身状态
-						bool bTargetIsDead = false;
-						bool bTargetIsTransformed = false;
-						
-						if (AWukongCharacter* WukongChar = Cast<AWukongCharacter>(Actor))
-						{
-							bTargetIsDead = WukongChar->IsDead();
-							bTargetIsTransformed = WukongChar->IsTransformed();
-						}
-						else if (AWukongClone* CloneActor = Cast<AWukongClone>(Actor))
-						{
-							if (UHealthComponent* CloneHealth = CloneActor->FindComponentByClass<UHealthComponent>())
-							{
-								bTargetIsDead = CloneHealth->IsDead();
-							}
-						}
+						const UHealthComponent* TargetHealth = ICombatActor::GetHealth(Actor);
+						const bool bTargetIsDead = TargetHealth && TargetHealth->IsDead();
+
+						const AWukongCharacter* WukongChar = Cast<AWukongCharacter>(Actor);
+						const bool bTargetIsTransformed = WukongChar && WukongChar->IsTransformed();
 						
 						// 如果目标处于变身状态，完全忽略
 						if (bTargetIsTransformed)
 						{
-							UE_LOG(LogTemp, Log, TEXT("OnPerceptionUpdated: Ignoring transformed Wukong"));
+							UE_LOG(LogBMAI, Verbose, TEXT("OnPerceptionUpdated: Ignoring transformed Wukong"));
 							continue;
 						}
 						
 						if (bTargetIsDead)
 						{
-							// 目标已死亡，清除目标并尝试找新目标
-							BlackboardComp->ClearValue(TEXT("TargetActor"));
-							BlackboardComp->SetValueAsBool(TEXT("IsInvestigating"), false);
-							GetWorldTimerManager().ClearTimer(LoseAggroTimer);
-							
-							// 尝试寻找新的敌对目标
-							AActor* NewTarget = FindNearestHostileTarget();
-							if (NewTarget)
-							{
-								BlackboardComp->SetValueAsObject(TEXT("TargetActor"), NewTarget);
-							}
-							else if (AEnemyBase* Enemy = Cast<AEnemyBase>(GetPawn()))
+							// 只有当前目标死亡才需要切换（通常已由 OnDeath 处理过）
+							if (Actor == WatchedTarget.Get())
 							{
-								Enemy->StartPatrolling();
+								SwitchToNextTarget();
 							}
-							UE_LOG(LogTemp, Log, TEXT("OnPerceptionUpdated: Target is dead, switching target or patrolling"));
 							continue;
 						}
 
@@ -220,7 +262,7 @@ void AEnemyAIController::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActor
 							GetWorldTimerManager().ClearTimer(LoseAggroTimer);
 
 							// 更新黑板
-							BlackboardComp->SetValueAsObject(TEXT("TargetActor"), Actor);
+							BlackboardComp->SetValue<UBlackboardKeyType_Object>(TargetActorKeyID, Actor);
 
 							// 通知 EnemyBase 播放发现动画
 							if (AEnemyBase* Enemy = Cast<AEnemyBase>(GetPawn()))
@@ -234,13 +276,13 @@ void AEnemyAIController::OnPerceptionUpdated(const TArray<AActor*>& UpdatedActor
 								Boss->SetBossHealthVisibility(true);
 							}
 							
-							UE_LOG(LogTemp, Log, TEXT("OnPerceptionUpdated: Hostile target sensed: %s"), *Actor->GetName());
+							UE_LOG(LogBMAI, Verbose, TEXT("OnPerceptionUpdated: Hostile target sensed: %s"), *Actor->GetName());
 						}
 						else
 						{
 							// 丢失视野：记录最后位置，进入搜寻模式
-							BlackboardComp->SetValueAsVector(TEXT("TargetLocation"), Stimulus.StimulusLocation);
-							BlackboardComp->SetValueAsBool(TEXT("IsInvestigating"), true);
+							BlackboardComp->SetValue<UBlackboardKeyType_Vector>(TargetLocationKeyID, Stimulus.StimulusLocation);
+							BlackboardComp->SetValue<UBlackboardKeyType_Bool>(IsInvestigatingKeyID, true);
 							
 							// 启动丢失仇恨计时器 (例如 5秒后彻底放弃)
 							GetWorldTimerManager().SetTimer(LoseAggroTimer, this, &AEnemyAIController::HandleLostAggro, 5.0f, false);
@@ -257,69 +299,30 @@ void AEnemyAIController::HandleLostAggro()
 	// 真正丢失仇恨：清除黑板上的目标
 	if (UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
 	{
-		BlackboardComp->ClearValue(TEXT("TargetActor"));
+		BlackboardComp->ClearValue(TargetActorKeyID);
 	}
 
 	if (AEnemyBase* Enemy = Cast<AEnemyBase>(GetPawn()))
 	{
 		// 调用 EnemyBase 的重置逻辑
 		Enemy->StartPatrolling();
-		UE_LOG(LogTemp, Warning, TEXT("AEnemyAIController::HandleLostAggro - Lost aggro (Timer Expired), returning to patrol."));
+		UE_LOG(LogBMAI, Log, TEXT("AEnemyAIController::HandleLostAggro - Lost aggro (Timer Expired), returning to patrol."));
 	}
 }
 
 AActor* AEnemyAIController::FindNearestHostileTarget()
 {
 	APawn* MyPawn = GetPawn();
-	if (!MyPawn) return nullptr;
-	
-	UTeamComponent* MyTeamComp = MyPawn->FindComponentByClass<UTeamComponent>();
-	if (!MyTeamComp) return nullptr;
-	
-	AActor* NearestTarget = nullptr;
-	float NearestDistSq = FLT_MAX;
-	FVector MyLocation = MyPawn->GetActorLocation();
-	
-	// 获取所有被感知到的Actor
-	TArray<AActor*> PerceivedActors;
-	if (AIPerceptionComponent)
-	{
-		AIPerceptionComponent->GetCurrentlyPerceivedActors(nullptr, PerceivedActors);
-	}
-	
-	for (AActor* Actor : PerceivedActors)
+	USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this);
+	if (!MyPawn || !Grid || !AIPerceptionComponent) return nullptr;
+
+	// 与分身共用同一个最近敌对查询，只额外要求目标当前仍被感知到
+	const float SearchRadius = SightConfig ? SightConfig->LoseSightRadius : 2000.0f;
+	return Grid->FindNearestHostile(MyPawn, SearchRadius, [this](AActor* Candidate)
 	{
-		if (!Actor || Actor == MyPawn) continue;
-		
-		// 检查是否是敌对目标
-		if (!MyTeamComp->IsHostileToActor(Actor)) continue;
-		
-		// 检查目标是否已经死亡
-		bool bIsDead = false;
-		if (AWukongCharacter* Wukong = Cast<AWukongCharacter>(Actor))
-		{
-			bIsDead = Wukong->IsDead();
-		}
-		else if (AWukongClone* Clone = Cast<AWukongClone>(Actor))
-		{
-			if (UHealthComponent* Health = Clone->FindComponentByClass<UHealthComponent>())
-			{
-				bIsDead = Health->IsDead();
-			}
-		}
-		
-		if (bIsDead) continue;
-		
-		// 计算距离
-		float DistSq = FVector::DistSquared(MyLocation, Actor->GetActorLocation());
-		if (DistSq < NearestDistSq)
-		{
-			NearestDistSq = DistSq;
-			NearestTarget = Actor;
-		}
-	}
-	
-	return NearestTarget;
+		const FActorPerceptionInfo* Info = AIPerceptionComponent->GetActorInfo(*Candidate);
+		return Info && Info->HasAnyCurrentStimulus();
+	});
 }
 
 
@@ -3,14 +3,20 @@
 #include "CoreMinimal.h"
 #include "AIController.h"
 #include "Perception/AIPerceptionTypes.h"
+#include "BehaviorTree/BehaviorTreeTypes.h"
 #include "EnemyAIController.generated.h"
 
 class UAIPerceptionComponent;
 class UAISenseConfig_Sight;
+class UBlackboardComponent;
+class UHealthComponent;
 
 /**
  * 敌人 AI 控制器
  * 负责控制敌人的感知、移动和攻击逻辑
+ * - 黑板键 ID 在 OnPossess 时解析一次，之后按 ID 读写
+ * - 观察黑板 TargetActor：有目标时才开启 Tick（转向目标），并订阅目标的 OnDeath，
+ *   目标死亡时切换目标或回到巡逻；巡逻中的敌人控制器完全不 Tick
  */
 UCLASS()
 class BLACKMYTH_API AEnemyAIController : public AAIController
@@ -22,10 +28,14 @@ public:
 
 protected:
 	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
 
 public:
 	virtual void Tick(float DeltaTime) override;
 
+	/** 设置黑板目标（使用缓存的键 ID） */
+	void SetTargetActor(AActor* NewTarget);
+
 	/** 感知更新回调 */
 	UFUNCTION()
 	void OnPerceptionUpdated(const TArray<AActor*>& UpdatedActors);
@@ -51,4 +61,30 @@ protected:
 	
 	/** 寻找最近的敌对目标（玩家或玩家的分身） */
 	AActor* FindNearestHostileTarget();
+
+	/** 当前目标死亡：切换到最近的其他敌对目标，没有则回到巡逻 */
+	void SwitchToNextTarget();
+
+private:
+	/** 解析黑板键 ID 并观察 TargetActor */
+	void CacheBlackboardKeys(UBlackboardComponent* BlackboardComp);
+
+	/** 黑板 TargetActor 变化回调 */
+	EBlackboardNotificationResult OnTargetKeyChanged(const UBlackboardComponent& BlackboardComp, FBlackboard::FKey ChangedKeyID);
+
+	/** 改为观察新目标：转移 OnDeath 订阅，按是否有目标开关 Tick */
+	void WatchTarget(AActor* NewTarget);
+
+	/** 被观察目标的死亡回调 */
+	UFUNCTION()
+	void HandleTargetDeath(AActor* Killer);
+
+	/** 黑板键 ID */
+	FBlackboard::FKey TargetActorKeyID = FBlackboard::InvalidKey;
+	FBlackboard::FKey TargetLocationKeyID = FBlackboard::InvalidKey;
+	FBlackboard::FKey IsInvestigatingKeyID = FBlackboard::InvalidKey;
+
+	/** 当前观察的目标及其生命组件（订阅了 OnDeath） */
+	TWeakObjectPtr<AActor> WatchedTarget;
+	TWeakObjectPtr<UHealthComponent> WatchedHealth;
 };
@@ -2,6 +2,7 @@
 #include "BlackMythSaveGame.h"
 #include "WukongCharacter.h"
 #include "Components/CapsuleComponent.h"
+#include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "EnemyAIController.h"
 #include "Kismet/GameplayStatics.h"
@@ -18,8 +19,9 @@
 #include "Components/StatusEffectComponent.h"
 #include "StatusEffect/StatusEffectBase.h"
 #include "Combat/TraceHitboxComponent.h"
-#include "Components/WidgetComponent.h"
+#include "Combat/AreaEffectSubsystem.h"
 #include "UI/EnemyHealthBarWidget.h"
+#include "UI/EnemyOverlaySubsystem.h"
 #include "Engine/SkeletalMesh.h"
 #include "Animation/Skeleton.h"
 #include "Animation/AnimInstance.h"
@@ -28,11 +30,23 @@
 #include "Blueprint/UserWidget.h"
 #include "GameFramework/GameStateBase.h"
 #include "Items/GoldPickup.h"
+#include "Items/GoldPickupSubsystem.h"
+#include "Subsystems/ActorRegistrySubsystem.h"
+#include "Subsystems/ActorPoolSubsystem.h"
+#include "EnemySpawner.h"
+#include "BlackMythStats.h"
+#include "BlackMythLog.h"
+
+DECLARE_CYCLE_STAT(TEXT("Enemy Tick"), STAT_EnemyTick, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Ticked"), STAT_EnemiesTicked, STATGROUP_BlackMyth);
 
 AEnemyBase::AEnemyBase()
 {
 	PrimaryActorTick.bCanEverTick = true;
 
+	// 头文件只前向声明了该枚举，默认值在这里设置（BeginPlay 时改为网格的实际设置）
+	DefaultVisibilityBasedAnimTickOption = EVisibilityBasedAnimTickOption::AlwaysTickPoseAndRefreshBones;
+
 	// 创建组件
 	HealthComponent = CreateDefaultSubobject<UHealthComponent>(TEXT("HealthComponent"));
 	CombatComponent = CreateDefaultSubobject<UCombatComponent>(TEXT("CombatComponent"));
@@ -53,6 +67,9 @@ AEnemyBase::AEnemyBase()
 	// 创建状态效果组件（管理中毒、减速等状态）
 	StatusEffectComponent = CreateDefaultSubobject<UStatusEffectComponent>(TEXT("StatusEffectComponent"));
 
+	// 登记战斗组件，命中检测等热路径直接读取
+	SetCombatComponents(HealthComponent, TeamComponent, StatusEffectComponent, CombatComponent);
+
 	// 设置默认 AI 控制器
 	AIControllerClass = AEnemyAIController::StaticClass();
 	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
@@ -71,23 +88,7 @@ AEnemyBase::AEnemyBase()
 	// 默认攻击范围 (稍微加大一点，避免贴得太近)
 	AttackRadius = 200.0f;
 
-	// ========== 新增：创建血条组件 ==========
-	HealthBarWidgetComponent = CreateDefaultSubobject<UWidgetComponent>(TEXT("HealthBarWidget"));
-	HealthBarWidgetComponent->SetupAttachment(GetRootComponent());
-	HealthBarWidgetComponent->SetRelativeLocation(FVector(0.0f, 0.0f, 120.0f));  // 头顶上方
-	HealthBarWidgetComponent->SetWidgetSpace(EWidgetSpace::Screen);  // 屏幕空间，始终面向摄像机
-	HealthBarWidgetComponent->SetDrawSize(FVector2D(150.0f, 20.0f));
-	HealthBarWidgetComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	HealthBarWidgetComponent->SetVisibility(false);  // 默认隐藏
-
-	// ========== 新增：创建定身"定"字 Widget 组件 ==========
-	FreezeTextWidgetComponent = CreateDefaultSubobject<UWidgetComponent>(TEXT("FreezeTextWidget"));
-	FreezeTextWidgetComponent->SetupAttachment(GetRootComponent());
-	FreezeTextWidgetComponent->SetRelativeLocation(FVector(0.0f, 0.0f, 180.0f));  // 头顶上方（比血条更高）
-	FreezeTextWidgetComponent->SetWidgetSpace(EWidgetSpace::Screen);  // 屏幕空间，始终面向摄像机
-	FreezeTextWidgetComponent->SetDrawSize(FVector2D(100.0f, 100.0f));
-	FreezeTextWidgetComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	FreezeTextWidgetComponent->SetVisibility(false);  // 默认隐藏
+	// 头顶血条和定身"定"字不再使用 Widget 组件，由 UEnemyOverlaySubsystem 统一绘制
 
 	// ========== 加载定身术默认资产 ==========
 	// 默认"定"字 Widget 类（路径需要在创建蓝图后设置）
@@ -120,56 +121,37 @@ void AEnemyBase::BeginPlay()
 	if (HealthComponent)
 	{
 		HealthComponent->OnDeath.AddDynamic(this, &AEnemyBase::HandleDeath);
+		HealthComponent->OnHealthChanged.AddDynamic(this, &AEnemyBase::HandleHealthChanged);
 	}
 
-	// 调试日志：检查蒙太奇是否正确加载
-	if (AttackMontage)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("AEnemyBase::BeginPlay - AttackMontage is SET: %s"), *AttackMontage->GetName());
-	}
-	else
-	{
-		UE_LOG(LogTemp, Error, TEXT("AEnemyBase::BeginPlay - AttackMontage is NULL! Please check Blueprint assignment."));
-	}
-
-	if (AggroMontage)
+	// 蒙太奇未配置是蓝图错误，保留警告；其余初始化信息只在 Verbose 下输出
+	if (!AttackMontage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AEnemyBase::BeginPlay - AggroMontage is SET: %s"), *AggroMontage->GetName());
+		UE_LOG(LogBMAI, Error, TEXT("[%s] AEnemyBase::BeginPlay - AttackMontage is NULL! Please check Blueprint assignment."), *GetName());
 	}
 
 	// 强制应用巡逻速度，确保蓝图配置生效
 	GetCharacterMovement()->MaxWalkSpeed = PatrollingSpeed;
 
-	// 统计场景中的敌人数量
-	TArray<AActor*> AllEnemies;
-	UGameplayStatics::GetAllActorsOfClass(this, AEnemyBase::StaticClass(), AllEnemies);
-	UE_LOG(LogTemp, Warning, TEXT("AEnemyBase::BeginPlay - Total Enemies: %d. I am: %s. AttackRadius: %f"), AllEnemies.Num(), *GetName(), AttackRadius);
+	// 注册到敌人列表，并统计场景中的敌人数量
+	int32 TotalEnemies = 0;
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterEnemy(this);
+		TotalEnemies = Registry->GetNumEnemies();
+	}
+	UE_LOG(LogBMAI, Verbose, TEXT("AEnemyBase::BeginPlay - Total Enemies: %d. I am: %s. AttackRadius: %f"), TotalEnemies, *GetName(), AttackRadius);
 
 	// 初始化状态
 	StartPatrolling();
 	bHasAggroed = false;
 
 	// ========== 新增：初始化血条 ==========
-	if (HealthBarWidgetComponent && HealthBarWidgetClass)
+	if (UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this))
 	{
-		HealthBarWidgetComponent->SetWidgetClass(HealthBarWidgetClass);
-		HealthBarWidgetComponent->SetRelativeLocation(FVector(0.0f, 0.0f, HealthBarHeightOffset));
-
-		// 强制初始化 Widget (确保 GetWidget() 返回有效实例)
-		HealthBarWidgetComponent->InitWidget();
-
-		// 获取 Widget 实例并初始化
-		HealthBarWidget = Cast<UEnemyHealthBarWidget>(HealthBarWidgetComponent->GetWidget());
-		if (HealthBarWidget && HealthComponent)
-		{
-			HealthBarWidget->InitializeHealthBar(HealthComponent);
-			UE_LOG(LogTemp, Warning, TEXT("[%s] HealthBar Widget initialized successfully"), *GetName());
-		}
-		else
-		{
-			UE_LOG(LogTemp, Error, TEXT("[%s] Failed to get HealthBar Widget instance!"), *GetName());
-		}
+		Overlay->ProvideWidgetClasses(HealthBarWidgetClass, AlertComponent ? AlertComponent->GetAlertIconWidgetClass() : nullptr, FreezeTextWidgetClass);
 	}
+	RegisterHealthBar();
 
 	// ========== 新增：生成武器 ==========
 	if (WeaponClass)
@@ -184,7 +166,7 @@ void AEnemyBase::BeginPlay()
 		{
 			// 附加到插槽
 			CurrentWeapon->AttachToComponent(GetMesh(), FAttachmentTransformRules::SnapToTargetIncludingScale, WeaponSocketName);
-			UE_LOG(LogTemp, Warning, TEXT("[%s] Spawned Weapon: %s attached to %s"), *GetName(), *CurrentWeapon->GetName(), *WeaponSocketName.ToString());
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] Spawned Weapon: %s attached to %s"), *GetName(), *CurrentWeapon->GetName(), *WeaponSocketName.ToString());
 
 			// 关键修复：让武器忽略持有者的碰撞，防止被弹飞
 			// 遍历武器的所有 PrimitiveComponent (如 CollisionSphere, StaticMesh 等)
@@ -213,11 +195,11 @@ void AEnemyBase::BeginPlay()
 			if (WeaponMesh && TraceHitboxComponent)
 			{
 				TraceHitboxComponent->SetMeshToTrace(WeaponMesh);
-				UE_LOG(LogTemp, Log, TEXT("[%s] Updated TraceHitbox to use Weapon Mesh: %s"), *GetName(), *WeaponMesh->GetName());
+				UE_LOG(LogBMAI, Verbose, TEXT("[%s] Updated TraceHitbox to use Weapon Mesh: %s"), *GetName(), *WeaponMesh->GetName());
 			}
 			else
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[%s] Weapon spawned but no Mesh found for Hitbox!"), *GetName());
+				UE_LOG(LogBMAI, Warning, TEXT("[%s] Weapon spawned but no Mesh found for Hitbox!"), *GetName());
 			}
 		}
 	}
@@ -234,7 +216,7 @@ void AEnemyBase::BeginPlay()
 			if (GetMesh()->DoesSocketExist(Name) || GetMesh()->GetBoneIndex(Name) != INDEX_NONE)
 			{
 				TraceHitboxComponent->SetStartSocket(Name);
-				UE_LOG(LogTemp, Warning, TEXT("AEnemyBase::BeginPlay - Auto-configured StartSocket: %s"), *Name.ToString());
+				UE_LOG(LogBMAI, Verbose, TEXT("AEnemyBase::BeginPlay - Auto-configured StartSocket: %s"), *Name.ToString());
 				break;
 			}
 		}
@@ -244,7 +226,7 @@ void AEnemyBase::BeginPlay()
 			if (GetMesh()->DoesSocketExist(Name) || GetMesh()->GetBoneIndex(Name) != INDEX_NONE)
 			{
 				TraceHitboxComponent->SetEndSocket(Name);
-				UE_LOG(LogTemp, Warning, TEXT("AEnemyBase::BeginPlay - Auto-configured EndSocket: %s"), *Name.ToString());
+				UE_LOG(LogBMAI, Verbose, TEXT("AEnemyBase::BeginPlay - Auto-configured EndSocket: %s"), *Name.ToString());
 				break;
 			}
 		}
@@ -263,10 +245,145 @@ void AEnemyBase::BeginPlay()
 	// 初始化韧性
 	CurrentPoise = MaxPoise;
 	LastHitTime = -100.0; // 确保一开始就能恢复
+
+	// 记录网格的动画更新设置，降频后回到全帧率时恢复
+	if (USkeletalMeshComponent* MeshComp = GetMesh())
+	{
+		bDefaultMeshUpdateRateOptimizations = MeshComp->bEnableUpdateRateOptimizations;
+		DefaultVisibilityBasedAnimTickOption = MeshComp->VisibilityBasedAnimTickOption;
+	}
+
+	// 预热金币掉落物对象池
+	if (UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this))
+	{
+		Pool->Prewarm(GoldPickupClass, GoldPickupPoolSize);
+	}
+}
+
+void AEnemyBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterEnemy(this);
+	}
+
+	if (UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this))
+	{
+		Overlay->UnregisterEnemy(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AEnemyBase::OnAcquiredFromPool()
+{
+	// 生命值、阵营和空间网格由各自组件的 IPoolable 回调恢复
+	const AEnemyBase* Defaults = GetClass()->GetDefaultObject<AEnemyBase>();
+
+	// 撤销 Die() 中的碰撞、移动和动画冻结
+	GetCapsuleComponent()->SetCollisionEnabled(Defaults->GetCapsuleComponent()->GetCollisionEnabled());
+	GetMesh()->SetCollisionEnabled(Defaults->GetMesh()->GetCollisionEnabled());
+	GetMesh()->bPauseAnims = false;
+	GetCharacterMovement()->SetMovementMode(MOVE_Walking);
+	GetCharacterMovement()->bOrientRotationToMovement = Defaults->GetCharacterMovement()->bOrientRotationToMovement;
+
+	// 重置状态（StartPatrolling 在死亡状态下不生效，先手动切换）
+	EnemyState = EEnemyState::EES_Patrolling;
+	StartPatrolling();
+	CurrentPoise = MaxPoise;
+	LastHitTime = -100.0;
+
+	if (CurrentWeapon)
+	{
+		CurrentWeapon->SetActorHiddenInGame(false);
+	}
+
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterEnemy(this);
+	}
+
+	if (EnemyController)
+	{
+		if (UBrainComponent* Brain = EnemyController->GetBrainComponent())
+		{
+			Brain->RestartLogic();
+		}
+	}
+
+	RegisterHealthBar();
+	if (bAlwaysShowHealthBar)
+	{
+		ShowHealthBar();
+	}
+	else
+	{
+		HideHealthBar();
+	}
+}
+
+void AEnemyBase::OnReleasedToPool()
+{
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterEnemy(this);
+	}
+
+	// 池中的敌人不显示头顶 UI（包括还没自动隐藏的警戒图标）
+	if (UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this))
+	{
+		Overlay->UnregisterEnemy(this);
+	}
+
+	// 池中的敌人不参与存档
+	if (AEnemySpawner* Spawner = Cast<AEnemySpawner>(GetOwner()))
+	{
+		Spawner->SpawnedEnemies.RemoveSingle(this);
+	}
+
+	// lambda 计时器不会被对象池按对象清除，需要单独清理
+	GetWorldTimerManager().ClearTimer(DeathFreezeTimer);
+	GetWorldTimerManager().ClearTimer(AttackEndTimer);
+
+	if (bIsFrozen)
+	{
+		RemoveFreeze();
+	}
+	if (StatusEffectComponent)
+	{
+		StatusEffectComponent->RemoveAllEffects();
+	}
+	if (TraceHitboxComponent)
+	{
+		TraceHitboxComponent->DeactivateTrace();
+	}
+	StopAnimMontage();
+	ClearCombatTarget();
+	HideHealthBar();
+
+	// 休眠中被回收时先恢复档位，取出后的行为树不带着休眠时的暂停
+	SetTickBucket(EEnemyTickBucket::Full);
+
+	if (EnemyController)
+	{
+		EnemyController->StopMovement();
+		if (UBrainComponent* Brain = EnemyController->GetBrainComponent())
+		{
+			Brain->StopLogic("Pooled");
+		}
+	}
+
+	if (CurrentWeapon)
+	{
+		CurrentWeapon->SetActorHiddenInGame(true);
+	}
 }
 
 void AEnemyBase::Tick(float DeltaTime)
 {
+	BLACKMYTH_SCOPE_CYCLE(STAT_EnemyTick, TEXT("BlackMyth.Enemy.Tick"));
+	INC_DWORD_STAT(STAT_EnemiesTicked);
+
 	Super::Tick(DeltaTime);
 
 	if (IsDead()) return;
@@ -294,20 +411,7 @@ void AEnemyBase::Tick(float DeltaTime)
 	{
 		const double DistanceToTarget = (CombatTarget->GetActorLocation() - GetActorLocation()).Size();
 
-		// 始终面向目标 (当不移动时)
-		// 解决“乱转”问题：当敌人停止移动准备攻击时，平滑旋转朝向目标
-		// [修复] 增加 !IsStunned() 和 !IsFrozen() 检查，防止眩晕或定身时还在转
-		if (!IsChasing() && !GetCharacterMovement()->IsFalling() && !IsStunned() && !IsFrozen())
-		{
-			FVector Direction = CombatTarget->GetActorLocation() - GetActorLocation();
-			Direction.Z = 0.0f; // 只在水平面旋转
-			if (!Direction.IsNearlyZero())
-			{
-				FRotator TargetRot = Direction.Rotation();
-				FRotator NewRot = FMath::RInterpTo(GetActorRotation(), TargetRot, DeltaTime, 5.0f);
-				SetActorRotation(NewRot);
-			}
-		}
+		// 转向目标由 AEnemyAIController 调用 UpdateFacing 完成
 
 		// 如果处于追击状态
 		if (EnemyState == EEnemyState::EES_Chasing)
@@ -326,7 +430,7 @@ void AEnemyBase::Tick(float DeltaTime)
 			// 之前是 50.0f，可能太小了，导致稍微一动就取消攻击
 			if (DistanceToTarget > (AttackRadius + 100.0f))
 			{
-				UE_LOG(LogTemp, Warning, TEXT("[%s] AEnemyBase::Tick - Target too far (%.2f > %.2f), Canceling Attack"), *GetName(), DistanceToTarget, AttackRadius + 100.0f);
+				UE_LOG(LogBMAI, Verbose, TEXT("[%s] AEnemyBase::Tick - Target too far (%.2f > %.2f), Canceling Attack"), *GetName(), DistanceToTarget, AttackRadius + 100.0f);
 				ClearAttackTimer();
 				ChaseTarget();
 			}
@@ -339,6 +443,9 @@ void AEnemyBase::ReceiveDamage(float Damage, AActor* DamageInstigator, bool bCan
 {
 	if (IsDead()) return;
 
+	// 受击立即恢复全帧率，不等下一次重要度评估
+	SetTickBucket(EEnemyTickBucket::Full);
+
 	// 闪避判定：在受到伤害前，尝试触发闪避（眩晕或定身时不能闪避）
 	// [Fix] 如果bCanBeDodged=false（如立棍AOE），则无视闪避直接受伤
 	if (bCanBeDodged && DodgeComponent && DamageInstigator && !IsStunned() && !IsFrozen())
@@ -346,14 +453,14 @@ void AEnemyBase::ReceiveDamage(float Damage, AActor* DamageInstigator, bool bCan
 		FVector ThreatDir = (GetActorLocation() - DamageInstigator->GetActorLocation()).GetSafeNormal();
 		if (DodgeComponent->IsInDodge()) // 检查是否在无敌状态
   		{
-  			UE_LOG(LogTemp, Log, TEXT("[%s] Dodged damage! (In dodge iframe)"), *GetName());
+  			UE_LOG(LogBMAI, Verbose, TEXT("[%s] Dodged damage! (In dodge iframe)"), *GetName());
       		return; // 无敌状态下不受伤
   		}
 
 		// 再尝试触发新闪避
 		if (DodgeComponent->TryDodge(ThreatDir))
 		{
-			UE_LOG(LogTemp, Log, TEXT("[%s] Dodged damage! (New dodge triggered)"), *GetName());
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] Dodged damage! (New dodge triggered)"), *GetName());
 			return; // 触发闪避也不受伤
 		}
 	}
@@ -372,22 +479,14 @@ void AEnemyBase::ReceiveDamage(float Damage, AActor* DamageInstigator, bool bCan
 	// 仇恨机制：如果被攻击，立即将攻击者设为目标
 	if (DamageInstigator)
 	{
-		CombatTarget = DamageInstigator;
-		
-		// [Fix] 同步更新黑板，确保行为树知道目标是谁
-		if (EnemyController)
-		{
-			if (UBlackboardComponent* BB = EnemyController->GetBlackboardComponent())
-			{
-				BB->SetValueAsObject(TEXT("TargetActor"), CombatTarget);
-			}
-		}
+		// [Fix] 同步更新黑板，确保行为树知道目标是谁（同时开启控制器的转向）
+		AssignCombatTarget(DamageInstigator);
 
 		ClearPatrolTimer();
 		ClearAttackTimer();
 		
-		// 播放受击音效
-		if (HitSound)
+		// 播放受击音效（范围技能批量结算时由 UAreaEffectSubsystem 合并播放）
+		if (HitSound && UAreaEffectSubsystem::ClaimSound())
 		{
 			UGameplayStatics::PlaySoundAtLocation(this, HitSound, GetActorLocation());
 		}
@@ -408,7 +507,7 @@ void AEnemyBase::ReceiveDamage(float Damage, AActor* DamageInstigator, bool bCan
 		LastHitTime = GetWorld()->GetTimeSeconds(); // 记录受击时间
 		
 		// 调试日志：打印当前韧性
-		UE_LOG(LogTemp, Warning, TEXT("[%s] Took %.1f Damage. Poise: %.1f / %.1f"), *GetName(), Damage, CurrentPoise, MaxPoise);
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Took %.1f Damage. Poise: %.1f / %.1f"), *GetName(), Damage, CurrentPoise, MaxPoise);
 
 		if (CurrentPoise <= 0.0f)
 		{
@@ -422,7 +521,7 @@ void AEnemyBase::ReceiveDamage(float Damage, AActor* DamageInstigator, bool bCan
 			{
 				// 已经在眩晕状态，只重置计时器延长眩晕，不重新播放动画
 				GetWorldTimerManager().SetTimer(StunTimer, this, &AEnemyBase::StunEnd, StunDuration, false);
-				UE_LOG(LogTemp, Warning, TEXT("[%s] Already Stunned, extending duration to %.1fs"), *GetName(), StunDuration);
+				UE_LOG(LogBMAI, Verbose, TEXT("[%s] Already Stunned, extending duration to %.1fs"), *GetName(), StunDuration);
 				return; // 重要：直接返回，不执行下面的动画播放
 			}
 			
@@ -467,7 +566,8 @@ void AEnemyBase::ReceiveDamage(float Damage, AActor* DamageInstigator, bool bCan
 				
 				// 设置恢复计时器
 				GetWorldTimerManager().SetTimer(StunTimer, this, &AEnemyBase::StunEnd, StunDuration, false);
-				UE_LOG(LogTemp, Warning, TEXT("[%s] Stunned! Poise Broken. Duration: %.1fs"), *GetName(), StunDuration);
+				BlackMythCombatLog::Record(ECombatEvent::Stun, DamageInstigator, this, StunDuration);
+				UE_LOG(LogBMAI, Verbose, TEXT("[%s] Stunned! Poise Broken. Duration: %.1fs"), *GetName(), StunDuration);
 			}
 			else
 			{
@@ -557,12 +657,12 @@ void AEnemyBase::PlayHitReactMontage(const FVector& ImpactPoint)
 	// 播放选中的蒙太奇
 	if (MontageToPlay)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s] PlayHitReactMontage - Playing: %s"), *GetName(), *MontageToPlay->GetName());
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] PlayHitReactMontage - Playing: %s"), *GetName(), *MontageToPlay->GetName());
 		PlayAnimMontage(MontageToPlay);
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s] PlayHitReactMontage - No Montage found for this direction!"), *GetName());
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] PlayHitReactMontage - No Montage found for this direction!"), *GetName());
 	}
 }
 
@@ -576,6 +676,9 @@ void AEnemyBase::Die()
 		RemoveFreeze();
 	}
 
+	// 恢复全帧率，保证死亡动画和冻结计时正常播放（死亡后不再参与重要度评估）
+	SetTickBucket(EEnemyTickBucket::Full);
+
 	EnemyState = EEnemyState::EES_Dead;
 
 	// 播放死亡音效
@@ -632,7 +735,6 @@ void AEnemyBase::Die()
 	if (DeathMontage)
 	{
 		const float DeathDuration = DeathMontage->GetPlayLength();
-		FTimerHandle DeathFreezeTimer;
 		GetWorldTimerManager().SetTimer(DeathFreezeTimer, [this]()
 		{
 			if (GetMesh())
@@ -643,8 +745,21 @@ void AEnemyBase::Die()
 		}, DeathDuration - 0.1f, false); // 提前 0.1秒冻结，确保停在最后一帧
 	}
 
-	// 设置销毁定时器（例如 5 秒后消失）
-	SetLifeSpan(5.0f);
+	// 设置销毁定时器（例如 5 秒后消失），由对象池创建的敌人改为回收
+	UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this);
+	if (Pool && Pool->IsPooled(this))
+	{
+		GetWorldTimerManager().SetTimer(DeathCleanupTimer, this, &AEnemyBase::OnCorpseExpired, CorpseLifeSpan, false);
+	}
+	else
+	{
+		SetLifeSpan(CorpseLifeSpan);
+	}
+}
+
+void AEnemyBase::OnCorpseExpired()
+{
+	UActorPoolSubsystem::ReleaseOrDestroy(this);
 }
 
 void AEnemyBase::Attack()
@@ -652,20 +767,20 @@ void AEnemyBase::Attack()
 	if (CombatTarget == nullptr || IsDead()) return;
 	if (IsStunned()) 
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s] !!! Attack() called but STUNNED, should not happen !!!"), *GetName());
+		UE_LOG(LogBMAI, Error, TEXT("[%s] !!! Attack() called but STUNNED, should not happen !!!"), *GetName());
 		return; // [Fix] 眩晕状态下禁止攻击
 	}
 	
 	// 在攻击真正开始时停止移动，防止滑步
 	if (EnemyController) EnemyController->StopMovement();
 
-	UE_LOG(LogTemp, Warning, TEXT("[%s] AEnemyBase::Attack - Attacking Target"), *GetName());
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] AEnemyBase::Attack - Attacking Target"), *GetName());
 	EnemyState = EEnemyState::EES_Engaged;
 	
 	// 强制打印 AttackMontage 的状态
 	if (AttackMontage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s] AEnemyBase::Attack - Playing Montage: %s"), *GetName(), *AttackMontage->GetName());
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] AEnemyBase::Attack - Playing Montage: %s"), *GetName(), *AttackMontage->GetName());
 		
 		// 播放攻击音效
 		if (AttackSound)
@@ -687,7 +802,7 @@ void AEnemyBase::Attack()
 		const float Duration = PlayAnimMontage(AttackMontage);
 		if (Duration <= 0.0f)
 		{
-			UE_LOG(LogTemp, Error, TEXT("[%s] AEnemyBase::Attack - Montage failed to play! Duration=0. Forcing AttackEnd."), *GetName());
+			UE_LOG(LogBMAI, Error, TEXT("[%s] AEnemyBase::Attack - Montage failed to play! Duration=0. Forcing AttackEnd."), *GetName());
 			AttackEnd();
 		}
 		else
@@ -698,7 +813,7 @@ void AEnemyBase::Attack()
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s] AEnemyBase::Attack - No AttackMontage assigned! (Ptr is NULL)"), *GetName());
+		UE_LOG(LogBMAI, Error, TEXT("[%s] AEnemyBase::Attack - No AttackMontage assigned! (Ptr is NULL)"), *GetName());
 		AttackEnd();
 	}
 }
@@ -708,7 +823,7 @@ void AEnemyBase::AttackEnd()
 	if (IsDead()) return;
 	if (IsStunned()) return; // [Fix] 眩晕状态下禁止执行攻击结束逻辑（防止重置状态）
 
-	UE_LOG(LogTemp, Warning, TEXT("[%s] AEnemyBase::AttackEnd - Attack Finished"), *GetName());
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] AEnemyBase::AttackEnd - Attack Finished"), *GetName());
 	
 	// 关闭攻击判定
 	if (TraceHitboxComponent)
@@ -736,7 +851,7 @@ void AEnemyBase::CheckCombatTarget()
 		// 如果有目标，且不在攻击范围内，继续追击
 		if (!IsInsideAttackRadius())
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[%s] AEnemyBase::CheckCombatTarget - Target out of range, Chasing"), *GetName());
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] AEnemyBase::CheckCombatTarget - Target out of range, Chasing"), *GetName());
 			// 清除攻击计时器，防止重复攻击
 			ClearAttackTimer();
 			
@@ -746,7 +861,7 @@ void AEnemyBase::CheckCombatTarget()
 		// 如果还在攻击范围内，且没有在攻击，准备下一次攻击
 		else if (!IsAttacking())
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[%s] AEnemyBase::CheckCombatTarget - Target in range, Preparing Attack"), *GetName());
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] AEnemyBase::CheckCombatTarget - Target in range, Preparing Attack"), *GetName());
 			// 确保没有移动
 			if (EnemyController) EnemyController->StopMovement();
 			
@@ -773,17 +888,42 @@ void AEnemyBase::PatrolTimerFinished()
 
 void AEnemyBase::ShowHealthBar()
 {
-	if (HealthBarWidgetComponent)
+	if (UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this))
 	{
-		HealthBarWidgetComponent->SetVisibility(true);
+		Overlay->SetHealthBarVisible(this, true);
 	}
 }
 
 void AEnemyBase::HideHealthBar()
 {
-	if (HealthBarWidgetComponent)
+	if (UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this))
+	{
+		Overlay->SetHealthBarVisible(this, false);
+	}
+}
+
+void AEnemyBase::HandleHealthChanged(float CurrentHealth, float MaxHealth)
+{
+	if (UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this))
+	{
+		Overlay->SetHealthPercent(this, MaxHealth > 0.0f ? CurrentHealth / MaxHealth : 0.0f);
+	}
+}
+
+void AEnemyBase::RegisterHealthBar()
+{
+	UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this);
+	if (!Overlay)
+	{
+		return;
+	}
+
+	const float AlertIconOffset = AlertComponent ? AlertComponent->GetAlertIconHeightOffset() : HealthBarHeightOffset;
+	Overlay->RegisterEnemy(this, HealthBarHeightOffset, AlertIconOffset, FreezeTextHeightOffset);
+
+	if (HealthComponent)
 	{
-		HealthBarWidgetComponent->SetVisibility(false);
+		Overlay->SetHealthPercent(this, HealthComponent->GetHealthPercent(), true);
 	}
 }
 
@@ -807,6 +947,27 @@ void AEnemyBase::StartPatrolling()
 	// MoveToTarget(PatrolTarget); // [Fix] 移除直接移动，交由行为树
 }
 
+void AEnemyBase::UpdateFacing(const AActor* Target, float DeltaTime)
+{
+	// 解决“乱转”问题：眩晕、定身、空中不转；追击中默认交给移动朝向
+	if (!Target || IsDead() || IsStunned() || IsFrozen() || GetCharacterMovement()->IsFalling())
+	{
+		return;
+	}
+
+	if (IsChasing() && !bFaceTargetWhileChasing)
+	{
+		return;
+	}
+
+	FVector Direction = Target->GetActorLocation() - GetActorLocation();
+	Direction.Z = 0.0f; // 只在水平面旋转
+	if (!Direction.IsNearlyZero())
+	{
+		SetActorRotation(FMath::RInterpTo(GetActorRotation(), Direction.Rotation(), DeltaTime, FacingInterpSpeed));
+	}
+}
+
 void AEnemyBase::ChaseTarget()
 {
 	if (IsDead()) return;
@@ -869,19 +1030,19 @@ void AEnemyBase::StartAttackTimer()
 	if (IsDead()) return;
 	if (IsStunned())
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s] !!! StartAttackTimer() called but STUNNED !!!"), *GetName());
+		UE_LOG(LogBMAI, Error, TEXT("[%s] !!! StartAttackTimer() called but STUNNED !!!"), *GetName());
 		return; // 眩晕状态下不应该设置攻击计时器
 	}
 
 	EnemyState = EEnemyState::EES_Attacking;
 	const float AttackTime = FMath::RandRange(AttackMin, AttackMax);
-	UE_LOG(LogTemp, Warning, TEXT("[%s] AEnemyBase::StartAttackTimer - Next attack in %f seconds"), *GetName(), AttackTime);
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] AEnemyBase::StartAttackTimer - Next attack in %f seconds"), *GetName(), AttackTime);
 	GetWorldTimerManager().SetTimer(AttackTimer, this, &AEnemyBase::Attack, AttackTime);
 }
 
 void AEnemyBase::ClearAttackTimer()
 {
-	UE_LOG(LogTemp, Warning, TEXT("[%s] ClearAttackTimer() called"), *GetName());
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] ClearAttackTimer() called"), *GetName());
 	GetWorldTimerManager().ClearTimer(AttackTimer);
 }
 
@@ -924,7 +1085,7 @@ void AEnemyBase::ClearCombatTarget()
 {
 	if (CombatTarget)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[%s] ClearCombatTarget - Lost sight of target"), *GetName());
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] ClearCombatTarget - Lost sight of target"), *GetName());
 	}
 	CombatTarget = nullptr;
 	
@@ -950,6 +1111,16 @@ void AEnemyBase::ClearCombatTarget()
 	}
 }
 
+void AEnemyBase::AssignCombatTarget(AActor* NewTarget)
+{
+	CombatTarget = NewTarget;
+
+	if (AEnemyAIController* EnemyAI = Cast<AEnemyAIController>(GetController()))
+	{
+		EnemyAI->SetTargetActor(NewTarget);
+	}
+}
+
 void AEnemyBase::SetCombatTarget(AActor* NewTarget)
 {
 	// 如果目标是处于变身状态的悟空，忽略
@@ -957,15 +1128,90 @@ void AEnemyBase::SetCombatTarget(AActor* NewTarget)
 	{
 		if (Wukong->IsTransformed())
 		{
-			UE_LOG(LogTemp, Log, TEXT("[%s] SetCombatTarget - Ignoring transformed Wukong"), *GetName());
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] SetCombatTarget - Ignoring transformed Wukong"), *GetName());
 			return;
 		}
 	}
 	
-	CombatTarget = NewTarget;
+	AssignCombatTarget(NewTarget);
 	if (CombatTarget)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[%s] SetCombatTarget - New target: %s"), *GetName(), *CombatTarget->GetName());
+		SetTickBucket(EEnemyTickBucket::Full);
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] SetCombatTarget - New target: %s"), *GetName(), *CombatTarget->GetName());
+	}
+}
+
+// ========== 重要度 / Tick LOD ==========
+
+bool AEnemyBase::IsInCombat() const
+{
+	return CombatTarget != nullptr
+		|| EnemyState == EEnemyState::EES_Chasing
+		|| EnemyState == EEnemyState::EES_Attacking
+		|| EnemyState == EEnemyState::EES_Engaged
+		|| EnemyState == EEnemyState::EES_Stunned
+		|| bIsFrozen;
+}
+
+void AEnemyBase::SetTickBucket(EEnemyTickBucket NewBucket)
+{
+	if (TickBucket == NewBucket)
+	{
+		return;
+	}
+
+	TickBucket = NewBucket;
+
+	const bool bFull = NewBucket == EEnemyTickBucket::Full;
+	const bool bDormant = NewBucket == EEnemyTickBucket::Dormant;
+	const float Interval = bFull ? 0.0f : ReducedTickInterval;
+
+	// Actor 自身：非战斗时 Tick 只做韧性恢复，降频无可见差异
+	SetActorTickEnabled(!bDormant);
+	SetActorTickInterval(Interval);
+
+	// 状态效果由 UStatusEffectSubsystem 统一推进，不受档位影响
+
+	// 头顶 UI（血条、警戒图标、定身字）由叠加层统一绘制，不受档位影响
+
+	// 动画：降频时启用 URO 并且不可见时不更新姿势，休眠时完全停止
+	if (USkeletalMeshComponent* MeshComp = GetMesh())
+	{
+		MeshComp->SetComponentTickEnabled(!bDormant);
+		MeshComp->bEnableUpdateRateOptimizations = bFull ? bDefaultMeshUpdateRateOptimizations : true;
+		MeshComp->VisibilityBasedAnimTickOption = bFull
+			? DefaultVisibilityBasedAnimTickOption
+			: EVisibilityBasedAnimTickOption::OnlyTickPoseWhenRendered;
+	}
+
+	// AI：休眠时暂停行为树和当前寻路，否则移动组件停 Tick 后寻路仍在下发移动请求，醒来时位置和寻路状态不一致
+	if (EnemyController)
+	{
+		UBrainComponent* Brain = EnemyController->GetBrainComponent();
+		if (bDormant && !bLogicPausedForDormant)
+		{
+			if (Brain)
+			{
+				Brain->PauseLogic(TEXT("休眠"));
+			}
+			EnemyController->PauseMove(EnemyController->GetCurrentMoveRequestID());
+			bLogicPausedForDormant = true;
+		}
+		else if (!bDormant && bLogicPausedForDormant)
+		{
+			if (Brain)
+			{
+				Brain->ResumeLogic(TEXT("唤醒"));
+			}
+			EnemyController->ResumeMove(FAIRequestID::CurrentRequest);
+			bLogicPausedForDormant = false;
+		}
+	}
+
+	// 移动：休眠时停止（下落中的敌人保持 Tick，避免悬空）
+	if (UCharacterMovementComponent* Movement = GetCharacterMovement())
+	{
+		Movement->SetComponentTickEnabled(!bDormant || Movement->IsFalling());
 	}
 }
 
@@ -983,7 +1229,7 @@ void AEnemyBase::StunEnd()
 {
 	if (IsDead()) return;
 	
-	UE_LOG(LogTemp, Error, TEXT("[%s] ===== STUN END - Recovering from stun ====="), *GetName());
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] Stun end - recovering from stun"), *GetName());
 	
 	// 恢复韧性
 	CurrentPoise = MaxPoise;
@@ -997,12 +1243,12 @@ void AEnemyBase::StunEnd()
 		if (UBrainComponent* BrainComp = EnemyController->GetBrainComponent())
 		{
 			BrainComp->ResumeLogic(TEXT("眩晕结束"));
-			UE_LOG(LogTemp, Warning, TEXT("[%s] Resumed AI Brain after stun"), *GetName());
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] Resumed AI Brain after stun"), *GetName());
 		}
 		
 		if (CombatTarget)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("[%s] Starting to chase target after stun"), *GetName());
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] Starting to chase target after stun"), *GetName());
 			// 使用和ChaseTarget()相同的逻辑，让敌人重新追击
 			EnemyController->SetFocus(CombatTarget);
 		}
@@ -1021,6 +1267,7 @@ float AEnemyBase::GetMaxHealth() const
 
 void AEnemyBase::HandleDeath(AActor* Killer)
 {
+	BlackMythCombatLog::Record(ECombatEvent::Death, Killer, this);
 	Die();
 }
 
@@ -1041,15 +1288,16 @@ void AEnemyBase::OnTargetSensed(AActor* Target)
 	{
 		if (Wukong->IsTransformed())
 		{
-			UE_LOG(LogTemp, Log, TEXT("AEnemyBase::OnTargetSensed - Ignoring transformed Wukong"));
+			UE_LOG(LogBMAI, Verbose, TEXT("AEnemyBase::OnTargetSensed - Ignoring transformed Wukong"));
 			return;
 		}
 	}
 
 	bHasAggroed = true;
-	CombatTarget = Target;
+	AssignCombatTarget(Target);
+	SetTickBucket(EEnemyTickBucket::Full);
 
-	UE_LOG(LogTemp, Warning, TEXT("AEnemyBase::OnTargetSensed - Target Sensed: %s"), *Target->GetName());
+	UE_LOG(LogBMAI, Verbose, TEXT("AEnemyBase::OnTargetSensed - Target Sensed: %s"), *Target->GetName());
 
 	// 触发战斗BGM切换
 	if (AGameStateBase* GameState = GetWorld()->GetGameState())
@@ -1092,13 +1340,13 @@ void AEnemyBase::OnTargetSensed(AActor* Target)
 	float Duration = 0.0f;
 	if (AggroMontage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AEnemyBase::OnTargetSensed - Playing AggroMontage: %s"), *AggroMontage->GetName());
+		UE_LOG(LogBMAI, Verbose, TEXT("AEnemyBase::OnTargetSensed - Playing AggroMontage: %s"), *AggroMontage->GetName());
 		Duration = PlayAnimMontage(AggroMontage);
 		EnemyState = EEnemyState::EES_Engaged; // 设为交战状态，防止其他逻辑干扰
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("AEnemyBase::OnTargetSensed - No AggroMontage assigned."));
+		UE_LOG(LogBMAI, Verbose, TEXT("AEnemyBase::OnTargetSensed - No AggroMontage assigned."));
 	}
 
 	// 如果没有动画，Duration 为 0，直接开始追击
@@ -1200,13 +1448,15 @@ void AEnemyBase::ApplyFreeze(float Duration)
 		EnemyState = EEnemyState::EES_Frozen;
 
 		// ========== 播放定身音效 ==========
-		if (FreezeSound)
+		// 范围定身时只有申请到名额的目标播放，其余由 UAreaEffectSubsystem 合并
+		if (FreezeSound && UAreaEffectSubsystem::ClaimSound())
 		{
 			UGameplayStatics::PlaySoundAtLocation(this, FreezeSound, GetActorLocation());
 		}
 
 		// ========== 播放定身特效 (Niagara) ==========
-		if (FreezeEffect)
+		// 范围定身时附着特效有数量上限，离中心较远的目标只保留金身材质
+		if (FreezeEffect && UAreaEffectSubsystem::ClaimAttachedEffect())
 		{
 			// 在敌人身上生成持续特效
 			ActiveFreezeEffectComponent = UNiagaraFunctionLibrary::SpawnSystemAttached(
@@ -1221,17 +1471,9 @@ void AEnemyBase::ApplyFreeze(float Duration)
 		}
 
 		// ========== 显示"定"字 UI ==========
-		if (FreezeTextWidgetComponent)
+		if (UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this))
 		{
-			// 设置位置
-			FreezeTextWidgetComponent->SetRelativeLocation(FVector(0.0f, 0.0f, FreezeTextHeightOffset));
-			
-			// 如果有 Widget 类，设置并显示
-			if (FreezeTextWidgetClass)
-			{
-				FreezeTextWidgetComponent->SetWidgetClass(FreezeTextWidgetClass);
-			}
-			FreezeTextWidgetComponent->SetVisibility(true);
+			Overlay->SetFreezeTextVisible(this, true);
 		}
 
 		// ========== [New] 施加金色“覆盖材质”金身效果 ==========
@@ -1243,7 +1485,8 @@ void AEnemyBase::ApplyFreeze(float Duration)
 			GetMesh()->SetOverlayMaterial(FreezeOverlayMaterial);
 		}
 
-		UE_LOG(LogTemp, Warning, TEXT("[%s] 被定身！持续 %.1f 秒"), *GetName(), Duration);
+		BlackMythCombatLog::Record(ECombatEvent::Freeze, nullptr, this, Duration);
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] 被定身！持续 %.1f 秒"), *GetName(), Duration);
 	}
 
 	// 设置定身结束计时器
@@ -1260,9 +1503,9 @@ void AEnemyBase::RemoveFreeze()
 	GetWorldTimerManager().ClearTimer(FreezeTimer);
 
 	// ========== 隐藏"定"字 UI ==========
-	if (FreezeTextWidgetComponent)
+	if (UEnemyOverlaySubsystem* Overlay = UEnemyOverlaySubsystem::Get(this))
 	{
-		FreezeTextWidgetComponent->SetVisibility(false);
+		Overlay->SetFreezeTextVisible(this, false);
 	}
 
 	// ========== 停止定身持续特效 ==========
@@ -1341,7 +1584,7 @@ void AEnemyBase::RemoveFreeze()
 		StartPatrolling();
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("[%s] 定身解除！恢复到状态: %d"), *GetName(), (int32)EnemyState);
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] 定身解除！恢复到状态: %d"), *GetName(), (int32)EnemyState);
 }
 
 void AEnemyBase::OnFreezeTimerExpired()
@@ -1352,8 +1595,9 @@ void AEnemyBase::OnFreezeTimerExpired()
 // ========== 保存敌人存档数据 ==========
 void AEnemyBase::WriteEnemySaveData(FEnemySaveData& OutData) const
 {
-	// 唯一ID
-	OutData.EnemyID = EnemyID;
+	// 稳定存档键
+	OutData.SpawnerKey = SpawnerKey;
+	OutData.SpawnIndex = SpawnIndex;
 
 	// 基础状态
 	OutData.bIsDead = IsDead();
@@ -1378,13 +1622,15 @@ void AEnemyBase::WriteEnemySaveData(FEnemySaveData& OutData) const
 	// 敌人类型
 	OutData.EnemyClass = this->GetClass();
 
-	// Spawner名称
-	OutData.SpawnerName = SpawnerName;
-
 	// 等级（暂时设为1，如果有Level属性再修改）
 	OutData.Level = 1;
 }
 
+uint64 AEnemyBase::GetSaveKey() const
+{
+	return FEnemySaveData::MakeSaveKey(SpawnerKey, SpawnIndex);
+}
+
 // ========== 导入敌人存档数据 ==========
 void AEnemyBase::LoadEnemySaveData(const FEnemySaveData& InData)
 {
@@ -1393,11 +1639,9 @@ void AEnemyBase::LoadEnemySaveData(const FEnemySaveData& InData)
 		return;
 	}
 
-	// 恢复唯一ID
-	EnemyID = InData.EnemyID;
-
-	// 恢复Spawner名称
-	SpawnerName = InData.SpawnerName;
+	// 恢复存档键
+	SpawnerKey = InData.SpawnerKey;
+	SpawnIndex = InData.SpawnIndex;
 
 	if (InData.bIsDead)
 	{
@@ -1445,6 +1689,28 @@ void AEnemyBase::LoadEnemySaveData(const FEnemySaveData& InData)
 	}
 }
 
+bool AEnemyBase::ResetForRestore()
+{
+	if (IsDead() || bIsFrozen || IsStunned())
+	{
+		return false;
+	}
+
+	ClearAttackTimer();
+	GetWorldTimerManager().ClearTimer(AggroTimer);
+	GetWorldTimerManager().ClearTimer(AttackEndTimer);
+	ClearCombatTarget();
+	bHasAggroed = false;
+
+	if (StatusEffectComponent)
+	{
+		StatusEffectComponent->RemoveAllEffects();
+	}
+
+	StopAnimMontage();
+	return true;
+}
+
 void AEnemyBase::InitEnemy(int32 InLevel, bool bIsFromSave)
 {
 	if (!bIsFromSave)
@@ -1462,10 +1728,10 @@ void AEnemyBase::ApplyAttackStatusEffects(AActor* Target)
 		return;
 	}
 	// 获取目标的 StatusEffectComponent
-	UStatusEffectComponent* TargetStatusComp = Target->FindComponentByClass<UStatusEffectComponent>();
+	UStatusEffectComponent* TargetStatusComp = ICombatActor::GetStatusEffects(Target);
 	if (!TargetStatusComp)
 	{
-		UE_LOG(LogTemp, Verbose, TEXT("[%s] ApplyAttackStatusEffects - Target %s has no StatusEffectComponent"),
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] ApplyAttackStatusEffects - Target %s has no StatusEffectComponent"),
 			*GetName(), *Target->GetName());
 		return;
 	}
@@ -1486,7 +1752,7 @@ void AEnemyBase::ApplyAttackStatusEffects(AActor* Target)
 			// 施加效果
 			TargetStatusComp->ApplyEffect(Config.EffectClass, this, Config.Duration);
 
-			UE_LOG(LogTemp, Log, TEXT("[%s] ApplyAttackStatusEffects - Applied %s to %s (Duration: %.1f, Chance: %.0f%%)"),
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] ApplyAttackStatusEffects - Applied %s to %s (Duration: %.1f, Chance: %.0f%%)"),
 				*GetName(),
 				*Config.EffectClass->GetName(),
 				*Target->GetName(),
@@ -1495,7 +1761,7 @@ void AEnemyBase::ApplyAttackStatusEffects(AActor* Target)
 		}
 		else
 		{
-			UE_LOG(LogTemp, Verbose, TEXT("[%s] ApplyAttackStatusEffects - %s effect did not trigger (Roll: %.2f, Chance: %.2f)"),
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] ApplyAttackStatusEffects - %s effect did not trigger (Roll: %.2f, Chance: %.2f)"),
 				*GetName(),
 				*Config.EffectClass->GetName(),
 				RandomValue,
@@ -1511,7 +1777,7 @@ void AEnemyBase::SpawnGoldDrop()
 	// 如果没有设置金币掉落类，则不生成
 	if (!GoldPickupClass)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s] SpawnGoldDrop - No GoldPickupClass set, skipping drop"), *GetName());
+		UE_LOG(LogBMAI, Warning, TEXT("[%s] SpawnGoldDrop - No GoldPickupClass set, skipping drop"), *GetName());
 		return;
 	}
 
@@ -1553,7 +1819,9 @@ void AEnemyBase::SpawnGoldDrop()
 		}
 	}
 
-	// 生成掉落物
+	// 交给金币管理子系统批量模拟；没有子系统时直接生成 Actor（优先从对象池取出）
+	UGoldPickupSubsystem* GoldManager = UGoldPickupSubsystem::Get(this);
+	UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this);
 	FVector BaseLocation = GetActorLocation();
 	BaseLocation.Z += 50.0f; // 稍微抬高生成位置
 
@@ -1575,24 +1843,27 @@ void AEnemyBase::SpawnGoldDrop()
 			SpawnLocation.Y += FMath::Sin(FMath::DegreesToRadians(RandomAngle)) * RandomRadius;
 		}
 
+		if (GoldManager)
+		{
+			GoldManager->SpawnCoin(GoldPickupClass, SpawnLocation, GoldPerDrop[i]);
+			continue;
+		}
+
 		// 生成金币掉落物
 		FActorSpawnParameters SpawnParams;
 		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-		AGoldPickup* GoldPickup = GetWorld()->SpawnActor<AGoldPickup>(
-			GoldPickupClass,
-			SpawnLocation,
-			FRotator::ZeroRotator,
-			SpawnParams
-		);
+		AGoldPickup* GoldPickup = Pool
+			? Pool->Acquire<AGoldPickup>(GoldPickupClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams)
+			: GetWorld()->SpawnActor<AGoldPickup>(GoldPickupClass, SpawnLocation, FRotator::ZeroRotator, SpawnParams);
 
 		if (GoldPickup)
 		{
 			GoldPickup->SetGoldAmount(GoldPerDrop[i]);
-			UE_LOG(LogTemp, Log, TEXT("[%s] Spawned gold pickup with %d gold at %s"),
+			UE_LOG(LogBMAI, Verbose, TEXT("[%s] Spawned gold pickup with %d gold at %s"),
 				*GetName(), GoldPerDrop[i], *SpawnLocation.ToString());
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[%s] Dropped %d gold in %d pickup(s)"), *GetName(), TotalGold, ActualDropCount);
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] Dropped %d gold in %d pickup(s)"), *GetName(), TotalGold, ActualDropCount);
 }
@@ -2,8 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "BlackMythCharacter.h"
-#include "Components/WidgetComponent.h"
 #include "StatusEffect/StatusEffectTypes.h"
+#include "Subsystems/PoolableInterface.h"
+#include "Components/TeamMemberInterface.h"
+#include "Combat/CombatActorInterface.h"
 #include "EnemyBase.generated.h"
 
 class UBehaviorTree;
@@ -19,6 +21,8 @@ class UEnemyDodgeComponent;
 class UEnemyAlertComponent;
 class UStatusEffectComponent;
 
+enum class EVisibilityBasedAnimTickOption : uint8;
+
 struct FEnemySaveData;
 
 /**
@@ -37,6 +41,17 @@ enum class EEnemyState : uint8
 	EES_NoState UMETA(DisplayName = "NoState")
 };
 
+/**
+ * 敌人 Tick 档位（由 UEnemySignificanceSubsystem 按重要度分配）
+ */
+UENUM(BlueprintType)
+enum class EEnemyTickBucket : uint8
+{
+	Full     UMETA(DisplayName = "Full"),      // 战斗中：全帧率
+	Reduced  UMETA(DisplayName = "Reduced"),   // 巡逻：降频 Tick，动画启用 URO、不可见时不更新姿势
+	Dormant  UMETA(DisplayName = "Dormant")    // 远处且不可见：冻结 Tick，暂停行为树和寻路
+};
+
 struct FEnemySaveData;
 
 /**
@@ -44,7 +59,7 @@ struct FEnemySaveData;
  * 继承自 ABlackMythCharacter 以复用摄像机等功能（如击杀特写）
  */
 UCLASS()
-class BLACKMYTH_API AEnemyBase : public ABlackMythCharacter
+class BLACKMYTH_API AEnemyBase : public ABlackMythCharacter, public IPoolable, public ITeamMember, public ICombatActor
 {
 	GENERATED_BODY()
 
@@ -53,6 +68,15 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// ========== IPoolable ==========
+
+	/** 撤销死亡时的各项禁用（碰撞、移动、动画冻结），重新加入注册表并重启 AI */
+	virtual void OnAcquiredFromPool() override;
+
+	/** 退出注册表、停止 AI、隐藏武器，并从所属 Spawner 的列表中移除 */
+	virtual void OnReleasedToPool() override;
 
 public:
 	virtual void Tick(float DeltaTime) override;
@@ -80,6 +104,12 @@ public:
 	/** 开始巡逻 (公开给 AIController 调用) */
 	void StartPatrolling();
 
+	/**
+	 * 平滑转向目标（AEnemyAIController 有目标时每帧调用，是敌人唯一的转向路径）
+	 * 死亡、眩晕、定身或在空中时不转；追击中由移动朝向负责，除非 bFaceTargetWhileChasing
+	 */
+	void UpdateFacing(const AActor* Target, float DeltaTime);
+
 protected:
 	/** 死亡处理 */
 	virtual void Die();
@@ -93,6 +123,12 @@ protected:
 
 	/** 检查战斗目标 */
 	void CheckCombatTarget();
+
+	/**
+	 * 设置 CombatTarget 并写入 AI 控制器的黑板 TargetActor
+	 * 转向只由 AEnemyAIController 在观察到目标后驱动，直接改 CombatTarget 不会让敌人转身
+	 */
+	void AssignCombatTarget(AActor* NewTarget);
 	
 	/** 检查巡逻目标 */
 	void CheckPatrolTarget();
@@ -107,6 +143,13 @@ protected:
 	/** 隐藏/显示血条 (预留接口) */
 	void HideHealthBar();
 	void ShowHealthBar();
+
+	/** 生命值变化时同步头顶血条 */
+	UFUNCTION()
+	void HandleHealthChanged(float CurrentHealth, float MaxHealth);
+
+	/** 注册到头顶 UI 子系统（初始血量直接显示，不做过渡） */
+	void RegisterHealthBar();
 	
 	/** 追逐目标 */
 	void ChaseTarget();
@@ -146,24 +189,53 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "AI")
 	void SetCombatTarget(AActor* NewTarget);
 
-	// 生成此敌人的Spawner名称（用于存档系统）
+	// ========== 重要度 / Tick LOD ==========
+
+	/** 是否处于战斗相关状态（有战斗目标、追击、攻击、眩晕、定身） */
+	UFUNCTION(BlueprintPure, Category = "Performance")
+	bool IsInCombat() const;
+
+	/** 当前 Tick 档位 */
+	UFUNCTION(BlueprintPure, Category = "Performance")
+	EEnemyTickBucket GetTickBucket() const { return TickBucket; }
+
+	/** 切换 Tick 档位，同步调整 Actor、组件和动画的更新频率 */
+	void SetTickBucket(EEnemyTickBucket NewBucket);
+
+	/** 是否参与重要度管理（Boss 等需要始终全帧率的敌人可关闭） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance")
+	bool bUseTickSignificance = true;
+
+	/** 非战斗状态下，超过此距离（厘米）且不可见时进入休眠 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (EditCondition = "bUseTickSignificance"))
+	float DormantDistance = 5000.0f;
+
+	/** 降频档位下 Actor 与组件的 Tick 间隔（秒） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Performance", meta = (EditCondition = "bUseTickSignificance"))
+	float ReducedTickInterval = 0.2f;
+
+	// 生成此敌人的Spawner名称（调试显示用）
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Save")
 	FString SpawnerName;
 
-	// ========== 新增：头顶血条 ==========
+	// 生成此敌人的Spawner存档键（AEnemySpawner::GetSpawnerKey）
+	UPROPERTY(VisibleAnywhere, Category = "Save")
+	uint32 SpawnerKey = 0;
+
+	// 在所属Spawner中的生成序号，与 SpawnerKey 一起构成稳定的存档键
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Save")
+	int32 SpawnIndex = INDEX_NONE;
 
-	// 血条 Widget 组件
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI")
-	TObjectPtr<UWidgetComponent> HealthBarWidgetComponent;
+	/** 存档键（SpawnerKey + SpawnIndex），跨运行稳定 */
+	uint64 GetSaveKey() const;
 
-	// 血条 Widget 类
+	// ========== 新增：头顶血条 ==========
+	// 血条由 UEnemyOverlaySubsystem 在全屏叠加层上统一绘制，敌人只登记状态
+
+	// 血条 Widget 类（提供给叠加层的对象池）
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
 	TSubclassOf<UEnemyHealthBarWidget> HealthBarWidgetClass;
 
-	// 血条 Widget 实例引用
-	UPROPERTY()
-	TObjectPtr<UEnemyHealthBarWidget> HealthBarWidget;
-
 	// 血条距离头顶的高度偏移
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "UI")
 	float HealthBarHeightOffset = 120.0f;
@@ -240,6 +312,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "AI")
 	float ChasingSpeed = 300.f;
 
+	// 转向目标的插值速度
+	UPROPERTY(EditAnywhere, Category = "AI")
+	float FacingInterpSpeed = 5.f;
+
+	// 追击移动中是否也保持面向目标
+	UPROPERTY(EditAnywhere, Category = "AI")
+	bool bFaceTargetWhileChasing = false;
+
 	UPROPERTY(EditAnywhere, Category = "AI")
 	float PatrolWaitMin = 2.f;
 
@@ -257,6 +337,14 @@ protected:
 	FTimerHandle AttackTimer;
 	FTimerHandle AggroTimer;
 	FTimerHandle AttackEndTimer; // 攻击结束计时器（保底机制）
+	FTimerHandle DeathFreezeTimer; // 死亡动画冻结计时器
+	FTimerHandle DeathCleanupTimer; // 尸体回收计时器（由对象池管理时代替 LifeSpan）
+
+	/** 尸体停留时间（秒） */
+	static constexpr float CorpseLifeSpan = 5.0f;
+
+	/** 尸体停留结束，回收到对象池 */
+	void OnCorpseExpired();
 
 	// 行为树 (保留，以备后续扩展)
 	UPROPERTY(EditAnywhere, Category = "AI")
@@ -434,14 +522,22 @@ protected:
 	/** 内部定身处理函数 */
 	void OnFreezeTimerExpired();
 
+	// ========== 重要度 / Tick LOD (内部实现) ==========
+
+	/** 当前 Tick 档位 */
+	EEnemyTickBucket TickBucket = EEnemyTickBucket::Full;
+
+	/** BeginPlay 时记录的网格动画设置（回到全帧率时恢复） */
+	bool bDefaultMeshUpdateRateOptimizations = false;
+	EVisibilityBasedAnimTickOption DefaultVisibilityBasedAnimTickOption;
+
+	/** 进入休眠时暂停了行为树和寻路（离开休眠时恢复） */
+	bool bLogicPausedForDormant = false;
+
 public:
 	// ========== 定身术 UI 与特效 ==========
 
-	/** 定身"定"字 Widget 组件（头顶显示） */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "UI|Freeze")
-	TObjectPtr<UWidgetComponent> FreezeTextWidgetComponent;
-
-	/** 定身文字 Widget 类（在蓝图中设置） */
+	/** 定身文字 Widget 类（在蓝图中设置，提供给 UEnemyOverlaySubsystem 的对象池） */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI|Freeze")
 	TSubclassOf<UUserWidget> FreezeTextWidgetClass;
 
@@ -491,6 +587,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loot")
 	int32 GoldDropCount = 1;
 
+	/** 金币掉落物对象池预热数量 (同一类掉落物取所有敌人中的最大值；只有玩家附近的金币会成为 Actor) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loot", meta = (ClampMin = "0"))
+	int32 GoldPickupPoolSize = 8;
+
 	/** 掉落物散布半径 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Loot")
 	float DropSpreadRadius = 50.0f;
@@ -507,10 +607,13 @@ public:
 	/** 从存档数据恢复 */
 	void LoadEnemySaveData(const struct FEnemySaveData& InData);
 
+	/**
+	 * 读档复用已存在的敌人前调用：清除战斗目标、状态效果和正在播放的蒙太奇
+	 * 已死亡或被定身的敌人不可复用（由调用方销毁后重新生成）
+	 */
+	bool ResetForRestore();
+
 	/** 刷怪时初始化敌人属性 */
 	UFUNCTION(BlueprintCallable)
 	virtual void InitEnemy(int32 InLevel, bool bIsFromSave = false);
-
-	UPROPERTY()
-	FGuid EnemyID;
 };
@@ -4,6 +4,8 @@
 #include "GameFramework/Actor.h"
 #include "BlackMythSaveGame.h"
 #include "UObject/ConstructorHelpers.h"
+#include "Subsystems/ActorRegistrySubsystem.h"
+#include "Subsystems/ActorPoolSubsystem.h"
 
 AEnemySpawner::AEnemySpawner()
 {
@@ -15,6 +17,11 @@ void AEnemySpawner::BeginPlay()
 {
     Super::BeginPlay();
 
+    if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+    {
+        Registry->RegisterSpawner(this);
+    }
+
     // 如果配置了默认敌人类型，则在游戏开始时自动生成
     if (DefaultEnemyClass)
     {
@@ -27,6 +34,16 @@ void AEnemySpawner::BeginPlay()
     }
 }
 
+void AEnemySpawner::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+    {
+        Registry->UnregisterSpawner(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
 AEnemyBase* AEnemySpawner::SpawnEnemy(TSubclassOf<AEnemyBase> EnemyClass, const FVector& Location, const FRotator& Rotation, int32 Level)
 {
     // 检查敌人类是否有效
@@ -45,8 +62,11 @@ AEnemyBase* AEnemySpawner::SpawnEnemy(TSubclassOf<AEnemyBase> EnemyClass, const
     SpawnParams.SpawnCollisionHandlingOverride =
         ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-    // 生成敌人实例
-    AEnemyBase* SpawnedEnemy = GetWorld()->SpawnActor<AEnemyBase>(EnemyClass, Location, Rotation, SpawnParams);
+    // 生成敌人实例（启用对象池时优先复用已回收的敌人）
+    UActorPoolSubsystem* Pool = bPoolEnemies ? UActorPoolSubsystem::Get(this) : nullptr;
+    AEnemyBase* SpawnedEnemy = Pool
+        ? Pool->Acquire<AEnemyBase>(EnemyClass, Location, Rotation, SpawnParams)
+        : GetWorld()->SpawnActor<AEnemyBase>(EnemyClass, Location, Rotation, SpawnParams);
 
     if (SpawnedEnemy)
     {
@@ -61,8 +81,10 @@ AEnemyBase* AEnemySpawner::SpawnEnemy(TSubclassOf<AEnemyBase> EnemyClass, const
             ETeleportType::TeleportPhysics
         );
 
-        // 设置生成器名称，用于存档系统关联
+        // 设置生成器名称和存档键，用于存档系统关联
         SpawnedEnemy->SpawnerName = GetName();
+        SpawnedEnemy->SpawnerKey = GetSpawnerKey();
+        SpawnedEnemy->SpawnIndex = NextSpawnIndex++;
         // 初始化敌人属性
         SpawnedEnemy->InitEnemy(Level, true);
         // 添加到管理列表
@@ -70,4 +92,10 @@ AEnemyBase* AEnemySpawner::SpawnEnemy(TSubclassOf<AEnemyBase> EnemyClass, const
     }
 
     return SpawnedEnemy;
-}
\ No newline at end of file
+}
+
+uint32 AEnemySpawner::GetSpawnerKey() const
+{
+    const FString KeySource = SaveID.IsNone() ? GetName() : SaveID.ToString();
+    return FCrc::StrCrc32(*KeySource);
+}
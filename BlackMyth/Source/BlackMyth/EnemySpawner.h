@@ -39,6 +39,15 @@ public:
     UPROPERTY()
     TArray<AEnemyBase*> SpawnedEnemies;
 
+    /**
+     * 存档键：SaveID 非空时取 SaveID 的哈希，否则取 Actor 名称的哈希
+     * 关卡中摆放的 Spawner 名称在多次运行间保持不变
+     */
+    uint32 GetSpawnerKey() const;
+
+    /** 读档恢复的敌人占用了 Index，之后新生成的敌人从其后继续编号 */
+    void ClaimSpawnIndex(int32 Index) { NextSpawnIndex = FMath::Max(NextSpawnIndex, Index + 1); }
+
     // 默认敌人类型，在BeginPlay时自动生成
     UPROPERTY(EditAnywhere, Category = "Spawn")
     TSubclassOf<AEnemyBase> DefaultEnemyClass;
@@ -47,10 +56,22 @@ public:
     UPROPERTY(EditAnywhere, Category = "Spawn")
     int32 DefaultEnemyLevel = 1;
 
+    // 是否通过对象池生成/回收敌人（尸体消失后回收，下次生成时复用）
+    UPROPERTY(EditAnywhere, Category = "Spawn")
+    bool bPoolEnemies = false;
+
 protected:
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     // 可选的敌人类型列表（预留扩展用）
     UPROPERTY(EditAnywhere, Category = "Spawn")
     TArray<TSubclassOf<AEnemyBase>> EnemyClasses;
+
+    // 存档 ID（可选）。重命名 Spawner 后填入原名称可保持旧存档有效
+    UPROPERTY(EditInstanceOnly, Category = "Save")
+    FName SaveID;
+
+    // 下一个生成的敌人序号
+    int32 NextSpawnIndex = 0;
 };
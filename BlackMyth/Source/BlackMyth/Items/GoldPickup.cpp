@@ -7,6 +7,8 @@
 #include "Components/WidgetComponent.h"
 #include "../Components/WalletComponent.h"
 #include "../UI/GoldValueWidget.h"
+#include "../Subsystems/ActorPoolSubsystem.h"
+#include "GoldPickupSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraSystem.h"
@@ -77,23 +79,64 @@ void AGoldPickup::BeginPlay()
 		ValueWidgetComponent->SetWidgetClass(ValueWidgetClass);
 		ValueWidgetComponent->SetRelativeLocation(FVector(0.0f, 0.0f, ValueTextHeightOffset));
 		ValueWidgetComponent->InitWidget();  // 强制初始化
+	}
+
+	if (MeshComponent && IdleMaterial)
+	{
+		MeshComponent->SetMaterial(0, IdleMaterial);
+	}
+
+	StartDrop();
+}
+
+void AGoldPickup::OnAcquiredFromPool()
+{
+	StartDrop();
+}
 
-		// 获取Widget实例并设置显示的金币数值
-		UGoldValueWidget* ValueWidget = Cast<UGoldValueWidget>(ValueWidgetComponent->GetWidget());
-		if (ValueWidget)
+void AGoldPickup::OnReleasedToPool()
+{
+	if (UGoldPickupSubsystem* Manager = UGoldPickupSubsystem::Get(this))
+	{
+		Manager->NotifyLiveCoinReleased(this);
+	}
+
+	// 从玩家的附近金币列表中移除自己（存活时间到期时可能还在列表中）
+	if (NearbyPlayer)
+	{
+		NearbyPlayer->NearbyGolds.Remove(this);
+		if (NearbyPlayer->NearbyGolds.Num() == 0)
 		{
-			ValueWidget->SetGoldValue(GoldAmount);
-			UE_LOG(LogTemp, Log, TEXT("[GoldPickup] Initialized value widget with %d gold"), GoldAmount);
+			NearbyPlayer->SetNearbyGold(nullptr);
 		}
 	}
 
+	bIsPickedUp = false;
+	bIsBeingAttracted = false;
+	bWaitingForPickup = false;
+	AttractTarget = nullptr;
+	NearbyPlayer = nullptr;
+}
+
+void AGoldPickup::StartDrop()
+{
+	// 价值显示
+	SetGoldAmount(GoldAmount);
+	if (ValueWidgetComponent)
+	{
+		ValueWidgetComponent->SetVisibility(true);
+	}
+
 	// 设置存活时间
 	if (LifeTime > 0.0f)
 	{
-		SetLifeSpan(LifeTime);
+		GetWorldTimerManager().SetTimer(LifeTimeTimer, this, &AGoldPickup::OnLifeTimeExpired, LifeTime, false);
 	}
 
 	// 初始化掉落动画
+	bHasLanded = false;
+	DropTimer = 0.0f;
+	FloatTimer = 0.0f;
 	DropStartLocation = GetActorLocation();
 	DropTargetLocation = DropStartLocation;
 	DropTargetLocation.Z = DropStartLocation.Z - DropBounceHeight; // 先下落
@@ -102,6 +145,55 @@ void AGoldPickup::BeginPlay()
 	UE_LOG(LogTemp, Log, TEXT("[GoldPickup] Spawned with %d gold"), GoldAmount);
 }
 
+void AGoldPickup::SetGoldAmount(int32 Amount)
+{
+	GoldAmount = Amount;
+
+	if (UGoldValueWidget* ValueWidget = ValueWidgetComponent ? Cast<UGoldValueWidget>(ValueWidgetComponent->GetWidget()) : nullptr)
+	{
+		ValueWidget->SetGoldValue(GoldAmount);
+	}
+}
+
+void AGoldPickup::ActivateFromManager(int32 Amount, float RemainingLifeTime, AWukongCharacter* Player)
+{
+	SetGoldAmount(Amount);
+
+	// 已经在实例化网格中落地，跳过掉落动画
+	bHasLanded = true;
+	DropTimer = DropDuration;
+	InitialZ = GetActorLocation().Z;
+
+	GetWorldTimerManager().ClearTimer(LifeTimeTimer);
+	if (RemainingLifeTime > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(LifeTimeTimer, this, &AGoldPickup::OnLifeTimeExpired, RemainingLifeTime, false);
+	}
+
+	// 玩家本来就在范围内，不依赖碰撞启用时是否补发重叠事件
+	NotifyPlayerInRange(Player);
+}
+
+FVector AGoldPickup::GetRestLocation() const
+{
+	FVector Location = GetActorLocation();
+	if (bHasLanded)
+	{
+		Location.Z = InitialZ;
+	}
+	return Location;
+}
+
+float AGoldPickup::GetRemainingLifeTime() const
+{
+	return FMath::Max(GetWorldTimerManager().GetTimerRemaining(LifeTimeTimer), 0.0f);
+}
+
+void AGoldPickup::OnLifeTimeExpired()
+{
+	UActorPoolSubsystem::ReleaseOrDestroy(this);
+}
+
 void AGoldPickup::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -166,6 +258,12 @@ void AGoldPickup::Tick(float DeltaTime)
 	else
 	{
 		// ===== 待机状态：旋转和浮动效果 =====
+		// 待机材质在 GPU 上完成浮动和旋转
+		if (IdleMaterial)
+		{
+			return;
+		}
+
 		// 旋转效果
 		FRotator CurrentRotation = GetActorRotation();
 		CurrentRotation.Yaw += RotationSpeed * DeltaTime;
@@ -191,8 +289,13 @@ void AGoldPickup::OnPlayerEnterRange(UPrimitiveComponent* OverlappedComp, AActor
 		return;
 	}
 
+	NotifyPlayerInRange(Player);
+}
+
+void AGoldPickup::NotifyPlayerInRange(AWukongCharacter* Player)
+{
 	// 如果已经在吸附或等待状态，不再处理
-	if (bIsBeingAttracted || bWaitingForPickup)
+	if (!Player || bIsPickedUp || bIsBeingAttracted || bWaitingForPickup)
 	{
 		return;
 	}
@@ -303,6 +406,6 @@ void AGoldPickup::PickUp(AWukongCharacter* Player)
 		);
 	}
 
-	// 销毁自身
-	Destroy();
+	// 回收自身
+	UActorPoolSubsystem::ReleaseOrDestroy(this);
 }
@@ -4,18 +4,22 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "../Subsystems/PoolableInterface.h"
 #include "GoldPickup.generated.h"
 
 class USphereComponent;
 class AWukongCharacter;
 class UWidgetComponent;
+class UMaterialInterface;
 
 /**
  * 金币掉落物
  * 敌人死亡时生成，玩家进入范围后自动拾取
+ * 敌人掉落的金币平时由 UGoldPickupSubsystem 以实例化网格批量绘制，
+ * 玩家进入吸附范围后才从对象池取出本 Actor 接管（ActivateFromManager）
  */
 UCLASS()
-class BLACKMYTH_API AGoldPickup : public AActor
+class BLACKMYTH_API AGoldPickup : public AActor, public IPoolable
 {
 	GENERATED_BODY()
 
@@ -25,6 +29,11 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	// ========== IPoolable ==========
+
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
+
 public:
 	virtual void Tick(float DeltaTime) override;
 
@@ -100,6 +109,13 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Pickup")
 	float FloatFrequency = 2.0f;
 
+	/**
+	 * 待机材质（可选）：用世界位置偏移实现浮动和旋转，实例化绘制时自定义数据 0 为相位
+	 * 设置后待机时不再每帧移动 Actor
+	 */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Pickup")
+	TObjectPtr<UMaterialInterface> IdleMaterial;
+
 	// ========== UI 配置 ==========
 
 	/** 金币价值Widget类（在蓝图中配置） */
@@ -120,9 +136,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Pickup")
 	void PickUp(AWukongCharacter* Player);
 
-	/** 设置金币数量 */
+	/** 设置金币数量（同时刷新价值显示） */
 	UFUNCTION(BlueprintCallable, Category = "Pickup")
-	void SetGoldAmount(int32 Amount) { GoldAmount = Amount; }
+	void SetGoldAmount(int32 Amount);
 
 	/** 玩家进入检测范围 */
 	UFUNCTION()
@@ -134,6 +150,22 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Pickup")
 	void StartAttract();
 
+	// ========== 金币管理子系统 ==========
+
+	/** 从休眠状态接管：跳过掉落动画，沿用剩余存活时间（0 表示永久），玩家已在范围内 */
+	void ActivateFromManager(int32 Amount, float RemainingLifeTime, AWukongCharacter* Player);
+
+	/** 是否可以交回管理子系统（未被吸附、未被拾取） */
+	bool CanReturnToManager() const { return !bIsPickedUp && !bIsBeingAttracted; }
+
+	/** 落地后的静止位置（不含浮动偏移） */
+	FVector GetRestLocation() const;
+
+	/** 剩余存活时间（永久返回 0） */
+	float GetRemainingLifeTime() const;
+
+	float GetDropDuration() const { return DropDuration; }
+
 protected:
 	/** 玩家离开检测范围 */
 	UFUNCTION()
@@ -141,6 +173,17 @@ protected:
 		UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
 
 private:
+	/** 开始掉落动画并计算存活时间（生成或从对象池复用时调用） */
+	void StartDrop();
+
+	/** 玩家进入范围：等待按 F 拾取 */
+	void NotifyPlayerInRange(AWukongCharacter* Player);
+
+	/** 存活时间到期（回收到对象池） */
+	void OnLifeTimeExpired();
+
+	FTimerHandle LifeTimeTimer;
+
 	/** 是否已被拾取（防止重复调用） */
 	bool bIsPickedUp = false;
 
@@ -0,0 +1,372 @@
+// 金币掉落管理子系统实现
+
+#include "GoldPickupSubsystem.h"
+#include "GoldPickup.h"
+#include "../WukongCharacter.h"
+#include "../Subsystems/ActorPoolSubsystem.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "../BlackMythStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gold Coins Instanced"), STAT_GoldCoinsInstanced, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Gold Coins Live"), STAT_GoldCoinsLive, STATGROUP_BlackMyth);
+
+// ========== USubsystem ==========
+
+bool UGoldPickupSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UGoldPickupSubsystem::Deinitialize()
+{
+	Types.Empty();
+	Locations.Empty();
+	DropElapsed.Empty();
+	ExpireTimes.Empty();
+	GoldAmounts.Empty();
+	TypeIndices.Empty();
+	Phases.Empty();
+	LiveCoins.Empty();
+	InstanceComponents.Empty();
+	Host = nullptr;
+
+	Super::Deinitialize();
+}
+
+TStatId UGoldPickupSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGoldPickupSubsystem, STATGROUP_BlackMyth);
+}
+
+UGoldPickupSubsystem* UGoldPickupSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UGoldPickupSubsystem>() : nullptr;
+}
+
+// ========== 掉落 ==========
+
+void UGoldPickupSubsystem::SpawnCoin(TSubclassOf<AGoldPickup> PickupClass, const FVector& Location, int32 GoldAmount)
+{
+	const int32 TypeIndex = FindOrAddType(PickupClass);
+	if (TypeIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// 与原先的 Actor 一样，从生成点下落 DropBounceHeight 后静止
+	const FCoinType& Type = Types[TypeIndex];
+	const FVector RestLocation = Location - FVector(0.0f, 0.0f, Type.DropBounceHeight);
+	const double ExpireTime = Type.LifeTime > 0.0f ? GetWorld()->GetTimeSeconds() + Type.LifeTime : 0.0;
+
+	AddCoin(TypeIndex, RestLocation, 0.0f, ExpireTime, GoldAmount);
+}
+
+void UGoldPickupSubsystem::NotifyLiveCoinReleased(AGoldPickup* Coin)
+{
+	const int32 Index = LiveCoins.IndexOfByKey(Coin);
+	if (Index != INDEX_NONE)
+	{
+		LiveCoins.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	}
+}
+
+int32 UGoldPickupSubsystem::FindOrAddType(TSubclassOf<AGoldPickup> PickupClass)
+{
+	if (!PickupClass)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 Existing = Types.IndexOfByPredicate([PickupClass](const FCoinType& Type)
+	{
+		return Type.PickupClass == PickupClass;
+	});
+	if (Existing != INDEX_NONE)
+	{
+		return Existing;
+	}
+
+	AActor* HostActor = GetOrCreateHost();
+	if (!HostActor || Types.Num() > MAX_uint8)
+	{
+		return INDEX_NONE;
+	}
+
+	const AGoldPickup* Defaults = PickupClass->GetDefaultObject<AGoldPickup>();
+
+	FCoinType& Type = Types.AddDefaulted_GetRef();
+	Type.PickupClass = PickupClass;
+	Type.AttractRadiusSquared = FMath::Square(Defaults->AttractRadius);
+	Type.DropBounceHeight = Defaults->DropBounceHeight;
+	Type.DropDuration = Defaults->GetDropDuration();
+	Type.LifeTime = Defaults->LifeTime;
+
+	// 网格、材质和相对变换取自蓝图中配置的 MeshComponent
+	UInstancedStaticMeshComponent* Instances = NewObject<UInstancedStaticMeshComponent>(HostActor);
+	Instances->SetupAttachment(HostActor->GetRootComponent());
+	Instances->SetMobility(EComponentMobility::Movable);
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Instances->SetGenerateOverlapEvents(false);
+	Instances->NumCustomDataFloats = 1;
+
+	if (const UStaticMeshComponent* TemplateMesh = Defaults->MeshComponent)
+	{
+		Instances->SetStaticMesh(TemplateMesh->GetStaticMesh());
+		for (int32 MaterialIndex = 0; MaterialIndex < TemplateMesh->GetNumMaterials(); ++MaterialIndex)
+		{
+			Instances->SetMaterial(MaterialIndex, TemplateMesh->GetMaterial(MaterialIndex));
+		}
+		Instances->SetCastShadow(TemplateMesh->CastShadow);
+		Type.MeshTransform = TemplateMesh->GetRelativeTransform();
+	}
+
+	if (Defaults->IdleMaterial)
+	{
+		Instances->SetMaterial(0, Defaults->IdleMaterial);
+	}
+
+	Instances->RegisterComponent();
+	HostActor->AddInstanceComponent(Instances);
+
+	Type.Instances = Instances;
+	InstanceComponents.Add(Instances);
+
+	return Types.Num() - 1;
+}
+
+AActor* UGoldPickupSubsystem::GetOrCreateHost()
+{
+	if (Host)
+	{
+		return Host;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transient;
+	Host = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+	if (Host)
+	{
+		USceneComponent* Root = NewObject<USceneComponent>(Host, TEXT("Root"));
+		Host->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	return Host;
+}
+
+// ========== 金币数组 ==========
+
+void UGoldPickupSubsystem::AddCoin(int32 TypeIndex, const FVector& RestLocation, float InDropElapsed, double ExpireTime, int32 GoldAmount)
+{
+	FCoinType& Type = Types[TypeIndex];
+
+	Locations.Add(RestLocation);
+	DropElapsed.Add(InDropElapsed);
+	ExpireTimes.Add(ExpireTime);
+	GoldAmounts.Add(GoldAmount);
+	TypeIndices.Add(static_cast<uint8>(TypeIndex));
+	Phases.Add(FMath::FRand());
+
+	Type.bMembershipDirty = true;
+}
+
+void UGoldPickupSubsystem::RemoveCoinAt(int32 Index)
+{
+	Types[TypeIndices[Index]].bMembershipDirty = true;
+
+	Locations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	DropElapsed.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	ExpireTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	GoldAmounts.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TypeIndices.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Phases.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+}
+
+FVector UGoldPickupSubsystem::GetCoinLocation(int32 Index) const
+{
+	const FCoinType& Type = Types[TypeIndices[Index]];
+	if (DropElapsed[Index] >= Type.DropDuration)
+	{
+		return Locations[Index];
+	}
+
+	// 与 AGoldPickup 的掉落动画相同：线性下落叠加一次正弦弹跳
+	const float Alpha = FMath::Clamp(DropElapsed[Index] / Type.DropDuration, 0.0f, 1.0f);
+	FVector Location = Locations[Index];
+	Location.Z += (1.0f - Alpha) * Type.DropBounceHeight + FMath::Sin(Alpha * PI) * Type.DropBounceHeight * 0.5f;
+	return Location;
+}
+
+// ========== 批量更新 ==========
+
+void UGoldPickupSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	BLACKMYTH_TRACE_SCOPE(TEXT("BlackMyth.GoldPickup.Tick"));
+
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	AWukongCharacter* Player = PlayerController ? Cast<AWukongCharacter>(PlayerController->GetPawn()) : nullptr;
+	if (Player && Player->IsDead())
+	{
+		Player = nullptr;
+	}
+	const FVector PlayerLocation = Player ? Player->GetActorLocation() : FVector::ZeroVector;
+
+	// 倒序遍历：RemoveAtSwap 换到当前位置的总是已经处理过的元素
+	for (int32 Index = Locations.Num() - 1; Index >= 0; --Index)
+	{
+		if (ExpireTimes[Index] > 0.0 && Now >= ExpireTimes[Index])
+		{
+			RemoveCoinAt(Index);
+			continue;
+		}
+
+		FCoinType& Type = Types[TypeIndices[Index]];
+		if (DropElapsed[Index] < Type.DropDuration)
+		{
+			DropElapsed[Index] += DeltaTime;
+			Type.bTransformsDirty = true;
+			continue;
+		}
+
+		if (Player && FVector::DistSquared(Locations[Index], PlayerLocation) <= Type.AttractRadiusSquared)
+		{
+			PromoteCoin(Index, Player);
+		}
+	}
+
+	DemoteLiveCoins(Player);
+	UpdateInstances();
+
+	SET_DWORD_STAT(STAT_GoldCoinsInstanced, Locations.Num());
+	SET_DWORD_STAT(STAT_GoldCoinsLive, LiveCoins.Num());
+}
+
+void UGoldPickupSubsystem::PromoteCoin(int32 Index, AWukongCharacter* Player)
+{
+	const int32 TypeIndex = TypeIndices[Index];
+	const FVector Location = Locations[Index];
+	const int32 GoldAmount = GoldAmounts[Index];
+	const double ExpireTime = ExpireTimes[Index];
+	RemoveCoinAt(Index);
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const TSubclassOf<AGoldPickup> PickupClass = Types[TypeIndex].PickupClass;
+	UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this);
+	AGoldPickup* Coin = Pool
+		? Pool->Acquire<AGoldPickup>(PickupClass, Location, FRotator::ZeroRotator, SpawnParams)
+		: GetWorld()->SpawnActor<AGoldPickup>(PickupClass, Location, FRotator::ZeroRotator, SpawnParams);
+
+	if (!Coin)
+	{
+		// 生成失败时留在数组里，下一帧再试
+		AddCoin(TypeIndex, Location, Types[TypeIndex].DropDuration, ExpireTime, GoldAmount);
+		return;
+	}
+
+	const float RemainingLifeTime = ExpireTime > 0.0 ? FMath::Max(static_cast<float>(ExpireTime - GetWorld()->GetTimeSeconds()), KINDA_SMALL_NUMBER) : 0.0f;
+	Coin->ActivateFromManager(GoldAmount, RemainingLifeTime, Player);
+	LiveCoins.Add(Coin);
+}
+
+void UGoldPickupSubsystem::DemoteLiveCoins(const AWukongCharacter* Player)
+{
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	for (int32 Index = LiveCoins.Num() - 1; Index >= 0; --Index)
+	{
+		AGoldPickup* Coin = LiveCoins[Index].Get();
+		if (!Coin)
+		{
+			LiveCoins.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		// 吸附中或已拾取的金币由 Actor 自己完成
+		if (!Coin->CanReturnToManager())
+		{
+			continue;
+		}
+
+		const FVector RestLocation = Coin->GetRestLocation();
+		const float ReleaseRadius = Coin->AttractRadius * ReleaseRangeScale;
+		if (Player && FVector::DistSquared(RestLocation, Player->GetActorLocation()) <= FMath::Square(ReleaseRadius))
+		{
+			continue;
+		}
+
+		const int32 TypeIndex = FindOrAddType(Coin->GetClass());
+		if (TypeIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const float RemainingLifeTime = Coin->GetRemainingLifeTime();
+		const double ExpireTime = RemainingLifeTime > 0.0f ? Now + RemainingLifeTime : 0.0;
+
+		LiveCoins.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+		AddCoin(TypeIndex, RestLocation, Types[TypeIndex].DropDuration, ExpireTime, Coin->GoldAmount);
+		UActorPoolSubsystem::ReleaseOrDestroy(Coin);
+	}
+}
+
+void UGoldPickupSubsystem::UpdateInstances()
+{
+	for (int32 TypeIndex = 0; TypeIndex < Types.Num(); ++TypeIndex)
+	{
+		FCoinType& Type = Types[TypeIndex];
+		if (!Type.bMembershipDirty && !Type.bTransformsDirty)
+		{
+			continue;
+		}
+
+		ScratchTransforms.Reset();
+		ScratchPhases.Reset();
+		for (int32 Index = 0; Index < Locations.Num(); ++Index)
+		{
+			if (TypeIndices[Index] == TypeIndex)
+			{
+				const FTransform CoinTransform(FRotator(0.0f, Phases[Index] * 360.0f, 0.0f), GetCoinLocation(Index));
+				ScratchTransforms.Add(Type.MeshTransform * CoinTransform);
+				ScratchPhases.Add(Phases[Index]);
+			}
+		}
+
+		if (Type.Instances)
+		{
+			if (Type.bMembershipDirty)
+			{
+				// 增删时整体重建，实例顺序与数组中该类型金币的顺序一致
+				Type.Instances->ClearInstances();
+				Type.Instances->AddInstances(ScratchTransforms, false, true);
+				for (int32 InstanceIndex = 0; InstanceIndex < ScratchPhases.Num(); ++InstanceIndex)
+				{
+					Type.Instances->SetCustomDataValue(InstanceIndex, 0, ScratchPhases[InstanceIndex]);
+				}
+				Type.Instances->MarkRenderStateDirty();
+			}
+			else
+			{
+				// 只有掉落中的金币在动，顺序不变，批量更新变换
+				Type.Instances->BatchUpdateInstancesTransforms(0, ScratchTransforms, true, true, true);
+			}
+		}
+
+		Type.bMembershipDirty = false;
+		Type.bTransformsDirty = false;
+	}
+}
@@ -0,0 +1,133 @@
+// 金币掉落管理子系统 - 批量模拟所有休眠金币并用实例化网格绘制，只有玩家附近的金币才成为 Actor
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GoldPickupSubsystem.generated.h"
+
+class AGoldPickup;
+class AWukongCharacter;
+class UInstancedStaticMeshComponent;
+
+/**
+ * 金币掉落管理子系统
+ * - 敌人掉落的金币先登记为数组中的一项（结构数组：静止位置、掉落进度、过期时间、金额、类型），
+ *   一次 Tick 内完成所有金币的掉落动画、过期和距离判断
+ * - 休眠金币按 AGoldPickup 子类分组，用一个 UInstancedStaticMeshComponent 绘制；
+ *   浮动和旋转由金币材质的世界位置偏移完成（AGoldPickup::IdleMaterial，
+ *   每个实例的自定义数据 0 为相位），落地后实例不再更新
+ * - 玩家进入吸附范围时，从对象池取出 AGoldPickup 接管（提示、按 F 吸附、拾取）；
+ *   玩家走远且未在吸附中的金币回到数组
+ */
+UCLASS()
+class BLACKMYTH_API UGoldPickupSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// ========== FTickableGameObject ==========
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return Locations.Num() > 0 || LiveCoins.Num() > 0; }
+
+	/** 获取世界的金币管理子系统（可能为空） */
+	static UGoldPickupSubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 掉落 ==========
+
+	/** 在 Location 掉落一枚金币（播放掉落动画后休眠） */
+	void SpawnCoin(TSubclassOf<AGoldPickup> PickupClass, const FVector& Location, int32 GoldAmount);
+
+	/** 金币 Actor 被回收时调用（拾取或过期） */
+	void NotifyLiveCoinReleased(AGoldPickup* Coin);
+
+	int32 GetNumInstancedCoins() const { return Locations.Num(); }
+	int32 GetNumLiveCoins() const { return LiveCoins.Num(); }
+
+	/** 玩家走出吸附范围多远（倍数）后，未被吸附的金币 Actor 回到休眠 */
+	static constexpr float ReleaseRangeScale = 1.25f;
+
+private:
+	/** 一种金币类的共享数据（取自类默认对象） */
+	struct FCoinType
+	{
+		TSubclassOf<AGoldPickup> PickupClass;
+		UInstancedStaticMeshComponent* Instances = nullptr;
+		FTransform MeshTransform;
+		float AttractRadiusSquared = 0.0f;
+		float DropBounceHeight = 0.0f;
+		float DropDuration = 0.0f;
+		float LifeTime = 0.0f;
+
+		/** 本帧需要重建实例（增删） / 只更新变换（掉落中） */
+		bool bMembershipDirty = false;
+		bool bTransformsDirty = false;
+	};
+
+	/** 查找或创建金币类型 */
+	int32 FindOrAddType(TSubclassOf<AGoldPickup> PickupClass);
+
+	/** 添加一枚金币 */
+	void AddCoin(int32 TypeIndex, const FVector& RestLocation, float InDropElapsed, double ExpireTime, int32 GoldAmount);
+
+	/** RemoveAtSwap 移除第 Index 枚金币 */
+	void RemoveCoinAt(int32 Index);
+
+	/** 把第 Index 枚金币变为 Actor */
+	void PromoteCoin(int32 Index, AWukongCharacter* Player);
+
+	/** 玩家走远的金币 Actor 回到数组 */
+	void DemoteLiveCoins(const AWukongCharacter* Player);
+
+	/** 掉落动画中的当前位置 */
+	FVector GetCoinLocation(int32 Index) const;
+
+	/** 按脏标记更新实例化网格 */
+	void UpdateInstances();
+
+	/** 承载实例化网格组件的 Actor */
+	AActor* GetOrCreateHost();
+
+	TArray<FCoinType> Types;
+
+	// ========== 休眠金币（结构数组，下标一致） ==========
+
+	/** 落地后的静止位置 */
+	TArray<FVector> Locations;
+
+	/** 已掉落时间，达到类型的 DropDuration 即落地 */
+	TArray<float> DropElapsed;
+
+	/** 过期的世界时间（0 表示永久） */
+	TArray<double> ExpireTimes;
+
+	TArray<int32> GoldAmounts;
+
+	TArray<uint8> TypeIndices;
+
+	/** 材质浮动/旋转的相位（0~1），避免同一堆金币同步起伏 */
+	TArray<float> Phases;
+
+	// ========== 活跃金币 ==========
+
+	/** 玩家附近已变为 Actor 的金币 */
+	TArray<TWeakObjectPtr<AGoldPickup>> LiveCoins;
+
+	UPROPERTY()
+	TObjectPtr<AActor> Host;
+
+	/** 实例化网格组件（与 Types 一一对应，保持引用） */
+	UPROPERTY()
+	TArray<TObjectPtr<UInstancedStaticMeshComponent>> InstanceComponents;
+
+	/** 重建实例时复用的缓冲 */
+	TArray<FTransform> ScratchTransforms;
+	TArray<float> ScratchPhases;
+};
@@ -3,6 +3,8 @@
 #include "PotionActor.h"
 #include "Components/StaticMeshComponent.h"
 #include "GameFramework/Character.h"
+#include "TimerManager.h"
+#include "../Subsystems/ActorPoolSubsystem.h"
 
 APotionActor::APotionActor()
 {
@@ -24,6 +26,11 @@ void APotionActor::BeginPlay()
 	Super::BeginPlay();
 }
 
+void APotionActor::OnReleasedToPool()
+{
+	HidePotion();
+}
+
 void APotionActor::ShowPotion()
 {
 	if (PotionMesh)
@@ -70,8 +77,13 @@ void APotionActor::DetachAndDestroy()
 	// 分离
 	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
 
-	// 延迟销毁（0.1秒后）
-	SetLifeSpan(0.1f);
+	// 延迟回收（0.1秒后）
+	GetWorldTimerManager().SetTimer(DetachDelayTimer, this, &APotionActor::OnDetachDelayExpired, 0.1f, false);
 
 	UE_LOG(LogTemp, Log, TEXT("PotionActor: %s detached and scheduled for destruction"), *PotionTypeName);
 }
+
+void APotionActor::OnDetachDelayExpired()
+{
+	UActorPoolSubsystem::ReleaseOrDestroy(this);
+}
@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "../Subsystems/PoolableInterface.h"
 #include "PotionActor.generated.h"
 
 /**
@@ -10,7 +11,7 @@
  * 用于在喝药动画中显示的药瓶模型
  */
 UCLASS()
-class BLACKMYTH_API APotionActor : public AActor
+class BLACKMYTH_API APotionActor : public AActor, public IPoolable
 {
 	GENERATED_BODY()
 
@@ -20,6 +21,10 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	// ========== IPoolable ==========
+
+	virtual void OnReleasedToPool() override;
+
 public:
 	// ========== 组件 ==========
 
@@ -55,7 +60,13 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Potion")
 	void AttachToCharacter(ACharacter* Character);
 
-	/** 从角色分离并销毁 */
+	/** 从角色分离并销毁（有对象池时回收） */
 	UFUNCTION(BlueprintCallable, Category = "Potion")
 	void DetachAndDestroy();
+
+private:
+	/** 延迟回收到对象池 */
+	void OnDetachDelayExpired();
+
+	FTimerHandle DetachDelayTimer;
 };
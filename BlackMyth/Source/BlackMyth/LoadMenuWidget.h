@@ -6,6 +6,7 @@
 #include "Blueprint/UserWidget.h"
 #include "Components/TextBlock.h"
 #include "EnemySpawner.h"
+#include "Save/BlackMythSaveFormat.h"
 #include "LoadMenuWidget.generated.h"
 
 /**
@@ -43,4 +44,11 @@ class BLACKMYTH_API ULoadMenuWidget : public UUserWidget {
   /** 点击读档槽（1~3）。 */
   UFUNCTION(BlueprintCallable, Category = "Load")
   void OnLoadSlotClicked(int32 SlotIndex);
+
+ private:
+  /** 存档读取完成（游戏线程）。 */
+  void OnSlotLoaded(TSharedPtr<const FBlackMythSaveSnapshot> Snapshot);
+
+  /** 是否正在等待存档读取。 */
+  bool bLoadInProgress = false;
 };
@@ -4,6 +4,8 @@
 #include "Dialogue/DialogueComponent.h"
 #include "Components/CapsuleComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "Subsystems/ActorRegistrySubsystem.h"
+#include "Subsystems/SpatialGridSubsystem.h"
 
 ANPCCharacter::ANPCCharacter()
 {
@@ -30,6 +32,32 @@ ANPCCharacter::ANPCCharacter()
 void ANPCCharacter::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterNPC(this);
+	}
+
+	// NPC 没有阵营组件，以中立阵营进入空间网格，供玩家交互检测查询
+	if (USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this))
+	{
+		Grid->RegisterActor(this, ETeam::Neutral);
+	}
+}
+
+void ANPCCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterNPC(this);
+	}
+
+	if (USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this))
+	{
+		Grid->UnregisterActor(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void ANPCCharacter::PostInitializeComponents()
@@ -3,6 +3,8 @@
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "GameFramework/DamageType.h"
+#include "Subsystems/ActorPoolSubsystem.h"
+#include "TimerManager.h"
 
 AProjectileBase::AProjectileBase()
 {
@@ -32,9 +34,6 @@ AProjectileBase::AProjectileBase()
 	ProjectileMovement->bShouldBounce = true; // 开启反弹
 	ProjectileMovement->Bounciness = 0.6f; // 设置反弹系数
 	ProjectileMovement->ProjectileGravityScale = 1.0f; // 正常重力
-
-	// 默认存活时间 (防止无限飞行)
-	InitialLifeSpan = 5.0f;
 }
 
 void AProjectileBase::BeginPlay()
@@ -43,6 +42,29 @@ void AProjectileBase::BeginPlay()
 	
 	// 绑定碰撞事件
 	CollisionSphere->OnComponentHit.AddDynamic(this, &AProjectileBase::OnHit);
+
+	GetWorldTimerManager().SetTimer(LifeTimeTimer, this, &AProjectileBase::OnLifeTimeExpired, LifeTime, false);
+}
+
+void AProjectileBase::OnAcquiredFromPool()
+{
+	// 复用时按新的朝向重新发射
+	ProjectileMovement->SetUpdatedComponent(CollisionSphere);
+	ProjectileMovement->Velocity = GetActorForwardVector() * ProjectileMovement->InitialSpeed;
+	ProjectileMovement->Activate(true);
+
+	GetWorldTimerManager().SetTimer(LifeTimeTimer, this, &AProjectileBase::OnLifeTimeExpired, LifeTime, false);
+}
+
+void AProjectileBase::OnReleasedToPool()
+{
+	ProjectileMovement->StopMovementImmediately();
+	ProjectileMovement->Deactivate();
+}
+
+void AProjectileBase::OnLifeTimeExpired()
+{
+	UActorPoolSubsystem::ReleaseOrDestroy(this);
 }
 
 void AProjectileBase::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, FVector NormalImpulse, const FHitResult& Hit)
@@ -70,8 +92,8 @@ void AProjectileBase::OnHit(UPrimitiveComponent* HitComp, AActor* OtherActor, UP
 				UGameplayStatics::PlaySoundAtLocation(this, HitSound, GetActorLocation());
 			}
 
-			// 只有打中人才销毁，打中墙壁则保留以进行反弹
-			Destroy();
+			// 只有打中人才回收，打中墙壁则保留以进行反弹
+			UActorPoolSubsystem::ReleaseOrDestroy(this);
 		}
 		else
 		{
@@ -2,13 +2,14 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Subsystems/PoolableInterface.h"
 #include "ProjectileBase.generated.h"
 
 class USphereComponent;
 class UProjectileMovementComponent;
 
 UCLASS()
-class BLACKMYTH_API AProjectileBase : public AActor
+class BLACKMYTH_API AProjectileBase : public AActor, public IPoolable
 {
 	GENERATED_BODY()
 	
@@ -18,6 +19,16 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
+	// ========== IPoolable ==========
+
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
+
+	/** 存活时间到期（回收到对象池） */
+	void OnLifeTimeExpired();
+
+	FTimerHandle LifeTimeTimer;
+
 public:	
 	// 碰撞组件
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
@@ -35,6 +46,10 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	float Damage = 10.0f;
 
+	// 存活时间 (防止无限飞行)，到期后回收到对象池
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+	float LifeTime = 5.0f;
+
 	// 命中特效
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	TObjectPtr<UParticleSystem> HitParticles;
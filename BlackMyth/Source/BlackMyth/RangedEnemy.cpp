@@ -2,6 +2,8 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "ProjectileBase.h"
 #include "Kismet/GameplayStatics.h"
+#include "Subsystems/ActorPoolSubsystem.h"
+#include "BlackMythLog.h"
 
 ARangedEnemy::ARangedEnemy()
 {
@@ -18,12 +20,23 @@ ARangedEnemy::ARangedEnemy()
 	AttackRadius = RangedAttackDistance;
 }
 
+void ARangedEnemy::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// 预热投掷物对象池，齐射时不再分配新对象
+	if (UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this))
+	{
+		Pool->Prewarm(ProjectileClass, ProjectilePoolSize);
+	}
+}
+
 void ARangedEnemy::Attack()
 {
 	if (CombatTarget == nullptr || IsDead()) return;
 	if (IsStunned()) return;
 
-	UE_LOG(LogTemp, Warning, TEXT("[%s] ARangedEnemy::Attack - Starting Ranged Attack"), *GetName());
+	UE_LOG(LogBMAI, Verbose, TEXT("[%s] ARangedEnemy::Attack - Starting Ranged Attack"), *GetName());
 	EnemyState = EEnemyState::EES_Engaged;
 
 	if (AttackMontage)
@@ -40,7 +53,7 @@ void ARangedEnemy::Attack()
 		const float Duration = PlayAnimMontage(AttackMontage);
 		if (Duration <= 0.0f)
 		{
-			UE_LOG(LogTemp, Error, TEXT("[%s] ARangedEnemy::Attack - Montage failed to play!"), *GetName());
+			UE_LOG(LogBMAI, Error, TEXT("[%s] ARangedEnemy::Attack - Montage failed to play!"), *GetName());
 			AttackEnd();
 		}
 		else
@@ -51,7 +64,7 @@ void ARangedEnemy::Attack()
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s] ARangedEnemy::Attack - No AttackMontage assigned!"), *GetName());
+		UE_LOG(LogBMAI, Error, TEXT("[%s] ARangedEnemy::Attack - No AttackMontage assigned!"), *GetName());
 		AttackEnd();
 	}
 }
@@ -60,7 +73,7 @@ void ARangedEnemy::SpawnProjectile()
 {
 	if (!ProjectileClass)
 	{
-		UE_LOG(LogTemp, Error, TEXT("[%s] SpawnProjectile - ProjectileClass is NULL!"), *GetName());
+		UE_LOG(LogBMAI, Error, TEXT("[%s] SpawnProjectile - ProjectileClass is NULL!"), *GetName());
 		return;
 	}
 
@@ -94,7 +107,14 @@ void ARangedEnemy::SpawnProjectile()
 	SpawnParams.Owner = this;
 	SpawnParams.Instigator = this;
 
-	GetWorld()->SpawnActor<AProjectileBase>(ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
+	if (UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this))
+	{
+		Pool->Acquire<AProjectileBase>(ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
+	}
+	else
+	{
+		GetWorld()->SpawnActor<AProjectileBase>(ProjectileClass, SpawnLocation, SpawnRotation, SpawnParams);
+	}
 
 	// 视觉效果：隐藏手中的武器 (模拟扔出去了)
 	// 假设 CurrentWeapon 是我们手中的武器 Actor
@@ -28,6 +28,7 @@ public:
 	void SpawnProjectile();
 
 protected:
+	virtual void BeginPlay() override;
 	virtual void Attack() override;
 
 	/** 理想的射击距离 (在这个距离内且有视野就会停止移动) */
@@ -38,6 +39,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	TSubclassOf<class AProjectileBase> ProjectileClass;
 
+	/** 投掷物对象池预热数量 (同一类投掷物取所有远程敌人中的最大值) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat", meta = (ClampMin = "0"))
+	int32 ProjectilePoolSize = 4;
+
 	/** 投掷物生成插槽 (通常是手部) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
 	FName ProjectileSpawnSocket = FName("WeaponSocket"); // 默认用 WeaponSocket，也可以改成 Hand_R
@@ -1,5 +1,6 @@
 #include "RegularEnemy.h"
 #include "BehaviorTree/BehaviorTree.h"
+#include "BlackMythLog.h"
 
 ARegularEnemy::ARegularEnemy()
 {
@@ -18,15 +19,15 @@ void ARegularEnemy::BeginPlay()
 	if (BehaviorTree)
 	{
 		FString BTName = BehaviorTree->GetName();
-		UE_LOG(LogTemp, Warning, TEXT("[%s] Using Behavior Tree: %s"), *GetName(), *BTName);
+		UE_LOG(LogBMAI, Verbose, TEXT("[%s] Using Behavior Tree: %s"), *GetName(), *BTName);
 
 		if (BTName.Contains(TEXT("Ranged")))
 		{
-			UE_LOG(LogTemp, Error, TEXT("!!! CONFIGURATION ERROR !!! [%s] is a RegularEnemy (Melee) but is using a RANGED Behavior Tree (%s)! This will cause it to run away or stop too far. Please change the Behavior Tree in the Blueprint Class Defaults to 'BT_Enemy'."), *GetName(), *BTName);
+			UE_LOG(LogBMAI, Error, TEXT("!!! CONFIGURATION ERROR !!! [%s] is a RegularEnemy (Melee) but is using a RANGED Behavior Tree (%s)! This will cause it to run away or stop too far. Please change the Behavior Tree in the Blueprint Class Defaults to 'BT_Enemy'."), *GetName(), *BTName);
 		}
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[%s] No Behavior Tree assigned!"), *GetName());
+		UE_LOG(LogBMAI, Warning, TEXT("[%s] No Behavior Tree assigned!"), *GetName());
 	}
 }
@@ -0,0 +1,538 @@
+// 存档二进制格式实现
+
+#include "BlackMythSaveFormat.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/SoftObjectPath.h"
+#include "../BlackMythLog.h"
+
+namespace BlackMythSave
+{
+	// 单个块内记录数上限（防止损坏数据导致超大分配）
+	constexpr int32 MaxRecordsPerChunk = 1 << 20;
+
+	// 反序列化时每项至少占用的字节数（字符串的长度前缀 / 记录的键和标志位），用于对照剩余字节数
+	constexpr int64 MinStringBytes = sizeof(int32);
+	constexpr int64 MinRecordBytes = sizeof(uint64) + sizeof(uint8);
+
+	// 敌人数据比较容差
+	constexpr float LocationTolerance = 1.0f;
+	constexpr float RotationTolerance = 0.5f;
+	constexpr float PoiseTolerance = 1.0f;
+
+	FString GetSlotName(int32 SlotIndex)
+	{
+		return FString::Printf(TEXT("SaveSlot_%d"), SlotIndex);
+	}
+
+	template<typename EnumType>
+	void SerializeEnumAsByte(FArchive& Ar, EnumType& Value)
+	{
+		uint8 Byte = static_cast<uint8>(Value);
+		Ar << Byte;
+		Value = static_cast<EnumType>(Byte);
+	}
+}
+
+// ========== 序列化 ==========
+
+void FSaveMeta::Serialize(FArchive& Ar)
+{
+	Ar << SaveName;
+	Ar << SaveTime;
+
+	Ar << PlayerLocation;
+	Ar << PlayerRotation;
+	Ar << PlayerHealth;
+	Ar << PlayerMaxHealth;
+	Ar << PlayerStamina;
+	Ar << PlayerMaxStamina;
+
+	Ar << bHasRespawnPoint;
+	if (bHasRespawnPoint)
+	{
+		Ar << RespawnLocation;
+		Ar << RespawnRotation;
+		Ar << RespawnTempleID;
+	}
+}
+
+void FEnemySaveRecord::Serialize(FArchive& Ar)
+{
+	using namespace BlackMythSave;
+
+	Ar << Key;
+	SerializeEnumAsByte(Ar, Flags);
+
+	// 墓碑只有键
+	if (EnumHasAnyFlags(Flags, ERecordFlags::Removed))
+	{
+		return;
+	}
+
+	Ar << EnemyClassIndex;
+	Ar << WeaponClassIndex;
+	Ar << WeaponSocketIndex;
+	Ar << Level;
+	Ar << CurrentHealth;
+	Ar << CurrentPoise;
+	Ar << EnemyState;
+	Ar << Location;
+	Ar << Rotation;
+
+	// 只有处于对应状态时才写附加字段
+	if (EnumHasAnyFlags(Flags, ERecordFlags::Stunned))
+	{
+		Ar << StunRemainingTime;
+	}
+
+	if (EnumHasAnyFlags(Flags, ERecordFlags::Frozen))
+	{
+		Ar << StateBeforeFreeze;
+		Ar << FrozenAnimPosition;
+		Ar << MovementSpeedBeforeFreeze;
+	}
+}
+
+void FSaveChunk::Serialize(FArchive& Ar)
+{
+	BlackMythSave::SerializeEnumAsByte(Ar, Type);
+	Meta.Serialize(Ar);
+
+	// 与 Ar << TArray<FString> 的布局相同，但读取时先校验数量再分配
+	int32 NumStrings = StringTable.Num();
+	Ar << NumStrings;
+
+	if (Ar.IsLoading())
+	{
+		if (NumStrings < 0 || NumStrings > BlackMythSave::InvalidStringIndex
+			|| NumStrings * BlackMythSave::MinStringBytes > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		StringTable.SetNum(NumStrings);
+	}
+
+	for (FString& Value : StringTable)
+	{
+		Ar << Value;
+		if (Ar.IsError())
+		{
+			return;
+		}
+	}
+
+	int32 NumRecords = Records.Num();
+	Ar << NumRecords;
+
+	if (Ar.IsLoading())
+	{
+		if (NumRecords < 0 || NumRecords > BlackMythSave::MaxRecordsPerChunk
+			|| NumRecords * BlackMythSave::MinRecordBytes > Ar.TotalSize() - Ar.Tell())
+		{
+			Ar.SetError();
+			return;
+		}
+		Records.SetNum(NumRecords);
+	}
+
+	for (FEnemySaveRecord& Record : Records)
+	{
+		Record.Serialize(Ar);
+		if (Ar.IsError())
+		{
+			return;
+		}
+	}
+}
+
+uint16 FSaveChunk::AddString(const FString& Value)
+{
+	const int32 Existing = StringTable.IndexOfByKey(Value);
+	if (Existing != INDEX_NONE)
+	{
+		return static_cast<uint16>(Existing);
+	}
+
+	if (StringTable.Num() >= BlackMythSave::InvalidStringIndex)
+	{
+		return BlackMythSave::InvalidStringIndex;
+	}
+
+	return static_cast<uint16>(StringTable.Add(Value));
+}
+
+namespace BlackMythSave
+{
+	// ========== FEnemySaveData <-> 二进制记录 ==========
+
+	FEnemySaveRecord MakeRecord(const FEnemySaveData& Data, FSaveChunk& Chunk)
+	{
+		FEnemySaveRecord Record;
+		Record.Key = Data.GetSaveKey();
+
+		if (Data.bIsDead)
+		{
+			Record.Flags |= ERecordFlags::Dead;
+		}
+		if (Data.bIsStunned)
+		{
+			Record.Flags |= ERecordFlags::Stunned;
+		}
+		if (Data.bIsFrozen)
+		{
+			Record.Flags |= ERecordFlags::Frozen;
+		}
+
+		if (Data.EnemyClass)
+		{
+			Record.EnemyClassIndex = Chunk.AddString(FSoftClassPath(Data.EnemyClass.Get()).ToString());
+		}
+		if (Data.WeaponClass)
+		{
+			Record.WeaponClassIndex = Chunk.AddString(FSoftClassPath(Data.WeaponClass.Get()).ToString());
+		}
+		if (!Data.WeaponSocketName.IsNone())
+		{
+			Record.WeaponSocketIndex = Chunk.AddString(Data.WeaponSocketName.ToString());
+		}
+
+		Record.Level = Data.Level;
+		Record.CurrentHealth = Data.CurrentHealth;
+		Record.CurrentPoise = Data.CurrentPoise;
+		Record.EnemyState = static_cast<uint8>(Data.EnemyState);
+		Record.StateBeforeFreeze = static_cast<uint8>(Data.StateBeforeFreeze);
+		Record.Location = FVector3f(Data.Location);
+		Record.Rotation = FRotator3f(Data.Rotation);
+		Record.StunRemainingTime = Data.StunRemainingTime;
+		Record.FrozenAnimPosition = Data.FrozenAnimPosition;
+		Record.MovementSpeedBeforeFreeze = Data.MovementSpeedBeforeFreeze;
+
+		return Record;
+	}
+
+	FEnemySaveRecord MakeRemovedRecord(uint64 Key)
+	{
+		FEnemySaveRecord Record;
+		Record.Key = Key;
+		Record.Flags = ERecordFlags::Removed;
+		return Record;
+	}
+
+	bool IsSaveEquivalent(const FEnemySaveData& A, const FEnemySaveData& B)
+	{
+		return A.EnemyClass == B.EnemyClass
+			&& A.WeaponClass == B.WeaponClass
+			&& A.WeaponSocketName == B.WeaponSocketName
+			&& A.Level == B.Level
+			&& A.bIsDead == B.bIsDead
+			&& A.CurrentHealth == B.CurrentHealth
+			&& FMath::IsNearlyEqual(A.CurrentPoise, B.CurrentPoise, PoiseTolerance)
+			&& A.EnemyState == B.EnemyState
+			&& A.Location.Equals(B.Location, LocationTolerance)
+			&& A.Rotation.Equals(B.Rotation, RotationTolerance)
+			&& A.bIsStunned == B.bIsStunned
+			&& A.StunRemainingTime == B.StunRemainingTime
+			&& A.bIsFrozen == B.bIsFrozen
+			&& A.FrozenAnimPosition == B.FrozenAnimPosition
+			&& A.StateBeforeFreeze == B.StateBeforeFreeze
+			&& A.MovementSpeedBeforeFreeze == B.MovementSpeedBeforeFreeze;
+	}
+
+	// ========== 字节流读写 ==========
+
+	void AppendChunk(FSaveChunk& Chunk, TArray<uint8>& OutBytes)
+	{
+		FMemoryWriter Writer(OutBytes, /*bIsPersistent*/ true, /*bSetOffset*/ true);
+
+		// 先写占位长度，序列化完再回填
+		const int64 SizeOffset = Writer.Tell();
+		uint32 ChunkSize = 0;
+		Writer << ChunkSize;
+
+		const int64 ChunkStart = Writer.Tell();
+		Chunk.Serialize(Writer);
+		const int64 ChunkEnd = Writer.Tell();
+
+		ChunkSize = static_cast<uint32>(ChunkEnd - ChunkStart);
+		Writer.Seek(SizeOffset);
+		Writer << ChunkSize;
+		Writer.Seek(ChunkEnd);
+	}
+
+	void WriteHeader(int32 NumChunks, TArray<uint8>& OutBytes)
+	{
+		FMemoryWriter Writer(OutBytes, /*bIsPersistent*/ true);
+
+		uint32 FileMagic = Magic;
+		uint16 FileVersion = static_cast<uint16>(EVersion::Latest);
+		uint16 FileNumChunks = static_cast<uint16>(NumChunks);
+
+		Writer << FileMagic;
+		Writer << FileVersion;
+		Writer << FileNumChunks;
+	}
+
+	bool HasBinaryHeader(const TArray<uint8>& Bytes)
+	{
+		if (Bytes.Num() < static_cast<int32>(sizeof(uint32)))
+		{
+			return false;
+		}
+
+		uint32 FileMagic = 0;
+		FMemory::Memcpy(&FileMagic, Bytes.GetData(), sizeof(uint32));
+		return FileMagic == Magic;
+	}
+
+	namespace
+	{
+		/** 读取并校验文件头 */
+		bool ReadHeader(const TArray<uint8>& Bytes, FMemoryReader& Reader, uint16& OutNumChunks)
+		{
+			if (!HasBinaryHeader(Bytes))
+			{
+				return false;
+			}
+
+			uint32 FileMagic = 0;
+			uint16 FileVersion = 0;
+			Reader << FileMagic;
+			Reader << FileVersion;
+			Reader << OutNumChunks;
+
+			if (Reader.IsError() || FileVersion == 0 || FileVersion > static_cast<uint16>(EVersion::Latest))
+			{
+				UE_LOG(LogBMSave, Error, TEXT("[Save] Unsupported save version %d (latest %d)"),
+					FileVersion, static_cast<int32>(EVersion::Latest));
+				return false;
+			}
+			return true;
+		}
+	}
+
+	bool ParseFile(const TArray<uint8>& Bytes, TArray<FSaveChunk>& OutChunks, int32& OutChunkBytesOffset)
+	{
+		FMemoryReader Reader(Bytes, /*bIsPersistent*/ true);
+
+		uint16 FileNumChunks = 0;
+		if (!ReadHeader(Bytes, Reader, FileNumChunks))
+		{
+			return false;
+		}
+
+		OutChunkBytesOffset = static_cast<int32>(Reader.Tell());
+		OutChunks.Reset(FileNumChunks);
+
+		for (int32 ChunkIndex = 0; ChunkIndex < FileNumChunks; ++ChunkIndex)
+		{
+			uint32 ChunkSize = 0;
+			Reader << ChunkSize;
+
+			const int64 ChunkStart = Reader.Tell();
+			if (Reader.IsError() || ChunkStart + ChunkSize > Reader.TotalSize())
+			{
+				UE_LOG(LogBMSave, Error, TEXT("[Save] Truncated save chunk %d"), ChunkIndex);
+				return false;
+			}
+
+			FSaveChunk& Chunk = OutChunks.AddDefaulted_GetRef();
+			Chunk.Serialize(Reader);
+			if (Reader.IsError())
+			{
+				UE_LOG(LogBMSave, Error, TEXT("[Save] Corrupted save chunk %d"), ChunkIndex);
+				return false;
+			}
+
+			// 以长度前缀为准跳到下一个块（较新的写入方可能在块尾追加了字段）
+			Reader.Seek(ChunkStart + ChunkSize);
+		}
+
+		return OutChunks.Num() > 0 && OutChunks[0].Type == EChunkType::Full;
+	}
+
+	bool ReadLatestMeta(const TArray<uint8>& Bytes, FSaveMeta& OutMeta)
+	{
+		FMemoryReader Reader(Bytes, /*bIsPersistent*/ true);
+
+		uint16 FileNumChunks = 0;
+		if (!ReadHeader(Bytes, Reader, FileNumChunks) || FileNumChunks == 0)
+		{
+			return false;
+		}
+
+		// 按长度前缀跳到最后一个块
+		int64 LastChunkStart = 0;
+		for (int32 ChunkIndex = 0; ChunkIndex < FileNumChunks; ++ChunkIndex)
+		{
+			uint32 ChunkSize = 0;
+			Reader << ChunkSize;
+
+			LastChunkStart = Reader.Tell();
+			if (Reader.IsError() || LastChunkStart + ChunkSize > Reader.TotalSize())
+			{
+				return false;
+			}
+			Reader.Seek(LastChunkStart + ChunkSize);
+		}
+
+		// 块开头为类型和元数据（见 FSaveChunk::Serialize）
+		Reader.Seek(LastChunkStart);
+		EChunkType Type = EChunkType::Full;
+		SerializeEnumAsByte(Reader, Type);
+		OutMeta.Serialize(Reader);
+		return !Reader.IsError();
+	}
+
+	void CollectClassPaths(const TArray<FSaveChunk>& Chunks, TArray<FSoftObjectPath>& OutPaths)
+	{
+		for (const FSaveChunk& Chunk : Chunks)
+		{
+			// 字符串表按块去重，先标记本块中被类字段引用的下标
+			TBitArray<> bIsClassIndex(false, Chunk.StringTable.Num());
+			for (const FEnemySaveRecord& Record : Chunk.Records)
+			{
+				if (Chunk.StringTable.IsValidIndex(Record.EnemyClassIndex))
+				{
+					bIsClassIndex[Record.EnemyClassIndex] = true;
+				}
+				if (Chunk.StringTable.IsValidIndex(Record.WeaponClassIndex))
+				{
+					bIsClassIndex[Record.WeaponClassIndex] = true;
+				}
+			}
+
+			for (TConstSetBitIterator<> It(bIsClassIndex); It; ++It)
+			{
+				OutPaths.AddUnique(FSoftObjectPath(Chunk.StringTable[It.GetIndex()]));
+			}
+		}
+	}
+
+	// ========== 合并 ==========
+
+	namespace
+	{
+		UClass* ResolveClass(const FSaveChunk& Chunk, uint16 Index, UClass* RequiredBase)
+		{
+			if (!Chunk.StringTable.IsValidIndex(Index))
+			{
+				return nullptr;
+			}
+
+			UClass* Class = FSoftClassPath(Chunk.StringTable[Index]).TryLoadClass<UObject>();
+			return Class && Class->IsChildOf(RequiredBase) ? Class : nullptr;
+		}
+
+		FEnemySaveData ToSaveData(const FEnemySaveRecord& Record, const FSaveChunk& Chunk)
+		{
+			FEnemySaveData Data;
+			Data.SpawnerKey = static_cast<uint32>(Record.Key >> 32);
+			Data.SpawnIndex = static_cast<int32>(static_cast<uint32>(Record.Key));
+
+			Data.EnemyClass = ResolveClass(Chunk, Record.EnemyClassIndex, AEnemyBase::StaticClass());
+			Data.WeaponClass = ResolveClass(Chunk, Record.WeaponClassIndex, AActor::StaticClass());
+			Data.WeaponSocketName = Chunk.StringTable.IsValidIndex(Record.WeaponSocketIndex)
+				? FName(*Chunk.StringTable[Record.WeaponSocketIndex])
+				: NAME_None;
+
+			Data.Level = Record.Level;
+			Data.bIsDead = EnumHasAnyFlags(Record.Flags, ERecordFlags::Dead);
+			Data.CurrentHealth = Record.CurrentHealth;
+			Data.CurrentPoise = Record.CurrentPoise;
+			Data.EnemyState = static_cast<EEnemyState>(Record.EnemyState);
+			Data.Location = FVector(Record.Location);
+			Data.Rotation = FRotator(Record.Rotation);
+
+			Data.bIsStunned = EnumHasAnyFlags(Record.Flags, ERecordFlags::Stunned);
+			Data.StunRemainingTime = Record.StunRemainingTime;
+
+			Data.bIsFrozen = EnumHasAnyFlags(Record.Flags, ERecordFlags::Frozen);
+			Data.FrozenAnimPosition = Record.FrozenAnimPosition;
+			Data.StateBeforeFreeze = static_cast<EEnemyState>(Record.StateBeforeFreeze);
+			Data.MovementSpeedBeforeFreeze = Record.MovementSpeedBeforeFreeze;
+
+			return Data;
+		}
+
+		void BuildEnemyList(const TMap<uint64, FEnemySaveData>& RecordsByKey, TArray<FEnemySaveData>& OutEnemies)
+		{
+			OutEnemies.Reset(RecordsByKey.Num());
+			for (const TPair<uint64, FEnemySaveData>& Pair : RecordsByKey)
+			{
+				OutEnemies.Add(Pair.Value);
+			}
+
+			OutEnemies.Sort([](const FEnemySaveData& A, const FEnemySaveData& B)
+			{
+				return A.GetSaveKey() < B.GetSaveKey();
+			});
+		}
+	}
+
+	void ResolveChunks(const TArray<FSaveChunk>& Chunks, FBlackMythSaveSnapshot& OutSnapshot, TMap<uint64, FEnemySaveData>& OutRecordsByKey)
+	{
+		OutRecordsByKey.Reset();
+
+		for (const FSaveChunk& Chunk : Chunks)
+		{
+			// Full 块是完整状态，丢弃之前的所有记录
+			if (Chunk.Type == EChunkType::Full)
+			{
+				OutRecordsByKey.Reset();
+			}
+
+			for (const FEnemySaveRecord& Record : Chunk.Records)
+			{
+				if (EnumHasAnyFlags(Record.Flags, ERecordFlags::Removed))
+				{
+					OutRecordsByKey.Remove(Record.Key);
+				}
+				else
+				{
+					OutRecordsByKey.Add(Record.Key, ToSaveData(Record, Chunk));
+				}
+			}
+
+			OutSnapshot.Meta = Chunk.Meta;
+		}
+
+		BuildEnemyList(OutRecordsByKey, OutSnapshot.Enemies);
+	}
+
+	void ConvertLegacySave(const UBlackMythSaveGame& Legacy, FBlackMythSaveSnapshot& OutSnapshot, TMap<uint64, FEnemySaveData>& OutRecordsByKey)
+	{
+		FSaveMeta& Meta = OutSnapshot.Meta;
+		Meta.SaveName = Legacy.SaveName;
+		Meta.SaveTime = Legacy.SaveTime;
+		Meta.PlayerLocation = Legacy.PlayerLocation;
+		Meta.PlayerRotation = Legacy.PlayerRotation;
+		Meta.PlayerHealth = Legacy.PlayerHealth;
+		Meta.PlayerMaxHealth = Legacy.PlayerMaxHealth;
+		Meta.PlayerStamina = Legacy.PlayerStamina;
+		Meta.PlayerMaxStamina = Legacy.PlayerMaxStamina;
+		Meta.bHasRespawnPoint = Legacy.bHasRespawnPoint;
+		Meta.RespawnLocation = Legacy.RespawnLocation;
+		Meta.RespawnRotation = Legacy.RespawnRotation;
+		Meta.RespawnTempleID = Legacy.RespawnTempleID;
+
+		// 旧版记录只有 Spawner 名称：键取名称哈希（与 AEnemySpawner::GetSpawnerKey 一致），序号按出现顺序
+		TMap<uint32, int32> NextIndexBySpawner;
+		OutRecordsByKey.Reset();
+
+		for (const FEnemySaveData& LegacyData : Legacy.Enemies)
+		{
+			FEnemySaveData Data = LegacyData;
+			if (Data.SpawnIndex == INDEX_NONE)
+			{
+				Data.SpawnerKey = Data.SpawnerName.IsEmpty() ? 0 : FCrc::StrCrc32(*Data.SpawnerName);
+				Data.SpawnIndex = NextIndexBySpawner.FindOrAdd(Data.SpawnerKey)++;
+			}
+
+			OutRecordsByKey.Add(Data.GetSaveKey(), Data);
+		}
+
+		BuildEnemyList(OutRecordsByKey, OutSnapshot.Enemies);
+	}
+}
@@ -0,0 +1,193 @@
+// 存档二进制格式 - 带版本号的分块日志格式，支持增量（Delta）记录
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../BlackMythSaveGame.h"
+
+struct FStreamableHandle;
+
+/**
+ * 文件布局（所有数值小端）：
+ *
+ *   [Header]  uint32 Magic | uint16 Version | uint16 NumChunks
+ *   [Chunk]*  uint32 ChunkSize | 块内容（见 FSaveChunk::Serialize）
+ *
+ * 第一个块一定是 Full（全量），之后追加 Delta 块，只包含自上次存档以来发生变化的敌人。
+ * 读档时按顺序应用所有块，后写的记录覆盖先写的。Delta 块过多时重写为单个 Full 块。
+ *
+ * 每个块都带完整的元数据（存档名、玩家状态、重生点），以最后一个块为准。
+ * 类路径与 Socket 名称放在块内字符串表中，记录只保存下标。
+ */
+namespace BlackMythSave
+{
+	/** 'BMSV' */
+	constexpr uint32 Magic = 0x56534D42;
+
+	/** 格式版本（读取时兼容所有 <= 当前版本的文件） */
+	enum class EVersion : uint16
+	{
+		Initial = 1,
+
+		// 新版本加在这里
+		VersionPlusOne,
+		Latest = VersionPlusOne - 1
+	};
+
+	/** 字符串表中的空下标 */
+	constexpr uint16 InvalidStringIndex = MAX_uint16;
+
+	/** Delta 块数量达到此值时下一次存档重写为 Full */
+	constexpr int32 MaxDeltaChunks = 8;
+
+	enum class EChunkType : uint8
+	{
+		Full,
+		Delta
+	};
+
+	/** 记录标志位 */
+	enum class ERecordFlags : uint8
+	{
+		None       = 0,
+		Removed    = 1 << 0,   // 敌人已不存在（墓碑）
+		Dead       = 1 << 1,
+		Stunned    = 1 << 2,
+		Frozen     = 1 << 3
+	};
+	ENUM_CLASS_FLAGS(ERecordFlags);
+
+	/** 存档槽名称（与旧版 UBlackMythSaveGame 槽位一致） */
+	FString GetSlotName(int32 SlotIndex);
+}
+
+/**
+ * 存档元数据 + 玩家状态（每个块都完整写一份）
+ */
+struct FSaveMeta
+{
+	FString SaveName;
+	FDateTime SaveTime;
+
+	FVector PlayerLocation = FVector::ZeroVector;
+	FRotator PlayerRotation = FRotator::ZeroRotator;
+	float PlayerHealth = 100.0f;
+	float PlayerMaxHealth = 100.0f;
+	float PlayerStamina = 100.0f;
+	float PlayerMaxStamina = 100.0f;
+
+	bool bHasRespawnPoint = false;
+	FVector RespawnLocation = FVector::ZeroVector;
+	FRotator RespawnRotation = FRotator::ZeroRotator;
+	FName RespawnTempleID = NAME_None;
+
+	void Serialize(FArchive& Ar);
+};
+
+/**
+ * 二进制敌人记录（纯数据，不引用 UObject，可在工作线程序列化）
+ */
+struct FEnemySaveRecord
+{
+	uint64 Key = 0;
+	BlackMythSave::ERecordFlags Flags = BlackMythSave::ERecordFlags::None;
+
+	uint16 EnemyClassIndex = BlackMythSave::InvalidStringIndex;
+	uint16 WeaponClassIndex = BlackMythSave::InvalidStringIndex;
+	uint16 WeaponSocketIndex = BlackMythSave::InvalidStringIndex;
+
+	int32 Level = 1;
+	float CurrentHealth = 0.0f;
+	float CurrentPoise = 0.0f;
+	uint8 EnemyState = 0;
+	uint8 StateBeforeFreeze = 0;
+
+	FVector3f Location = FVector3f::ZeroVector;
+	FRotator3f Rotation = FRotator3f::ZeroRotator;
+
+	float StunRemainingTime = 0.0f;
+	float FrozenAnimPosition = 0.0f;
+	float MovementSpeedBeforeFreeze = 0.0f;
+
+	void Serialize(FArchive& Ar);
+};
+
+/**
+ * 一个存档块
+ */
+struct FSaveChunk
+{
+	BlackMythSave::EChunkType Type = BlackMythSave::EChunkType::Full;
+	FSaveMeta Meta;
+	TArray<FString> StringTable;
+	TArray<FEnemySaveRecord> Records;
+
+	void Serialize(FArchive& Ar);
+
+	/** 追加到字符串表（去重），返回下标 */
+	uint16 AddString(const FString& Value);
+};
+
+/**
+ * 读档得到的完整状态（所有块合并之后）
+ */
+struct FBlackMythSaveSnapshot
+{
+	FSaveMeta Meta;
+
+	/** 存活或已死亡的敌人（墓碑已剔除），按存档键排列 */
+	TArray<FEnemySaveData> Enemies;
+
+	/** 读档时预加载敌人类的句柄；关卡恢复分多帧生成敌人，结束前由它保持类不被回收 */
+	TSharedPtr<FStreamableHandle> ClassLoadHandle;
+};
+
+namespace BlackMythSave
+{
+	// ========== 游戏线程：FEnemySaveData <-> 二进制记录 ==========
+
+	/** 把内存中的敌人数据转为二进制记录，类路径/Socket 写入 Chunk 的字符串表 */
+	FEnemySaveRecord MakeRecord(const FEnemySaveData& Data, FSaveChunk& Chunk);
+
+	/** 墓碑记录 */
+	FEnemySaveRecord MakeRemovedRecord(uint64 Key);
+
+	/** 两份敌人数据在存档意义上是否相同（用于判断是否需要写 Delta） */
+	bool IsSaveEquivalent(const FEnemySaveData& A, const FEnemySaveData& B);
+
+	// ========== 任意线程：字节流读写 ==========
+
+	/** 序列化一个块（带长度前缀），追加到 OutBytes */
+	void AppendChunk(FSaveChunk& Chunk, TArray<uint8>& OutBytes);
+
+	/** 写文件头，NumChunks 为文件中块的总数 */
+	void WriteHeader(int32 NumChunks, TArray<uint8>& OutBytes);
+
+	/**
+	 * 解析文件
+	 * @param OutChunks 所有块（按写入顺序）
+	 * @param OutChunkBytesOffset 第一个块在文件中的偏移（之后的字节即为所有块的原始数据）
+	 * @return 格式/版本不匹配或数据损坏时返回 false
+	 */
+	bool ParseFile(const TArray<uint8>& Bytes, TArray<FSaveChunk>& OutChunks, int32& OutChunkBytesOffset);
+
+	/** 只读取最后一个块的元数据（跳过所有记录，用于存档列表显示名称） */
+	bool ReadLatestMeta(const TArray<uint8>& Bytes, FSaveMeta& OutMeta);
+
+	/** 文件是否为二进制格式（否则按旧版 USaveGame 处理） */
+	bool HasBinaryHeader(const TArray<uint8>& Bytes);
+
+	/** 收集所有块中引用的类路径（用于读档前异步预加载） */
+	void CollectClassPaths(const TArray<FSaveChunk>& Chunks, TArray<FSoftObjectPath>& OutPaths);
+
+	// ========== 游戏线程：合并 ==========
+
+	/**
+	 * 按顺序应用所有块，得到最终状态
+	 * 类路径在此解析（需要游戏线程；未预加载的类会同步加载）
+	 */
+	void ResolveChunks(const TArray<FSaveChunk>& Chunks, FBlackMythSaveSnapshot& OutSnapshot, TMap<uint64, FEnemySaveData>& OutRecordsByKey);
+
+	/** 旧版 UBlackMythSaveGame 转换为快照 */
+	void ConvertLegacySave(const UBlackMythSaveGame& Legacy, FBlackMythSaveSnapshot& OutSnapshot, TMap<uint64, FEnemySaveData>& OutRecordsByKey);
+}
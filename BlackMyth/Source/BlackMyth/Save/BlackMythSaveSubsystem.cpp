@@ -0,0 +1,418 @@
+// 存档子系统实现
+
+#include "BlackMythSaveSubsystem.h"
+#include "../Subsystems/ActorRegistrySubsystem.h"
+#include "../EnemySpawner.h"
+#include "../EnemyBase.h"
+#include "../WukongCharacter.h"
+#include "../Components/HealthComponent.h"
+#include "../Components/StaminaComponent.h"
+#include "Async/Async.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "../BlackMythStats.h"
+#include "../BlackMythLog.h"
+
+DECLARE_CYCLE_STAT(TEXT("Save Gather And Diff"), STAT_SaveGatherAndDiff, STATGROUP_BlackMyth);
+DECLARE_CYCLE_STAT(TEXT("Save Write Slot"), STAT_SaveWriteSlot, STATGROUP_BlackMyth);
+DECLARE_CYCLE_STAT(TEXT("Load Read And Parse"), STAT_LoadReadAndParse, STATGROUP_BlackMyth);
+DECLARE_CYCLE_STAT(TEXT("Load Resolve"), STAT_LoadResolve, STATGROUP_BlackMyth);
+
+// ========== USubsystem ==========
+
+void UBlackMythSaveSubsystem::Deinitialize()
+{
+	// 退出前确保文件已完整写入
+	WaitForPendingSave();
+
+	// 排队的存档：上一次写入的日志提交还在游戏线程队列里，不能拿来做差，直接整体重写
+	if (QueuedSlot != INDEX_NONE)
+	{
+		PendingSlot = INDEX_NONE;
+		Journals.Remove(QueuedSlot);
+		WriteSnapshotAsync(QueuedSlot, QueuedSnapshot);
+		QueuedSlot = INDEX_NONE;
+		WaitForPendingSave();
+	}
+
+	Super::Deinitialize();
+}
+
+UBlackMythSaveSubsystem* UBlackMythSaveSubsystem::Get(const UObject* WorldContextObject)
+{
+	UGameInstance* GameInstance = UGameplayStatics::GetGameInstance(WorldContextObject);
+	return GameInstance ? GameInstance->GetSubsystem<UBlackMythSaveSubsystem>() : nullptr;
+}
+
+// ========== 存档 ==========
+
+bool UBlackMythSaveSubsystem::SaveSlotAsync(int32 SlotIndex, const FString& SaveName)
+{
+	BLACKMYTH_SCOPE_CYCLE(STAT_SaveGatherAndDiff, TEXT("BlackMyth.Save.GatherAndDiff"));
+
+	FBlackMythSaveSnapshot Snapshot;
+	if (!GatherSnapshot(SaveName, Snapshot))
+	{
+		return false;
+	}
+
+	// 上一次写入完成（日志提交）后才能做差，先排队
+	if (IsSaveInProgress())
+	{
+		UE_LOG(LogBMSave, Log, TEXT("[Save] Slot %d is still being written, save to slot %d queued"), PendingSlot, SlotIndex);
+		QueuedSlot = SlotIndex;
+		QueuedSnapshot = MoveTemp(Snapshot);
+		return true;
+	}
+
+	WriteSnapshotAsync(SlotIndex, Snapshot);
+	return true;
+}
+
+void UBlackMythSaveSubsystem::WriteSnapshotAsync(int32 SlotIndex, const FBlackMythSaveSnapshot& Snapshot)
+{
+	using namespace BlackMythSave;
+
+	check(!IsSaveInProgress());
+
+	// 没有日志（本次运行中未读写过该槽位）时写 Full 覆盖，不在游戏线程读盘
+	const FSlotJournal* Journal = Journals.Find(SlotIndex);
+	const bool bWriteFull = !Journal || Journal->NumChunks == 0 || Journal->NumChunks - 1 >= MaxDeltaChunks;
+
+	// 游戏线程：做差并把 UObject 引用转换为字符串表
+	TSharedRef<FSaveChunk> Chunk = MakeShared<FSaveChunk>();
+	Chunk->Type = bWriteFull ? EChunkType::Full : EChunkType::Delta;
+	Chunk->Meta = Snapshot.Meta;
+
+	FSlotJournal NewJournal;
+	NewJournal.Records.Reserve(Snapshot.Enemies.Num());
+	NewJournal.NumChunks = bWriteFull ? 1 : Journal->NumChunks + 1;
+
+	for (const FEnemySaveData& Data : Snapshot.Enemies)
+	{
+		const uint64 Key = Data.GetSaveKey();
+		NewJournal.Records.Add(Key, Data);
+
+		const FEnemySaveData* Previous = bWriteFull ? nullptr : Journal->Records.Find(Key);
+		if (!Previous || !IsSaveEquivalent(*Previous, Data))
+		{
+			Chunk->Records.Add(MakeRecord(Data, *Chunk));
+		}
+	}
+
+	if (!bWriteFull)
+	{
+		// 上次存在、这次消失的敌人写墓碑
+		for (const TPair<uint64, FEnemySaveData>& Pair : Journal->Records)
+		{
+			if (!NewJournal.Records.Contains(Pair.Key))
+			{
+				Chunk->Records.Add(MakeRemovedRecord(Pair.Key));
+			}
+		}
+
+		NewJournal.ChunkBytes = Journal->ChunkBytes;
+	}
+
+	UE_LOG(LogBMSave, Log, TEXT("[Save] Slot %d: writing %s chunk with %d/%d enemy records"),
+		SlotIndex, bWriteFull ? TEXT("full") : TEXT("delta"), Chunk->Records.Num(), Snapshot.Enemies.Num());
+
+	PendingSlot = SlotIndex;
+	PendingSaveName = Snapshot.Meta.SaveName;
+	BLACKMYTH_TRACE_BOOKMARK(TEXT("Save slot %d"), SlotIndex);
+
+	// 工作线程：序列化块并写文件，完成后回到游戏线程提交日志
+	TWeakObjectPtr<UBlackMythSaveSubsystem> WeakThis(this);
+	PendingTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis, SlotIndex, Chunk, NewJournal = MoveTemp(NewJournal)]() mutable
+		{
+			BLACKMYTH_SCOPE_CYCLE(STAT_SaveWriteSlot, TEXT("BlackMyth.Save.WriteSlot"));
+
+			AppendChunk(*Chunk, NewJournal.ChunkBytes);
+
+			TArray<uint8> FileBytes;
+			FileBytes.Reserve(NewJournal.ChunkBytes.Num() + 8);
+			WriteHeader(NewJournal.NumChunks, FileBytes);
+			FileBytes.Append(NewJournal.ChunkBytes);
+
+			const bool bSuccess = UGameplayStatics::SaveDataToSlot(FileBytes, GetSlotName(SlotIndex), 0);
+
+			AsyncTask(ENamedThreads::GameThread,
+				[WeakThis, SlotIndex, bSuccess, NewJournal = MoveTemp(NewJournal)]() mutable
+				{
+					if (UBlackMythSaveSubsystem* This = WeakThis.Get())
+					{
+						This->OnSaveFinished(SlotIndex, bSuccess, MoveTemp(NewJournal));
+					}
+				});
+		});
+}
+
+void UBlackMythSaveSubsystem::OnSaveFinished(int32 SlotIndex, bool bSuccess, FSlotJournal&& NewJournal)
+{
+	FString SavedName = MoveTemp(PendingSaveName);
+	PendingSlot = INDEX_NONE;
+	PendingSaveName.Reset();
+
+	if (bSuccess)
+	{
+		UE_LOG(LogBMSave, Log, TEXT("[Save] Slot %d saved (%d chunks, %d bytes)"),
+			SlotIndex, NewJournal.NumChunks, NewJournal.ChunkBytes.Num());
+		Journals.Add(SlotIndex, MoveTemp(NewJournal));
+		SlotSaveNames.Add(SlotIndex, MoveTemp(SavedName));
+	}
+	else
+	{
+		// 文件状态未知，下次存档时整体重写
+		UE_LOG(LogBMSave, Error, TEXT("[Save] Failed to write slot %d"), SlotIndex);
+		Journals.Remove(SlotIndex);
+		SlotSaveNames.Remove(SlotIndex);
+	}
+
+	// 日志已提交，写入排队的存档
+	if (QueuedSlot != INDEX_NONE)
+	{
+		const int32 NextSlot = QueuedSlot;
+		QueuedSlot = INDEX_NONE;
+		WriteSnapshotAsync(NextSlot, QueuedSnapshot);
+		QueuedSnapshot = FBlackMythSaveSnapshot();
+	}
+}
+
+void UBlackMythSaveSubsystem::WaitForPendingSave()
+{
+	if (PendingTask.IsValid())
+	{
+		PendingTask.Wait();
+	}
+}
+
+bool UBlackMythSaveSubsystem::GatherSnapshot(const FString& SaveName, FBlackMythSaveSnapshot& OutSnapshot) const
+{
+	UWorld* World = GetWorld();
+	ACharacter* Player = World ? UGameplayStatics::GetPlayerCharacter(World, 0) : nullptr;
+	if (!Player)
+	{
+		return false;
+	}
+
+	FSaveMeta& Meta = OutSnapshot.Meta;
+	Meta.SaveName = SaveName;
+	Meta.SaveTime = FDateTime::Now();
+
+	// 玩家位置、朝向与属性
+	Meta.PlayerLocation = Player->GetActorLocation();
+	Meta.PlayerRotation = Player->GetActorRotation();
+
+	if (AWukongCharacter* Wukong = Cast<AWukongCharacter>(Player))
+	{
+		if (UHealthComponent* HealthComp = Wukong->GetHealthComponent())
+		{
+			Meta.PlayerHealth = HealthComp->GetCurrentHealth();
+			Meta.PlayerMaxHealth = HealthComp->GetMaxHealth();
+		}
+		if (UStaminaComponent* StaminaComp = Wukong->GetStaminaComponent())
+		{
+			Meta.PlayerStamina = StaminaComp->GetCurrentStamina();
+			Meta.PlayerMaxStamina = StaminaComp->GetMaxStamina();
+		}
+	}
+
+	// 所有生成器管理的敌人
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(World))
+	{
+		for (AEnemySpawner* Spawner : Registry->GetSpawners())
+		{
+			for (AEnemyBase* Enemy : Spawner->SpawnedEnemies)
+			{
+				if (IsValid(Enemy))
+				{
+					Enemy->WriteEnemySaveData(OutSnapshot.Enemies.AddDefaulted_GetRef());
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+// ========== 读档 ==========
+
+void UBlackMythSaveSubsystem::LoadSlotAsync(int32 SlotIndex, FOnSlotLoaded OnLoaded)
+{
+	BLACKMYTH_TRACE_BOOKMARK(TEXT("Load slot %d"), SlotIndex);
+
+	TSharedRef<FParsedSlot> Slot = MakeShared<FParsedSlot>();
+	TWeakObjectPtr<UBlackMythSaveSubsystem> WeakThis(this);
+
+	// 工作线程：读文件 + 解析（排在正在进行的写入之后）
+	UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis, SlotIndex, Slot, OnLoaded = MoveTemp(OnLoaded)]() mutable
+		{
+			ReadAndParseSlot(SlotIndex, *Slot);
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, SlotIndex, Slot, OnLoaded = MoveTemp(OnLoaded)]() mutable
+			{
+				UBlackMythSaveSubsystem* This = WeakThis.Get();
+				if (!This || !Slot->bValid)
+				{
+					OnLoaded(nullptr);
+					return;
+				}
+
+				// 游戏线程：异步预加载所有引用的类，完成后合并
+				TArray<FSoftObjectPath> ClassPaths;
+				BlackMythSave::CollectClassPaths(Slot->Chunks, ClassPaths);
+
+				TSharedRef<FOnSlotLoaded> SharedCallback = MakeShared<FOnSlotLoaded>(MoveTemp(OnLoaded));
+				TSharedRef<FBlackMythSaveSnapshot> Snapshot = MakeShared<FBlackMythSaveSnapshot>();
+				auto Resolve = [WeakThis, SlotIndex, Slot, Snapshot, SharedCallback]()
+				{
+					UBlackMythSaveSubsystem* Subsystem = WeakThis.Get();
+					if (!Subsystem || !Subsystem->ResolveParsedSlot(SlotIndex, *Slot, *Snapshot))
+					{
+						Snapshot->ClassLoadHandle.Reset();
+						(*SharedCallback)(nullptr);
+						return;
+					}
+					(*SharedCallback)(Snapshot);
+				};
+
+				if (ClassPaths.IsEmpty())
+				{
+					Resolve();
+				}
+				else
+				{
+					// 句柄随快照一起交给关卡恢复，恢复结束时释放
+					Snapshot->ClassLoadHandle = This->StreamableManager.RequestAsyncLoad(MoveTemp(ClassPaths), FStreamableDelegate::CreateLambda(Resolve));
+				}
+			});
+		},
+		UE::Tasks::Prerequisites(PendingTask));
+}
+
+void UBlackMythSaveSubsystem::ReadAndParseSlot(int32 SlotIndex, FParsedSlot& OutSlot)
+{
+	using namespace BlackMythSave;
+
+	BLACKMYTH_SCOPE_CYCLE(STAT_LoadReadAndParse, TEXT("BlackMyth.Load.ReadAndParse"));
+
+	if (!UGameplayStatics::LoadDataFromSlot(OutSlot.Bytes, GetSlotName(SlotIndex), 0))
+	{
+		return;
+	}
+
+	OutSlot.bBinary = HasBinaryHeader(OutSlot.Bytes);
+	if (!OutSlot.bBinary)
+	{
+		// 旧版 USaveGame 需要在游戏线程反序列化
+		OutSlot.bValid = true;
+		return;
+	}
+
+	OutSlot.bValid = ParseFile(OutSlot.Bytes, OutSlot.Chunks, OutSlot.ChunkBytesOffset);
+	if (!OutSlot.bValid)
+	{
+		UE_LOG(LogBMSave, Error, TEXT("[Save] Slot %d is corrupted"), SlotIndex);
+	}
+}
+
+bool UBlackMythSaveSubsystem::ResolveParsedSlot(int32 SlotIndex, const FParsedSlot& Slot, FBlackMythSaveSnapshot& OutSnapshot)
+{
+	using namespace BlackMythSave;
+
+	BLACKMYTH_SCOPE_CYCLE(STAT_LoadResolve, TEXT("BlackMyth.Load.Resolve"));
+
+	if (!Slot.bValid)
+	{
+		return false;
+	}
+
+	FSlotJournal Journal;
+
+	if (Slot.bBinary)
+	{
+		ResolveChunks(Slot.Chunks, OutSnapshot, Journal.Records);
+		Journal.ChunkBytes.Append(Slot.Bytes.GetData() + Slot.ChunkBytesOffset, Slot.Bytes.Num() - Slot.ChunkBytesOffset);
+		Journal.NumChunks = Slot.Chunks.Num();
+	}
+	else
+	{
+		// 旧版 USaveGame：NumChunks 保持 0，下次存档整体重写为新格式
+		const UBlackMythSaveGame* Legacy = Cast<UBlackMythSaveGame>(UGameplayStatics::LoadGameFromMemory(Slot.Bytes));
+		if (!Legacy)
+		{
+			return false;
+		}
+
+		ConvertLegacySave(*Legacy, OutSnapshot, Journal.Records);
+	}
+
+	// 写入进行中时不覆盖日志，写入完成后会提交更新的状态
+	if (PendingSlot != SlotIndex)
+	{
+		Journals.Add(SlotIndex, MoveTemp(Journal));
+		SlotSaveNames.Add(SlotIndex, OutSnapshot.Meta.SaveName);
+	}
+	return true;
+}
+
+bool UBlackMythSaveSubsystem::ReadSlotSaveName(int32 SlotIndex, FString& OutSaveName)
+{
+	using namespace BlackMythSave;
+
+	if (QueuedSlot == SlotIndex)
+	{
+		OutSaveName = QueuedSnapshot.Meta.SaveName;
+		return true;
+	}
+
+	if (PendingSlot == SlotIndex)
+	{
+		OutSaveName = PendingSaveName;
+		return true;
+	}
+
+	// 界面每次打开都会刷新，已知的名称直接返回
+	if (const FString* Cached = SlotSaveNames.Find(SlotIndex))
+	{
+		OutSaveName = *Cached;
+		return true;
+	}
+
+	TArray<uint8> Bytes;
+	if (!UGameplayStatics::LoadDataFromSlot(Bytes, GetSlotName(SlotIndex), 0))
+	{
+		return false;
+	}
+
+	if (HasBinaryHeader(Bytes))
+	{
+		// 只跳读块长度并反序列化最后一个块的元数据
+		FSaveMeta Meta;
+		if (!ReadLatestMeta(Bytes, Meta))
+		{
+			return false;
+		}
+
+		OutSaveName = Meta.SaveName;
+	}
+	else if (const UBlackMythSaveGame* Legacy = Cast<UBlackMythSaveGame>(UGameplayStatics::LoadGameFromMemory(Bytes)))
+	{
+		OutSaveName = Legacy->SaveName;
+	}
+	else
+	{
+		return false;
+	}
+
+	SlotSaveNames.Add(SlotIndex, OutSaveName);
+	return true;
+}
+
+bool UBlackMythSaveSubsystem::DoesSlotExist(int32 SlotIndex) const
+{
+	return PendingSlot == SlotIndex || QueuedSlot == SlotIndex || UGameplayStatics::DoesSaveGameExist(BlackMythSave::GetSlotName(SlotIndex), 0);
+}
@@ -0,0 +1,122 @@
+// 存档子系统 - 增量二进制存档的写入（工作线程）与读取
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
+#include "Engine/StreamableManager.h"
+#include "BlackMythSaveFormat.h"
+#include "BlackMythSaveSubsystem.generated.h"
+
+/**
+ * 存档子系统
+ * - 存档：游戏线程收集快照并与上次写入的状态做差，只把变化的敌人写成 Delta 块；
+ *   块序列化和文件写入在后台线程完成，不阻塞游戏线程
+ * - 读档：后台线程读取并解析文件，游戏线程异步预加载敌人/武器类后再合并所有块；
+ *   兼容旧版 UBlackMythSaveGame 存档（下次存档时自动转换为新格式）
+ *
+ * 每个槽位在内存中保留一份"已提交"的日志（最后写入的敌人状态 + 已有块的原始字节），
+ * 追加 Delta 时直接复用已有字节，无需重新序列化。日志在读档或写入完成时建立；
+ * 没有日志的槽位直接写 Full 块覆盖，存档时游戏线程从不读盘。
+ */
+UCLASS()
+class BLACKMYTH_API UBlackMythSaveSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual void Deinitialize() override;
+
+	/** 获取存档子系统（可能为空） */
+	static UBlackMythSaveSubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 存档 / 读档 ==========
+
+	/**
+	 * 异步保存当前世界状态到槽位
+	 * 已有存档正在写入时，快照立即收集并排队，写入完成后再写（只保留最后一次排队的存档）
+	 * @return 无法收集玩家状态时返回 false
+	 */
+	bool SaveSlotAsync(int32 SlotIndex, const FString& SaveName);
+
+	/** 读档完成回调，失败时快照为空 */
+	using FOnSlotLoaded = TFunction<void(TSharedPtr<const FBlackMythSaveSnapshot>)>;
+
+	/**
+	 * 异步读取槽位，回调在游戏线程执行
+	 * 若有存档正在写入，读取排在写入之后
+	 */
+	void LoadSlotAsync(int32 SlotIndex, FOnSlotLoaded OnLoaded);
+
+	/** 存档显示名称（优先取缓存；否则只读最后一个块的元数据，不解析敌人记录） */
+	bool ReadSlotSaveName(int32 SlotIndex, FString& OutSaveName);
+
+	bool DoesSlotExist(int32 SlotIndex) const;
+
+	bool IsSaveInProgress() const { return PendingSlot != INDEX_NONE; }
+
+private:
+	/** 槽位的已提交状态 */
+	struct FSlotJournal
+	{
+		/** 最后一次成功写入后的敌人状态（按存档键） */
+		TMap<uint64, FEnemySaveData> Records;
+
+		/** 文件中所有块的原始字节（不含文件头） */
+		TArray<uint8> ChunkBytes;
+
+		/** 文件中块的数量，0 表示下一次必须写 Full */
+		int32 NumChunks = 0;
+	};
+
+	/** 读取并解析后的原始槽位数据 */
+	struct FParsedSlot
+	{
+		TArray<uint8> Bytes;
+		TArray<FSaveChunk> Chunks;
+		int32 ChunkBytesOffset = 0;
+		bool bBinary = false;
+		bool bValid = false;
+	};
+
+	/** 读取文件并解析块（任意线程） */
+	static void ReadAndParseSlot(int32 SlotIndex, FParsedSlot& OutSlot);
+
+	/** 合并解析结果并建立日志（游戏线程） */
+	bool ResolveParsedSlot(int32 SlotIndex, const FParsedSlot& Slot, FBlackMythSaveSnapshot& OutSnapshot);
+
+	/** 在游戏线程收集玩家与敌人状态 */
+	bool GatherSnapshot(const FString& SaveName, FBlackMythSaveSnapshot& OutSnapshot) const;
+
+	/** 与日志做差并在工作线程写入（不能有正在进行的写入） */
+	void WriteSnapshotAsync(int32 SlotIndex, const FBlackMythSaveSnapshot& Snapshot);
+
+	/** 后台写入完成后在游戏线程提交日志 */
+	void OnSaveFinished(int32 SlotIndex, bool bSuccess, FSlotJournal&& NewJournal);
+
+	/** 等待正在进行的写入完成（文件落盘，日志提交仍在游戏线程排队） */
+	void WaitForPendingSave();
+
+	TMap<int32, FSlotJournal> Journals;
+
+	/** 正在写入的槽位（INDEX_NONE 表示空闲） */
+	int32 PendingSlot = INDEX_NONE;
+
+	/** 正在写入的存档名称（写入期间槽位信息直接显示此名称） */
+	FString PendingSaveName;
+
+	/** 排队等待写入的存档（INDEX_NONE 表示没有） */
+	int32 QueuedSlot = INDEX_NONE;
+	FBlackMythSaveSnapshot QueuedSnapshot;
+
+	/** 已知的槽位显示名称（写入/读档/首次读取名称时更新） */
+	TMap<int32, FString> SlotSaveNames;
+
+	UE::Tasks::FTask PendingTask;
+
+	/** 读档时预加载敌人/武器类 */
+	FStreamableManager StreamableManager;
+};
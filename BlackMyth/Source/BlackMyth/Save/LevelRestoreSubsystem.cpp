@@ -0,0 +1,238 @@
+// 关卡恢复子系统实现
+
+#include "LevelRestoreSubsystem.h"
+#include "../Subsystems/ActorRegistrySubsystem.h"
+#include "../Subsystems/ActorPoolSubsystem.h"
+#include "../EnemySpawner.h"
+#include "../EnemyBase.h"
+#include "../WukongCharacter.h"
+#include "../Components/HealthComponent.h"
+#include "../Components/StaminaComponent.h"
+#include "Engine/World.h"
+#include "Engine/StreamableManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "../BlackMythStats.h"
+#include "../BlackMythLog.h"
+
+DECLARE_CYCLE_STAT(TEXT("Load Restore Enemies"), STAT_LoadRestoreEnemies, STATGROUP_BlackMyth);
+
+// ========== USubsystem ==========
+
+bool ULevelRestoreSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId ULevelRestoreSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULevelRestoreSubsystem, STATGROUP_BlackMyth);
+}
+
+ULevelRestoreSubsystem* ULevelRestoreSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<ULevelRestoreSubsystem>() : nullptr;
+}
+
+// ========== 恢复流程 ==========
+
+void ULevelRestoreSubsystem::BeginRestore(TSharedRef<const FBlackMythSaveSnapshot> InSnapshot)
+{
+	Snapshot = InSnapshot;
+	NextRecordIndex = 0;
+	NumReused = 0;
+	NumSpawned = 0;
+	NumFrames = 0;
+	SpawnersByKey.Reset();
+	ExistingEnemies.Reset();
+	FallbackSpawner.Reset();
+
+	RestorePlayer(InSnapshot->Meta);
+
+	UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this);
+	if (!Registry)
+	{
+		Snapshot.Reset();
+		return;
+	}
+
+	// 按存档键建立 Spawner 与现有敌人的哈希表，记录匹配为 O(1)
+	for (AEnemySpawner* Spawner : Registry->GetSpawners())
+	{
+		SpawnersByKey.Add(Spawner->GetSpawnerKey(), Spawner);
+		if (!FallbackSpawner.IsValid())
+		{
+			FallbackSpawner = Spawner;
+		}
+
+		for (AEnemyBase* Enemy : Spawner->SpawnedEnemies)
+		{
+			if (!IsValid(Enemy))
+			{
+				continue;
+			}
+
+			// 同键的多余敌人不可能被认领，直接销毁
+			const uint64 Key = Enemy->GetSaveKey();
+			if (ExistingEnemies.Contains(Key))
+			{
+				Enemy->Destroy();
+				continue;
+			}
+			ExistingEnemies.Add(Key, Enemy);
+		}
+	}
+
+	UE_LOG(LogBMSave, Log, TEXT("[Restore] Restoring %d enemies (%d live, %d spawners)"),
+		InSnapshot->Enemies.Num(), ExistingEnemies.Num(), SpawnersByKey.Num());
+}
+
+void ULevelRestoreSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!Snapshot.IsValid())
+	{
+		return;
+	}
+
+	BLACKMYTH_SCOPE_CYCLE(STAT_LoadRestoreEnemies, TEXT("BlackMyth.Load.RestoreEnemies"));
+
+	++NumFrames;
+
+	// 保证每帧至少处理一条记录，之后按时间预算继续
+	const double Deadline = FPlatformTime::Seconds() + FrameBudgetMs * 0.001;
+	const TArray<FEnemySaveData>& Enemies = Snapshot->Enemies;
+
+	do
+	{
+		if (NextRecordIndex >= Enemies.Num())
+		{
+			FinishRestore();
+			return;
+		}
+
+		RestoreEnemy(Enemies[NextRecordIndex++]);
+	}
+	while (FPlatformTime::Seconds() < Deadline);
+}
+
+void ULevelRestoreSubsystem::RestorePlayer(const FSaveMeta& Meta)
+{
+	ACharacter* Player = UGameplayStatics::GetPlayerCharacter(this, 0);
+	if (!Player)
+	{
+		return;
+	}
+
+	// 恢复玩家位置和朝向
+	Player->SetActorLocation(Meta.PlayerLocation);
+	Player->SetActorRotation(Meta.PlayerRotation);
+
+	// 恢复玩家属性（血量和体力）
+	if (AWukongCharacter* Wukong = Cast<AWukongCharacter>(Player))
+	{
+		if (UHealthComponent* HealthComp = Wukong->GetHealthComponent())
+		{
+			HealthComp->SetHealth(Meta.PlayerHealth);
+		}
+		if (UStaminaComponent* StaminaComp = Wukong->GetStaminaComponent())
+		{
+			// 通过计算差值来精确恢复体力值
+			const float StaminaDiff = Meta.PlayerStamina - StaminaComp->GetCurrentStamina();
+			if (StaminaDiff > 0)
+			{
+				StaminaComp->RestoreStamina(StaminaDiff);
+			}
+			else if (StaminaDiff < 0)
+			{
+				StaminaComp->ConsumeStamina(-StaminaDiff);
+			}
+		}
+	}
+}
+
+void ULevelRestoreSubsystem::RestoreEnemy(const FEnemySaveData& Data)
+{
+	// 验证敌人数据有效性
+	if (!Data.EnemyClass || Data.SpawnIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	// 同键、同类且仍然存活的敌人直接复用，避免销毁/重新生成
+	TWeakObjectPtr<AEnemyBase> Existing;
+	ExistingEnemies.RemoveAndCopyValue(Data.GetSaveKey(), Existing);
+
+	if (AEnemyBase* Enemy = Existing.Get())
+	{
+		if (Enemy->GetClass() == Data.EnemyClass.Get() && Enemy->ResetForRestore())
+		{
+			Enemy->LoadEnemySaveData(Data);
+			++NumReused;
+			return;
+		}
+
+		// 回收后 Spawner 生成时可以直接复用（启用对象池时）
+		UActorPoolSubsystem::ReleaseOrDestroy(Enemy);
+	}
+
+	TWeakObjectPtr<AEnemySpawner>* SpawnerPtr = SpawnersByKey.Find(Data.SpawnerKey);
+	AEnemySpawner* Spawner = SpawnerPtr ? SpawnerPtr->Get() : FallbackSpawner.Get();
+	if (!Spawner)
+	{
+		return;
+	}
+
+	if (AEnemyBase* NewEnemy = Spawner->SpawnEnemy(Data.EnemyClass, Data.Location, Data.Rotation, Data.Level))
+	{
+		NewEnemy->LoadEnemySaveData(Data);
+		Spawner->ClaimSpawnIndex(Data.SpawnIndex);
+		++NumSpawned;
+	}
+}
+
+void ULevelRestoreSubsystem::FinishRestore()
+{
+	// 存档中不存在的敌人
+	int32 NumDestroyed = 0;
+	for (const TPair<uint64, TWeakObjectPtr<AEnemyBase>>& Pair : ExistingEnemies)
+	{
+		if (AEnemyBase* Enemy = Pair.Value.Get())
+		{
+			UActorPoolSubsystem::ReleaseOrDestroy(Enemy);
+			++NumDestroyed;
+		}
+	}
+
+	// 一次性压缩所有 Spawner 的敌人列表（逐个 Remove 是 O(n^2)）
+	for (const TPair<uint32, TWeakObjectPtr<AEnemySpawner>>& Pair : SpawnersByKey)
+	{
+		if (AEnemySpawner* Spawner = Pair.Value.Get())
+		{
+			Spawner->SpawnedEnemies.RemoveAll([](const AEnemyBase* Enemy)
+			{
+				return !IsValid(Enemy);
+			});
+		}
+	}
+
+	UE_LOG(LogBMSave, Log, TEXT("[Restore] Finished in %d frames: %d reused, %d spawned, %d destroyed"),
+		NumFrames, NumReused, NumSpawned, NumDestroyed);
+
+	// 敌人都已生成，预加载的类不再需要额外持有
+	if (Snapshot->ClassLoadHandle.IsValid())
+	{
+		Snapshot->ClassLoadHandle->ReleaseHandle();
+	}
+
+	Snapshot.Reset();
+	SpawnersByKey.Reset();
+	ExistingEnemies.Reset();
+	FallbackSpawner.Reset();
+}
@@ -0,0 +1,73 @@
+// 关卡恢复子系统 - 把读档快照分帧应用到当前世界
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BlackMythSaveFormat.h"
+#include "LevelRestoreSubsystem.generated.h"
+
+class AEnemySpawner;
+class AEnemyBase;
+
+/**
+ * 关卡恢复子系统
+ * 读档快照到达后：
+ * 1. 立即恢复玩家状态，按存档键建立 Spawner 哈希表和现有敌人哈希表
+ * 2. 每帧在时间预算内处理一批敌人记录：键与类都匹配的存活敌人直接复用并覆盖状态，
+ *    否则销毁旧敌人后重新生成
+ * 3. 销毁存档中不存在的敌人，压缩各 Spawner 的敌人列表
+ */
+UCLASS()
+class BLACKMYTH_API ULevelRestoreSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// ========== FTickableGameObject ==========
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return Snapshot.IsValid(); }
+
+	/** 获取世界的恢复子系统（可能为空） */
+	static ULevelRestoreSubsystem* Get(const UObject* WorldContextObject);
+
+	/** 开始恢复（会取消正在进行的恢复） */
+	void BeginRestore(TSharedRef<const FBlackMythSaveSnapshot> InSnapshot);
+
+	bool IsRestoring() const { return Snapshot.IsValid(); }
+
+	/** 每帧用于恢复敌人的时间预算（毫秒） */
+	float FrameBudgetMs = 4.0f;
+
+private:
+	void RestorePlayer(const FSaveMeta& Meta);
+
+	/** 应用单条敌人记录 */
+	void RestoreEnemy(const FEnemySaveData& Data);
+
+	/** 销毁剩余敌人并压缩 Spawner 列表 */
+	void FinishRestore();
+
+	TSharedPtr<const FBlackMythSaveSnapshot> Snapshot;
+
+	/** 下一条要处理的记录 */
+	int32 NextRecordIndex = 0;
+
+	TMap<uint32, TWeakObjectPtr<AEnemySpawner>> SpawnersByKey;
+
+	/** 恢复开始时存在、尚未被记录认领的敌人 */
+	TMap<uint64, TWeakObjectPtr<AEnemyBase>> ExistingEnemies;
+
+	/** 找不到对应 Spawner 时的后备 Spawner */
+	TWeakObjectPtr<AEnemySpawner> FallbackSpawner;
+
+	int32 NumReused = 0;
+	int32 NumSpawned = 0;
+	int32 NumFrames = 0;
+};
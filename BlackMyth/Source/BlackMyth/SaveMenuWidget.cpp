@@ -1,12 +1,5 @@
 #include "SaveMenuWidget.h"
-#include "Kismet/GameplayStatics.h"
-#include "GameFramework/Character.h"
-#include "BlackMythSaveGame.h"
-#include "WukongCharacter.h"
-#include "EnemySpawner.h"
-#include "EnemyBase.h"
-#include "Components/HealthComponent.h"
-#include "Components/StaminaComponent.h"
+#include "Save/BlackMythSaveSubsystem.h"
 
 void USaveMenuWidget::OnSaveSlotClicked(int32 SlotIndex)
 {
@@ -22,82 +15,35 @@ void USaveMenuWidget::OnSaveSlotClicked(int32 SlotIndex)
         return;
     }
 
-    ACharacter* Player = UGameplayStatics::GetPlayerCharacter(World, 0);
-    if (!Player)
+    UBlackMythSaveSubsystem* SaveSubsystem = UBlackMythSaveSubsystem::Get(World);
+    if (!SaveSubsystem)
     {
         return;
     }
 
-    // 创建存档对象
-    UBlackMythSaveGame* SaveGame = Cast<UBlackMythSaveGame>(
-        UGameplayStatics::CreateSaveGameObject(
-            UBlackMythSaveGame::StaticClass()));
-
-    if (!SaveGame)
+    // 设置存档名称（优先使用用户输入）
+    FString SaveName;
+    if (SaveNameTextBox && !SaveNameTextBox->GetText().IsEmpty())
     {
-        return;
+        SaveName = SaveNameTextBox->GetText().ToString();
     }
-
-    // 保存玩家位置和朝向
-    SaveGame->PlayerLocation = Player->GetActorLocation();
-    SaveGame->PlayerRotation = Player->GetActorRotation();
-
-    // 保存玩家属性（血量和体力）
-    if (AWukongCharacter* Wukong = Cast<AWukongCharacter>(Player))
+    else
     {
-        if (UHealthComponent* HealthComp = Wukong->GetHealthComponent())
-        {
-            SaveGame->PlayerHealth = HealthComp->GetCurrentHealth();
-            SaveGame->PlayerMaxHealth = HealthComp->GetMaxHealth();
-        }
-        if (UStaminaComponent* StaminaComp = Wukong->GetStaminaComponent())
-        {
-            SaveGame->PlayerStamina = StaminaComp->GetCurrentStamina();
-            SaveGame->PlayerMaxStamina = StaminaComp->GetMaxStamina();
-        }
+        SaveName = FString::Printf(TEXT("Save Slot %d"), SlotIndex);
     }
 
-    // 保存所有敌人状态
-    TArray<AActor*> FoundSpawners;
-    UGameplayStatics::GetAllActorsOfClass(World, AEnemySpawner::StaticClass(), FoundSpawners);
-
-    SaveGame->Enemies.Empty();
-
-    // 遍历所有生成器，保存其生成的敌人数据
-    for (AActor* SpawnerActor : FoundSpawners)
+    // 收集状态并在后台线程写入（只写入自上次存档以来变化的敌人）
+    // 上一次存档仍在写入时会排队，写完后自动写入
+    if (!SaveSubsystem->SaveSlotAsync(SlotIndex, SaveName))
     {
-        AEnemySpawner* Spawner = Cast<AEnemySpawner>(SpawnerActor);
-        if (Spawner)
+        // 保存失败，菜单保持打开并在槽位上提示
+        if (UTextBlock* SlotText = GetSlotText(SlotIndex))
         {
-            for (AEnemyBase* Enemy : Spawner->SpawnedEnemies)
-            {
-                if (IsValid(Enemy))
-                {
-                    FEnemySaveData Data;
-                    Enemy->WriteEnemySaveData(Data);
-                    SaveGame->Enemies.Add(Data);
-                }
-            }
+            SlotText->SetText(FText::FromString(TEXT("存档失败")));
         }
+        return;
     }
 
-    // 设置存档名称（优先使用用户输入）
-    if (SaveNameTextBox && !SaveNameTextBox->GetText().IsEmpty())
-    {
-        SaveGame->SaveName = SaveNameTextBox->GetText().ToString();
-    }
-    else
-    {
-        SaveGame->SaveName = FString::Printf(TEXT("Save Slot %d"), SlotIndex);
-    }
-
-    // 记录存档时间戳
-    SaveGame->SaveTime = FDateTime::Now();
-
-    // 写入存档文件
-    const FString SlotName = FString::Printf(TEXT("SaveSlot_%d"), SlotIndex);
-    UGameplayStatics::SaveGameToSlot(SaveGame, SlotName, 0);
-
     // 关闭保存菜单UI
     RemoveFromParent();
 }
@@ -112,6 +58,17 @@ void USaveMenuWidget::NativeConstruct()
     UpdateSlotInfo(3, SaveSlot3Text);
 }
 
+UTextBlock* USaveMenuWidget::GetSlotText(int32 SlotIndex) const
+{
+    switch (SlotIndex)
+    {
+    case 1: return SaveSlot1Text;
+    case 2: return SaveSlot2Text;
+    case 3: return SaveSlot3Text;
+    default: return nullptr;
+    }
+}
+
 void USaveMenuWidget::UpdateSlotInfo(int32 SlotIndex, UTextBlock* Text)
 {
     if (!Text)
@@ -119,20 +76,13 @@ void USaveMenuWidget::UpdateSlotInfo(int32 SlotIndex, UTextBlock* Text)
         return;
     }
 
-    const FString SlotName = FString::Printf(TEXT("SaveSlot_%d"), SlotIndex);
-
-    // 检查存档是否存在
-    if (UGameplayStatics::DoesSaveGameExist(SlotName, 0))
+    // 读取已有存档的名称
+    FString SaveName;
+    UBlackMythSaveSubsystem* SaveSubsystem = UBlackMythSaveSubsystem::Get(this);
+    if (SaveSubsystem && SaveSubsystem->ReadSlotSaveName(SlotIndex, SaveName))
     {
-        UBlackMythSaveGame* SaveGame = Cast<UBlackMythSaveGame>(
-            UGameplayStatics::LoadGameFromSlot(SlotName, 0));
-
-        if (SaveGame)
-        {
-            // 显示已有存档的名称
-            Text->SetText(FText::FromString(SaveGame->SaveName));
-            return;
-        }
+        Text->SetText(FText::FromString(SaveName));
+        return;
     }
 
     // 存档不存在，显示空存档
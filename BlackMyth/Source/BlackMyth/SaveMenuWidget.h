@@ -24,6 +24,9 @@ protected:
 	/** 更新指定存档槽的显示文本。 */
 	void UpdateSlotInfo(int32 SlotIndex, UTextBlock* Text);
 
+	/** 存档槽（1~3）对应的显示文本。 */
+	UTextBlock* GetSlotText(int32 SlotIndex) const;
+
 public:
 	/** 存档名称输入框。 */
 	UPROPERTY(meta = (BindWidget))
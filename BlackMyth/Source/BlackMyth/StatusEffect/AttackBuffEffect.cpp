@@ -2,6 +2,7 @@
 
 #include "AttackBuffEffect.h"
 #include "../Components/CombatComponent.h"
+#include "../Combat/CombatActorInterface.h"
 
 UAttackBuffEffect::UAttackBuffEffect()
 {
@@ -13,42 +14,42 @@ UAttackBuffEffect::UAttackBuffEffect()
 	EmissiveIntensity = 0.0f;
 }
 
-void UAttackBuffEffect::OnApplied_Implementation()
+void UAttackBuffEffect::OnApplied(FStatusEffectContext& Context) const
 {
-	Super::OnApplied_Implementation();
+	Super::OnApplied(Context);
 
-	AActor* Target = GetOwnerActor();
+	AActor* Target = Context.Owner;
 	if (!Target) return;
 
-	if (UCombatComponent* Combat = Target->FindComponentByClass<UCombatComponent>())
+	if (UCombatComponent* Combat = ICombatActor::GetCombat(Target))
 	{
 		// 保存原始攻击力加成
-		OriginalAttackBonus = Combat->GetAttackPowerBonus();
+		Context.SavedValue = Combat->GetAttackPowerBonus();
 
 		// 计算并应用攻击力提升
 		float BaseAttack = Combat->GetBaseAttackPower();
 		float BonusIncrease = BaseAttack * (AttackMultiplier - 1.0f);
-		Combat->SetAttackPowerBonus(OriginalAttackBonus + BonusIncrease);
+		Combat->SetAttackPowerBonus(Context.SavedValue + BonusIncrease);
 
 		UE_LOG(LogTemp, Log, TEXT("AttackBuffEffect: Applied to %s, BaseAttack=%.1f, Bonus=%.1f -> %.1f"),
-			*Target->GetName(), BaseAttack, OriginalAttackBonus, Combat->GetAttackPowerBonus());
+			*Target->GetName(), BaseAttack, Context.SavedValue, Combat->GetAttackPowerBonus());
 	}
 }
 
-void UAttackBuffEffect::OnRemoved_Implementation()
+void UAttackBuffEffect::OnRemoved(const FStatusEffectContext& Context) const
 {
-	AActor* Target = GetOwnerActor();
+	AActor* Target = Context.Owner;
 	if (Target)
 	{
-		if (UCombatComponent* Combat = Target->FindComponentByClass<UCombatComponent>())
+		if (UCombatComponent* Combat = ICombatActor::GetCombat(Target))
 		{
 			// 恢复原始攻击力加成
-			Combat->SetAttackPowerBonus(OriginalAttackBonus);
+			Combat->SetAttackPowerBonus(Context.SavedValue);
 
 			UE_LOG(LogTemp, Log, TEXT("AttackBuffEffect: Removed from %s, Bonus restored to %.1f"),
-				*Target->GetName(), OriginalAttackBonus);
+				*Target->GetName(), Context.SavedValue);
 		}
 	}
 
-	Super::OnRemoved_Implementation();
+	Super::OnRemoved(Context);
 }
@@ -18,14 +18,11 @@ class BLACKMYTH_API UAttackBuffEffect : public UStatusEffectBase
 public:
 	UAttackBuffEffect();
 
-	virtual void OnApplied_Implementation() override;
-	virtual void OnRemoved_Implementation() override;
+	/** 施加时把原始攻击力加成保存到 Context.SavedValue，用于移除时恢复 */
+	virtual void OnApplied(FStatusEffectContext& Context) const override;
+	virtual void OnRemoved(const FStatusEffectContext& Context) const override;
 
 	/** Buff倍率（1.3 = 提升30%攻击力） */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Buff")
 	float AttackMultiplier = 1.3f;
-
-private:
-	/** 保存原始攻击力加成，用于移除时恢复 */
-	float OriginalAttackBonus = 0.0f;
 };
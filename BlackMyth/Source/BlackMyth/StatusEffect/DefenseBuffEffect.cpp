@@ -2,6 +2,7 @@
 
 #include "DefenseBuffEffect.h"
 #include "../Components/HealthComponent.h"
+#include "../Combat/CombatActorInterface.h"
 
 UDefenseBuffEffect::UDefenseBuffEffect()
 {
@@ -13,14 +14,14 @@ UDefenseBuffEffect::UDefenseBuffEffect()
 	EmissiveIntensity = 0.0f;
 }
 
-void UDefenseBuffEffect::OnApplied_Implementation()
+void UDefenseBuffEffect::OnApplied(FStatusEffectContext& Context) const
 {
-	Super::OnApplied_Implementation();
+	Super::OnApplied(Context);
 
-	AActor* Target = GetOwnerActor();
+	AActor* Target = Context.Owner;
 	if (!Target) return;
 
-	if (UHealthComponent* Health = Target->FindComponentByClass<UHealthComponent>())
+	if (UHealthComponent* Health = ICombatActor::GetHealth(Target))
 	{
 		// 设置伤害减免倍率
 		Health->DamageReductionMultiplier = DamageReductionMultiplier;
@@ -30,12 +31,12 @@ void UDefenseBuffEffect::OnApplied_Implementation()
 	}
 }
 
-void UDefenseBuffEffect::OnRemoved_Implementation()
+void UDefenseBuffEffect::OnRemoved(const FStatusEffectContext& Context) const
 {
-	AActor* Target = GetOwnerActor();
+	AActor* Target = Context.Owner;
 	if (Target)
 	{
-		if (UHealthComponent* Health = Target->FindComponentByClass<UHealthComponent>())
+		if (UHealthComponent* Health = ICombatActor::GetHealth(Target))
 		{
 			// 恢复为无减免
 			Health->DamageReductionMultiplier = 1.0f;
@@ -45,5 +46,5 @@ void UDefenseBuffEffect::OnRemoved_Implementation()
 		}
 	}
 
-	Super::OnRemoved_Implementation();
+	Super::OnRemoved(Context);
 }
@@ -18,8 +18,8 @@ class BLACKMYTH_API UDefenseBuffEffect : public UStatusEffectBase
 public:
 	UDefenseBuffEffect();
 
-	virtual void OnApplied_Implementation() override;
-	virtual void OnRemoved_Implementation() override;
+	virtual void OnApplied(FStatusEffectContext& Context) const override;
+	virtual void OnRemoved(const FStatusEffectContext& Context) const override;
 
 	/** 伤害减免倍率（0.5 = 减免50%伤害） */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "Buff")
@@ -12,11 +12,11 @@ UHealingIndicatorEffect::UHealingIndicatorEffect()
 	EmissiveIntensity = 0.0f;
 }
 
-void UHealingIndicatorEffect::OnApplied_Implementation()
+void UHealingIndicatorEffect::OnApplied(FStatusEffectContext& Context) const
 {
-	Super::OnApplied_Implementation();
+	Super::OnApplied(Context);
 
-	AActor* Target = GetOwnerActor();
+	AActor* Target = Context.Owner;
 	if (Target)
 	{
 		UE_LOG(LogTemp, Log, TEXT("HealingIndicatorEffect: Applied to %s (display only, healing was already done)"),
@@ -24,13 +24,13 @@ void UHealingIndicatorEffect::OnApplied_Implementation()
 	}
 }
 
-void UHealingIndicatorEffect::OnRemoved_Implementation()
+void UHealingIndicatorEffect::OnRemoved(const FStatusEffectContext& Context) const
 {
-	AActor* Target = GetOwnerActor();
+	AActor* Target = Context.Owner;
 	if (Target)
 	{
 		UE_LOG(LogTemp, Log, TEXT("HealingIndicatorEffect: Removed from %s"), *Target->GetName());
 	}
 
-	Super::OnRemoved_Implementation();
+	Super::OnRemoved(Context);
 }
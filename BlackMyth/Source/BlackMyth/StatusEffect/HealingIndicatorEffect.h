@@ -19,6 +19,6 @@ public:
 	UHealingIndicatorEffect();
 
 protected:
-	virtual void OnApplied_Implementation() override;
-	virtual void OnRemoved_Implementation() override;
+	virtual void OnApplied(FStatusEffectContext& Context) const override;
+	virtual void OnRemoved(const FStatusEffectContext& Context) const override;
 };
@@ -1,8 +1,6 @@
 // 中毒效果实现
 
 #include "PoisonEffect.h"
-#include "../Components/HealthComponent.h"
-#include "GameFramework/Actor.h"
 
 UPoisonEffect::UPoisonEffect()
 {
@@ -20,56 +18,27 @@ UPoisonEffect::UPoisonEffect()
 	// 默认伤害配置
 	DamagePerSecond = 10.0f;
 	DamageInterval = 0.5f;
-	AccumulatedTime = 0.0f;
 }
 
-void UPoisonEffect::OnApplied_Implementation()
+void UPoisonEffect::OnApplied(FStatusEffectContext& Context) const
 {
-	Super::OnApplied_Implementation();
-
-	// 重置累计时间
-	AccumulatedTime = 0.0f;
+	Super::OnApplied(Context);
 
 	UE_LOG(LogTemp, Log, TEXT("[PoisonEffect] Applied - DPS: %.1f, Interval: %.1f"),
 		DamagePerSecond, DamageInterval);
 }
 
-void UPoisonEffect::OnTick_Implementation(float DeltaTime)
+void UPoisonEffect::OnRemoved(const FStatusEffectContext& Context) const
 {
-	// 调用基类更新剩余时间
-	Super::OnTick_Implementation(DeltaTime);
-
-	// 累计时间
-	AccumulatedTime += DeltaTime;
-
-	// 检查是否到达伤害间隔
-	if (AccumulatedTime >= DamageInterval)
-	{
-		// 计算本次伤害
-		float DamageThisTick = DamagePerSecond * DamageInterval;
-
-		// 获取目标的 HealthComponent 并造成伤害
-		AActor* Owner = OwnerActor.Get();
-		if (Owner)
-		{
-			UHealthComponent* HealthComp = Owner->FindComponentByClass<UHealthComponent>();
-			if (HealthComp)
-			{
-				HealthComp->TakeDamage(DamageThisTick, Instigator.Get());
+	Super::OnRemoved(Context);
 
-				UE_LOG(LogTemp, Verbose, TEXT("[PoisonEffect] Dealt %.1f damage to %s"),
-					DamageThisTick, *Owner->GetName());
-			}
-		}
-
-		// 重置累计时间
-		AccumulatedTime = 0.0f;
-	}
+	UE_LOG(LogTemp, Log, TEXT("[PoisonEffect] Removed"));
 }
 
-void UPoisonEffect::OnRemoved_Implementation()
+bool UPoisonEffect::GetPeriodicDamage(float& OutInterval, float& OutDamagePerTick) const
 {
-	Super::OnRemoved_Implementation();
-
-	UE_LOG(LogTemp, Log, TEXT("[PoisonEffect] Removed"));
+	// 每隔 DamageInterval 造成一次伤害，由子系统批量累计并通过缓存的 HealthComponent 结算
+	OutInterval = DamageInterval;
+	OutDamagePerTick = DamagePerSecond * DamageInterval;
+	return DamageInterval > 0.0f && DamagePerSecond > 0.0f;
 }
@@ -17,9 +17,9 @@ public:
 
 	// ========== 生命周期重写 ==========
 
-	virtual void OnApplied_Implementation() override;
-	virtual void OnTick_Implementation(float DeltaTime) override;
-	virtual void OnRemoved_Implementation() override;
+	virtual void OnApplied(FStatusEffectContext& Context) const override;
+	virtual void OnRemoved(const FStatusEffectContext& Context) const override;
+	virtual bool GetPeriodicDamage(float& OutInterval, float& OutDamagePerTick) const override;
 
 protected:
 	// ========== 中毒效果属性 ==========
@@ -31,7 +31,4 @@ protected:
 	/** 两次伤害之间的时间间隔 */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Poison", meta = (ClampMin = "0.1"))
 	float DamageInterval = 0.5f;
-
-	/** 累计时间（用于计算下次伤害） */
-	float AccumulatedTime = 0.0f;
 };
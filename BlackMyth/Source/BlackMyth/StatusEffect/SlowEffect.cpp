@@ -16,22 +16,14 @@ USlowEffect::USlowEffect()
 
 	// 默认减速配置
 	SpeedMultiplier = 0.5f;
-	OriginalWalkSpeed = 0.0f;
-	bSpeedModified = false;
 }
 
-void USlowEffect::OnApplied_Implementation()
+void USlowEffect::OnApplied(FStatusEffectContext& Context) const
 {
-	Super::OnApplied_Implementation();
+	Super::OnApplied(Context);
 
 	// 获取角色的移动组件
-	AActor* Owner = OwnerActor.Get();
-	if (!Owner)
-	{
-		return;
-	}
-
-	ACharacter* Character = Cast<ACharacter>(Owner);
+	ACharacter* Character = Cast<ACharacter>(Context.Owner);
 	if (!Character)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("[SlowEffect] Owner is not a Character, cannot apply slow!"));
@@ -45,47 +37,32 @@ void USlowEffect::OnApplied_Implementation()
 		return;
 	}
 
-	// 保存原始速度
-	OriginalWalkSpeed = MoveComp->MaxWalkSpeed;
+	// 保存原始速度（SavedValue 为 0 表示未应用减速）
+	Context.SavedValue = MoveComp->MaxWalkSpeed;
 
 	// 应用减速
 	MoveComp->MaxWalkSpeed *= SpeedMultiplier;
-	bSpeedModified = true;
 
 	UE_LOG(LogTemp, Log, TEXT("[SlowEffect] Applied - Original Speed: %.1f, New Speed: %.1f (%.0f%% slow)"),
-		OriginalWalkSpeed, MoveComp->MaxWalkSpeed, (1.0f - SpeedMultiplier) * 100.0f);
+		Context.SavedValue, MoveComp->MaxWalkSpeed, (1.0f - SpeedMultiplier) * 100.0f);
 }
 
-void USlowEffect::OnTick_Implementation(float DeltaTime)
-{
-	// 调用基类更新剩余时间
-	Super::OnTick_Implementation(DeltaTime);
-}
-
-void USlowEffect::OnRemoved_Implementation()
+void USlowEffect::OnRemoved(const FStatusEffectContext& Context) const
 {
 	// 恢复原始速度
-	if (bSpeedModified)
+	if (Context.SavedValue > 0.0f)
 	{
-		AActor* Owner = OwnerActor.Get();
-		if (Owner)
+		if (ACharacter* Character = Cast<ACharacter>(Context.Owner))
 		{
-			ACharacter* Character = Cast<ACharacter>(Owner);
-			if (Character)
+			if (UCharacterMovementComponent* MoveComp = Character->GetCharacterMovement())
 			{
-				UCharacterMovementComponent* MoveComp = Character->GetCharacterMovement();
-				if (MoveComp)
-				{
-					MoveComp->MaxWalkSpeed = OriginalWalkSpeed;
+				MoveComp->MaxWalkSpeed = Context.SavedValue;
 
-					UE_LOG(LogTemp, Log, TEXT("[SlowEffect] Removed - Speed restored to: %.1f"),
-						OriginalWalkSpeed);
-				}
+				UE_LOG(LogTemp, Log, TEXT("[SlowEffect] Removed - Speed restored to: %.1f"),
+					Context.SavedValue);
 			}
 		}
-
-		bSpeedModified = false;
 	}
 
-	Super::OnRemoved_Implementation();
+	Super::OnRemoved(Context);
 }
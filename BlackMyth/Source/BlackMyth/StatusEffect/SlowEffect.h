@@ -17,9 +17,8 @@ public:
 
 	// ========== 生命周期重写 ==========
 
-	virtual void OnApplied_Implementation() override;
-	virtual void OnTick_Implementation(float DeltaTime) override;
-	virtual void OnRemoved_Implementation() override;
+	virtual void OnApplied(FStatusEffectContext& Context) const override;
+	virtual void OnRemoved(const FStatusEffectContext& Context) const override;
 
 protected:
 	// ========== 减速效果属性 ==========
@@ -27,10 +26,4 @@ protected:
 	/** 速度倍率（0.5即速度变为原来的50%） */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Slow", meta = (ClampMin = "0.1", ClampMax = "1.0"))
 	float SpeedMultiplier = 0.5f;
-
-	/** 保存原始行走速度 */
-	float OriginalWalkSpeed = 0.0f;
-
-	/** 是否已应用减速（防止重复应用） */
-	bool bSpeedModified = false;
 };
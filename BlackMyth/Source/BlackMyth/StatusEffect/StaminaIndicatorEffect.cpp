@@ -12,11 +12,11 @@ UStaminaIndicatorEffect::UStaminaIndicatorEffect()
 	EmissiveIntensity = 0.0f;
 }
 
-void UStaminaIndicatorEffect::OnApplied_Implementation()
+void UStaminaIndicatorEffect::OnApplied(FStatusEffectContext& Context) const
 {
-	Super::OnApplied_Implementation();
+	Super::OnApplied(Context);
 
-	AActor* Target = GetOwnerActor();
+	AActor* Target = Context.Owner;
 	if (Target)
 	{
 		UE_LOG(LogTemp, Log, TEXT("StaminaIndicatorEffect: Applied to %s (display only, stamina was already restored)"),
@@ -24,13 +24,13 @@ void UStaminaIndicatorEffect::OnApplied_Implementation()
 	}
 }
 
-void UStaminaIndicatorEffect::OnRemoved_Implementation()
+void UStaminaIndicatorEffect::OnRemoved(const FStatusEffectContext& Context) const
 {
-	AActor* Target = GetOwnerActor();
+	AActor* Target = Context.Owner;
 	if (Target)
 	{
 		UE_LOG(LogTemp, Log, TEXT("StaminaIndicatorEffect: Removed from %s"), *Target->GetName());
 	}
 
-	Super::OnRemoved_Implementation();
+	Super::OnRemoved(Context);
 }
@@ -20,6 +20,6 @@ public:
 
 protected:
 	// 不需要实现任何实际效果，只是显示图标
-	virtual void OnApplied_Implementation() override;
-	virtual void OnRemoved_Implementation() override;
+	virtual void OnApplied(FStatusEffectContext& Context) const override;
+	virtual void OnRemoved(const FStatusEffectContext& Context) const override;
 };
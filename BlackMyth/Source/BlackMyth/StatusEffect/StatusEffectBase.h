@@ -1,4 +1,4 @@
-// 状态效果基类 - 所有状态效果的抽象基类
+// 状态效果基类 - 所有状态效果的抽象基类（只读配置，运行时数据由 UStatusEffectSubsystem 管理）
 
 #pragma once
 
@@ -9,7 +9,13 @@
 
 class UStatusEffectComponent;
 
-// 状态效果基类，所有具体状态效果（中毒、减速、灼烧等）继承此类
+/**
+ * 状态效果基类，所有具体状态效果（中毒、减速、灼烧等）继承此类
+ *
+ * 只作为设计师配置使用：施加效果时不再创建实例，子系统直接读取类的 CDO。
+ * 每个激活效果的剩余时间、累计时间等运行时数据存放在 UStatusEffectSubsystem 的 SoA 中，
+ * 回调通过 FStatusEffectContext 访问目标和施加者，因此回调都是 const 的。
+ */
 UCLASS(Abstract, Blueprintable, BlueprintType)
 class BLACKMYTH_API UStatusEffectBase : public UObject
 {
@@ -18,63 +24,30 @@ class BLACKMYTH_API UStatusEffectBase : public UObject
 public:
 	UStatusEffectBase(){};
 
-	// ========== 生命周期方法 ==========
+	// ========== 生命周期回调 ==========
 
-	// 初始化效果
-	UFUNCTION(BlueprintCallable, Category = "StatusEffect")
-	virtual void Initialize(AActor* InOwner, AActor* InInstigator, float InDuration);
+	/** 效果被施加时调用（可写入 Context.SavedValue，移除时原样传回） */
+	virtual void OnApplied(FStatusEffectContext& Context) const;
 
-	// 效果被施加时调用
-	UFUNCTION(BlueprintNativeEvent, Category = "StatusEffect")
-	void OnApplied();
-	virtual void OnApplied_Implementation();
+	/** 效果被移除时调用（过期、手动移除或目标销毁） */
+	virtual void OnRemoved(const FStatusEffectContext& Context) const;
 
-	// 每帧更新状态效果
-	UFUNCTION(BlueprintNativeEvent, Category = "StatusEffect")
-	void OnTick(float DeltaTime);
-	virtual void OnTick_Implementation(float DeltaTime);
-
-	// 效果被移除时调用
-	UFUNCTION(BlueprintNativeEvent, Category = "StatusEffect")
-	void OnRemoved();
-	virtual void OnRemoved_Implementation();
+	/**
+	 * 周期伤害配置（子系统在批量更新中按间隔累计，不逐帧调用虚函数）
+	 * @return 没有周期伤害时返回 false
+	 */
+	virtual bool GetPeriodicDamage(float& OutInterval, float& OutDamagePerTick) const { return false; }
 
 	// ========== 查询方法 ==========
 
-	/** 检查效果是否已过期 */
-	UFUNCTION(BlueprintPure, Category = "StatusEffect")
-	bool IsExpired() const { return RemainingTime <= 0.0f; }
-
 	/** 获取效果类型 */
 	UFUNCTION(BlueprintPure, Category = "StatusEffect")
 	EStatusEffectType GetEffectType() const { return EffectType; }
 
-	/** 获取剩余时间 */
-	UFUNCTION(BlueprintPure, Category = "StatusEffect")
-	float GetRemainingTime() const { return RemainingTime; }
-
-	/** 获取总持续时间 */
+	/** 获取默认持续时间 */
 	UFUNCTION(BlueprintPure, Category = "StatusEffect")
 	float GetDuration() const { return Duration; }
 
-	/** 获取剩余时间百分比 (0-1) */
-	UFUNCTION(BlueprintPure, Category = "StatusEffect")
-	float GetRemainingTimePercent() const { return Duration > 0.0f ? RemainingTime / Duration : 0.0f; }
-
-	/** 获取效果目标 */
-	UFUNCTION(BlueprintPure, Category = "StatusEffect")
-	AActor* GetOwnerActor() const { return OwnerActor.Get(); }
-
-	/** 获取效果施加者 */
-	UFUNCTION(BlueprintPure, Category = "StatusEffect")
-	AActor* GetInstigator() const { return Instigator.Get(); }
-
-	// ========== 时间控制 ==========
-
-	/** 刷新效果持续时间 */
-	UFUNCTION(BlueprintCallable, Category = "StatusEffect")
-	void RefreshDuration(float NewDuration);
-
 	// ========== 视觉效果 ==========
 
 	/** 获取 Tint 颜色 */
@@ -98,20 +71,19 @@ public:
 	bool IsAttackDisabled() const { return bDisableAttack; }
 
 protected:
+	/** 日志中使用的效果名称 */
+	FString GetEffectName() const;
+
 	// ========== 效果属性 ==========
 
 	/** 效果类型（子类必须在构造函数中设置） */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "StatusEffect|Config")
 	EStatusEffectType EffectType = EStatusEffectType::None;
 
-	/** 总持续时间 */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "StatusEffect|Runtime")
+	/** 默认持续时间（施加时以调用方传入的时间为准） */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "StatusEffect|Config")
 	float Duration = 0.0f;
 
-	/** 剩余时间 */
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "StatusEffect|Runtime")
-	float RemainingTime = 0.0f;
-
 	/** 是否可叠加（预留接口，当前默认 false） */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "StatusEffect|Config")
 	bool bStackable = false;
@@ -124,20 +96,6 @@ protected:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "StatusEffect|Behavior")
 	bool bDisableAttack = false;
 
-	// ========== 引用 ==========
-
-	/** 效果目标（被施加效果的角色） */
-	UPROPERTY(BlueprintReadOnly, Category = "StatusEffect|Runtime")
-	TWeakObjectPtr<AActor> OwnerActor;
-
-	/** 效果施加者（造成效果的角色） */
-	UPROPERTY(BlueprintReadOnly, Category = "StatusEffect|Runtime")
-	TWeakObjectPtr<AActor> Instigator;
-
-	/** 所属的状态效果组件 */
-	UPROPERTY(BlueprintReadOnly, Category = "StatusEffect|Runtime")
-	TWeakObjectPtr<UStatusEffectComponent> OwnerComponent;
-
 	// ========== 视觉效果属性 ==========
 
 	/** Tint 颜色（叠加到角色材质上的颜色） */
@@ -151,8 +109,4 @@ protected:
 	/** 自发光强度 */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "StatusEffect|Visual", meta = (ClampMin = "0.0"))
 	float EmissiveIntensity = 0.0f;
-
-public:
-	/** 设置所属组件 */
-	void SetOwnerComponent(UStatusEffectComponent* InComponent);
 };
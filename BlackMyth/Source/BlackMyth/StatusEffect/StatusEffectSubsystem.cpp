@@ -0,0 +1,302 @@
+// 状态效果子系统实现
+
+#include "StatusEffectSubsystem.h"
+#include "StatusEffectBase.h"
+#include "../Components/StatusEffectComponent.h"
+#include "../Components/HealthComponent.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "../BlackMythStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Status Effects Active"), STAT_StatusEffectsActive, STATGROUP_BlackMyth);
+
+// ========== USubsystem ==========
+
+bool UStatusEffectSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UStatusEffectSubsystem::Deinitialize()
+{
+	// 世界拆除时不再调用 OnRemoved（目标 Actor 已经在销毁）
+	Types.Empty();
+	RemainingTimes.Empty();
+	Durations.Empty();
+	Accumulators.Empty();
+	TickIntervals.Empty();
+	TickDamages.Empty();
+	PendingTicks.Empty();
+	SavedValues.Empty();
+	Owners.Empty();
+	Instigators.Empty();
+	Configs.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UStatusEffectSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UStatusEffectSubsystem, STATGROUP_BlackMyth);
+}
+
+UStatusEffectSubsystem* UStatusEffectSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UStatusEffectSubsystem>() : nullptr;
+}
+
+// ========== 批量更新 ==========
+
+void UStatusEffectSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	BLACKMYTH_TRACE_SCOPE(TEXT("BlackMyth.StatusEffect.Tick"));
+
+	const int32 Num = Types.Num();
+	SET_DWORD_STAT(STAT_StatusEffectsActive, Num);
+	if (Num == 0)
+	{
+		return;
+	}
+
+	// 1. 推进计时：只读写数值列，效果多时分块并行
+	if (Num >= ParallelThreshold)
+	{
+		const int32 NumChunks = FMath::DivideAndRoundUp(Num, ParallelChunkSize);
+		ParallelFor(NumChunks, [this, Num, DeltaTime](int32 ChunkIndex)
+		{
+			const int32 Begin = ChunkIndex * ParallelChunkSize;
+			AdvanceRange(Begin, FMath::Min(Begin + ParallelChunkSize, Num), DeltaTime);
+		});
+	}
+	else
+	{
+		AdvanceRange(0, Num, DeltaTime);
+	}
+
+	// 2. 游戏线程：收集周期伤害和过期效果，广播剩余时间
+	//    伤害和移除的回调可能再修改效果列表，因此先收集、遍历结束后再执行
+	struct FPendingDamage
+	{
+		TWeakObjectPtr<UHealthComponent> Health;
+		TWeakObjectPtr<AActor> Instigator;
+		float Damage;
+	};
+	TArray<FPendingDamage, TInlineAllocator<16>> PendingDamages;
+	TArray<TPair<TWeakObjectPtr<UStatusEffectComponent>, EStatusEffectType>, TInlineAllocator<16>> ExpiredEffects;
+
+	// 倒序遍历：RemoveAtSwap 换到当前位置的总是已经处理过的元素
+	for (int32 Index = Num - 1; Index >= 0; --Index)
+	{
+		UStatusEffectComponent* Component = Owners[Index].Get();
+		if (!Component)
+		{
+			// 所属组件未经过 EndPlay 就失效了，直接丢弃
+			RemoveAt(Index, false);
+			continue;
+		}
+
+		if (PendingTicks[Index] > 0 && Component->CachedHealth.IsValid())
+		{
+			PendingDamages.Add({ Component->CachedHealth, Instigators[Index], TickDamages[Index] * PendingTicks[Index] });
+		}
+
+		// 只有蓝图等监听者存在时才广播（HUD 不再监听，效果通常无人绑定）
+		if (Component->OnEffectUpdated.IsBound())
+		{
+			Component->OnEffectUpdated.Broadcast(Types[Index], RemainingTimes[Index]);
+		}
+
+		if (RemainingTimes[Index] <= 0.0f)
+		{
+			ExpiredEffects.Emplace(Component, Types[Index]);
+		}
+	}
+
+	// 3. 结算周期伤害
+	for (const FPendingDamage& Pending : PendingDamages)
+	{
+		if (UHealthComponent* Health = Pending.Health.Get())
+		{
+			Health->TakeDamage(Pending.Damage, Pending.Instigator.Get());
+		}
+	}
+
+	// 4. 移除过期效果（目标可能已在伤害结算中死亡并清空了效果）
+	for (const TPair<TWeakObjectPtr<UStatusEffectComponent>, EStatusEffectType>& Expired : ExpiredEffects)
+	{
+		if (RemoveEffect(Expired.Key.Get(), Expired.Value))
+		{
+			UE_LOG(LogTemp, Log, TEXT("StatusEffectSubsystem: Effect [%s] expired and removed"),
+				*StaticEnum<EStatusEffectType>()->GetNameStringByValue(static_cast<int64>(Expired.Value)));
+		}
+	}
+}
+
+void UStatusEffectSubsystem::AdvanceRange(int32 Begin, int32 End, float DeltaTime)
+{
+	float* Remaining = RemainingTimes.GetData();
+	float* Accumulated = Accumulators.GetData();
+	const float* Intervals = TickIntervals.GetData();
+	int32* Ticks = PendingTicks.GetData();
+
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		Remaining[Index] = FMath::Max(Remaining[Index] - DeltaTime, 0.0f);
+
+		int32 NumTicks = 0;
+		if (Intervals[Index] > 0.0f)
+		{
+			// 一帧跨越多个间隔时（卡顿）补齐所有伤害次数
+			Accumulated[Index] += DeltaTime;
+			while (Accumulated[Index] >= Intervals[Index])
+			{
+				Accumulated[Index] -= Intervals[Index];
+				++NumTicks;
+			}
+		}
+		Ticks[Index] = NumTicks;
+	}
+}
+
+// ========== 效果管理 ==========
+
+bool UStatusEffectSubsystem::ApplyEffect(UStatusEffectComponent* Component, TSubclassOf<UStatusEffectBase> EffectClass, AActor* Instigator, float Duration)
+{
+	if (!Component || !EffectClass)
+	{
+		return false;
+	}
+
+	UStatusEffectBase* Config = EffectClass->GetDefaultObject<UStatusEffectBase>();
+	const EStatusEffectType Type = Config->GetEffectType();
+	if (Type == EStatusEffectType::None)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("StatusEffectSubsystem::ApplyEffect - %s has no EffectType!"), *EffectClass->GetName());
+		return false;
+	}
+
+	// 已存在同类型效果，刷新持续时间
+	const int32 ExistingIndex = Component->EffectIndices[static_cast<int32>(Type)];
+	if (Types.IsValidIndex(ExistingIndex))
+	{
+		Durations[ExistingIndex] = Duration;
+		RemainingTimes[ExistingIndex] = Duration;
+		return false;
+	}
+
+	float TickInterval = 0.0f;
+	float TickDamage = 0.0f;
+	if (!Config->GetPeriodicDamage(TickInterval, TickDamage))
+	{
+		TickInterval = 0.0f;
+		TickDamage = 0.0f;
+	}
+
+	const int32 Index = Types.Add(Type);
+	RemainingTimes.Add(Duration);
+	Durations.Add(Duration);
+	Accumulators.Add(0.0f);
+	TickIntervals.Add(TickInterval);
+	TickDamages.Add(TickDamage);
+	PendingTicks.Add(0);
+	SavedValues.Add(0.0f);
+	Owners.Add(Component);
+	Instigators.Add(Instigator);
+	Configs.Add(Config);
+
+	// 调用配置的施加回调，保存需要在移除时恢复的数值
+	FStatusEffectContext Context = MakeContext(Index);
+	Config->OnApplied(Context);
+	SavedValues[Index] = Context.SavedValue;
+
+	Component->HandleEffectAdded(Type, Index, Config, Duration);
+	return true;
+}
+
+bool UStatusEffectSubsystem::RemoveEffect(UStatusEffectComponent* Component, EStatusEffectType Type)
+{
+	if (!Component || Type == EStatusEffectType::None)
+	{
+		return false;
+	}
+
+	const int32 Index = Component->EffectIndices[static_cast<int32>(Type)];
+	if (!Types.IsValidIndex(Index))
+	{
+		return false;
+	}
+
+	RemoveAt(Index, true);
+	return true;
+}
+
+void UStatusEffectSubsystem::RemoveAllEffects(UStatusEffectComponent* Component)
+{
+	if (!Component)
+	{
+		return;
+	}
+
+	for (int32 TypeIndex = 0; TypeIndex < NumStatusEffectTypes; ++TypeIndex)
+	{
+		RemoveEffect(Component, static_cast<EStatusEffectType>(TypeIndex));
+	}
+}
+
+void UStatusEffectSubsystem::RemoveAt(int32 Index, bool bCallOnRemoved)
+{
+	const EStatusEffectType Type = Types[Index];
+	const UStatusEffectBase* Config = Configs[Index];
+	UStatusEffectComponent* Component = Owners[Index].Get();
+	const FStatusEffectContext Context = MakeContext(Index);
+
+	// 先从 SoA 中移除，回调里再施加/移除效果时看到的是一致的状态
+	Types.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	RemainingTimes.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Durations.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Accumulators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TickIntervals.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	TickDamages.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	PendingTicks.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	SavedValues.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Owners.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Instigators.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+	Configs.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// 末尾的效果被换到了 Index，更新其所属组件记录的下标
+	if (Types.IsValidIndex(Index))
+	{
+		if (UStatusEffectComponent* MovedOwner = Owners[Index].Get())
+		{
+			MovedOwner->EffectIndices[static_cast<int32>(Types[Index])] = Index;
+		}
+	}
+
+	if (bCallOnRemoved && Config)
+	{
+		Config->OnRemoved(Context);
+	}
+
+	if (Component)
+	{
+		Component->HandleEffectRemoved(Type);
+	}
+}
+
+FStatusEffectContext UStatusEffectSubsystem::MakeContext(int32 Index) const
+{
+	FStatusEffectContext Context;
+	Context.Component = Owners[Index].Get();
+	Context.Owner = Context.Component ? Context.Component->GetOwner() : nullptr;
+	Context.Instigator = Instigators[Index].Get();
+	Context.SavedValue = SavedValues[Index];
+	return Context;
+}
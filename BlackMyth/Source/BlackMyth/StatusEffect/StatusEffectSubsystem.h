@@ -0,0 +1,116 @@
+// 状态效果子系统 - 以 SoA 形式集中存放并批量更新世界中所有激活的状态效果
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "StatusEffectTypes.h"
+#include "StatusEffectSubsystem.generated.h"
+
+class UStatusEffectBase;
+class UStatusEffectComponent;
+
+/**
+ * 状态效果子系统
+ * - 每个激活效果是 SoA 数组中的一个下标（类型、剩余时间、累计时间、所属组件等各占一列），
+ *   不再为每次施加创建 UObject；效果类的 CDO 作为只读配置
+ * - Tick 中一次性推进所有效果的计时：纯数值部分在效果较多时分块并行，
+ *   周期伤害、过期移除等需要访问 UObject 的部分回到游戏线程按顺序执行
+ * - 组件按类型记录自己效果所在的下标，查询和移除都是 O(1)；
+ *   移除采用 RemoveAtSwap，被移动的效果会同步更新所属组件的下标
+ */
+UCLASS()
+class BLACKMYTH_API UStatusEffectSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// ========== FTickableGameObject ==========
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return Types.Num() > 0; }
+
+	/** 获取世界的状态效果子系统（可能为空） */
+	static UStatusEffectSubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 效果管理 ==========
+
+	/**
+	 * 施加效果（同类型已存在时刷新持续时间）
+	 * @return 新施加返回 true，刷新已有效果返回 false
+	 */
+	bool ApplyEffect(UStatusEffectComponent* Component, TSubclassOf<UStatusEffectBase> EffectClass, AActor* Instigator, float Duration);
+
+	/** 移除组件上指定类型的效果（调用配置的 OnRemoved 并通知组件） */
+	bool RemoveEffect(UStatusEffectComponent* Component, EStatusEffectType Type);
+
+	/** 移除组件上的所有效果 */
+	void RemoveAllEffects(UStatusEffectComponent* Component);
+
+	// ========== 查询 ==========
+
+	/** 效果剩余时间（下标来自组件，无效时返回 0） */
+	float GetRemainingTime(int32 Index) const { return RemainingTimes.IsValidIndex(Index) ? RemainingTimes[Index] : 0.0f; }
+
+	/** 效果总持续时间 */
+	float GetDuration(int32 Index) const { return Durations.IsValidIndex(Index) ? Durations[Index] : 0.0f; }
+
+	/** 效果配置 */
+	const UStatusEffectBase* GetConfig(int32 Index) const { return Configs.IsValidIndex(Index) ? Configs[Index].Get() : nullptr; }
+
+	/** 当前激活的效果总数 */
+	int32 GetNumActiveEffects() const { return Types.Num(); }
+
+	/** 超过此数量时计时推进分块并行 */
+	static constexpr int32 ParallelThreshold = 512;
+
+	/** 并行时每块处理的效果数量 */
+	static constexpr int32 ParallelChunkSize = 256;
+
+private:
+	/** 推进 [Begin, End) 范围内效果的计时，只读写数值列 */
+	void AdvanceRange(int32 Begin, int32 End, float DeltaTime);
+
+	/** 移除下标处的效果（RemoveAtSwap，并更新被移动效果所属组件的下标） */
+	void RemoveAt(int32 Index, bool bCallOnRemoved);
+
+	/** 组装回调上下文 */
+	FStatusEffectContext MakeContext(int32 Index) const;
+
+	// ========== SoA 数据（同一下标表示同一个效果） ==========
+
+	TArray<EStatusEffectType> Types;
+	TArray<float> RemainingTimes;
+	TArray<float> Durations;
+
+	/** 周期伤害的累计时间 */
+	TArray<float> Accumulators;
+
+	/** 周期伤害间隔（0 表示无周期伤害），施加时从配置读取 */
+	TArray<float> TickIntervals;
+
+	/** 每次周期伤害的数值 */
+	TArray<float> TickDamages;
+
+	/** 本帧触发的周期伤害次数（AdvanceRange 写入，游戏线程读取） */
+	TArray<int32> PendingTicks;
+
+	/** 配置 OnApplied 保存、OnRemoved 使用的数值 */
+	TArray<float> SavedValues;
+
+	/** 所属组件 */
+	TArray<TWeakObjectPtr<UStatusEffectComponent>> Owners;
+
+	/** 施加者 */
+	TArray<TWeakObjectPtr<AActor>> Instigators;
+
+	/** 效果配置（类的 CDO，只读） */
+	UPROPERTY()
+	TArray<TObjectPtr<UStatusEffectBase>> Configs;
+};
@@ -6,7 +6,9 @@
 #include "StatusEffectTypes.generated.h"
 
 // 前向声明
+class AActor;
 class UStatusEffectBase;
+class UStatusEffectComponent;
 
 // 状态效果类型枚举
 UENUM(BlueprintType)
@@ -22,6 +24,33 @@ enum class EStatusEffectType : uint8
 	StaminaIndicator UMETA(DisplayName = "Stamina Indicator"), // 体力恢复指示（体力药使用后的UI显示）
 };
 
+/** 效果类型数量（用于按类型索引的定长数组和位掩码，新增类型时需保持为最后一项 + 1） */
+constexpr int32 NumStatusEffectTypes = static_cast<int32>(EStatusEffectType::StaminaIndicator) + 1;
+static_assert(NumStatusEffectTypes <= 32, "EStatusEffectType must fit in a uint32 mask");
+
+/** 效果类型对应的位 */
+constexpr uint32 StatusEffectBit(EStatusEffectType Type) { return 1u << static_cast<uint32>(Type); }
+
+/**
+ * 状态效果回调上下文
+ * 效果配置对象（UStatusEffectBase 的 CDO）是只读的，每个激活效果的运行时数据
+ * 存放在 UStatusEffectSubsystem 的 SoA 中，通过此结构传给配置对象的回调
+ */
+struct FStatusEffectContext
+{
+	/** 效果目标（被施加效果的角色） */
+	AActor* Owner = nullptr;
+
+	/** 效果施加者（造成效果的角色） */
+	AActor* Instigator = nullptr;
+
+	/** 所属的状态效果组件 */
+	UStatusEffectComponent* Component = nullptr;
+
+	/** 施加时保存、移除时恢复的数值（如原始移速、原始攻击力加成） */
+	float SavedValue = 0.0f;
+};
+
 // 状态效果配置结构体，用于在敌人蓝图中配置攻击附带的状态效果
 USTRUCT(BlueprintType)
 struct FStatusEffectConfig
@@ -0,0 +1,216 @@
+// Actor 对象池子系统实现
+
+#include "ActorPoolSubsystem.h"
+#include "PoolableInterface.h"
+#include "GameFramework/Actor.h"
+#include "Components/ActorComponent.h"
+#include "TimerManager.h"
+#include "../BlackMythStats.h"
+#include "../BlackMythLog.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("ActorPool Spawned"), STAT_ActorPoolSpawned, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ActorPool Reused"), STAT_ActorPoolReused, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("ActorPool Free"), STAT_ActorPoolFree, STATGROUP_BlackMyth);
+
+// ========== USubsystem ==========
+
+bool UActorPoolSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UActorPoolSubsystem::Deinitialize()
+{
+	// 空闲实例随世界一起销毁，这里只清理记录
+	Buckets.Empty();
+	PooledActors.Empty();
+
+	Super::Deinitialize();
+}
+
+UActorPoolSubsystem* UActorPoolSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UActorPoolSubsystem>() : nullptr;
+}
+
+template<typename FuncType>
+void UActorPoolSubsystem::ForEachPoolable(AActor* Actor, FuncType&& Func)
+{
+	if (IPoolable* PoolableActor = Cast<IPoolable>(Actor))
+	{
+		Func(*PoolableActor);
+	}
+
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		if (IPoolable* PoolableComponent = Cast<IPoolable>(Component))
+		{
+			Func(*PoolableComponent);
+		}
+	}
+}
+
+// ========== 取出 / 回收 ==========
+
+AActor* UActorPoolSubsystem::AcquireActor(UClass* Class, const FTransform& Transform, const FActorSpawnParameters& SpawnParams)
+{
+	if (!Class)
+	{
+		return nullptr;
+	}
+
+	FActorPoolBucket* Bucket = Buckets.Find(Class);
+	while (Bucket && Bucket->Free.Num() > 0)
+	{
+		AActor* Actor = Bucket->Free.Pop(EAllowShrinking::No);
+		if (!IsValid(Actor))
+		{
+			// 空闲期间被外部销毁（如关卡流送卸载）
+			--Bucket->NumCreated;
+			continue;
+		}
+
+		PooledActors.Add(Actor, false);
+		DEC_DWORD_STAT(STAT_ActorPoolFree);
+		INC_DWORD_STAT(STAT_ActorPoolReused);
+
+		// 通用激活：变换、Owner、可见性、碰撞、Tick
+		Actor->SetOwner(SpawnParams.Owner);
+		Actor->SetInstigator(SpawnParams.Instigator);
+		Actor->SetActorTransform(Transform, false, nullptr, ETeleportType::ResetPhysics);
+		Actor->SetActorHiddenInGame(false);
+		Actor->SetActorEnableCollision(true);
+		Actor->SetActorTickEnabled(Actor->PrimaryActorTick.bStartWithTickEnabled);
+		for (UActorComponent* Component : Actor->GetComponents())
+		{
+			Component->SetComponentTickEnabled(Component->PrimaryComponentTick.bStartWithTickEnabled);
+		}
+
+		ForEachPoolable(Actor, [](IPoolable& Poolable) { Poolable.OnAcquiredFromPool(); });
+		return Actor;
+	}
+
+	return SpawnPooledActor(Class, Transform, SpawnParams);
+}
+
+AActor* UActorPoolSubsystem::SpawnPooledActor(UClass* Class, const FTransform& Transform, const FActorSpawnParameters& SpawnParams)
+{
+	UWorld* World = GetWorld();
+	AActor* Actor = World ? World->SpawnActor<AActor>(Class, Transform, SpawnParams) : nullptr;
+	if (!Actor)
+	{
+		return nullptr;
+	}
+
+	Buckets.FindOrAdd(Class).NumCreated++;
+	PooledActors.Add(Actor, false);
+	INC_DWORD_STAT(STAT_ActorPoolSpawned);
+	return Actor;
+}
+
+bool UActorPoolSubsystem::Release(AActor* Actor)
+{
+	if (!IsValid(Actor) || Actor->IsActorBeingDestroyed())
+	{
+		return false;
+	}
+
+	bool* bIsFree = PooledActors.Find(Actor);
+	if (!bIsFree)
+	{
+		return false;
+	}
+
+	// 重复回收
+	if (*bIsFree)
+	{
+		return true;
+	}
+
+	UWorld* World = GetWorld();
+	FActorPoolBucket& Bucket = Buckets.FindOrAdd(Actor->GetClass());
+	if (!World || World->bIsTearingDown || Bucket.Free.Num() >= MaxFreePerClass)
+	{
+		PooledActors.Remove(Actor);
+		--Bucket.NumCreated;
+		return false;
+	}
+
+	ForEachPoolable(Actor, [](IPoolable& Poolable) { Poolable.OnReleasedToPool(); });
+
+	// 通用停用：隐藏、关闭碰撞与 Tick、清除计时器与寿命
+	World->GetTimerManager().ClearAllTimersForObject(Actor);
+	Actor->SetLifeSpan(0.0f);
+	Actor->DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	Actor->SetActorHiddenInGame(true);
+	Actor->SetActorEnableCollision(false);
+	Actor->SetActorTickEnabled(false);
+	for (UActorComponent* Component : Actor->GetComponents())
+	{
+		Component->SetComponentTickEnabled(false);
+	}
+
+	*bIsFree = true;
+	Bucket.Free.Add(Actor);
+	INC_DWORD_STAT(STAT_ActorPoolFree);
+	return true;
+}
+
+void UActorPoolSubsystem::ReleaseOrDestroy(AActor* Actor)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	UActorPoolSubsystem* Pool = Get(Actor);
+	if (!Pool || !Pool->Release(Actor))
+	{
+		Actor->Destroy();
+	}
+}
+
+void UActorPoolSubsystem::Prewarm(UClass* Class, int32 Count)
+{
+	if (!Class)
+	{
+		return;
+	}
+
+	const FActorPoolBucket* Bucket = Buckets.Find(Class);
+	const int32 NumToSpawn = FMath::Min(Count, MaxFreePerClass) - (Bucket ? Bucket->NumCreated : 0);
+	if (NumToSpawn <= 0)
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	for (int32 Index = 0; Index < NumToSpawn; ++Index)
+	{
+		if (AActor* Actor = SpawnPooledActor(Class, FTransform::Identity, SpawnParams))
+		{
+			Release(Actor);
+		}
+	}
+
+	UE_LOG(LogBMCombat, Log, TEXT("[ActorPool] Prewarmed %d x %s"), NumToSpawn, *Class->GetName());
+}
+
+bool UActorPoolSubsystem::IsPooled(const AActor* Actor) const
+{
+	return Actor && PooledActors.Contains(Actor);
+}
+
+int32 UActorPoolSubsystem::GetNumFree(UClass* Class) const
+{
+	const FActorPoolBucket* Bucket = Buckets.Find(Class);
+	return Bucket ? Bucket->Free.Num() : 0;
+}
@@ -0,0 +1,93 @@
+// Actor 对象池子系统 - 复用频繁生成/销毁的 Actor，避免 UObject 分配与 GC 峰值
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Engine/World.h"
+#include "ActorPoolSubsystem.generated.h"
+
+/** 单个类的空闲实例 */
+USTRUCT()
+struct FActorPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<AActor>> Free;
+
+	/** 该类由对象池创建的实例总数（空闲 + 使用中） */
+	int32 NumCreated = 0;
+};
+
+/**
+ * Actor 对象池子系统
+ * - Acquire：优先取出空闲实例（设置变换/Owner 后调用 IPoolable::OnAcquiredFromPool），
+ *   没有空闲实例时正常 SpawnActor
+ * - Release：隐藏、关闭碰撞和 Tick、清除计时器后放回空闲列表；
+ *   不是由对象池创建的 Actor 直接 Destroy
+ * - Prewarm：由使用方在 BeginPlay 中按各自配置的数量预先生成实例
+ *
+ * Actor 和它的组件都可以实现 IPoolable 接收回收/取出通知。
+ */
+UCLASS()
+class BLACKMYTH_API UActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	/** 获取世界的对象池（可能为空） */
+	static UActorPoolSubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 取出 / 回收 ==========
+
+	/** 取出一个实例（复用或新建） */
+	AActor* AcquireActor(UClass* Class, const FTransform& Transform, const FActorSpawnParameters& SpawnParams = FActorSpawnParameters());
+
+	template<typename T>
+	T* Acquire(TSubclassOf<T> Class, const FVector& Location, const FRotator& Rotation, const FActorSpawnParameters& SpawnParams = FActorSpawnParameters())
+	{
+		return Cast<T>(AcquireActor(Class, FTransform(Rotation, Location), SpawnParams));
+	}
+
+	/**
+	 * 回收实例
+	 * @return Actor 不是由对象池创建或池已满时返回 false（调用方负责销毁）
+	 */
+	bool Release(AActor* Actor);
+
+	/** 有对象池时回收，否则销毁（可用于替换原来的 Destroy 调用） */
+	static void ReleaseOrDestroy(AActor* Actor);
+
+	/** 确保该类至少有 Count 个实例（空闲 + 使用中），不足的部分立即生成并回收 */
+	void Prewarm(UClass* Class, int32 Count);
+
+	/** Actor 是否由对象池创建 */
+	bool IsPooled(const AActor* Actor) const;
+
+	/** 该类当前的空闲实例数 */
+	int32 GetNumFree(UClass* Class) const;
+
+	/** 每个类最多保留的空闲实例数，超出的直接销毁 */
+	static constexpr int32 MaxFreePerClass = 128;
+
+private:
+	/** 新建一个由对象池管理的实例 */
+	AActor* SpawnPooledActor(UClass* Class, const FTransform& Transform, const FActorSpawnParameters& SpawnParams);
+
+	/** 对 Actor 及其实现 IPoolable 的组件调用回调 */
+	template<typename FuncType>
+	static void ForEachPoolable(AActor* Actor, FuncType&& Func);
+
+	UPROPERTY()
+	TMap<TObjectPtr<UClass>, FActorPoolBucket> Buckets;
+
+	/** 所有由对象池创建的 Actor，值表示是否在空闲列表中 */
+	TMap<TObjectKey<AActor>, bool> PooledActors;
+};
@@ -0,0 +1,213 @@
+// Actor 注册表子系统实现
+
+#include "ActorRegistrySubsystem.h"
+#include "../EnemyBase.h"
+#include "../EnemySpawner.h"
+#include "../Temple.h"
+#include "../NPCCharacter.h"
+#include "../Components/HealthComponent.h"
+#include "Engine/World.h"
+
+void UActorRegistrySubsystem::Deinitialize()
+{
+	Enemies.Empty();
+	Damageables.Empty();
+	Spawners.Empty();
+	Temples.Empty();
+	TemplesByID.Empty();
+	NPCs.Empty();
+	Summons.Empty();
+
+	Super::Deinitialize();
+}
+
+UActorRegistrySubsystem* UActorRegistrySubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UActorRegistrySubsystem>() : nullptr;
+}
+
+// ========== 注册 / 注销 ==========
+
+void UActorRegistrySubsystem::RegisterEnemy(AEnemyBase* Enemy)
+{
+	if (Enemy)
+	{
+		Enemies.Add(Enemy);
+	}
+}
+
+void UActorRegistrySubsystem::UnregisterEnemy(AEnemyBase* Enemy)
+{
+	Enemies.Remove(Enemy);
+}
+
+void UActorRegistrySubsystem::RegisterDamageable(AActor* Actor, UHealthComponent* Health)
+{
+	if (Actor && Health)
+	{
+		Damageables.Add(Actor, Health);
+	}
+}
+
+void UActorRegistrySubsystem::UnregisterDamageable(AActor* Actor)
+{
+	Damageables.Remove(Actor);
+}
+
+void UActorRegistrySubsystem::RegisterSpawner(AEnemySpawner* Spawner)
+{
+	if (Spawner)
+	{
+		Spawners.Add(Spawner);
+	}
+}
+
+void UActorRegistrySubsystem::UnregisterSpawner(AEnemySpawner* Spawner)
+{
+	Spawners.Remove(Spawner);
+}
+
+void UActorRegistrySubsystem::RegisterTemple(AInteractableActor* Temple)
+{
+	if (!Temple)
+	{
+		return;
+	}
+
+	Temples.Add(Temple);
+	if (!Temple->TempleID.IsNone())
+	{
+		TemplesByID.Add(Temple->TempleID, Temple);
+	}
+}
+
+void UActorRegistrySubsystem::UnregisterTemple(AInteractableActor* Temple)
+{
+	if (!Temple)
+	{
+		return;
+	}
+
+	Temples.Remove(Temple);
+
+	// 只移除指向自己的索引（防止重复 ID 时误删另一座庙）
+	if (const TObjectPtr<AInteractableActor>* Found = TemplesByID.Find(Temple->TempleID))
+	{
+		if (*Found == Temple)
+		{
+			TemplesByID.Remove(Temple->TempleID);
+		}
+	}
+}
+
+void UActorRegistrySubsystem::RegisterNPC(ANPCCharacter* NPC)
+{
+	if (NPC)
+	{
+		NPCs.Add(NPC);
+	}
+}
+
+void UActorRegistrySubsystem::UnregisterNPC(ANPCCharacter* NPC)
+{
+	NPCs.Remove(NPC);
+}
+
+void UActorRegistrySubsystem::RegisterSummon(AActor* Summon)
+{
+	if (Summon)
+	{
+		Summons.Add(Summon);
+	}
+}
+
+void UActorRegistrySubsystem::UnregisterSummon(AActor* Summon)
+{
+	Summons.Remove(Summon);
+}
+
+// ========== 过滤查询 ==========
+
+void UActorRegistrySubsystem::GetEnemiesInRadius(const FVector& Center, float Radius, bool bAliveOnly, TArray<AEnemyBase*>& OutEnemies) const
+{
+	const float RadiusSq = Radius * Radius;
+
+	for (AEnemyBase* Enemy : Enemies)
+	{
+		if (!IsValid(Enemy) || (bAliveOnly && Enemy->IsDead()))
+		{
+			continue;
+		}
+
+		if (FVector::DistSquared(Center, Enemy->GetActorLocation()) <= RadiusSq)
+		{
+			OutEnemies.Add(Enemy);
+		}
+	}
+}
+
+void UActorRegistrySubsystem::GetDamageablesInRadius(const FVector& Center, float Radius, bool bAliveOnly, TArray<AActor*>& OutActors) const
+{
+	const float RadiusSq = Radius * Radius;
+
+	for (const TPair<TObjectPtr<AActor>, TObjectPtr<UHealthComponent>>& Pair : Damageables)
+	{
+		AActor* Actor = Pair.Key;
+		if (!IsValid(Actor))
+		{
+			continue;
+		}
+
+		if (bAliveOnly && Pair.Value && Pair.Value->IsDead())
+		{
+			continue;
+		}
+
+		if (FVector::DistSquared(Center, Actor->GetActorLocation()) <= RadiusSq)
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+UHealthComponent* UActorRegistrySubsystem::FindHealthComponent(const AActor* Actor) const
+{
+	const TObjectPtr<UHealthComponent>* Found = Damageables.Find(const_cast<AActor*>(Actor));
+	return Found ? Found->Get() : nullptr;
+}
+
+AInteractableActor* UActorRegistrySubsystem::FindTempleByID(FName TempleID) const
+{
+	const TObjectPtr<AInteractableActor>* Found = TemplesByID.Find(TempleID);
+	return Found ? Found->Get() : nullptr;
+}
+
+void UActorRegistrySubsystem::GetSummonsOwnedBy(const AActor* Owner, TSubclassOf<AActor> SummonClass, TArray<AActor*>& OutSummons) const
+{
+	for (AActor* Summon : Summons)
+	{
+		if (IsValid(Summon) && Summon->GetOwner() == Owner && (!SummonClass || Summon->IsA(SummonClass)))
+		{
+			OutSummons.Add(Summon);
+		}
+	}
+}
+
+AActor* UActorRegistrySubsystem::FindFirstSummonOfClass(TSubclassOf<AActor> SummonClass) const
+{
+	for (AActor* Summon : Summons)
+	{
+		if (IsValid(Summon) && (!SummonClass || Summon->IsA(SummonClass)))
+		{
+			return Summon;
+		}
+	}
+
+	return nullptr;
+}
@@ -0,0 +1,119 @@
+// Actor 注册表子系统 - 按类型维护场景中存活的 Actor，替代 GetAllActorsOfClass 全场景扫描
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ActorRegistrySubsystem.generated.h"
+
+class AEnemyBase;
+class AEnemySpawner;
+class AInteractableActor;
+class ANPCCharacter;
+class UHealthComponent;
+
+/**
+ * Actor 注册表子系统
+ * 各类 Actor 在 BeginPlay 时注册、EndPlay 时注销，
+ * 查询方只遍历对应类型的集合，不再扫描整个关卡的 Actor 列表。
+ *
+ * 维护的集合：
+ * - Enemies      所有 AEnemyBase
+ * - Damageables  所有挂载 UHealthComponent 的 Actor（由 HealthComponent 自己注册）
+ * - Spawners     所有 AEnemySpawner
+ * - Temples      所有 AInteractableActor（土地庙），额外按 TempleID 建索引
+ * - NPCs         所有 ANPCCharacter
+ * - Summons      召唤物（哮天犬等），查询时按 Owner 过滤
+ */
+UCLASS()
+class BLACKMYTH_API UActorRegistrySubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	/** 获取世界的注册表（可能为空，例如编辑器预览世界） */
+	static UActorRegistrySubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 注册 / 注销 ==========
+
+	void RegisterEnemy(AEnemyBase* Enemy);
+	void UnregisterEnemy(AEnemyBase* Enemy);
+
+	void RegisterDamageable(AActor* Actor, UHealthComponent* Health);
+	void UnregisterDamageable(AActor* Actor);
+
+	void RegisterSpawner(AEnemySpawner* Spawner);
+	void UnregisterSpawner(AEnemySpawner* Spawner);
+
+	void RegisterTemple(AInteractableActor* Temple);
+	void UnregisterTemple(AInteractableActor* Temple);
+
+	void RegisterNPC(ANPCCharacter* NPC);
+	void UnregisterNPC(ANPCCharacter* NPC);
+
+	void RegisterSummon(AActor* Summon);
+	void UnregisterSummon(AActor* Summon);
+
+	// ========== 遍历 ==========
+
+	const TSet<TObjectPtr<AEnemyBase>>& GetEnemies() const { return Enemies; }
+	const TMap<TObjectPtr<AActor>, TObjectPtr<UHealthComponent>>& GetDamageables() const { return Damageables; }
+	const TSet<TObjectPtr<AEnemySpawner>>& GetSpawners() const { return Spawners; }
+	const TSet<TObjectPtr<AInteractableActor>>& GetTemples() const { return Temples; }
+	const TSet<TObjectPtr<ANPCCharacter>>& GetNPCs() const { return NPCs; }
+	const TSet<TObjectPtr<AActor>>& GetSummons() const { return Summons; }
+
+	int32 GetNumEnemies() const { return Enemies.Num(); }
+
+	// ========== 过滤查询 ==========
+
+	/**
+	 * 收集半径内的敌人
+	 * @param bAliveOnly 是否跳过已死亡的敌人
+	 */
+	void GetEnemiesInRadius(const FVector& Center, float Radius, bool bAliveOnly, TArray<AEnemyBase*>& OutEnemies) const;
+
+	/**
+	 * 收集半径内可受伤的 Actor
+	 * @param bAliveOnly 是否跳过 HealthComponent 已死亡的 Actor
+	 */
+	void GetDamageablesInRadius(const FVector& Center, float Radius, bool bAliveOnly, TArray<AActor*>& OutActors) const;
+
+	/** 查询 Actor 注册时的 HealthComponent（未注册返回 nullptr） */
+	UHealthComponent* FindHealthComponent(const AActor* Actor) const;
+
+	/** 按 TempleID 查找土地庙 */
+	AInteractableActor* FindTempleByID(FName TempleID) const;
+
+	/** 收集指定 Owner 召唤的、类型为 SummonClass 的召唤物 */
+	void GetSummonsOwnedBy(const AActor* Owner, TSubclassOf<AActor> SummonClass, TArray<AActor*>& OutSummons) const;
+
+	/** 第一个类型为 SummonClass 的召唤物（没有则返回 nullptr） */
+	AActor* FindFirstSummonOfClass(TSubclassOf<AActor> SummonClass) const;
+
+private:
+	UPROPERTY()
+	TSet<TObjectPtr<AEnemyBase>> Enemies;
+
+	/** Actor -> HealthComponent，省去查询方再调用 FindComponentByClass */
+	UPROPERTY()
+	TMap<TObjectPtr<AActor>, TObjectPtr<UHealthComponent>> Damageables;
+
+	UPROPERTY()
+	TSet<TObjectPtr<AEnemySpawner>> Spawners;
+
+	UPROPERTY()
+	TSet<TObjectPtr<AInteractableActor>> Temples;
+
+	/** TempleID -> 土地庙 */
+	UPROPERTY()
+	TMap<FName, TObjectPtr<AInteractableActor>> TemplesByID;
+
+	UPROPERTY()
+	TSet<TObjectPtr<ANPCCharacter>> NPCs;
+
+	UPROPERTY()
+	TSet<TObjectPtr<AActor>> Summons;
+};
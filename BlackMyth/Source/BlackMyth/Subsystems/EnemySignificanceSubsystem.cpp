@@ -0,0 +1,127 @@
+// 敌人重要度子系统实现
+
+#include "EnemySignificanceSubsystem.h"
+#include "ActorRegistrySubsystem.h"
+#include "../EnemyBase.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "../BlackMythStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Full Tick"), STAT_EnemySignificanceFull, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Reduced Tick"), STAT_EnemySignificanceReduced, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Enemies Dormant"), STAT_EnemySignificanceDormant, STATGROUP_BlackMyth);
+
+namespace EnemySignificance
+{
+	/** 评估周期（秒）：档位变化不需要逐帧响应，进入战斗由敌人自己立即切换 */
+	constexpr float EvaluationInterval = 0.25f;
+
+	/** 判定"最近被渲染"的时间窗口（秒） */
+	constexpr float RecentlyRenderedTolerance = 0.5f;
+}
+
+// ========== USubsystem ==========
+
+bool UEnemySignificanceSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UEnemySignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySignificanceSubsystem, STATGROUP_BlackMyth);
+}
+
+UEnemySignificanceSubsystem* UEnemySignificanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UEnemySignificanceSubsystem>() : nullptr;
+}
+
+void UEnemySignificanceSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	BLACKMYTH_TRACE_SCOPE(TEXT("BlackMyth.EnemySignificance.Tick"));
+
+	TimeUntilEvaluation -= DeltaTime;
+	if (TimeUntilEvaluation <= 0.0f)
+	{
+		TimeUntilEvaluation = EnemySignificance::EvaluationInterval;
+		EvaluateAll();
+	}
+}
+
+// ========== 评估 ==========
+
+void UEnemySignificanceSubsystem::EvaluateAll()
+{
+	UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this);
+	if (!Registry)
+	{
+		return;
+	}
+
+	// 以玩家摄像机位置为观察点，没有玩家时退化为"全部非休眠"
+	FVector ViewLocation = FVector::ZeroVector;
+	bool bHasViewer = false;
+	if (APlayerController* PC = UGameplayStatics::GetPlayerController(this, 0))
+	{
+		FRotator ViewRotation;
+		PC->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		bHasViewer = true;
+	}
+
+	BucketCounts[0] = BucketCounts[1] = BucketCounts[2] = 0;
+
+	for (AEnemyBase* Enemy : Registry->GetEnemies())
+	{
+		// 死亡的敌人由自身负责收尾（死亡动画结束后会关闭网格 Tick）
+		if (!IsValid(Enemy) || Enemy->IsDead())
+		{
+			continue;
+		}
+
+		const EEnemyTickBucket Bucket = ComputeBucket(Enemy, ViewLocation, bHasViewer);
+		Enemy->SetTickBucket(Bucket);
+		++BucketCounts[static_cast<int32>(Bucket)];
+	}
+
+	SET_DWORD_STAT(STAT_EnemySignificanceFull, BucketCounts[static_cast<int32>(EEnemyTickBucket::Full)]);
+	SET_DWORD_STAT(STAT_EnemySignificanceReduced, BucketCounts[static_cast<int32>(EEnemyTickBucket::Reduced)]);
+	SET_DWORD_STAT(STAT_EnemySignificanceDormant, BucketCounts[static_cast<int32>(EEnemyTickBucket::Dormant)]);
+}
+
+EEnemyTickBucket UEnemySignificanceSubsystem::ComputeBucket(const AEnemyBase* Enemy, const FVector& ViewLocation, bool bHasViewer) const
+{
+	if (!Enemy->bUseTickSignificance || Enemy->IsInCombat())
+	{
+		return EEnemyTickBucket::Full;
+	}
+
+	if (bHasViewer)
+	{
+		const bool bFar = FVector::DistSquared(ViewLocation, Enemy->GetActorLocation()) > FMath::Square(Enemy->DormantDistance);
+		const USkeletalMeshComponent* MeshComp = Enemy->GetMesh();
+		const bool bRecentlyRendered = MeshComp && MeshComp->WasRecentlyRendered(EnemySignificance::RecentlyRenderedTolerance);
+
+		if (bFar && !bRecentlyRendered)
+		{
+			return EEnemyTickBucket::Dormant;
+		}
+	}
+
+	return EEnemyTickBucket::Reduced;
+}
+
+int32 UEnemySignificanceSubsystem::GetNumInBucket(EEnemyTickBucket Bucket) const
+{
+	return BucketCounts[static_cast<int32>(Bucket)];
+}
@@ -0,0 +1,55 @@
+// 敌人重要度子系统 - 按距离、可见性和战斗状态为敌人分配 Tick 档位
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemySignificanceSubsystem.generated.h"
+
+class AEnemyBase;
+enum class EEnemyTickBucket : uint8;
+
+/**
+ * 敌人重要度子系统
+ * 定期遍历注册表中的敌人，按以下规则分配档位（AEnemyBase::SetTickBucket 负责具体降频）：
+ * - Full     处于战斗状态
+ * - Reduced  非战斗（巡逻、待机）
+ * - Dormant  非战斗、距离玩家超过 DormantDistance 且最近没有被渲染
+ *
+ * 进入战斗（发现目标、受击）时敌人自己会立即切回 Full，不依赖本子系统的评估周期；
+ * 本子系统只负责降档和唤醒休眠的敌人（休眠敌人的 Actor Tick 已关闭）。
+ */
+UCLASS()
+class BLACKMYTH_API UEnemySignificanceSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// ========== FTickableGameObject ==========
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** 获取世界的重要度子系统（可能为空） */
+	static UEnemySignificanceSubsystem* Get(const UObject* WorldContextObject);
+
+	/** 立即重新评估所有敌人 */
+	void EvaluateAll();
+
+	/** 上一次评估各档位的敌人数量 */
+	int32 GetNumInBucket(EEnemyTickBucket Bucket) const;
+
+private:
+	/** 计算单个敌人应处的档位 */
+	EEnemyTickBucket ComputeBucket(const AEnemyBase* Enemy, const FVector& ViewLocation, bool bHasViewer) const;
+
+	/** 距离下一次评估的剩余时间 */
+	float TimeUntilEvaluation = 0.0f;
+
+	/** 上一次评估各档位的敌人数量（按 EEnemyTickBucket 索引） */
+	int32 BucketCounts[3] = { 0, 0, 0 };
+};
@@ -0,0 +1,200 @@
+// 视线查询子系统实现
+
+#include "LineOfSightSubsystem.h"
+#include "Engine/World.h"
+#include "../BlackMythStats.h"
+#include "../BlackMythPerfCounters.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("LineOfSight Queries"), STAT_LineOfSightQueries, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LineOfSight Traces Issued"), STAT_LineOfSightTraces, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("LineOfSight Cached Pairs"), STAT_LineOfSightEntries, STATGROUP_BlackMyth);
+
+// ========== USubsystem ==========
+
+bool ULineOfSightSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void ULineOfSightSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	TraceDelegate.BindUObject(this, &ULineOfSightSubsystem::OnTraceDone);
+}
+
+void ULineOfSightSubsystem::Deinitialize()
+{
+	// 已发出的射线结果会因为委托失效而被丢弃
+	TraceDelegate.Unbind();
+	Entries.Empty();
+	QueuedKeys.Empty();
+	InFlightTraces.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId ULineOfSightSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(ULineOfSightSubsystem, STATGROUP_BlackMyth);
+}
+
+ULineOfSightSubsystem* ULineOfSightSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<ULineOfSightSubsystem>() : nullptr;
+}
+
+// ========== 查询 ==========
+
+ELineOfSightResult ULineOfSightSubsystem::QueryLineOfSight(const AActor* Viewer, const AActor* Target, const FVector& From, const FVector& To,
+	float MaxAge, TArrayView<const AActor* const> ExtraIgnored)
+{
+	if (!Viewer || !Target)
+	{
+		return ELineOfSightResult::Unknown;
+	}
+
+	INC_DWORD_STAT(STAT_LineOfSightQueries);
+
+	const double Now = GetWorld()->GetTimeSeconds();
+	const FPairKey Key(FObjectKey(Viewer), FObjectKey(Target));
+
+	FEntry& Entry = Entries.FindOrAdd(Key);
+	Entry.LastQueryTime = Now;
+
+	const float AcceptableAge = MaxAge < 0.0f ? DefaultMaxAge : MaxAge;
+	const bool bStale = Entry.ResultTime < 0.0 || Now - Entry.ResultTime > AcceptableAge;
+
+	// 过期且没有在途请求时登记（同一帧内的重复查询只会刷新端点）
+	if (bStale && !Entry.bInFlight)
+	{
+		Entry.Viewer = Viewer;
+		Entry.Target = Target;
+		Entry.From = From;
+		Entry.To = To;
+		Entry.ExtraIgnored.Reset();
+		for (const AActor* Ignored : ExtraIgnored)
+		{
+			Entry.ExtraIgnored.Add(Ignored);
+		}
+
+		if (!Entry.bQueued)
+		{
+			Entry.bQueued = true;
+			QueuedKeys.Add(Key);
+		}
+	}
+
+	return Entry.Result;
+}
+
+// ========== 批量发出 ==========
+
+void ULineOfSightSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	BLACKMYTH_TRACE_SCOPE(TEXT("BlackMyth.LineOfSight.Tick"));
+
+	DispatchQueued();
+
+	TimeUntilEviction -= DeltaTime;
+	if (TimeUntilEviction <= 0.0f)
+	{
+		TimeUntilEviction = EvictAfterSeconds * 0.5f;
+		EvictStaleEntries(GetWorld()->GetTimeSeconds());
+	}
+
+	SET_DWORD_STAT(STAT_LineOfSightEntries, Entries.Num());
+}
+
+void ULineOfSightSubsystem::DispatchQueued()
+{
+	UWorld* World = GetWorld();
+	if (!World || QueuedKeys.Num() == 0)
+	{
+		return;
+	}
+
+	const int32 NumToDispatch = FMath::Min(QueuedKeys.Num(), MaxTracesPerTick);
+	for (int32 Index = 0; Index < NumToDispatch; ++Index)
+	{
+		FEntry* Entry = Entries.Find(QueuedKeys[Index]);
+		if (!Entry)
+		{
+			continue;
+		}
+
+		Entry->bQueued = false;
+
+		const AActor* Viewer = Entry->Viewer.Get();
+		const AActor* Target = Entry->Target.Get();
+		if (!Viewer || !Target)
+		{
+			continue;
+		}
+
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(LineOfSightService), false);
+		QueryParams.AddIgnoredActor(Viewer);
+		QueryParams.AddIgnoredActor(Target);
+		for (const TWeakObjectPtr<const AActor>& Ignored : Entry->ExtraIgnored)
+		{
+			if (const AActor* IgnoredActor = Ignored.Get())
+			{
+				QueryParams.AddIgnoredActor(IgnoredActor);
+			}
+		}
+
+		const uint32 RequestId = NextRequestId++;
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Entry->From, Entry->To, ECC_Visibility, QueryParams,
+			FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, RequestId);
+
+		InFlightTraces.Add(RequestId, QueuedKeys[Index]);
+		Entry->bInFlight = true;
+	}
+
+	INC_DWORD_STAT_BY(STAT_LineOfSightTraces, NumToDispatch);
+	BlackMythPerf::Add(BlackMythPerf::ECounter::PhysicsQueries, NumToDispatch);
+	QueuedKeys.RemoveAt(0, NumToDispatch, EAllowShrinking::No);
+}
+
+void ULineOfSightSubsystem::OnTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FPairKey Key;
+	if (!InFlightTraces.RemoveAndCopyValue(TraceDatum.UserData, Key))
+	{
+		return;
+	}
+
+	if (FEntry* Entry = Entries.Find(Key))
+	{
+		// 没有阻挡命中说明视线畅通
+		const bool bBlocked = TraceDatum.OutHits.ContainsByPredicate([](const FHitResult& Hit) { return Hit.bBlockingHit; });
+		Entry->Result = bBlocked ? ELineOfSightResult::Blocked : ELineOfSightResult::Visible;
+		Entry->ResultTime = GetWorld()->GetTimeSeconds();
+		Entry->bInFlight = false;
+	}
+}
+
+void ULineOfSightSubsystem::EvictStaleEntries(double Now)
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		const FEntry& Entry = It->Value;
+		if (Entry.bQueued || Entry.bInFlight)
+		{
+			continue;
+		}
+
+		if (!Entry.Viewer.IsValid() || !Entry.Target.IsValid() || Now - Entry.LastQueryTime > EvictAfterSeconds)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,125 @@
+// 视线查询子系统 - 合并同帧重复的可见性请求，以异步射线执行并缓存结果
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "WorldCollision.h"
+#include "LineOfSightSubsystem.generated.h"
+
+/** 视线查询结果 */
+enum class ELineOfSightResult : uint8
+{
+	Unknown,    // 尚无结果（首次查询，异步射线还没有返回）
+	Visible,    // 视线畅通
+	Blocked     // 被遮挡
+};
+
+/**
+ * 视线查询子系统
+ * - 以（观察者, 目标）为键缓存可见性，结果在调用方给出的 MaxAge 内直接复用
+ * - 结果过期时不会立即发射线，而是登记到本帧的请求队列；同一对观察者/目标在一帧内多次查询只登记一次
+ * - Tick 时把队列中的请求以 AsyncLineTraceByChannel 发出（每帧最多 MaxTracesPerTick 条），
+ *   结果在下一帧由物理线程返回，游戏线程不再等待同步射线
+ * - 长时间没有被查询的条目会被清理
+ *
+ * 调用方在 Unknown 时自行决定按可见还是不可见处理（锁定视为可见，AI 攻击判定视为不可见）。
+ */
+UCLASS()
+class BLACKMYTH_API ULineOfSightSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// ========== FTickableGameObject ==========
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return Entries.Num() > 0; }
+
+	/** 获取世界的视线查询子系统（可能为空） */
+	static ULineOfSightSubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 查询 ==========
+
+	/**
+	 * 查询 Viewer 到 Target 的视线（ECC_Visibility，忽略双方）
+	 * @param From          射线起点（通常是观察者眼睛高度）
+	 * @param To            射线终点（通常是目标的锁定点）
+	 * @param MaxAge        可接受的缓存时间（秒），小于 0 时使用 DefaultMaxAge
+	 * @param ExtraIgnored  额外忽略的 Actor（只在发出新射线时使用）
+	 * @return 缓存的结果；过期时仍返回上一次的结果，并登记新的异步射线
+	 */
+	ELineOfSightResult QueryLineOfSight(const AActor* Viewer, const AActor* Target, const FVector& From, const FVector& To,
+		float MaxAge = -1.0f, TArrayView<const AActor* const> ExtraIgnored = TArrayView<const AActor* const>());
+
+	/** 默认缓存时间（秒） */
+	static constexpr float DefaultMaxAge = 0.15f;
+
+	/** 每帧最多发出的异步射线数量，超出的请求顺延到下一帧 */
+	static constexpr int32 MaxTracesPerTick = 64;
+
+	/** 条目超过此时间没有被查询则清理（秒） */
+	static constexpr float EvictAfterSeconds = 2.0f;
+
+private:
+	using FPairKey = TPair<FObjectKey, FObjectKey>;
+
+	struct FEntry
+	{
+		TWeakObjectPtr<const AActor> Viewer;
+		TWeakObjectPtr<const AActor> Target;
+
+		/** 最近一次登记的射线端点 */
+		FVector From = FVector::ZeroVector;
+		FVector To = FVector::ZeroVector;
+
+		/** 最近一次登记的额外忽略列表 */
+		TArray<TWeakObjectPtr<const AActor>, TInlineAllocator<2>> ExtraIgnored;
+
+		/** 结果时间（世界时间），小于 0 表示尚无结果 */
+		double ResultTime = -1.0;
+
+		/** 最近一次被查询的时间 */
+		double LastQueryTime = 0.0;
+
+		ELineOfSightResult Result = ELineOfSightResult::Unknown;
+
+		/** 已在本帧队列中 */
+		bool bQueued = false;
+
+		/** 异步射线已发出、尚未返回 */
+		bool bInFlight = false;
+	};
+
+	/** 发出队列中的请求 */
+	void DispatchQueued();
+
+	/** 异步射线返回 */
+	void OnTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+
+	/** 清理长时间未查询或对象已失效的条目 */
+	void EvictStaleEntries(double Now);
+
+	TMap<FPairKey, FEntry> Entries;
+
+	/** 本帧待发出的请求（去重后） */
+	TArray<FPairKey> QueuedKeys;
+
+	/** 异步射线编号 -> 条目键 */
+	TMap<uint32, FPairKey> InFlightTraces;
+
+	uint32 NextRequestId = 1;
+
+	FTraceDelegate TraceDelegate;
+
+	/** 距离下一次清理的时间 */
+	float TimeUntilEviction = 0.0f;
+};
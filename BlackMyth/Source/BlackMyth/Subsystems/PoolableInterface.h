@@ -0,0 +1,34 @@
+// 可池化接口 - 对象池回收/取出时的重置钩子
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "PoolableInterface.generated.h"
+
+UINTERFACE(MinimalAPI, meta = (CannotImplementInterfaceInBlueprint))
+class UPoolable : public UInterface
+{
+	GENERATED_BODY()
+};
+
+/**
+ * 可池化接口
+ * 由 UActorPoolSubsystem 管理的 Actor 及其组件都可以实现此接口。
+ * 对象池已经处理了通用部分（隐藏、关闭碰撞与 Tick、清除计时器、设置变换/Owner），
+ * 这里只需要处理类自身的状态。
+ *
+ * 注意：新生成的实例走正常的 BeginPlay，不会调用 OnAcquiredFromPool；
+ * 只有从池中复用的实例才会调用，因此 OnAcquiredFromPool 应当完成与 BeginPlay 等价的"激活"逻辑。
+ */
+class BLACKMYTH_API IPoolable
+{
+	GENERATED_BODY()
+
+public:
+	/** 从池中取出复用（变换、Owner、Instigator 已设置，Actor 已显示） */
+	virtual void OnAcquiredFromPool() {}
+
+	/** 回收到池中（之后 Actor 会被隐藏并停止 Tick） */
+	virtual void OnReleasedToPool() {}
+};
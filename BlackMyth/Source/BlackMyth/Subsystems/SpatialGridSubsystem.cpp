@@ -0,0 +1,371 @@
+// 空间网格子系统实现
+
+#include "SpatialGridSubsystem.h"
+#include "../Components/TeamComponent.h"
+#include "../Components/HealthComponent.h"
+#include "../Combat/CombatActorInterface.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "../BlackMythStats.h"
+#include "../BlackMythPerfCounters.h"
+#include "../BlackMythLog.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("SpatialGrid Entries"), STAT_SpatialGridEntries, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SpatialGrid Cell Moves"), STAT_SpatialGridCellMoves, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("SpatialGrid Queries"), STAT_SpatialGridQueries, STATGROUP_BlackMyth);
+
+// ========== USubsystem ==========
+
+void USpatialGridSubsystem::Deinitialize()
+{
+	Grid.Reset();
+	TrackedActors.Empty();
+	HandleByActor.Empty();
+	QueryHandles.Empty();
+
+	Super::Deinitialize();
+}
+
+bool USpatialGridSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId USpatialGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpatialGridSubsystem, STATGROUP_BlackMyth);
+}
+
+USpatialGridSubsystem* USpatialGridSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<USpatialGridSubsystem>() : nullptr;
+}
+
+void USpatialGridSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	BLACKMYTH_TRACE_SCOPE(TEXT("BlackMyth.SpatialGrid.Tick"));
+
+	RefreshEntries();
+}
+
+// ========== 注册 / 注销 ==========
+
+void USpatialGridSubsystem::RegisterActor(AActor* Actor, ETeam Team, UTeamComponent* TeamComponent)
+{
+	if (!Actor)
+	{
+		return;
+	}
+
+	// 重复注册时只更新阵营来源
+	if (const int32* ExistingHandle = HandleByActor.Find(Actor))
+	{
+		FTrackedActor& Tracked = TrackedActors[*ExistingHandle];
+		Tracked.TeamComponent = TeamComponent;
+		Tracked.FixedTeam = Team;
+		Grid.Update(*ExistingHandle, Actor->GetActorLocation(), TeamComponent ? TeamComponent->GetTeam() : Team);
+		return;
+	}
+
+	const int32 Handle = Grid.Add(Actor->GetActorLocation(), TeamComponent ? TeamComponent->GetTeam() : Team);
+	if (TrackedActors.Num() <= Handle)
+	{
+		TrackedActors.SetNum(Handle + 1);
+	}
+
+	FTrackedActor& Tracked = TrackedActors[Handle];
+	Tracked.Actor = Actor;
+	Tracked.TeamComponent = TeamComponent;
+	Tracked.FixedTeam = Team;
+
+	HandleByActor.Add(Actor, Handle);
+}
+
+void USpatialGridSubsystem::UnregisterActor(AActor* Actor)
+{
+	int32 Handle = INDEX_NONE;
+	if (HandleByActor.RemoveAndCopyValue(Actor, Handle))
+	{
+		Grid.Remove(Handle);
+		TrackedActors[Handle] = FTrackedActor();
+	}
+}
+
+bool USpatialGridSubsystem::GetRegisteredTeam(const AActor* Actor, ETeam& OutTeam) const
+{
+	const int32* Handle = HandleByActor.Find(Actor);
+	if (!Handle)
+	{
+		return false;
+	}
+
+	OutTeam = Grid.GetTeam(*Handle);
+	return true;
+}
+
+void USpatialGridSubsystem::RefreshEntries()
+{
+	int32 NumCellMoves = 0;
+
+	for (auto It = HandleByActor.CreateIterator(); It; ++It)
+	{
+		const int32 Handle = It.Value();
+		FTrackedActor& Tracked = TrackedActors[Handle];
+
+		AActor* Actor = Tracked.Actor.Get();
+		if (!IsValid(Actor))
+		{
+			// 未走 EndPlay 就被销毁的 Actor
+			Grid.Remove(Handle);
+			Tracked = FTrackedActor();
+			It.RemoveCurrent();
+			continue;
+		}
+
+		const UTeamComponent* TeamComponent = Tracked.TeamComponent.Get();
+		const ETeam Team = TeamComponent ? TeamComponent->GetTeam() : Tracked.FixedTeam;
+
+		if (Grid.Update(Handle, Actor->GetActorLocation(), Team))
+		{
+			++NumCellMoves;
+		}
+	}
+
+	SET_DWORD_STAT(STAT_SpatialGridEntries, Grid.Num());
+	INC_DWORD_STAT_BY(STAT_SpatialGridCellMoves, NumCellMoves);
+}
+
+// ========== 查询 ==========
+
+AActor* USpatialGridSubsystem::ResolveHandle(int32 Handle) const
+{
+	if (!TrackedActors.IsValidIndex(Handle))
+	{
+		return nullptr;
+	}
+
+	AActor* Actor = TrackedActors[Handle].Actor.Get();
+	return IsValid(Actor) ? Actor : nullptr;
+}
+
+void USpatialGridSubsystem::HandlesToActors(const TArray<int32>& Handles, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reserve(OutActors.Num() + Handles.Num());
+	for (const int32 Handle : Handles)
+	{
+		if (AActor* Actor = ResolveHandle(Handle))
+		{
+			OutActors.Add(Actor);
+		}
+	}
+}
+
+void USpatialGridSubsystem::QueryRadius(const FVector& Center, float Radius, uint8 TeamMask, TArray<AActor*>& OutActors) const
+{
+	INC_DWORD_STAT(STAT_SpatialGridQueries);
+	BlackMythPerf::Add(BlackMythPerf::ECounter::SpatialQueries);
+
+	QueryHandles.Reset();
+	Grid.QueryRadius(Center, Radius, TeamMask, QueryHandles);
+	HandlesToActors(QueryHandles, OutActors);
+}
+
+void USpatialGridSubsystem::QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, uint8 TeamMask, TArray<AActor*>& OutActors) const
+{
+	INC_DWORD_STAT(STAT_SpatialGridQueries);
+	BlackMythPerf::Add(BlackMythPerf::ECounter::SpatialQueries);
+
+	QueryHandles.Reset();
+	Grid.QueryCone(Origin, Direction, Radius, HalfAngleDegrees, TeamMask, QueryHandles);
+	HandlesToActors(QueryHandles, OutActors);
+}
+
+void USpatialGridSubsystem::QueryKNearest(const FVector& Center, float Radius, int32 K, uint8 TeamMask, TArray<AActor*>& OutActors) const
+{
+	INC_DWORD_STAT(STAT_SpatialGridQueries);
+	BlackMythPerf::Add(BlackMythPerf::ECounter::SpatialQueries);
+
+	QueryHandles.Reset();
+	Grid.QueryKNearest(Center, Radius, K, TeamMask, QueryHandles);
+	HandlesToActors(QueryHandles, OutActors);
+}
+
+AActor* USpatialGridSubsystem::FindNearest(const FVector& Center, float Radius, uint8 TeamMask, TFunctionRef<bool(AActor*)> Filter) const
+{
+	INC_DWORD_STAT(STAT_SpatialGridQueries);
+	BlackMythPerf::Add(BlackMythPerf::ECounter::SpatialQueries);
+
+	AActor* Nearest = nullptr;
+	float NearestDistSq = TNumericLimits<float>::Max();
+
+	Grid.ForEachInRadius(Center, Radius, TeamMask, [this, &Filter, &Nearest, &NearestDistSq](int32 Handle, float DistSq)
+	{
+		if (DistSq >= NearestDistSq)
+		{
+			return;
+		}
+
+		AActor* Actor = ResolveHandle(Handle);
+		if (Actor && Filter(Actor))
+		{
+			Nearest = Actor;
+			NearestDistSq = DistSq;
+		}
+	});
+
+	return Nearest;
+}
+
+AActor* USpatialGridSubsystem::FindNearestHostile(const AActor* Seeker, float Radius) const
+{
+	return FindNearestHostile(Seeker, Radius, [](AActor*) { return true; });
+}
+
+AActor* USpatialGridSubsystem::FindNearestHostile(const AActor* Seeker, float Radius, TFunctionRef<bool(AActor*)> Filter) const
+{
+	ETeam SeekerTeam;
+	if (!Seeker || !UTeamComponent::TryGetActorTeam(Seeker, SeekerTeam))
+	{
+		return nullptr;
+	}
+
+	return FindNearest(Seeker->GetActorLocation(), Radius, SpatialGrid::HostileTeamMask(SeekerTeam), [Seeker, &Filter](AActor* Candidate)
+	{
+		if (Candidate == Seeker)
+		{
+			return false;
+		}
+
+		const UHealthComponent* Health = ICombatActor::GetHealth(Candidate);
+		if (Health && Health->IsDead())
+		{
+			return false;
+		}
+
+		return Filter(Candidate);
+	});
+}
+
+// ========== 性能测试 ==========
+
+#if !UE_BUILD_SHIPPING
+
+namespace SpatialGridBenchmark
+{
+	/**
+	 * 控制台命令：BlackMyth.SpatialGrid.Benchmark [实体数=512] [查询数=2000] [半径=1500]
+	 * 在 200m x 200m 区域内随机撒点（90% 敌人，其余为玩家/中立），
+	 * 对比网格查询与线性遍历的耗时，并校验两者结果数量一致。
+	 */
+	static void Run(const TArray<FString>& Args)
+	{
+		const int32 NumEntities = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 512;
+		const int32 NumQueries = Args.Num() > 1 ? FMath::Max(FCString::Atoi(*Args[1]), 1) : 2000;
+		const float Radius = Args.Num() > 2 ? FMath::Max(FCString::Atof(*Args[2]), 1.0f) : 1500.0f;
+		constexpr float HalfWorldSize = 10000.0f;
+
+		FRandomStream Random(1234);
+		FSpatialHashGrid Grid;
+		TArray<FVector> Locations;
+		TArray<ETeam> Teams;
+		Locations.Reserve(NumEntities);
+		Teams.Reserve(NumEntities);
+
+		for (int32 i = 0; i < NumEntities; ++i)
+		{
+			const FVector Location(
+				Random.FRandRange(-HalfWorldSize, HalfWorldSize),
+				Random.FRandRange(-HalfWorldSize, HalfWorldSize),
+				Random.FRandRange(0.0f, 500.0f));
+			const float Roll = Random.FRand();
+			const ETeam Team = Roll < 0.9f ? ETeam::Enemy : (Roll < 0.95f ? ETeam::Player : ETeam::Neutral);
+
+			Grid.Add(Location, Team);
+			Locations.Add(Location);
+			Teams.Add(Team);
+		}
+
+		TArray<FVector> QueryCenters;
+		QueryCenters.Reserve(NumQueries);
+		for (int32 i = 0; i < NumQueries; ++i)
+		{
+			QueryCenters.Add(FVector(Random.FRandRange(-HalfWorldSize, HalfWorldSize), Random.FRandRange(-HalfWorldSize, HalfWorldSize), 250.0f));
+		}
+
+		const uint8 EnemyMask = SpatialGrid::TeamBit(ETeam::Enemy);
+		const float RadiusSq = FMath::Square(Radius);
+		TArray<int32> Handles;
+		int64 GridHits = 0;
+		int64 LinearHits = 0;
+
+		// 网格半径查询
+		double StartTime = FPlatformTime::Seconds();
+		for (const FVector& Center : QueryCenters)
+		{
+			Handles.Reset();
+			Grid.QueryRadius(Center, Radius, EnemyMask, Handles);
+			GridHits += Handles.Num();
+		}
+		const double GridRadiusTime = FPlatformTime::Seconds() - StartTime;
+
+		// 线性遍历（等价于旧的全量遍历）
+		StartTime = FPlatformTime::Seconds();
+		for (const FVector& Center : QueryCenters)
+		{
+			for (int32 i = 0; i < Locations.Num(); ++i)
+			{
+				if (Teams[i] == ETeam::Enemy && FVector::DistSquared(Center, Locations[i]) <= RadiusSq)
+				{
+					++LinearHits;
+				}
+			}
+		}
+		const double LinearTime = FPlatformTime::Seconds() - StartTime;
+
+		// 扇形查询
+		StartTime = FPlatformTime::Seconds();
+		for (const FVector& Center : QueryCenters)
+		{
+			Handles.Reset();
+			Grid.QueryCone(Center, FVector::ForwardVector, Radius, 60.0f, EnemyMask, Handles);
+		}
+		const double GridConeTime = FPlatformTime::Seconds() - StartTime;
+
+		// K 近邻查询
+		StartTime = FPlatformTime::Seconds();
+		for (const FVector& Center : QueryCenters)
+		{
+			Handles.Reset();
+			Grid.QueryKNearest(Center, Radius, 4, EnemyMask, Handles);
+		}
+		const double GridKNearestTime = FPlatformTime::Seconds() - StartTime;
+
+		const double ToMicrosPerQuery = 1.0e6 / NumQueries;
+		UE_LOG(LogBMCombat, Display, TEXT("[SpatialGrid] Benchmark: %d entities, %d queries, radius %.0f, cell %.0f"),
+			NumEntities, NumQueries, Radius, Grid.GetCellSize());
+		UE_LOG(LogBMCombat, Display, TEXT("[SpatialGrid]   Radius   %.3f us/query (%lld hits)"), GridRadiusTime * ToMicrosPerQuery, GridHits);
+		UE_LOG(LogBMCombat, Display, TEXT("[SpatialGrid]   Cone     %.3f us/query"), GridConeTime * ToMicrosPerQuery);
+		UE_LOG(LogBMCombat, Display, TEXT("[SpatialGrid]   KNearest %.3f us/query"), GridKNearestTime * ToMicrosPerQuery);
+		UE_LOG(LogBMCombat, Display, TEXT("[SpatialGrid]   Linear   %.3f us/query (%lld hits)"), LinearTime * ToMicrosPerQuery, LinearHits);
+
+		if (GridHits != LinearHits)
+		{
+			UE_LOG(LogBMCombat, Error, TEXT("[SpatialGrid] Benchmark mismatch: grid %lld vs linear %lld"), GridHits, LinearHits);
+		}
+	}
+
+	static FAutoConsoleCommand BenchmarkCommand(
+		TEXT("BlackMyth.SpatialGrid.Benchmark"),
+		TEXT("Benchmark spatial grid queries against a linear scan. Args: [NumEntities=512] [NumQueries=2000] [Radius=1500]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&Run));
+}
+
+#endif
@@ -0,0 +1,102 @@
+// 空间网格子系统 - 阵营感知的近邻查询，替代物理重叠检测与全场景遍历
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "SpatialHashGrid.h"
+#include "SpatialGridSubsystem.generated.h"
+
+class UTeamComponent;
+
+/**
+ * 空间网格子系统
+ * 维护一张按阵营分桶的空间哈希网格（FSpatialHashGrid）：
+ * - 挂载 UTeamComponent 的 Actor 由组件自动注册，阵营随组件变化
+ * - 没有阵营组件的 Actor（NPC 等）注册时指定固定阵营
+ * - 每帧末刷新一次位置，只有跨格子或换阵营的条目才移动桶
+ *
+ * 所有查询都不访问物理场景，位置取自最近一次刷新（最多滞后一帧）。
+ */
+UCLASS()
+class BLACKMYTH_API USpatialGridSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual void Deinitialize() override;
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+	// ========== FTickableGameObject ==========
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** 获取世界的空间网格（可能为空，例如编辑器预览世界） */
+	static USpatialGridSubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 注册 / 注销 ==========
+
+	/**
+	 * 注册 Actor
+	 * @param TeamComponent 非空时每帧从组件读取阵营，否则固定使用 Team
+	 */
+	void RegisterActor(AActor* Actor, ETeam Team, UTeamComponent* TeamComponent = nullptr);
+	void UnregisterActor(AActor* Actor);
+
+	/** 查询 Actor 注册时记录的阵营（未注册返回 false） */
+	bool GetRegisteredTeam(const AActor* Actor, ETeam& OutTeam) const;
+
+	int32 GetNumRegistered() const { return Grid.Num(); }
+
+	// ========== 查询 ==========
+
+	/** 收集半径内、阵营在 TeamMask 中的 Actor */
+	void QueryRadius(const FVector& Center, float Radius, uint8 TeamMask, TArray<AActor*>& OutActors) const;
+
+	/** 收集水平扇形内的 Actor（HalfAngleDegrees 为半角） */
+	void QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, uint8 TeamMask, TArray<AActor*>& OutActors) const;
+
+	/** 收集最近的 K 个 Actor，按距离升序 */
+	void QueryKNearest(const FVector& Center, float Radius, int32 K, uint8 TeamMask, TArray<AActor*>& OutActors) const;
+
+	/** 半径内满足 Filter 的最近 Actor（没有则返回 nullptr） */
+	AActor* FindNearest(const FVector& Center, float Radius, uint8 TeamMask, TFunctionRef<bool(AActor*)> Filter) const;
+
+	/**
+	 * Seeker 周围半径内最近的存活敌对单位（没有则返回 nullptr）
+	 * 阵营取自 Seeker，存活以生命组件为准；分身和敌人 AI 的索敌都走这里
+	 * @param Filter 额外筛选（例如只保留已被感知到的目标）
+	 */
+	AActor* FindNearestHostile(const AActor* Seeker, float Radius) const;
+	AActor* FindNearestHostile(const AActor* Seeker, float Radius, TFunctionRef<bool(AActor*)> Filter) const;
+
+private:
+	struct FTrackedActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+		TWeakObjectPtr<UTeamComponent> TeamComponent;
+		ETeam FixedTeam = ETeam::Neutral;
+	};
+
+	/** 刷新所有条目的位置和阵营，清理已销毁的 Actor */
+	void RefreshEntries();
+
+	/** 句柄 -> Actor（无效句柄或已销毁返回 nullptr） */
+	AActor* ResolveHandle(int32 Handle) const;
+
+	void HandlesToActors(const TArray<int32>& Handles, TArray<AActor*>& OutActors) const;
+
+	FSpatialHashGrid Grid;
+
+	/** 下标与网格句柄一致 */
+	TArray<FTrackedActor> TrackedActors;
+
+	TMap<TObjectKey<AActor>, int32> HandleByActor;
+
+	/** 查询时复用的句柄缓冲 */
+	mutable TArray<int32> QueryHandles;
+};
@@ -0,0 +1,142 @@
+// 空间哈希网格实现
+
+#include "SpatialHashGrid.h"
+
+FSpatialHashGrid::FSpatialHashGrid(float InCellSize)
+	: CellSize(FMath::Max(InCellSize, 1.0f))
+	, InvCellSize(1.0f / FMath::Max(InCellSize, 1.0f))
+{
+}
+
+// ========== 条目管理 ==========
+
+int32 FSpatialHashGrid::Add(const FVector& Location, ETeam Team)
+{
+	FEntry Entry;
+	Entry.Location = Location;
+	Entry.Cell = ToCell(Location);
+	Entry.Team = Team;
+
+	const int32 Handle = Entries.Add(Entry);
+	AddToBucket(Handle, Entry);
+	return Handle;
+}
+
+void FSpatialHashGrid::Remove(int32 Handle)
+{
+	if (!Entries.IsValidIndex(Handle))
+	{
+		return;
+	}
+
+	RemoveFromBucket(Handle, Entries[Handle]);
+	Entries.RemoveAt(Handle);
+}
+
+bool FSpatialHashGrid::Update(int32 Handle, const FVector& Location, ETeam Team)
+{
+	if (!Entries.IsValidIndex(Handle))
+	{
+		return false;
+	}
+
+	FEntry& Entry = Entries[Handle];
+	Entry.Location = Location;
+
+	const FIntPoint NewCell = ToCell(Location);
+	if (NewCell == Entry.Cell && Team == Entry.Team)
+	{
+		return false;
+	}
+
+	RemoveFromBucket(Handle, Entry);
+	Entry.Cell = NewCell;
+	Entry.Team = Team;
+	AddToBucket(Handle, Entry);
+	return true;
+}
+
+void FSpatialHashGrid::Reset()
+{
+	Entries.Empty();
+	for (FCellMap& TeamCells : Cells)
+	{
+		TeamCells.Empty();
+	}
+}
+
+void FSpatialHashGrid::AddToBucket(int32 Handle, const FEntry& Entry)
+{
+	GetCells(Entry.Team).FindOrAdd(Entry.Cell).Add(Handle);
+}
+
+void FSpatialHashGrid::RemoveFromBucket(int32 Handle, const FEntry& Entry)
+{
+	if (FCellBucket* Bucket = GetCells(Entry.Team).Find(Entry.Cell))
+	{
+		Bucket->RemoveSingleSwap(Handle, EAllowShrinking::No);
+	}
+}
+
+// ========== 查询 ==========
+
+void FSpatialHashGrid::QueryRadius(const FVector& Center, float Radius, uint8 TeamMask, TArray<int32>& OutHandles) const
+{
+	ForEachInRadius(Center, Radius, TeamMask, [&OutHandles](int32 Handle, float)
+	{
+		OutHandles.Add(Handle);
+	});
+}
+
+void FSpatialHashGrid::QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, uint8 TeamMask, TArray<int32>& OutHandles) const
+{
+	const FVector Forward2D = Direction.GetSafeNormal2D();
+	const float MinDot = FMath::Cos(FMath::DegreesToRadians(FMath::Clamp(HalfAngleDegrees, 0.0f, 180.0f)));
+
+	ForEachInRadius(Origin, Radius, TeamMask, [this, &Origin, &Forward2D, MinDot, &OutHandles](int32 Handle, float)
+	{
+		const FVector ToEntry = (Entries[Handle].Location - Origin).GetSafeNormal2D();
+
+		// 与原点重合的条目视为在扇形内
+		if (ToEntry.IsNearlyZero() || FVector::DotProduct(Forward2D, ToEntry) >= MinDot)
+		{
+			OutHandles.Add(Handle);
+		}
+	});
+}
+
+void FSpatialHashGrid::QueryKNearest(const FVector& Center, float Radius, int32 K, uint8 TeamMask, TArray<int32>& OutHandles) const
+{
+	if (K <= 0)
+	{
+		return;
+	}
+
+	// 按距离升序保存当前最近的 K 个，K 通常很小，插入排序即可
+	TArray<TPair<float, int32>, TInlineAllocator<16>> Nearest;
+
+	ForEachInRadius(Center, Radius, TeamMask, [K, &Nearest](int32 Handle, float DistSq)
+	{
+		if (Nearest.Num() == K)
+		{
+			if (DistSq >= Nearest.Last().Key)
+			{
+				return;
+			}
+			Nearest.Pop(EAllowShrinking::No);
+		}
+
+		int32 InsertIndex = Nearest.Num();
+		while (InsertIndex > 0 && Nearest[InsertIndex - 1].Key > DistSq)
+		{
+			--InsertIndex;
+		}
+		Nearest.Insert(TPair<float, int32>(DistSq, Handle), InsertIndex);
+	});
+
+	OutHandles.Reserve(OutHandles.Num() + Nearest.Num());
+	for (const TPair<float, int32>& Pair : Nearest)
+	{
+		OutHandles.Add(Pair.Value);
+	}
+}
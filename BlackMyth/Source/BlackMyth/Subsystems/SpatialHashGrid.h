@@ -0,0 +1,175 @@
+// 空间哈希网格 - 按阵营分桶的近邻查询数据结构（不依赖物理场景）
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "../Components/TeamComponent.h"
+
+namespace SpatialGrid
+{
+	/** ETeam 枚举数量 */
+	constexpr int32 NumTeams = TeamHostility::NumTeams;
+
+	/** 默认格子边长（厘米），与常见查询半径（NPC 交互 ~300、警报 ~1000、锁定 ~2000）同一量级 */
+	constexpr float DefaultCellSize = 1000.0f;
+
+	/** 阵营对应的掩码位 */
+	using TeamHostility::TeamBit;
+
+	/** 所有阵营 */
+	constexpr uint8 AllTeams = static_cast<uint8>((1u << NumTeams) - 1u);
+
+	/** 与 Team 敌对的阵营掩码（直接取 TeamHostility 表，与敌我判定共用同一份关系） */
+	constexpr uint8 HostileTeamMask(ETeam Team)
+	{
+		return TeamHostility::HostileMask(Team);
+	}
+}
+
+/**
+ * 空间哈希网格
+ * XY 平面按固定边长划分格子，每个阵营一张 格子 -> 条目句柄 的哈希表。
+ * 条目只在跨越格子或切换阵营时才移动桶，位置更新本身是 O(1)。
+ * 查询只遍历半径覆盖的格子，最终按三维距离精确过滤。
+ *
+ * 句柄为稀疏数组下标，移除后可能被复用；外部需自行维护 句柄 -> 对象 的映射。
+ */
+class BLACKMYTH_API FSpatialHashGrid
+{
+public:
+	explicit FSpatialHashGrid(float InCellSize = SpatialGrid::DefaultCellSize);
+
+	// ========== 条目管理 ==========
+
+	/** 添加条目，返回句柄 */
+	int32 Add(const FVector& Location, ETeam Team);
+
+	/** 移除条目 */
+	void Remove(int32 Handle);
+
+	/**
+	 * 更新条目位置与阵营
+	 * @return 是否换了桶（跨格子或换阵营）
+	 */
+	bool Update(int32 Handle, const FVector& Location, ETeam Team);
+
+	/** 清空所有条目 */
+	void Reset();
+
+	bool IsValidHandle(int32 Handle) const { return Entries.IsValidIndex(Handle); }
+	const FVector& GetLocation(int32 Handle) const { return Entries[Handle].Location; }
+	ETeam GetTeam(int32 Handle) const { return Entries[Handle].Team; }
+	int32 Num() const { return Entries.Num(); }
+	float GetCellSize() const { return CellSize; }
+
+	// ========== 查询 ==========
+
+	/**
+	 * 遍历半径内、阵营在 TeamMask 中的条目
+	 * @param Visitor void(int32 Handle, float DistSq)，遍历期间不能修改网格
+	 */
+	template<typename VisitorType>
+	void ForEachInRadius(const FVector& Center, float Radius, uint8 TeamMask, VisitorType&& Visitor) const;
+
+	/** 收集半径内的条目 */
+	void QueryRadius(const FVector& Center, float Radius, uint8 TeamMask, TArray<int32>& OutHandles) const;
+
+	/**
+	 * 收集水平扇形内的条目（与锁定系统一致，只比较 XY 方向）
+	 * @param HalfAngleDegrees 扇形半角
+	 */
+	void QueryCone(const FVector& Origin, const FVector& Direction, float Radius, float HalfAngleDegrees, uint8 TeamMask, TArray<int32>& OutHandles) const;
+
+	/** 收集半径内最近的 K 个条目，按距离升序 */
+	void QueryKNearest(const FVector& Center, float Radius, int32 K, uint8 TeamMask, TArray<int32>& OutHandles) const;
+
+private:
+	struct FEntry
+	{
+		FVector Location;
+		FIntPoint Cell;
+		ETeam Team;
+	};
+
+	using FCellBucket = TArray<int32, TInlineAllocator<8>>;
+	using FCellMap = TMap<FIntPoint, FCellBucket>;
+
+	FIntPoint ToCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt32(Location.X * InvCellSize), FMath::FloorToInt32(Location.Y * InvCellSize));
+	}
+
+	FCellMap& GetCells(ETeam Team) { return Cells[static_cast<int32>(Team)]; }
+
+	void AddToBucket(int32 Handle, const FEntry& Entry);
+	void RemoveFromBucket(int32 Handle, const FEntry& Entry);
+
+	TSparseArray<FEntry> Entries;
+
+	/** 每个阵营一张格子表；空桶保留，避免单位在格子边界来回走动时反复分配 */
+	FCellMap Cells[SpatialGrid::NumTeams];
+
+	float CellSize;
+	float InvCellSize;
+};
+
+template<typename VisitorType>
+void FSpatialHashGrid::ForEachInRadius(const FVector& Center, float Radius, uint8 TeamMask, VisitorType&& Visitor) const
+{
+	const float RadiusSq = FMath::Square(Radius);
+	const FIntPoint MinCell = ToCell(Center - FVector(Radius));
+	const FIntPoint MaxCell = ToCell(Center + FVector(Radius));
+	const int64 NumCoveredCells = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+
+	auto VisitBucket = [this, &Center, RadiusSq, &Visitor](const FCellBucket& Bucket)
+	{
+		for (const int32 Handle : Bucket)
+		{
+			const float DistSq = FVector::DistSquared(Center, Entries[Handle].Location);
+			if (DistSq <= RadiusSq)
+			{
+				Visitor(Handle, DistSq);
+			}
+		}
+	};
+
+	for (int32 TeamIndex = 0; TeamIndex < SpatialGrid::NumTeams; ++TeamIndex)
+	{
+		if ((TeamMask & (1u << TeamIndex)) == 0)
+		{
+			continue;
+		}
+
+		const FCellMap& TeamCells = Cells[TeamIndex];
+		if (TeamCells.Num() == 0)
+		{
+			continue;
+		}
+
+		if (NumCoveredCells > TeamCells.Num())
+		{
+			// 半径覆盖的格子比已占用的格子还多：直接遍历已占用格子
+			for (const TPair<FIntPoint, FCellBucket>& Pair : TeamCells)
+			{
+				const FIntPoint& Cell = Pair.Key;
+				if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y)
+				{
+					VisitBucket(Pair.Value);
+				}
+			}
+		}
+		else
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+				{
+					if (const FCellBucket* Bucket = TeamCells.Find(FIntPoint(X, Y)))
+					{
+						VisitBucket(*Bucket);
+					}
+				}
+			}
+		}
+	}
+}
@@ -2,8 +2,8 @@
 #include "Components/Button.h"
 #include "Components/TextBlock.h"
 #include "Kismet/GameplayStatics.h"
-#include "EngineUtils.h"
 #include "Temple.h"
+#include "Subsystems/ActorRegistrySubsystem.h"
 #include "WukongCharacter.h"
 #include "TeleportMenuWidget.h"
 #include "GameFramework/PlayerController.h"
@@ -45,54 +45,53 @@ void UTeleportButtonWidget::OnTeleportClicked()
         return;
     }
 
-    // 遍历场景中的所有土地庙，查找目标土地庙
-    for (TActorIterator<AInteractableActor> It(World); It; ++It)
+    // 按 TempleID 查找目标土地庙
+    UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(World);
+    AInteractableActor* Temple = Registry ? Registry->FindTempleByID(TargetTempleID) : nullptr;
+    if (!Temple || !Temple->TeleportPoint)
     {
-        // 找到匹配的土地庙
-        if (It->TempleID == TargetTempleID && It->TeleportPoint)
-        {
-            FVector TeleportLoc = It->TeleportPoint->GetComponentLocation();
-            FRotator TeleportRot = It->TeleportPoint->GetComponentRotation();
-            
-            // 在传送点周围随机偏移位置，避免与土地庙模型碰撞
-            const float RandomRadius = FMath::RandRange(100.f, 200.f);
-            const float RandomAngle = FMath::RandRange(0.f, 2.f * PI);
-            const float OffsetX = RandomRadius * FMath::Cos(RandomAngle);
-            const float OffsetY = RandomRadius * FMath::Sin(RandomAngle);
-            const float HeightOffset = 150.f;  // 向上偏移，防止卡入地形
-            
-            TeleportLoc += FVector(OffsetX, OffsetY, HeightOffset);
-            
-            // 传送玩家到目标位置
-            Player->SetActorLocation(TeleportLoc);
-            Player->SetActorRotation(TeleportRot);
-
-            // 关闭传送菜单UI
-            // 关闭传送菜单和父级土地庙菜单
-            if (UTeleportMenuWidget* TeleportMenu = GetTypedOuter<UTeleportMenuWidget>())
-            {
-                if (TeleportMenu->OwnerTempleWidget)
-                {
-                    TeleportMenu->OwnerTempleWidget->RemoveFromParent();
-                }
-                TeleportMenu->RemoveFromParent();
-            }
-            else if (UUserWidget* OwnerWidget = GetTypedOuter<UUserWidget>())
-            {
-                OwnerWidget->RemoveFromParent();
-            }
+        return;
+    }
 
-            // 恢复游戏运行状态
-            UGameplayStatics::SetGamePaused(World, false);
+    FVector TeleportLoc = Temple->TeleportPoint->GetComponentLocation();
+    FRotator TeleportRot = Temple->TeleportPoint->GetComponentRotation();
+    
+    // 在传送点周围随机偏移位置，避免与土地庙模型碰撞
+    const float RandomRadius = FMath::RandRange(100.f, 200.f);
+    const float RandomAngle = FMath::RandRange(0.f, 2.f * PI);
+    const float OffsetX = RandomRadius * FMath::Cos(RandomAngle);
+    const float OffsetY = RandomRadius * FMath::Sin(RandomAngle);
+    const float HeightOffset = 150.f;  // 向上偏移，防止卡入地形
+    
+    TeleportLoc += FVector(OffsetX, OffsetY, HeightOffset);
+    
+    // 传送玩家到目标位置
+    Player->SetActorLocation(TeleportLoc);
+    Player->SetActorRotation(TeleportRot);
 
-            // 恢复游戏输入模式，隐藏鼠标光标
-            if (APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0))
-            {
-                PC->SetInputMode(FInputModeGameOnly());
-                PC->bShowMouseCursor = false;
-            }
-            break;
+    // 关闭传送菜单UI
+    // 关闭传送菜单和父级土地庙菜单
+    if (UTeleportMenuWidget* TeleportMenu = GetTypedOuter<UTeleportMenuWidget>())
+    {
+        if (TeleportMenu->OwnerTempleWidget)
+        {
+            TeleportMenu->OwnerTempleWidget->RemoveFromParent();
         }
+        TeleportMenu->RemoveFromParent();
+    }
+    else if (UUserWidget* OwnerWidget = GetTypedOuter<UUserWidget>())
+    {
+        OwnerWidget->RemoveFromParent();
+    }
+
+    // 恢复游戏运行状态
+    UGameplayStatics::SetGamePaused(World, false);
+
+    // 恢复游戏输入模式，隐藏鼠标光标
+    if (APlayerController* PC = UGameplayStatics::GetPlayerController(World, 0))
+    {
+        PC->SetInputMode(FInputModeGameOnly());
+        PC->bShowMouseCursor = false;
     }
 }
 
@@ -1,6 +1,6 @@
 #include "TeleportMenuWidget.h"
 #include "Temple.h"
-#include "EngineUtils.h"
+#include "Subsystems/ActorRegistrySubsystem.h"
 #include "Components/CanvasPanel.h"
 #include "Components/CanvasPanelSlot.h"
 #include "Components/Image.h"
@@ -46,11 +46,14 @@ void UTeleportMenuWidget::BuildTeleportButtons()
     Temples.Reserve(32);
 
     int32 Count = 0;
-    for (TActorIterator<AInteractableActor> It(GetWorld()); It; ++It)
+    if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
     {
-        Temples.Add(*It);
-        ++Count;
-        UE_LOG(LogTemp, Verbose, TEXT("找到土地庙: %s"), *It->GetName());
+        for (AInteractableActor* Temple : Registry->GetTemples())
+        {
+            Temples.Add(Temple);
+            ++Count;
+            UE_LOG(LogTemp, Verbose, TEXT("找到土地庙: %s"), *Temple->GetName());
+        }
     }
     UE_LOG(LogTemp, Log, TEXT("土地庙总数: %d"), Count);
 
@@ -11,6 +11,7 @@
 #include "Components/InventoryComponent.h"
 #include "Items/ItemTypes.h"
 #include "BlackMythGameInstance.h"
+#include "Subsystems/ActorRegistrySubsystem.h"
 
 AInteractableActor::AInteractableActor()
 {
@@ -42,6 +43,22 @@ void AInteractableActor::BeginPlay()
     // 绑定交互范围的重叠事件
     InteractionSphere->OnComponentBeginOverlap.AddDynamic(this, &AInteractableActor::OnPlayerEnter);
     InteractionSphere->OnComponentEndOverlap.AddDynamic(this, &AInteractableActor::OnPlayerExit);
+
+    // 注册到土地庙列表（传送菜单按 TempleID 查找）
+    if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+    {
+        Registry->RegisterTemple(this);
+    }
+}
+
+void AInteractableActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+    {
+        Registry->UnregisterTemple(this);
+    }
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void AInteractableActor::OnPlayerEnter(UPrimitiveComponent* OverlappedComp, AActor* OtherActor,
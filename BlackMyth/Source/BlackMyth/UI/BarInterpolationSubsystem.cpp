@@ -0,0 +1,169 @@
+// 进度条插值子系统实现
+
+#include "BarInterpolationSubsystem.h"
+#include "Components/ProgressBar.h"
+#include "Engine/World.h"
+#include "../BlackMythStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Animating Bars"), STAT_AnimatingBars, STATGROUP_BlackMyth);
+
+// ========== USubsystem ==========
+
+bool UBarInterpolationSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UBarInterpolationSubsystem::Deinitialize()
+{
+	Bars.Empty();
+	Values.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UBarInterpolationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBarInterpolationSubsystem, STATGROUP_BlackMyth);
+}
+
+UBarInterpolationSubsystem* UBarInterpolationSubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UBarInterpolationSubsystem>() : nullptr;
+}
+
+// ========== 批量插值 ==========
+
+void UBarInterpolationSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	BLACKMYTH_TRACE_SCOPE(TEXT("BlackMyth.BarInterpolation.Tick"));
+
+	// 倒序遍历：RemoveAtSwap 换到当前位置的总是已经处理过的元素
+	for (int32 Index = Bars.Num() - 1; Index >= 0; --Index)
+	{
+		FAnimatedBar& Entry = Bars[Index];
+		UProgressBar* Bar = Entry.Bar.Get();
+		if (!Bar)
+		{
+			Bars.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		Entry.Current = FMath::FInterpTo(Entry.Current, Entry.Target, DeltaTime, Entry.Speed);
+
+		if (FMath::IsNearlyEqual(Entry.Current, Entry.Target, SettleTolerance))
+		{
+			Bar->SetPercent(Entry.Target);
+			Bars.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
+
+		Bar->SetPercent(Entry.Current);
+	}
+
+	for (auto It = Values.CreateIterator(); It; ++It)
+	{
+		FAnimatedValue& Value = It.Value();
+		Value.Current = FMath::FInterpTo(Value.Current, Value.Target, DeltaTime, Value.Speed);
+
+		if (FMath::IsNearlyEqual(Value.Current, Value.Target, SettleTolerance))
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	SET_DWORD_STAT(STAT_AnimatingBars, GetNumAnimating());
+	INC_DWORD_STAT_BY(STAT_WidgetsTicking, Bars.Num());
+}
+
+// ========== 插值 ==========
+
+void UBarInterpolationSubsystem::AnimateTo(UProgressBar* Bar, float TargetPercent, float Speed)
+{
+	if (!Bar)
+	{
+		return;
+	}
+
+	const int32 Existing = FindBar(Bar);
+	if (Existing != INDEX_NONE)
+	{
+		Bars[Existing].Target = TargetPercent;
+		Bars[Existing].Speed = Speed;
+		return;
+	}
+
+	const float Current = Bar->GetPercent();
+	if (Speed <= 0.0f || FMath::IsNearlyEqual(Current, TargetPercent, SettleTolerance))
+	{
+		// 不需要过渡，直接设置
+		Bar->SetPercent(TargetPercent);
+		return;
+	}
+
+	FAnimatedBar& Entry = Bars.AddDefaulted_GetRef();
+	Entry.Bar = Bar;
+	Entry.Current = Current;
+	Entry.Target = TargetPercent;
+	Entry.Speed = Speed;
+}
+
+void UBarInterpolationSubsystem::Stop(const UProgressBar* Bar)
+{
+	const int32 Existing = FindBar(Bar);
+	if (Existing != INDEX_NONE)
+	{
+		Bars.RemoveAtSwap(Existing, 1, EAllowShrinking::No);
+	}
+}
+
+void UBarInterpolationSubsystem::AnimateValue(FObjectKey Key, float CurrentValue, float TargetValue, float Speed)
+{
+	if (FAnimatedValue* Existing = Values.Find(Key))
+	{
+		Existing->Target = TargetValue;
+		Existing->Speed = Speed;
+		return;
+	}
+
+	if (Speed <= 0.0f || FMath::IsNearlyEqual(CurrentValue, TargetValue, SettleTolerance))
+	{
+		return;
+	}
+
+	FAnimatedValue& Value = Values.Add(Key);
+	Value.Current = CurrentValue;
+	Value.Target = TargetValue;
+	Value.Speed = Speed;
+}
+
+bool UBarInterpolationSubsystem::GetValue(FObjectKey Key, float& OutValue) const
+{
+	if (const FAnimatedValue* Value = Values.Find(Key))
+	{
+		OutValue = Value->Current;
+		return true;
+	}
+	return false;
+}
+
+void UBarInterpolationSubsystem::StopValue(FObjectKey Key)
+{
+	Values.Remove(Key);
+}
+
+int32 UBarInterpolationSubsystem::FindBar(const UProgressBar* Bar) const
+{
+	return Bars.IndexOfByPredicate([Bar](const FAnimatedBar& Entry)
+	{
+		return Entry.Bar.Get() == Bar;
+	});
+}
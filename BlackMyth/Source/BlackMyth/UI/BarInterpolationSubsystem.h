@@ -0,0 +1,92 @@
+// 进度条插值子系统 - 集中平滑所有正在变化的血条，数值稳定后不再 Tick
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "BarInterpolationSubsystem.generated.h"
+
+class UProgressBar;
+
+/**
+ * 进度条插值子系统
+ * - 血条在数值变化时登记目标值，子系统每帧批量 FInterpTo 所有登记的进度条
+ * - 到达目标后从列表移除；列表为空时 IsTickable 返回 false，整个子系统不 Tick
+ * - 血条 Widget 本身不再 Tick，100 个可见血条在没有人受伤时几乎没有开销
+ * - 敌人头顶叠加层的血条是池化 Widget，不固定对应某个进度条：按敌人登记显示值，叠加层每帧用 GetValue 读取
+ */
+UCLASS()
+class BLACKMYTH_API UBarInterpolationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// ========== FTickableGameObject ==========
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return Bars.Num() > 0 || Values.Num() > 0; }
+
+	/** 获取世界的进度条插值子系统（可能为空） */
+	static UBarInterpolationSubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 插值 ==========
+
+	/**
+	 * 让进度条从当前显示值平滑过渡到目标值
+	 * 已在过渡中的进度条只更新目标值和速度，从当前位置继续
+	 */
+	void AnimateTo(UProgressBar* Bar, float TargetPercent, float Speed);
+
+	/** 停止过渡（Widget 销毁时调用，进度条保持当前显示值） */
+	void Stop(const UProgressBar* Bar);
+
+	/**
+	 * 让不直接对应进度条的显示值从 CurrentValue 平滑过渡到 TargetValue
+	 * 已在过渡中的值只更新目标值和速度，从当前位置继续
+	 */
+	void AnimateValue(FObjectKey Key, float CurrentValue, float TargetValue, float Speed);
+
+	/** 读取正在过渡的值；未登记或已到达目标时返回 false */
+	bool GetValue(FObjectKey Key, float& OutValue) const;
+
+	/** 停止值的过渡 */
+	void StopValue(FObjectKey Key);
+
+	/** 当前正在过渡的进度条和值的数量 */
+	int32 GetNumAnimating() const { return Bars.Num() + Values.Num(); }
+
+	/** 显示值与目标值的差距小于此值时视为到达 */
+	static constexpr float SettleTolerance = 0.001f;
+
+private:
+	struct FAnimatedBar
+	{
+		TWeakObjectPtr<UProgressBar> Bar;
+		float Current = 0.0f;
+		float Target = 0.0f;
+		float Speed = 0.0f;
+	};
+
+	/** 查找进度条在列表中的下标 */
+	int32 FindBar(const UProgressBar* Bar) const;
+
+	/** 正在过渡的进度条（到达目标后 RemoveAtSwap 移除） */
+	TArray<FAnimatedBar> Bars;
+
+	struct FAnimatedValue
+	{
+		float Current = 0.0f;
+		float Target = 0.0f;
+		float Speed = 0.0f;
+	};
+
+	/** 正在过渡的显示值（到达目标后移除） */
+	TMap<FObjectKey, FAnimatedValue> Values;
+};
@@ -1,6 +1,7 @@
 // 敌人头顶血条 Widget 实现
 
 #include "EnemyHealthBarWidget.h"
+#include "BarInterpolationSubsystem.h"
 #include "Components/ProgressBar.h"
 #include "../Components/HealthComponent.h"
 
@@ -15,23 +16,22 @@ void UEnemyHealthBarWidget::NativeConstruct()
 		return;
 	}
 
-	// 初始化显示为满血
+	// 初始化显示为满血（对象池中的血条可能在构造前已被设置过百分比）
 	if (HealthBar)
 	{
-		HealthBar->SetPercent(1.0f);
+		HealthBar->SetPercent(AppliedPercent >= 0.0f ? AppliedPercent : 1.0f);
 	}
 }
 
-void UEnemyHealthBarWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void UEnemyHealthBarWidget::NativeDestruct()
 {
-	Super::NativeTick(MyGeometry, InDeltaTime);
-
-	// 平滑过渡血条
-	if (HealthBar && !FMath::IsNearlyEqual(CurrentDisplayPercent, TargetHealthPercent, 0.001f))
+	// 停止未完成的过渡
+	if (UBarInterpolationSubsystem* Interpolator = UBarInterpolationSubsystem::Get(this))
 	{
-		CurrentDisplayPercent = FMath::FInterpTo(CurrentDisplayPercent, TargetHealthPercent, InDeltaTime, SmoothSpeed);
-		HealthBar->SetPercent(CurrentDisplayPercent);
+		Interpolator->Stop(HealthBar);
 	}
+
+	Super::NativeDestruct();
 }
 
 void UEnemyHealthBarWidget::InitializeHealthBar(UHealthComponent* InHealthComponent)
@@ -43,7 +43,7 @@ void UEnemyHealthBarWidget::InitializeHealthBar(UHealthComponent* InHealthCompon
 		// 绑定生命值变化委托
 		HealthComponent->OnHealthChanged.AddDynamic(this, &UEnemyHealthBarWidget::OnHealthChanged);
 
-		UE_LOG(LogTemp, Warning, TEXT("[HealthBar] Bindded to %s, Current: %.1f/%.1f"),
+		UE_LOG(LogTemp, Log, TEXT("[HealthBar] Bound to %s, Current: %.1f/%.1f"),
 			*HealthComponent->GetOwner()->GetName(),
 			HealthComponent->GetCurrentHealth(),
 			HealthComponent->GetMaxHealth());
@@ -59,9 +59,26 @@ void UEnemyHealthBarWidget::InitializeHealthBar(UHealthComponent* InHealthCompon
 
 void UEnemyHealthBarWidget::UpdateHealthBar()
 {
-	if (HealthComponent)
+	if (!HealthComponent)
+	{
+		return;
+	}
+
+	TargetHealthPercent = HealthComponent->GetHealthPercent();
+
+	if (!HealthBar)
+	{
+		return;
+	}
+
+	// 交给插值子系统平滑过渡，到达目标后自动停止
+	if (UBarInterpolationSubsystem* Interpolator = UBarInterpolationSubsystem::Get(this))
+	{
+		Interpolator->AnimateTo(HealthBar, TargetHealthPercent, SmoothSpeed);
+	}
+	else
 	{
-		TargetHealthPercent = HealthComponent->GetHealthPercent();
+		HealthBar->SetPercent(TargetHealthPercent);
 	}
 }
 
@@ -78,10 +95,28 @@ void UEnemyHealthBarWidget::OnHealthChanged(float CurrentHealth, float MaxHealth
 	float Percent = CurrentHealth / MaxHealth;
 
 	UpdateHealthBar();
+	UpdateBarColor(Percent);
 
+	UE_LOG(LogTemp, Verbose, TEXT("[EnemyHealthBar] Health Changed: %.1f/%.1f (%.1f%%)"),
+		CurrentHealth, MaxHealth, TargetHealthPercent * 100.0f);
+}
+
+void UEnemyHealthBarWidget::SetDisplayPercent(float Percent)
+{
+	if (!HealthBar || Percent == AppliedPercent)
+	{
+		return;
+	}
+
+	AppliedPercent = Percent;
+	HealthBar->SetPercent(Percent);
+	UpdateBarColor(Percent);
+}
+
+void UEnemyHealthBarWidget::UpdateBarColor(float Percent)
+{
 	FLinearColor BarColor;
 
-	UE_LOG(LogTemp, Warning, TEXT("[HealthBar] OnHealthChanged: %.1f/%.1f"), CurrentHealth, MaxHealth);
 	// 根据血量百分比改变颜色（绿→黄→红）
 	if (Percent > 0.5f)
 		BarColor = FLinearColor::LerpUsingHSV(FLinearColor::Yellow, FLinearColor::Green, (Percent - 0.5f) * 2.0f);
@@ -89,7 +124,4 @@ void UEnemyHealthBarWidget::OnHealthChanged(float CurrentHealth, float MaxHealth
 		BarColor = FLinearColor::LerpUsingHSV(FLinearColor::Red, FLinearColor::Yellow, Percent * 2.0f);
 
 	HealthBar->SetFillColorAndOpacity(BarColor);
-
-	UE_LOG(LogTemp, Verbose, TEXT("[EnemyHealthBar] Health Changed: %.1f/%.1f (%.1f%%)"),
-		CurrentHealth, MaxHealth, TargetHealthPercent * 100.0f);
 }
@@ -11,9 +11,13 @@ class UHealthComponent;
 
 /**
  * 敌人头顶血条 Widget
- * 挂载在每个敌人头顶，实时显示生命值
+ * 由 UEnemyOverlayWidget 按可见数量池化，通过 SetDisplayPercent 显示叠加层算好的百分比；
+ * 也可以单独使用 InitializeHealthBar 绑定生命值组件
+ *
+ * 不再 Tick：绑定模式下生命值变化时把目标值交给 UBarInterpolationSubsystem 统一平滑，
+ * 没有人受伤时血条没有任何每帧开销
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class BLACKMYTH_API UEnemyHealthBarWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -30,9 +34,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Health Bar")
 	void UpdateHealthBar();
 
+	/**
+	 * 直接设置显示的百分比和颜色（由 UEnemyOverlayWidget 的对象池使用，不绑定生命值组件）
+	 * 与上次相同时不做任何修改
+	 */
+	void SetDisplayPercent(float Percent);
+
 protected:
 	virtual void NativeConstruct() override;
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeDestruct() override;
 
 	/** 生命值变化回调 */
 	UFUNCTION()
@@ -50,8 +60,11 @@ protected:
 	/** 目标血量百分比（用于平滑过渡） */
 	float TargetHealthPercent = 1.0f;
 
-	/** 当前显示的血量百分比 */
-	float CurrentDisplayPercent = 1.0f;
+	/** 根据血量百分比设置颜色（绿→黄→红） */
+	void UpdateBarColor(float Percent);
+
+	/** SetDisplayPercent 上次设置的值 */
+	float AppliedPercent = -1.0f;
 
 	/** 血条变化平滑速度 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Health Bar")
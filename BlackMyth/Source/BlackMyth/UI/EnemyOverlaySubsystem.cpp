@@ -0,0 +1,329 @@
+// 敌人头顶 UI 子系统实现
+
+#include "EnemyOverlaySubsystem.h"
+#include "EnemyHealthBarWidget.h"
+#include "BarInterpolationSubsystem.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+#include "../BlackMythStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlay Entries"), STAT_EnemyOverlayEntries, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlay Visible Widgets"), STAT_EnemyOverlayVisible, STATGROUP_BlackMyth);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Overlay Pooled Widgets"), STAT_EnemyOverlayPooled, STATGROUP_BlackMyth);
+
+// ========== USubsystem ==========
+
+bool UEnemyOverlaySubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+void UEnemyOverlaySubsystem::Deinitialize()
+{
+	Entries.Empty();
+	IndexByEnemy.Empty();
+	NumFlagged = 0;
+	bOverlayShowing = false;
+	Overlay = nullptr;
+
+	Super::Deinitialize();
+}
+
+TStatId UEnemyOverlaySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemyOverlaySubsystem, STATGROUP_BlackMyth);
+}
+
+UEnemyOverlaySubsystem* UEnemyOverlaySubsystem::Get(const UObject* WorldContextObject)
+{
+	if (!WorldContextObject)
+	{
+		return nullptr;
+	}
+
+	UWorld* World = WorldContextObject->GetWorld();
+	return World ? World->GetSubsystem<UEnemyOverlaySubsystem>() : nullptr;
+}
+
+// ========== 批量投影 ==========
+
+void UEnemyOverlaySubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	BLACKMYTH_TRACE_SCOPE(TEXT("BlackMyth.EnemyOverlay.Tick"));
+
+	VisibleBars.Reset();
+	VisibleAlertIcons.Reset();
+	VisibleFreezeTexts.Reset();
+
+	const UBarInterpolationSubsystem* Interpolator = UBarInterpolationSubsystem::Get(this);
+
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+
+	// 整个列表共用一份视图投影矩阵
+	FSceneViewProjectionData ProjectionData;
+	const bool bHasView = LocalPlayer && LocalPlayer->ViewportClient
+		&& LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, ProjectionData);
+
+	if (bHasView)
+	{
+		const FMatrix ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+		const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+		const FVector ViewOrigin = ProjectionData.ViewOrigin;
+		const float MaxDistanceSquared = FMath::Square(MaxDrawDistance);
+		const FBox2D ScreenBounds(
+			FVector2D(ViewRect.Min) - FVector2D(ScreenMargin, ScreenMargin),
+			FVector2D(ViewRect.Max) + FVector2D(ScreenMargin, ScreenMargin));
+
+		// 投影结果是视口像素，画布使用 DPI 缩放后的 Slate 单位
+		const float ViewportScale = UWidgetLayoutLibrary::GetViewportScale(PlayerController);
+		const float InvViewportScale = ViewportScale > 0.0f ? 1.0f / ViewportScale : 1.0f;
+
+		// 倒序遍历：RemoveAtSwap 换到当前位置的总是已经处理过的元素
+		for (int32 Index = Entries.Num() - 1; Index >= 0; --Index)
+		{
+			FEntry& Entry = Entries[Index];
+			const AActor* Enemy = Entry.Enemy.Get();
+			if (!Enemy)
+			{
+				RemoveEntryAt(Index);
+				continue;
+			}
+
+			if (Entry.Flags == EEnemyOverlayFlags::None)
+			{
+				continue;
+			}
+
+			const bool bShowHealthBar = EnumHasAnyFlags(Entry.Flags, EEnemyOverlayFlags::HealthBar);
+			// 过渡中的显示值从插值子系统读取；不在过渡中说明已到达目标
+			if (bShowHealthBar && Entry.DisplayPercent != Entry.TargetPercent
+				&& (!Interpolator || !Interpolator->GetValue(Entry.Key, Entry.DisplayPercent)))
+			{
+				Entry.DisplayPercent = Entry.TargetPercent;
+			}
+
+			const FVector BaseLocation = Enemy->GetActorLocation();
+			if (FVector::DistSquared(BaseLocation, ViewOrigin) > MaxDistanceSquared)
+			{
+				continue;
+			}
+
+			auto Project = [&](float HeightOffset, FVector2D& OutPosition)
+			{
+				FVector2D ScreenPosition;
+				if (!FSceneView::ProjectWorldToScreen(BaseLocation + FVector(0.0f, 0.0f, HeightOffset), ViewRect, ViewProjection, ScreenPosition)
+					|| !ScreenBounds.IsInside(ScreenPosition))
+				{
+					return false;
+				}
+
+				OutPosition = ScreenPosition * InvViewportScale;
+				return true;
+			};
+
+			FVector2D Position;
+			if (bShowHealthBar && Project(Entry.HealthBarOffset, Position))
+			{
+				FEnemyOverlayBarItem& Item = VisibleBars.AddDefaulted_GetRef();
+				Item.Position = Position;
+				Item.HealthPercent = Entry.DisplayPercent;
+			}
+
+			if (EnumHasAnyFlags(Entry.Flags, EEnemyOverlayFlags::AlertIcon) && Project(Entry.AlertIconOffset, Position))
+			{
+				VisibleAlertIcons.Add(Position);
+			}
+
+			if (EnumHasAnyFlags(Entry.Flags, EEnemyOverlayFlags::FreezeText) && Project(Entry.FreezeTextOffset, Position))
+			{
+				VisibleFreezeTexts.Add(Position);
+			}
+		}
+	}
+
+	const int32 NumVisible = VisibleBars.Num() + VisibleAlertIcons.Num() + VisibleFreezeTexts.Num();
+	const bool bAnyVisible = NumVisible > 0;
+	if (UEnemyOverlayWidget* OverlayWidget = bAnyVisible ? GetOrCreateOverlay(PlayerController) : Overlay.Get())
+	{
+		OverlayWidget->ShowHealthBars(VisibleBars);
+		OverlayWidget->ShowAlertIcons(VisibleAlertIcons);
+		OverlayWidget->ShowFreezeTexts(VisibleFreezeTexts);
+		SET_DWORD_STAT(STAT_EnemyOverlayPooled, OverlayWidget->GetPoolSize());
+	}
+	bOverlayShowing = bAnyVisible;
+
+	SET_DWORD_STAT(STAT_EnemyOverlayEntries, Entries.Num());
+	SET_DWORD_STAT(STAT_EnemyOverlayVisible, NumVisible);
+	INC_DWORD_STAT_BY(STAT_WidgetsTicking, NumVisible);
+}
+
+UEnemyOverlayWidget* UEnemyOverlaySubsystem::GetOrCreateOverlay(APlayerController* PlayerController)
+{
+	if (Overlay || !PlayerController)
+	{
+		return Overlay;
+	}
+
+	Overlay = CreateWidget<UEnemyOverlayWidget>(PlayerController, UEnemyOverlayWidget::StaticClass());
+	if (Overlay)
+	{
+		Overlay->SetWidgetClasses(HealthBarWidgetClass, AlertIconWidgetClass, FreezeTextWidgetClass);
+
+		// 位于玩家 HUD（ZOrder 0）之下
+		Overlay->AddToViewport(-1);
+	}
+
+	return Overlay;
+}
+
+// ========== 注册 ==========
+
+void UEnemyOverlaySubsystem::RegisterEnemy(AActor* Enemy, float HealthBarOffset, float AlertIconOffset, float FreezeTextOffset)
+{
+	if (!Enemy)
+	{
+		return;
+	}
+
+	const FObjectKey Key(Enemy);
+	int32 Index = INDEX_NONE;
+	if (const int32* Existing = IndexByEnemy.Find(Key))
+	{
+		Index = *Existing;
+	}
+	else
+	{
+		Index = Entries.AddDefaulted();
+		Entries[Index].Key = Key;
+		Entries[Index].Enemy = Enemy;
+		IndexByEnemy.Add(Key, Index);
+	}
+
+	Entries[Index].HealthBarOffset = HealthBarOffset;
+	Entries[Index].AlertIconOffset = AlertIconOffset;
+	Entries[Index].FreezeTextOffset = FreezeTextOffset;
+}
+
+void UEnemyOverlaySubsystem::UnregisterEnemy(const AActor* Enemy)
+{
+	if (const int32* Existing = IndexByEnemy.Find(FObjectKey(Enemy)))
+	{
+		RemoveEntryAt(*Existing);
+	}
+}
+
+void UEnemyOverlaySubsystem::ProvideWidgetClasses(TSubclassOf<UEnemyHealthBarWidget> HealthBarClass, TSubclassOf<UUserWidget> AlertIconClass, TSubclassOf<UUserWidget> FreezeTextClass)
+{
+	if (!HealthBarWidgetClass && HealthBarClass)
+	{
+		HealthBarWidgetClass = HealthBarClass;
+	}
+
+	if (!AlertIconWidgetClass && AlertIconClass)
+	{
+		AlertIconWidgetClass = AlertIconClass;
+	}
+
+	if (!FreezeTextWidgetClass && FreezeTextClass)
+	{
+		FreezeTextWidgetClass = FreezeTextClass;
+	}
+
+	if (Overlay)
+	{
+		Overlay->SetWidgetClasses(HealthBarWidgetClass, AlertIconWidgetClass, FreezeTextWidgetClass);
+	}
+}
+
+void UEnemyOverlaySubsystem::RemoveEntryAt(int32 Index)
+{
+	if (Entries[Index].Flags != EEnemyOverlayFlags::None)
+	{
+		--NumFlagged;
+	}
+
+	if (UBarInterpolationSubsystem* Interpolator = UBarInterpolationSubsystem::Get(this))
+	{
+		Interpolator->StopValue(Entries[Index].Key);
+	}
+
+	IndexByEnemy.Remove(Entries[Index].Key);
+	Entries.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+
+	// 末尾的条目被换到了 Index，更新其下标
+	if (Entries.IsValidIndex(Index))
+	{
+		IndexByEnemy.Add(Entries[Index].Key, Index);
+	}
+}
+
+// ========== 状态 ==========
+
+void UEnemyOverlaySubsystem::SetHealthPercent(const AActor* Enemy, float Percent, bool bSnap)
+{
+	if (const int32* Existing = IndexByEnemy.Find(FObjectKey(Enemy)))
+	{
+		FEntry& Entry = Entries[*Existing];
+		Entry.TargetPercent = FMath::Clamp(Percent, 0.0f, 1.0f);
+
+		UBarInterpolationSubsystem* Interpolator = UBarInterpolationSubsystem::Get(this);
+		if (bSnap || !Interpolator)
+		{
+			Entry.DisplayPercent = Entry.TargetPercent;
+			if (Interpolator)
+			{
+				Interpolator->StopValue(Entry.Key);
+			}
+		}
+		else
+		{
+			Interpolator->AnimateValue(Entry.Key, Entry.DisplayPercent, Entry.TargetPercent, HealthBarSmoothSpeed);
+		}
+	}
+}
+
+void UEnemyOverlaySubsystem::SetHealthBarVisible(const AActor* Enemy, bool bVisible)
+{
+	SetFlag(Enemy, EEnemyOverlayFlags::HealthBar, bVisible);
+}
+
+void UEnemyOverlaySubsystem::SetAlertIconVisible(const AActor* Enemy, bool bVisible)
+{
+	SetFlag(Enemy, EEnemyOverlayFlags::AlertIcon, bVisible);
+}
+
+void UEnemyOverlaySubsystem::SetFreezeTextVisible(const AActor* Enemy, bool bVisible)
+{
+	SetFlag(Enemy, EEnemyOverlayFlags::FreezeText, bVisible);
+}
+
+void UEnemyOverlaySubsystem::SetFlag(const AActor* Enemy, EEnemyOverlayFlags Flag, bool bEnabled)
+{
+	const int32* Existing = IndexByEnemy.Find(FObjectKey(Enemy));
+	if (!Existing)
+	{
+		return;
+	}
+
+	FEntry& Entry = Entries[*Existing];
+	const bool bWasFlagged = Entry.Flags != EEnemyOverlayFlags::None;
+
+	if (bEnabled)
+	{
+		EnumAddFlags(Entry.Flags, Flag);
+	}
+	else
+	{
+		EnumRemoveFlags(Entry.Flags, Flag);
+	}
+
+	const bool bIsFlagged = Entry.Flags != EEnemyOverlayFlags::None;
+	NumFlagged += static_cast<int32>(bIsFlagged) - static_cast<int32>(bWasFlagged);
+}
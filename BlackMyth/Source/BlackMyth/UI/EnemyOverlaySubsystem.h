@@ -0,0 +1,139 @@
+// 敌人头顶 UI 子系统 - 以紧凑数组记录所有敌人的血条/警戒图标/定身字状态，每帧一次性投影、裁剪并交给叠加层绘制
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "EnemyOverlayWidget.h"
+#include "EnemyOverlaySubsystem.generated.h"
+
+class UEnemyHealthBarWidget;
+
+/** 敌人头顶显示的内容 */
+enum class EEnemyOverlayFlags : uint8
+{
+	None      = 0,
+	HealthBar = 1 << 0,
+	AlertIcon = 1 << 1,
+	FreezeText = 1 << 2
+};
+ENUM_CLASS_FLAGS(EEnemyOverlayFlags);
+
+/**
+ * 敌人头顶 UI 子系统
+ * - 每个注册的敌人在数组中占一项：头顶偏移、目标/显示血量百分比、显示标记；
+ *   显示百分比的平滑过渡由 UBarInterpolationSubsystem 推进（与单独使用的血条同一套插值）
+ * - Tick 中用本地玩家的视图投影矩阵一次性投影所有带标记的条目，
+ *   剔除在相机后方、屏幕外或超出 MaxDrawDistance 的条目，剩余的交给 UEnemyOverlayWidget
+ * - 叠加层 Widget 按可见数量池化，敌人不再各自持有 UWidgetComponent
+ * - 没有任何条目需要显示且叠加层已全部隐藏时不 Tick
+ */
+UCLASS()
+class BLACKMYTH_API UEnemyOverlaySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// ========== USubsystem ==========
+
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+	virtual void Deinitialize() override;
+
+	// ========== FTickableGameObject ==========
+
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+	virtual bool IsTickable() const override { return NumFlagged > 0 || bOverlayShowing; }
+
+	/** 获取世界的敌人头顶 UI 子系统（可能为空） */
+	static UEnemyOverlaySubsystem* Get(const UObject* WorldContextObject);
+
+	// ========== 注册 ==========
+
+	/** 注册敌人（已注册时只更新偏移），初始不显示任何内容 */
+	void RegisterEnemy(AActor* Enemy, float HealthBarOffset, float AlertIconOffset, float FreezeTextOffset);
+
+	/** 注销敌人 */
+	void UnregisterEnemy(const AActor* Enemy);
+
+	/** 提供叠加层使用的 Widget 类（以第一次提供的非空类为准） */
+	void ProvideWidgetClasses(TSubclassOf<UEnemyHealthBarWidget> HealthBarClass, TSubclassOf<UUserWidget> AlertIconClass, TSubclassOf<UUserWidget> FreezeTextClass);
+
+	// ========== 状态 ==========
+
+	/**
+	 * 设置血量百分比
+	 * @param bSnap 为 true 时显示值立即跳到目标，否则平滑过渡
+	 */
+	void SetHealthPercent(const AActor* Enemy, float Percent, bool bSnap = false);
+
+	/** 显示/隐藏血条 */
+	void SetHealthBarVisible(const AActor* Enemy, bool bVisible);
+
+	/** 显示/隐藏警戒图标 */
+	void SetAlertIconVisible(const AActor* Enemy, bool bVisible);
+
+	/** 显示/隐藏定身"定"字 */
+	void SetFreezeTextVisible(const AActor* Enemy, bool bVisible);
+
+	/** 超过此距离（cm）的敌人不显示头顶 UI */
+	static constexpr float MaxDrawDistance = 6000.0f;
+
+	/** 投影点超出视口此范围（像素）时剔除 */
+	static constexpr float ScreenMargin = 64.0f;
+
+	/** 血条显示值的平滑速度 */
+	static constexpr float HealthBarSmoothSpeed = 5.0f;
+
+private:
+	struct FEntry
+	{
+		FObjectKey Key;
+		TWeakObjectPtr<AActor> Enemy;
+		float HealthBarOffset = 0.0f;
+		float AlertIconOffset = 0.0f;
+		float FreezeTextOffset = 0.0f;
+		float TargetPercent = 1.0f;
+		float DisplayPercent = 1.0f;
+		EEnemyOverlayFlags Flags = EEnemyOverlayFlags::None;
+	};
+
+	/** 设置/清除条目的显示标记，并维护 NumFlagged */
+	void SetFlag(const AActor* Enemy, EEnemyOverlayFlags Flag, bool bEnabled);
+
+	/** RemoveAtSwap 移除条目并更新被移动条目的下标 */
+	void RemoveEntryAt(int32 Index);
+
+	/** 创建叠加层 Widget（首次需要显示时） */
+	UEnemyOverlayWidget* GetOrCreateOverlay(APlayerController* PlayerController);
+
+	/** 注册的敌人（紧凑数组） */
+	TArray<FEntry> Entries;
+
+	/** 敌人 -> 条目下标 */
+	TMap<FObjectKey, int32> IndexByEnemy;
+
+	/** 带有显示标记的条目数量 */
+	int32 NumFlagged = 0;
+
+	/** 叠加层上一帧是否还有显示的 Widget（需要再 Tick 一次把它们隐藏） */
+	bool bOverlayShowing = false;
+
+	/** 本帧可见列表（复用内存） */
+	TArray<FEnemyOverlayBarItem> VisibleBars;
+	TArray<FVector2D> VisibleAlertIcons;
+	TArray<FVector2D> VisibleFreezeTexts;
+
+	UPROPERTY()
+	TObjectPtr<UEnemyOverlayWidget> Overlay;
+
+	UPROPERTY()
+	TSubclassOf<UEnemyHealthBarWidget> HealthBarWidgetClass;
+
+	UPROPERTY()
+	TSubclassOf<UUserWidget> AlertIconWidgetClass;
+
+	UPROPERTY()
+	TSubclassOf<UUserWidget> FreezeTextWidgetClass;
+};
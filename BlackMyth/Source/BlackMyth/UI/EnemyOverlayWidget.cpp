@@ -0,0 +1,149 @@
+// 敌人头顶 UI 叠加层实现
+
+#include "EnemyOverlayWidget.h"
+#include "EnemyHealthBarWidget.h"
+#include "Blueprint/WidgetTree.h"
+#include "Components/CanvasPanel.h"
+#include "Components/CanvasPanelSlot.h"
+
+void UEnemyOverlayWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// 纯 C++ 创建时没有设计器布局，自动生成全屏画布作为根控件
+	if (!OverlayCanvas && WidgetTree)
+	{
+		if (WidgetTree->RootWidget)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("EnemyOverlayWidget: Blueprint layout has no CanvasPanel named 'OverlayCanvas'"));
+		}
+		else
+		{
+			OverlayCanvas = WidgetTree->ConstructWidget<UCanvasPanel>(UCanvasPanel::StaticClass(), TEXT("OverlayCanvas"));
+			WidgetTree->RootWidget = OverlayCanvas;
+		}
+	}
+
+	// 叠加层只用于显示，不拦截鼠标
+	SetVisibility(ESlateVisibility::HitTestInvisible);
+}
+
+void UEnemyOverlayWidget::SetWidgetClasses(TSubclassOf<UEnemyHealthBarWidget> InHealthBarClass, TSubclassOf<UUserWidget> InAlertIconClass, TSubclassOf<UUserWidget> InFreezeTextClass)
+{
+	if (HealthBarPool.Num() == 0 && InHealthBarClass)
+	{
+		HealthBarClass = InHealthBarClass;
+	}
+
+	if (AlertIconPool.Num() == 0 && InAlertIconClass)
+	{
+		AlertIconClass = InAlertIconClass;
+	}
+
+	if (FreezeTextPool.Num() == 0 && InFreezeTextClass)
+	{
+		FreezeTextClass = InFreezeTextClass;
+	}
+}
+
+void UEnemyOverlayWidget::ShowHealthBars(TConstArrayView<FEnemyOverlayBarItem> Items)
+{
+	int32 NumPlaced = 0;
+	for (const FEnemyOverlayBarItem& Item : Items)
+	{
+		UEnemyHealthBarWidget* Bar = Cast<UEnemyHealthBarWidget>(AcquirePooledWidget(HealthBarPool, NumPlaced, HealthBarClass));
+		if (!Bar)
+		{
+			break;
+		}
+
+		SetWidgetPosition(Bar, Item.Position);
+		Bar->SetDisplayPercent(Item.HealthPercent);
+		++NumPlaced;
+	}
+
+	UpdatePoolVisibility(HealthBarPool, NumPlaced, NumShownHealthBars);
+}
+
+void UEnemyOverlayWidget::ShowAlertIcons(TConstArrayView<FVector2D> Positions)
+{
+	ShowIcons(AlertIconPool, AlertIconClass, Positions, NumShownAlertIcons);
+}
+
+void UEnemyOverlayWidget::ShowFreezeTexts(TConstArrayView<FVector2D> Positions)
+{
+	ShowIcons(FreezeTextPool, FreezeTextClass, Positions, NumShownFreezeTexts);
+}
+
+void UEnemyOverlayWidget::ShowIcons(TArray<TObjectPtr<UUserWidget>>& Pool, TSubclassOf<UUserWidget> WidgetClass, TConstArrayView<FVector2D> Positions, int32& InOutShownCount)
+{
+	int32 NumPlaced = 0;
+	for (const FVector2D& Position : Positions)
+	{
+		UUserWidget* Icon = AcquirePooledWidget(Pool, NumPlaced, WidgetClass);
+		if (!Icon)
+		{
+			break;
+		}
+
+		SetWidgetPosition(Icon, Position);
+		++NumPlaced;
+	}
+
+	UpdatePoolVisibility(Pool, NumPlaced, InOutShownCount);
+}
+
+UUserWidget* UEnemyOverlayWidget::AcquirePooledWidget(TArray<TObjectPtr<UUserWidget>>& Pool, int32 Index, TSubclassOf<UUserWidget> WidgetClass)
+{
+	if (Pool.IsValidIndex(Index))
+	{
+		return Pool[Index];
+	}
+
+	if (!OverlayCanvas || !WidgetClass)
+	{
+		return nullptr;
+	}
+
+	UUserWidget* Widget = CreateWidget<UUserWidget>(this, WidgetClass);
+	if (!Widget)
+	{
+		return nullptr;
+	}
+
+	// 以底部中心对齐到头顶投影点，大小由 Widget 自身决定
+	if (UCanvasPanelSlot* CanvasSlot = OverlayCanvas->AddChildToCanvas(Widget))
+	{
+		CanvasSlot->SetAutoSize(true);
+		CanvasSlot->SetAlignment(FVector2D(0.5f, 1.0f));
+	}
+
+	Widget->SetVisibility(ESlateVisibility::Collapsed);
+	Pool.Add(Widget);
+	return Widget;
+}
+
+void UEnemyOverlayWidget::UpdatePoolVisibility(TArray<TObjectPtr<UUserWidget>>& Pool, int32 NewCount, int32& InOutShownCount)
+{
+	// 新增显示的
+	for (int32 Index = InOutShownCount; Index < NewCount; ++Index)
+	{
+		Pool[Index]->SetVisibility(ESlateVisibility::HitTestInvisible);
+	}
+
+	// 本帧不再需要的
+	for (int32 Index = NewCount; Index < InOutShownCount; ++Index)
+	{
+		Pool[Index]->SetVisibility(ESlateVisibility::Collapsed);
+	}
+
+	InOutShownCount = NewCount;
+}
+
+void UEnemyOverlayWidget::SetWidgetPosition(UUserWidget* Widget, const FVector2D& Position)
+{
+	if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Widget->Slot))
+	{
+		CanvasSlot->SetPosition(Position);
+	}
+}
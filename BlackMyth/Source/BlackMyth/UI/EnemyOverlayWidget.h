@@ -0,0 +1,92 @@
+// 敌人头顶 UI 叠加层 - 在一个全屏画布上摆放所有可见敌人的血条、警戒图标和定身字
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "EnemyOverlayWidget.generated.h"
+
+class UCanvasPanel;
+class UEnemyHealthBarWidget;
+
+/** 一个可见血条：屏幕位置（Slate 单位）和显示百分比 */
+struct FEnemyOverlayBarItem
+{
+	FVector2D Position = FVector2D::ZeroVector;
+	float HealthPercent = 1.0f;
+};
+
+/**
+ * 敌人头顶 UI 叠加层
+ * - 由 UEnemyOverlaySubsystem 创建并每帧提供本帧可见的血条/图标列表，自身不 Tick
+ * - 血条、警戒图标和定身字 Widget 按可见数量从对象池取用：池只会增长到同屏可见的峰值，
+ *   多余的折叠隐藏，敌人总数不再决定 Widget 数量
+ * - 蓝图子类可提供名为 OverlayCanvas 的 CanvasPanel，否则自动创建一个全屏画布
+ */
+UCLASS(meta = (DisableNativeTick))
+class BLACKMYTH_API UEnemyOverlayWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	/** 设置池中创建的 Widget 类（只在池为空时生效） */
+	void SetWidgetClasses(TSubclassOf<UEnemyHealthBarWidget> InHealthBarClass, TSubclassOf<UUserWidget> InAlertIconClass, TSubclassOf<UUserWidget> InFreezeTextClass);
+
+	/** 按本帧可见列表摆放血条 */
+	void ShowHealthBars(TConstArrayView<FEnemyOverlayBarItem> Items);
+
+	/** 按本帧可见列表摆放警戒图标 */
+	void ShowAlertIcons(TConstArrayView<FVector2D> Positions);
+
+	/** 按本帧可见列表摆放定身字 */
+	void ShowFreezeTexts(TConstArrayView<FVector2D> Positions);
+
+	/** 池中的 Widget 总数（血条 + 图标 + 定身字） */
+	int32 GetPoolSize() const { return HealthBarPool.Num() + AlertIconPool.Num() + FreezeTextPool.Num(); }
+
+protected:
+	virtual void NativeOnInitialized() override;
+
+	/** 叠加层画布（蓝图中可选的同名 CanvasPanel） */
+	UPROPERTY(meta = (BindWidgetOptional))
+	TObjectPtr<UCanvasPanel> OverlayCanvas;
+
+private:
+	/** 取出池中第 Index 个 Widget，池不够时创建并加入画布 */
+	UUserWidget* AcquirePooledWidget(TArray<TObjectPtr<UUserWidget>>& Pool, int32 Index, TSubclassOf<UUserWidget> WidgetClass);
+
+	/** 显示 [0, NewCount)，折叠上一帧多出来的 [NewCount, OldCount) */
+	static void UpdatePoolVisibility(TArray<TObjectPtr<UUserWidget>>& Pool, int32 NewCount, int32& InOutShownCount);
+
+	/** 把位置列表摆放到池中的 Widget 上 */
+	void ShowIcons(TArray<TObjectPtr<UUserWidget>>& Pool, TSubclassOf<UUserWidget> WidgetClass, TConstArrayView<FVector2D> Positions, int32& InOutShownCount);
+
+	/** 把 Widget 的画布槽位移动到指定位置 */
+	static void SetWidgetPosition(UUserWidget* Widget, const FVector2D& Position);
+
+	UPROPERTY()
+	TSubclassOf<UEnemyHealthBarWidget> HealthBarClass;
+
+	UPROPERTY()
+	TSubclassOf<UUserWidget> AlertIconClass;
+
+	UPROPERTY()
+	TSubclassOf<UUserWidget> FreezeTextClass;
+
+	/** 血条池（元素均为 UEnemyHealthBarWidget） */
+	UPROPERTY()
+	TArray<TObjectPtr<UUserWidget>> HealthBarPool;
+
+	/** 警戒图标池 */
+	UPROPERTY()
+	TArray<TObjectPtr<UUserWidget>> AlertIconPool;
+
+	/** 定身字池 */
+	UPROPERTY()
+	TArray<TObjectPtr<UUserWidget>> FreezeTextPool;
+
+	/** 上一帧显示的数量（只修改可见性发生变化的 Widget） */
+	int32 NumShownHealthBars = 0;
+	int32 NumShownAlertIcons = 0;
+	int32 NumShownFreezeTexts = 0;
+};
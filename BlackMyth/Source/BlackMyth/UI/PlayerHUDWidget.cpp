@@ -52,7 +52,6 @@ void UPlayerHUDWidget::NativeDestruct()
 
 	// 清除所有状态效果图标
 	ActiveEffectIcons.Empty();
-	EffectTotalDurations.Empty();
 
 	Super::NativeDestruct();
 }
@@ -231,7 +230,8 @@ void UPlayerHUDWidget::BindStatusEffectComponent(UStatusEffectComponent* StatusE
 	// 绑定委托
 	StatusEffectComponent->OnEffectApplied.AddDynamic(this, &UPlayerHUDWidget::AddStatusEffectIcon);
 	StatusEffectComponent->OnEffectRemoved.AddDynamic(this, &UPlayerHUDWidget::RemoveStatusEffectIcon);
-	StatusEffectComponent->OnEffectUpdated.AddDynamic(this, &UPlayerHUDWidget::UpdateStatusEffectDuration);
+
+	// 不监听 OnEffectUpdated：图标按开始时间和总时长在绘制时计算剩余时间，刷新时会重新收到 OnEffectApplied
 
 	UE_LOG(LogTemp, Log, TEXT("PlayerHUDWidget: Bound to StatusEffectComponent"));
 }
@@ -242,7 +242,6 @@ void UPlayerHUDWidget::UnbindStatusEffectDelegates()
 	{
 		CachedStatusEffectComponent->OnEffectApplied.RemoveDynamic(this, &UPlayerHUDWidget::AddStatusEffectIcon);
 		CachedStatusEffectComponent->OnEffectRemoved.RemoveDynamic(this, &UPlayerHUDWidget::RemoveStatusEffectIcon);
-		CachedStatusEffectComponent->OnEffectUpdated.RemoveDynamic(this, &UPlayerHUDWidget::UpdateStatusEffectDuration);
 	}
 }
 
@@ -255,11 +254,13 @@ void UPlayerHUDWidget::AddStatusEffectIcon(EStatusEffectType EffectType, float D
 		return;
 	}
 
-	// 检查是否已经有这个效果的图标（如有则更新持续时间）
-	if (ActiveEffectIcons.Contains(EffectType))
+	// 检查是否已经有这个效果的图标（如有则重新开始倒计时）
+	if (UStatusEffectIconWidget** ExistingIcon = ActiveEffectIcons.Find(EffectType))
 	{
-		// 刷新总持续时间
-		EffectTotalDurations.Add(EffectType, Duration);
+		if (*ExistingIcon)
+		{
+			(*ExistingIcon)->StartCountdown(Duration);
+		}
 		UE_LOG(LogTemp, Log, TEXT("PlayerHUDWidget: Refreshed effect icon for type %d, duration: %.1f"), static_cast<int32>(EffectType), Duration);
 		return;
 	}
@@ -279,8 +280,9 @@ void UPlayerHUDWidget::AddStatusEffectIcon(EStatusEffectType EffectType, float D
 		return;
 	}
 
-	// 设置效果类型
+	// 设置效果类型并开始倒计时
 	NewIcon->SetEffectType(EffectType);
+	NewIcon->StartCountdown(Duration);
 
 	// 添加到容器
 	UHorizontalBoxSlot* IconSlot = StatusEffectContainer->AddChildToHorizontalBox(NewIcon);
@@ -290,9 +292,8 @@ void UPlayerHUDWidget::AddStatusEffectIcon(EStatusEffectType EffectType, float D
 		IconSlot->SetPadding(FMargin(5.0f, 0.0f, 5.0f, 0.0f));
 	}
 
-	// 保存引用和持续时间
+	// 保存引用
 	ActiveEffectIcons.Add(EffectType, NewIcon);
-	EffectTotalDurations.Add(EffectType, Duration);
 
 	UE_LOG(LogTemp, Log, TEXT("PlayerHUDWidget: Added effect icon for type %d, duration: %.1f"), static_cast<int32>(EffectType), Duration);
 }
@@ -311,7 +312,6 @@ void UPlayerHUDWidget::RemoveStatusEffectIcon(EStatusEffectType EffectType)
 
 	// 从映射中移除
 	ActiveEffectIcons.Remove(EffectType);
-	EffectTotalDurations.Remove(EffectType);
 
 	UE_LOG(LogTemp, Log, TEXT("PlayerHUDWidget: Removed effect icon for type %d"), static_cast<int32>(EffectType));
 }
@@ -325,15 +325,8 @@ void UPlayerHUDWidget::UpdateStatusEffectDuration(EStatusEffectType EffectType,
 		return;
 	}
 
-	// 获取总持续时间
-	float TotalDuration = 0.0f;
-	if (float* FoundDuration = EffectTotalDurations.Find(EffectType))
-	{
-		TotalDuration = *FoundDuration;
-	}
-
-	// 更新图标显示
-	(*FoundIcon)->UpdateDuration(RemainingTime, TotalDuration);
+	// 校准图标的倒计时（总持续时间沿用施加时记录的值）
+	(*FoundIcon)->UpdateDuration(RemainingTime, (*FoundIcon)->GetTotalDuration());
 }
 
 // ========== 背包栏相关实现 ==========
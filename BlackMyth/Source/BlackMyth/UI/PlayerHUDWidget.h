@@ -27,7 +27,7 @@ class UInventoryBarWidget;
  * 3. 调用 InitializeHUD() 绑定角色组件
  * 4. 可选：添加 HorizontalBox 命名为 StatusEffectContainer 用于显示状态效果图标
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class BLACKMYTH_API UPlayerHUDWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -83,7 +83,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "HUD|StatusEffect")
 	void RemoveStatusEffectIcon(EStatusEffectType EffectType);
 
-	/** 更新状态效果剩余时间 */
+	/** 校准状态效果剩余时间（图标已按时间自行倒计时，只在需要与外部时间同步时调用） */
 	UFUNCTION(BlueprintCallable, Category = "HUD|StatusEffect")
 	void UpdateStatusEffectDuration(EStatusEffectType EffectType, float RemainingTime);
 
@@ -170,9 +170,6 @@ private:
 	UPROPERTY()
 	TMap<EStatusEffectType, UStatusEffectIconWidget*> ActiveEffectIcons;
 
-	/** 各效果的总持续时间（用于计算进度条） */
-	TMap<EStatusEffectType, float> EffectTotalDurations;
-
 	/** 连击隐藏计时器句柄 */
 	FTimerHandle ComboHideTimerHandle;
 
@@ -41,7 +41,7 @@ struct FSkillInfo
  * 技能栏 Widget
  * 管理4个技能槽位，显示技能图标和冷却状态
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class BLACKMYTH_API USkillBarWidget : public UUserWidget
 {
 	GENERATED_BODY()
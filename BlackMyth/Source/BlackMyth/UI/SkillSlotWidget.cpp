@@ -4,6 +4,30 @@
 #include "Components/Image.h"
 #include "Components/TextBlock.h"
 #include "Components/ProgressBar.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+void USkillSlotWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	// 冷却显示绑定到时间计算函数，Slate 绘制时取值（隐藏时不绘制也不计算）
+	if (CooldownText)
+	{
+		CooldownText->TextDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(USkillSlotWidget, GetCooldownText));
+	}
+
+	if (CooldownBar)
+	{
+		CooldownBar->PercentDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(USkillSlotWidget, GetCooldownProgress));
+	}
+
+	if (CooldownOverlay)
+	{
+		OverlayBaseColor = CooldownOverlay->GetColorAndOpacity();
+		CooldownOverlay->ColorAndOpacityDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(USkillSlotWidget, GetCooldownOverlayColor));
+	}
+}
 
 void USkillSlotWidget::NativeConstruct()
 {
@@ -13,15 +37,14 @@ void USkillSlotWidget::NativeConstruct()
 	UpdateVisuals();
 }
 
-void USkillSlotWidget::NativeTick(const FGeometry& MyGeometry, float InDeltaTime)
+void USkillSlotWidget::NativeDestruct()
 {
-	Super::NativeTick(MyGeometry, InDeltaTime);
-
-	// 更新冷却
-	if (bIsOnCooldown)
+	if (UWorld* World = GetWorld())
 	{
-		UpdateCooldown(InDeltaTime);
+		World->GetTimerManager().ClearTimer(CooldownTimerHandle);
 	}
+
+	Super::NativeDestruct();
 }
 
 void USkillSlotWidget::InitializeSlot(const FString& InSkillName, const FString& InKeyName, UTexture2D* InIcon)
@@ -42,11 +65,7 @@ void USkillSlotWidget::InitializeSlot(const FString& InSkillName, const FString&
 	}
 
 	// 初始状态
-	bIsOnCooldown = false;
-	RemainingCooldown = 0.0f;
-	TotalCooldown = 0.0f;
-
-	UpdateVisuals();
+	ResetCooldown();
 }
 
 void USkillSlotWidget::StartCooldown(float CooldownDuration)
@@ -58,8 +77,9 @@ void USkillSlotWidget::StartCooldown(float CooldownDuration)
 
 	bIsOnCooldown = true;
 	TotalCooldown = CooldownDuration;
-	RemainingCooldown = CooldownDuration;
+	CooldownStartTime = GetWorldTime();
 
+	ScheduleCooldownEnd(CooldownDuration);
 	UpdateVisuals();
 }
 
@@ -70,29 +90,46 @@ void USkillSlotWidget::UpdateCooldown(float DeltaTime)
 		return;
 	}
 
-	RemainingCooldown -= DeltaTime;
+	// 开始时间前移等价于多经过了 DeltaTime
+	CooldownStartTime -= DeltaTime;
 
-	if (RemainingCooldown <= 0.0f)
+	const float Remaining = GetRemainingCooldown();
+	if (Remaining <= 0.0f)
 	{
 		// 冷却结束
 		ResetCooldown();
 	}
 	else
 	{
-		// 更新显示
-		UpdateVisuals();
+		ScheduleCooldownEnd(Remaining);
 	}
 }
 
 void USkillSlotWidget::ResetCooldown()
 {
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(CooldownTimerHandle);
+	}
+
 	bIsOnCooldown = false;
-	RemainingCooldown = 0.0f;
 	TotalCooldown = 0.0f;
+	CooldownStartTime = 0.0;
 
 	UpdateVisuals();
 }
 
+float USkillSlotWidget::GetRemainingCooldown() const
+{
+	if (!bIsOnCooldown)
+	{
+		return 0.0f;
+	}
+
+	const float Elapsed = static_cast<float>(GetWorldTime() - CooldownStartTime);
+	return FMath::Max(TotalCooldown - Elapsed, 0.0f);
+}
+
 float USkillSlotWidget::GetCooldownProgress() const
 {
 	if (!bIsOnCooldown || TotalCooldown <= 0.0f)
@@ -100,7 +137,35 @@ float USkillSlotWidget::GetCooldownProgress() const
 		return 1.0f;  // 完全可用
 	}
 
-	return 1.0f - (RemainingCooldown / TotalCooldown);
+	return 1.0f - (GetRemainingCooldown() / TotalCooldown);
+}
+
+FText USkillSlotWidget::GetCooldownText() const
+{
+	// 显示剩余秒数（向上取整）
+	return FText::AsNumber(FMath::CeilToInt(GetRemainingCooldown()));
+}
+
+FLinearColor USkillSlotWidget::GetCooldownOverlayColor() const
+{
+	// 遮罩透明度基于冷却进度
+	FLinearColor Color = OverlayBaseColor;
+	Color.A *= (1.0f - GetCooldownProgress()) * 0.7f;
+	return Color;
+}
+
+double USkillSlotWidget::GetWorldTime() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
+}
+
+void USkillSlotWidget::ScheduleCooldownEnd(float RemainingTime)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().SetTimer(CooldownTimerHandle, this, &USkillSlotWidget::ResetCooldown, RemainingTime, false);
+	}
 }
 
 void USkillSlotWidget::UpdateVisuals()
@@ -118,26 +183,20 @@ void USkillSlotWidget::UpdateVisuals()
 			SkillIcon->SetColorAndOpacity(CooldownColor);
 		}
 
+		// 遮罩透明度、倒计时和进度由绑定在绘制时计算，这里只切换可见性
 		if (CooldownOverlay)
 		{
 			CooldownOverlay->SetVisibility(ESlateVisibility::Visible);
-			// 设置遮罩透明度基于冷却进度
-			float Alpha = 1.0f - GetCooldownProgress();
-			CooldownOverlay->SetRenderOpacity(Alpha * 0.7f);
 		}
 
 		if (CooldownText)
 		{
 			CooldownText->SetVisibility(ESlateVisibility::Visible);
-			// 显示剩余秒数（向上取整）
-			int32 SecondsRemaining = FMath::CeilToInt(RemainingCooldown);
-			CooldownText->SetText(FText::FromString(FString::Printf(TEXT("%d"), SecondsRemaining)));
 		}
 
 		if (CooldownBar)
 		{
 			CooldownBar->SetVisibility(ESlateVisibility::Visible);
-			CooldownBar->SetPercent(GetCooldownProgress());
 			CooldownBar->SetFillColorAndOpacity(CooldownBarColor);
 		}
 	}
@@ -13,8 +13,11 @@ class UProgressBar;
 /**
  * 单个技能槽位 Widget
  * 显示技能图标、按键提示和冷却进度
+ *
+ * 不再 Tick：只记录冷却开始时间和总时长，倒计时文本、进度条和遮罩通过属性绑定在绘制时计算；
+ * 冷却结束由一次性计时器切换回可用状态
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class BLACKMYTH_API USkillSlotWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -28,7 +31,7 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Skill")
 	void StartCooldown(float CooldownDuration);
 
-	/** 更新冷却进度（每帧调用） */
+	/** 额外推进冷却时间（显示已在绘制时按时间计算，无需每帧调用） */
 	UFUNCTION(BlueprintCallable, Category = "Skill")
 	void UpdateCooldown(float DeltaTime);
 
@@ -46,15 +49,26 @@ public:
 
 	/** 获取剩余冷却时间 */
 	UFUNCTION(BlueprintPure, Category = "Skill")
-	float GetRemainingCooldown() const { return RemainingCooldown; }
+	float GetRemainingCooldown() const;
 
 	/** 获取冷却进度 (0-1, 0=刚开始冷却, 1=冷却完成) */
 	UFUNCTION(BlueprintPure, Category = "Skill")
 	float GetCooldownProgress() const;
 
 protected:
+	virtual void NativeOnInitialized() override;
 	virtual void NativeConstruct() override;
-	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void NativeDestruct() override;
+
+	// ========== 绘制时绑定 ==========
+
+	/** 冷却倒计时文本（剩余秒数向上取整） */
+	UFUNCTION()
+	FText GetCooldownText() const;
+
+	/** 冷却遮罩颜色（透明度随冷却进度降低） */
+	UFUNCTION()
+	FLinearColor GetCooldownOverlayColor() const;
 
 	// ========== UI 控件绑定 ==========
 
@@ -109,9 +123,21 @@ private:
 	/** 总冷却时间 */
 	float TotalCooldown = 0.0f;
 
-	/** 剩余冷却时间 */
-	float RemainingCooldown = 0.0f;
+	/** 冷却开始时的世界时间（剩余时间由此推算） */
+	double CooldownStartTime = 0.0;
+
+	/** 冷却遮罩在蓝图中设置的颜色 */
+	FLinearColor OverlayBaseColor = FLinearColor::White;
+
+	/** 冷却结束计时器 */
+	FTimerHandle CooldownTimerHandle;
+
+	/** 当前世界时间 */
+	double GetWorldTime() const;
+
+	/** 按剩余时间重新设置冷却结束计时器 */
+	void ScheduleCooldownEnd(float RemainingTime);
 
-	/** 更新视觉效果 */
+	/** 更新视觉效果（只在冷却开始/结束时调用） */
 	void UpdateVisuals();
 };
@@ -4,21 +4,22 @@
 #include "Components/Image.h"
 #include "Components/ProgressBar.h"
 #include "Components/TextBlock.h"
+#include "Engine/World.h"
 
-void UStatusEffectIconWidget::NativeConstruct()
+void UStatusEffectIconWidget::NativeOnInitialized()
 {
-	Super::NativeConstruct();
+	Super::NativeOnInitialized();
 
-	// 初始化进度条为满
+	// 进度条和文本绑定到时间计算函数，Slate 绘制时取值
 	if (DurationProgressBar)
 	{
-		DurationProgressBar->SetPercent(1.0f);
+		DurationProgressBar->PercentDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UStatusEffectIconWidget, GetRemainingPercent));
+		DurationProgressBar->FillColorAndOpacityDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UStatusEffectIconWidget, GetDurationBarColor));
 	}
 
-	// 初始化文本（如果存在）为隐藏
 	if (DurationText)
 	{
-		DurationText->SetText(FText::FromString(TEXT("")));
+		DurationText->TextDelegate.BindUFunction(this, GET_FUNCTION_NAME_CHECKED(UStatusEffectIconWidget, GetDurationText));
 	}
 }
 
@@ -28,38 +29,56 @@ void UStatusEffectIconWidget::SetEffectType(EStatusEffectType InEffectType)
 	UpdateIconDisplay();
 }
 
+void UStatusEffectIconWidget::StartCountdown(float InTotalDuration)
+{
+	UpdateDuration(InTotalDuration, InTotalDuration);
+}
+
 void UStatusEffectIconWidget::UpdateDuration(float RemainingTime, float InTotalDuration)
 {
-	// 更新总持续时间（首次调用时设置）
-	if (TotalDuration <= 0.0f && InTotalDuration > 0.0f)
+	if (InTotalDuration > 0.0f)
 	{
 		TotalDuration = InTotalDuration;
 	}
 
-	// 更新进度条
-	if (DurationProgressBar && TotalDuration > 0.0f)
+	// 反推开始时间，之后的剩余时间在绘制时按世界时间计算
+	const UWorld* World = GetWorld();
+	const double Now = World ? World->GetTimeSeconds() : 0.0;
+	StartTime = Now - FMath::Max(TotalDuration - RemainingTime, 0.0f);
+}
+
+float UStatusEffectIconWidget::GetRemainingTime() const
+{
+	const UWorld* World = GetWorld();
+	const double Now = World ? World->GetTimeSeconds() : StartTime;
+	return FMath::Max(TotalDuration - static_cast<float>(Now - StartTime), 0.0f);
+}
+
+float UStatusEffectIconWidget::GetRemainingPercent() const
+{
+	return TotalDuration > 0.0f ? FMath::Clamp(GetRemainingTime() / TotalDuration, 0.0f, 1.0f) : 1.0f;
+}
+
+FLinearColor UStatusEffectIconWidget::GetDurationBarColor() const
+{
+	// 根据剩余时间改变进度条颜色（低于25%时变红）
+	if (TotalDuration > 0.0f && GetRemainingPercent() <= 0.25f)
 	{
-		float Percent = FMath::Clamp(RemainingTime / TotalDuration, 0.0f, 1.0f);
-		DurationProgressBar->SetPercent(Percent);
-
-		// 根据剩余时间改变进度条颜色（低于25%时变红）
-		if (Percent <= 0.25f)
-		{
-			DurationProgressBar->SetFillColorAndOpacity(FLinearColor(1.0f, 0.2f, 0.2f, 1.0f));
-		}
-		else
-		{
-			DurationProgressBar->SetFillColorAndOpacity(GetColorForEffectType(EffectType));
-		}
+		return FLinearColor(1.0f, 0.2f, 0.2f, 1.0f);
 	}
 
-	// 更新时间文本
-	if (DurationText)
+	return GetColorForEffectType(EffectType);
+}
+
+FText UStatusEffectIconWidget::GetDurationText() const
+{
+	if (TotalDuration <= 0.0f)
 	{
-		// 显示剩余时间，保留一位小数
-		FString TimeString = FString::Printf(TEXT("%.1f"), FMath::Max(0.0f, RemainingTime));
-		DurationText->SetText(FText::FromString(TimeString));
+		return FText::GetEmpty();
 	}
+
+	// 显示剩余时间，保留一位小数
+	return FText::FromString(FString::Printf(TEXT("%.1f"), GetRemainingTime()));
 }
 
 FLinearColor UStatusEffectIconWidget::GetColorForEffectType(EStatusEffectType Type) const
@@ -157,11 +176,7 @@ void UStatusEffectIconWidget::UpdateIconDisplay()
 		EffectIcon->SetColorAndOpacity(IconColor);
 	}
 
-	// 设置进度条颜色
-	if (DurationProgressBar)
-	{
-		DurationProgressBar->SetFillColorAndOpacity(IconColor);
-	}
+	// 进度条颜色由 GetDurationBarColor 绑定提供
 
 	// 设置效果名称文本
 	if (EffectNameText)
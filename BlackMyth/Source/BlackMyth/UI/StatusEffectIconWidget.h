@@ -14,8 +14,11 @@ class UTextBlock;
 /**
  * 状态效果图标 Widget
  * 显示单个状态效果的图标、进度条和剩余时间
+ *
+ * 不再 Tick 也不接收逐帧的剩余时间广播：施加/刷新时记录开始时间和总时长，
+ * 进度条和倒计时文本通过属性绑定在绘制时计算
  */
-UCLASS()
+UCLASS(meta = (DisableNativeTick))
 class BLACKMYTH_API UStatusEffectIconWidget : public UUserWidget
 {
 	GENERATED_BODY()
@@ -25,10 +28,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "StatusEffect")
 	void SetEffectType(EStatusEffectType InEffectType);
 
-	/** 更新剩余时间显示 */
+	/** 开始倒计时（效果施加或刷新时调用） */
+	UFUNCTION(BlueprintCallable, Category = "StatusEffect")
+	void StartCountdown(float InTotalDuration);
+
+	/** 按剩余时间校准倒计时 */
 	UFUNCTION(BlueprintCallable, Category = "StatusEffect")
 	void UpdateDuration(float RemainingTime, float TotalDuration);
 
+	/** 获取剩余时间（按开始时间推算） */
+	UFUNCTION(BlueprintPure, Category = "StatusEffect")
+	float GetRemainingTime() const;
+
 	/** 获取当前效果类型 */
 	UFUNCTION(BlueprintPure, Category = "StatusEffect")
 	EStatusEffectType GetEffectType() const { return EffectType; }
@@ -38,7 +49,21 @@ public:
 	float GetTotalDuration() const { return TotalDuration; }
 
 protected:
-	virtual void NativeConstruct() override;
+	virtual void NativeOnInitialized() override;
+
+	// ========== 绘制时绑定 ==========
+
+	/** 剩余时间比例 */
+	UFUNCTION()
+	float GetRemainingPercent() const;
+
+	/** 进度条颜色（低于 25% 时变红） */
+	UFUNCTION()
+	FLinearColor GetDurationBarColor() const;
+
+	/** 剩余时间文本（保留一位小数） */
+	UFUNCTION()
+	FText GetDurationText() const;
 
 	// ========== UI 控件绑定 ==========
 
@@ -126,6 +151,9 @@ private:
 	/** 总持续时间 */
 	float TotalDuration = 0.0f;
 
+	/** 倒计时开始时的世界时间 */
+	double StartTime = 0.0;
+
 	/** 根据效果类型获取对应颜色 */
 	FLinearColor GetColorForEffectType(EStatusEffectType Type) const;
 
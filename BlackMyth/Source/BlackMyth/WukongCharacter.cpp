@@ -22,6 +22,7 @@
 #include "Components/WalletComponent.h"
 #include "Items/GoldPickup.h"
 #include "Combat/TraceHitboxComponent.h"
+#include "Combat/AreaEffectSubsystem.h"
 #include "Dialogue/DialogueComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "GameFramework/SpringArmComponent.h"
@@ -30,6 +31,11 @@
 #include "EnhancedInputComponent.h"
 #include "InputAction.h"
 #include "Temple.h"
+#include "Subsystems/ActorRegistrySubsystem.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "Subsystems/ActorPoolSubsystem.h"
+#include "BlackMythPerfCounters.h"
+#include "BlackMythLog.h"
 #include "EngineUtils.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -38,7 +44,6 @@
 #include "Animation/AnimSequence.h"
 #include "TimerManager.h"
 #include "Engine/World.h"
-#include "Engine/OverlapResult.h"
 #include "CollisionQueryParams.h"
 
 // 设置默认值
@@ -83,6 +88,9 @@ AWukongCharacter::AWukongCharacter()
     // 创建状态效果组件（管理中毒、减速等状态）
     StatusEffectComponent = CreateDefaultSubobject<UStatusEffectComponent>(TEXT("StatusEffectComponent"));
 
+    // 登记战斗组件，命中检测等热路径直接读取
+    SetCombatComponents(HealthComponent, TeamComponent, StatusEffectComponent, CombatComponent);
+
     // 创建背包组件（管理物品和消耗品）
     InventoryComponent = CreateDefaultSubobject<UInventoryComponent>(TEXT("InventoryComponent"));
 
@@ -232,6 +240,14 @@ void AWukongCharacter::BeginPlay()
     // 初始化对话状态
     bIsInDialogue = false;
     CurrentDialogueNPC = nullptr;
+
+    // 预热对象池：分身和喝药动画中的药瓶
+    if (UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this))
+    {
+        Pool->Prewarm(CloneClass, CloneCount);
+        Pool->Prewarm(HealthPotionClass, 1);
+        Pool->Prewarm(StaminaPotionClass, 1);
+    }
 }
 
 // 每帧都调用
@@ -242,9 +258,6 @@ void AWukongCharacter::Tick(float DeltaTime)
     // 更新状态机
     UpdateState(DeltaTime);
 
-    // 更新冷却
-    UpdateCooldowns(DeltaTime);
-
     // 体力更新由StaminaComponent自己处理
 
     // 摄像机距离限制（防止战斗时贴太近）
@@ -292,49 +305,49 @@ void AWukongCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
 {
     Super::SetupPlayerInputComponent(PlayerInputComponent);
 
-    UE_LOG(LogTemp, Warning, TEXT("SetupPlayerInputComponent called!"));
-    UE_LOG(LogTemp, Warning, TEXT("  DodgeAction=%s"), DodgeAction ? *DodgeAction->GetName() : TEXT("NULL"));
-    UE_LOG(LogTemp, Warning, TEXT("  AttackAction=%s"), AttackAction ? *AttackAction->GetName() : TEXT("NULL"));
-    UE_LOG(LogTemp, Warning, TEXT("  SprintAction=%s"), SprintAction ? *SprintAction->GetName() : TEXT("NULL"));
+    UE_LOG(LogBMCombat, Verbose, TEXT("SetupPlayerInputComponent called!"));
+    UE_LOG(LogBMCombat, Verbose, TEXT("  DodgeAction=%s"), DodgeAction ? *DodgeAction->GetName() : TEXT("NULL"));
+    UE_LOG(LogBMCombat, Verbose, TEXT("  AttackAction=%s"), AttackAction ? *AttackAction->GetName() : TEXT("NULL"));
+    UE_LOG(LogBMCombat, Verbose, TEXT("  SprintAction=%s"), SprintAction ? *SprintAction->GetName() : TEXT("NULL"));
 
     if (UEnhancedInputComponent* EnhancedInputComponent = Cast<UEnhancedInputComponent>(PlayerInputComponent))
     {
-        UE_LOG(LogTemp, Warning, TEXT("  EnhancedInputComponent is valid"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("  EnhancedInputComponent is valid"));
         
         // 绑定dodge Action
         if (DodgeAction)
         {
             EnhancedInputComponent->BindAction(DodgeAction, ETriggerEvent::Started, this, &AWukongCharacter::OnDodgePressed);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound DodgeAction to OnDodgePressed"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound DodgeAction to OnDodgePressed"));
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("  DodgeAction is NULL! Dodge will not work!"));
+            UE_LOG(LogBMCombat, Error, TEXT("  DodgeAction is NULL! Dodge will not work!"));
         }
 
         // 绑定攻击Action
         if (AttackAction)
         {
             EnhancedInputComponent->BindAction(AttackAction, ETriggerEvent::Started, this, &AWukongCharacter::PerformAttack);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound AttackAction to PerformAttack"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound AttackAction to PerformAttack"));
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("  AttackAction is NULL! Attack will not work!"));
+            UE_LOG(LogBMCombat, Error, TEXT("  AttackAction is NULL! Attack will not work!"));
         }
 
         // 绑定重击Action
         if (HeavyAttackAction)
         {
             EnhancedInputComponent->BindAction(HeavyAttackAction, ETriggerEvent::Started, this, &AWukongCharacter::PerformHeavyAttack);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound HeavyAttackAction to PerformHeavyAttack"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound HeavyAttackAction to PerformHeavyAttack"));
         }
 
         // 绑定立棍Action
         if (PoleStanceAction)
         {
             EnhancedInputComponent->BindAction(PoleStanceAction, ETriggerEvent::Started, this, &AWukongCharacter::PerformPoleStance);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound PoleStanceAction to PerformPoleStance"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound PoleStanceAction to PerformPoleStance"));
         }
 
         // 绑定甩花棍Action
@@ -342,36 +355,36 @@ void AWukongCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
         {
             EnhancedInputComponent->BindAction(StaffSpinAction, ETriggerEvent::Started, this, &AWukongCharacter::PerformStaffSpin);
             EnhancedInputComponent->BindAction(StaffSpinAction, ETriggerEvent::Completed, this, &AWukongCharacter::PerformStaffSpin); // Handle release if needed
-            UE_LOG(LogTemp, Warning, TEXT("  Bound StaffSpinAction to PerformStaffSpin"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound StaffSpinAction to PerformStaffSpin"));
         }
 
         // 绑定使用道具Action
         if (UseItemAction)
         {
             EnhancedInputComponent->BindAction(UseItemAction, ETriggerEvent::Started, this, &AWukongCharacter::UseItem);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound UseItemAction to UseItem"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound UseItemAction to UseItem"));
         }
 
         // 绑定影分身技能Action（按1）
         if (ShadowCloneAction)
         {
             EnhancedInputComponent->BindAction(ShadowCloneAction, ETriggerEvent::Started, this, &AWukongCharacter::PerformShadowClone);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound ShadowCloneAction to PerformShadowClone"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound ShadowCloneAction to PerformShadowClone"));
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("  ShadowCloneAction is NULL! Shadow Clone (Key 1) will not work! Assign IA_ShadowClone in BP_Wukong."));
+            UE_LOG(LogBMCombat, Error, TEXT("  ShadowCloneAction is NULL! Shadow Clone (Key 1) will not work! Assign IA_ShadowClone in BP_Wukong."));
         }
 
         // 绑定定身术技能Action（按2）
         if (FreezeSpellAction)
         {
             EnhancedInputComponent->BindAction(FreezeSpellAction, ETriggerEvent::Started, this, &AWukongCharacter::PerformFreezeSpell);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound FreezeSpellAction to PerformFreezeSpell"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound FreezeSpellAction to PerformFreezeSpell"));
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("  FreezeSpellAction is NULL! Freeze Spell (Key 2) will not work! Assign IA_FreezeSpell in BP_Wukong."));
+            UE_LOG(LogBMCombat, Warning, TEXT("  FreezeSpellAction is NULL! Freeze Spell (Key 2) will not work! Assign IA_FreezeSpell in BP_Wukong."));
         }
 
         // 绑定冲刺Action
@@ -379,93 +392,93 @@ void AWukongCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
         {
             EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Started, this, &AWukongCharacter::OnSprintStarted);
             EnhancedInputComponent->BindAction(SprintAction, ETriggerEvent::Completed, this, &AWukongCharacter::OnSprintStopped);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound SprintAction"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound SprintAction"));
         }
         else
         {
-            UE_LOG(LogTemp, Error, TEXT("  SprintAction is NULL! Sprint will not work!"));
+            UE_LOG(LogBMCombat, Error, TEXT("  SprintAction is NULL! Sprint will not work!"));
         }
 
         // 绑定视角锁定Action
         if (LockOnAction)
         {
             EnhancedInputComponent->BindAction(LockOnAction, ETriggerEvent::Started, this, &AWukongCharacter::OnLockOnPressed);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound LockOnAction to OnLockOnPressed"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound LockOnAction to OnLockOnPressed"));
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("  LockOnAction is NULL - Lock-on disabled"));
+            UE_LOG(LogBMCombat, Warning, TEXT("  LockOnAction is NULL - Lock-on disabled"));
         }
 
         // 绑定切换视角锁定对象Action
         if (SwitchTargetAction)
         {
             EnhancedInputComponent->BindAction(SwitchTargetAction, ETriggerEvent::Triggered, this, &AWukongCharacter::OnSwitchTarget);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound SwitchTargetAction to OnSwitchTarget"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound SwitchTargetAction to OnSwitchTarget"));
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("  SwitchTargetAction is NULL - Target switching disabled"));
+            UE_LOG(LogBMCombat, Warning, TEXT("  SwitchTargetAction is NULL - Target switching disabled"));
         }
 
         // 绑定交互Action
         if (InteractAction)
         {
             EnhancedInputComponent->BindAction(InteractAction, ETriggerEvent::Started, this, &AWukongCharacter::OnInteract);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound InteractAction (E) to OnInteract"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound InteractAction (E) to OnInteract"));
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("  InteractAction is NULL - Interaction disabled"));
+            UE_LOG(LogBMCombat, Warning, TEXT("  InteractAction is NULL - Interaction disabled"));
         }
 
         // 绑定变身术Action（按3）
         if (TransformAction)
         {
             EnhancedInputComponent->BindAction(TransformAction, ETriggerEvent::Started, this, &AWukongCharacter::PerformTransform);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound TransformAction to PerformTransform"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound TransformAction to PerformTransform"));
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("  TransformAction is NULL! Transform (Key 3) will not work! Assign IA_Transform in BP_Wukong."));
+            UE_LOG(LogBMCombat, Warning, TEXT("  TransformAction is NULL! Transform (Key 3) will not work! Assign IA_Transform in BP_Wukong."));
         }
 
         // 绑定技能4Action（按4）
         if (Skill4Action)
         {
             EnhancedInputComponent->BindAction(Skill4Action, ETriggerEvent::Started, this, &AWukongCharacter::PerformSkill4);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound Skill4Action to PerformSkill4"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound Skill4Action to PerformSkill4"));
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("  Skill4Action is NULL! Skill 4 (Key 4) will not work! Assign IA_Skill4 in BP_Wukong if needed."));
+            UE_LOG(LogBMCombat, Warning, TEXT("  Skill4Action is NULL! Skill 4 (Key 4) will not work! Assign IA_Skill4 in BP_Wukong if needed."));
         }
 
         // 绑定背包开关Action（I键）
         if (ToggleInventoryAction)
         {
             EnhancedInputComponent->BindAction(ToggleInventoryAction, ETriggerEvent::Started, this, &AWukongCharacter::ToggleInventory);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound ToggleInventoryAction to ToggleInventory"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound ToggleInventoryAction to ToggleInventory"));
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("  ToggleInventoryAction is NULL! Inventory (Tab) will not work! Assign IA_ToggleInventory in BP_Wukong."));
+            UE_LOG(LogBMCombat, Warning, TEXT("  ToggleInventoryAction is NULL! Inventory (Tab) will not work! Assign IA_ToggleInventory in BP_Wukong."));
         }
 
         // 绑定拾取Action（F键）
         if (PickupAction)
         {
             EnhancedInputComponent->BindAction(PickupAction, ETriggerEvent::Started, this, &AWukongCharacter::TryPickup);
-            UE_LOG(LogTemp, Warning, TEXT("  Bound PickupAction (F) to TryPickup"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("  Bound PickupAction (F) to TryPickup"));
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("  PickupAction is NULL! Pickup (F) will not work! Assign IA_Pickup in BP_Wukong."));
+            UE_LOG(LogBMCombat, Warning, TEXT("  PickupAction is NULL! Pickup (F) will not work! Assign IA_Pickup in BP_Wukong."));
         }
 
         EnhancedInputComponent->BindAction(TempleAction, ETriggerEvent::Started,
         this, &AWukongCharacter::OnTempleInteract);
-        UE_LOG(LogTemp, Error,
+        UE_LOG(LogBMCombat, Error,
             TEXT("[InputCheck] TempleAction=%s"),
             *GetNameSafe(TempleAction)
         );
@@ -473,7 +486,7 @@ void AWukongCharacter::SetupPlayerInputComponent(UInputComponent* PlayerInputCom
     }
     else
     {
-        UE_LOG(LogTemp, Error, TEXT("  EnhancedInputComponent is NULL! No inputs will work!"));
+        UE_LOG(LogBMCombat, Error, TEXT("  EnhancedInputComponent is NULL! No inputs will work!"));
     }
 }
 
@@ -496,7 +509,7 @@ void AWukongCharacter::Attack()
     // 如果已经在攻击中，加入输入缓冲（用于Combo）
     if (CurrentState == EWukongState::Attacking)
     {
-        InputBuffer.Add(TEXT("Attack"));
+        InputBuffer.Push(EWukongBufferedInput::Attack, GetWorld()->GetTimeSeconds());
         return;
     }
 
@@ -509,7 +522,7 @@ void AWukongCharacter::Attack()
 // 处理输入
 void AWukongCharacter::OnDodgePressed()
 {
-    UE_LOG(LogTemp, Warning, TEXT("OnDodgePressed() called! CurrentState=%d"), (int32)CurrentState);
+    UE_LOG(LogBMCombat, Verbose, TEXT("OnDodgePressed() called! CurrentState=%d"), (int32)CurrentState);
 
     if (CurrentState == EWukongState::Attacking || 
         CurrentState == EWukongState::Dodging || 
@@ -517,7 +530,7 @@ void AWukongCharacter::OnDodgePressed()
         CurrentState == EWukongState::Dead ||
         bIsInDialogue)
     {
-        UE_LOG(LogTemp, Warning, TEXT("OnDodgePressed() blocked by state"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("OnDodgePressed() blocked by state"));
         return;
     }
 
@@ -526,19 +539,19 @@ void AWukongCharacter::OnDodgePressed()
     {
         if (Movement->IsFalling())
         {
-            UE_LOG(LogTemp, Warning, TEXT("OnDodgePressed() blocked - cannot dodge in air"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("OnDodgePressed() blocked - cannot dodge in air"));
             return;
         }
     }
 
-    if (!IsCooldownActive(TEXT("Dodge")))
+    if (!IsCooldownActive(EWukongCooldown::Dodge))
     {
-        UE_LOG(LogTemp, Warning, TEXT("OnDodgePressed() -> calling PerformDodge()"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("OnDodgePressed() -> calling PerformDodge()"));
         PerformDodge();
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("OnDodgePressed() blocked by cooldown"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("OnDodgePressed() blocked by cooldown"));
     }
 }
 
@@ -554,7 +567,7 @@ void AWukongCharacter::OnAttackPressed()
     }
 
     // 先缓冲
-    InputBuffer.Add(TEXT("Attack"));
+    InputBuffer.Push(EWukongBufferedInput::Attack, GetWorld()->GetTimeSeconds());
 
     // 如果没有处于攻击状态，就立即调用刚刚存在缓冲里面的攻击
     if (CurrentState != EWukongState::Attacking)
@@ -702,14 +715,14 @@ void AWukongCharacter::ReceiveDamage(float Damage, AActor* DamageInstigator)
         HitAnim->bEnableRootMotion = true;
         HitAnim->bForceRootLock = true; // 确保根骨骼被锁定，位移应用到胶囊体
 
-        UE_LOG(LogTemp, Warning, TEXT("ReceiveDamage: Playing HitAnim '%s' with Rate %.2f"), *HitAnim->GetName(), HitAnimPlayRate);
+        UE_LOG(LogBMCombat, Verbose, TEXT("ReceiveDamage: Playing HitAnim '%s' with Rate %.2f"), *HitAnim->GetName(), HitAnimPlayRate);
         // 优先使用 DefaultSlot
         float Duration = PlayAnimationAsMontageDynamic(HitAnim, FName("DefaultSlot"), HitAnimPlayRate);
         HitStunTimer = (Duration > 0.0f) ? Duration : HitStunDuration;
     }
     else
     {
-        UE_LOG(LogTemp, Warning, TEXT("ReceiveDamage: HitAnim is NULL!"));
+        UE_LOG(LogBMCombat, Warning, TEXT("ReceiveDamage: HitAnim is NULL!"));
         HitStunTimer = HitStunDuration;
     }
 
@@ -741,7 +754,7 @@ void AWukongCharacter::ChangeState(EWukongState NewState)
         if (UCharacterMovementComponent* Movement = GetCharacterMovement())
         {
             Movement->MaxWalkSpeed = CachedMaxWalkSpeed > 0.0f ? CachedMaxWalkSpeed : WalkSpeed;
-            UE_LOG(LogTemp, Log, TEXT("ChangeState: Exiting Attacking, restored MaxWalkSpeed=%f"), Movement->MaxWalkSpeed);
+            UE_LOG(LogBMCombat, Verbose, TEXT("ChangeState: Exiting Attacking, restored MaxWalkSpeed=%f"), Movement->MaxWalkSpeed);
         }
     }
 
@@ -758,7 +771,7 @@ void AWukongCharacter::ChangeState(EWukongState NewState)
             if (Movement->MaxWalkSpeed < 1.0f)  // 如果速度异常低
             {
                 Movement->MaxWalkSpeed = bIsSprinting ? SprintSpeed : WalkSpeed;
-                UE_LOG(LogTemp, Warning, TEXT("ChangeState: Fixed abnormal MaxWalkSpeed, now=%f"), Movement->MaxWalkSpeed);
+                UE_LOG(LogBMCombat, Warning, TEXT("ChangeState: Fixed abnormal MaxWalkSpeed, now=%f"), Movement->MaxWalkSpeed);
             }
         }
         // 允许体力恢复
@@ -769,6 +782,7 @@ void AWukongCharacter::ChangeState(EWukongState NewState)
         break;
     case EWukongState::Attacking:
         AttackTimer = AttackDuration;
+        AttackStartTime = GetWorld()->GetTimeSeconds();
         // 攻击时：允许移动但速度减半
         if (UCharacterMovementComponent* Movement = GetCharacterMovement())
         {
@@ -776,7 +790,7 @@ void AWukongCharacter::ChangeState(EWukongState NewState)
             CachedMaxWalkSpeed = Movement->MaxWalkSpeed;
             // 攻击时移动速度变为原来的 50%（可通过 AttackMoveSpeedMultiplier 调整）
             Movement->MaxWalkSpeed = CachedMaxWalkSpeed * AttackMoveSpeedMultiplier;
-            UE_LOG(LogTemp, Log, TEXT("ChangeState: Entering Attacking, MaxWalkSpeed reduced to %f (%.0f%%)"), 
+            UE_LOG(LogBMCombat, Verbose, TEXT("ChangeState: Entering Attacking, MaxWalkSpeed reduced to %f (%.0f%%)"), 
                 Movement->MaxWalkSpeed, AttackMoveSpeedMultiplier * 100.0f);
         }
         // 攻击时禁止体力恢复
@@ -789,7 +803,7 @@ void AWukongCharacter::ChangeState(EWukongState NewState)
         DodgeTimer = DodgeDuration;
         bIsInvincible = true;
         InvincibilityTimer = DodgeInvincibilityDuration;
-        StartCooldown(TEXT("Dodge"), DodgeCooldown);
+        StartCooldown(EWukongCooldown::Dodge, DodgeCooldown);
         // 翻滚时禁止体力恢复
         if (StaminaComponent)
         {
@@ -801,7 +815,7 @@ void AWukongCharacter::ChangeState(EWukongState NewState)
         AbilityTimer = 1.5f;  // 战技持续时间
         bIsInvincible = true;  // 战技期间无敌
         InvincibilityTimer = 1.5f;
-        StartCooldown(TEXT("Ability"), AbilityCooldown);
+        StartCooldown(EWukongCooldown::Ability, AbilityCooldown);
         // 使用战技时禁止体力恢复
         if (StaminaComponent)
         {
@@ -810,11 +824,11 @@ void AWukongCharacter::ChangeState(EWukongState NewState)
         break;
     case EWukongState::HitStun:
         ResetCombo();
-        InputBuffer.Empty();
+        InputBuffer.Reset();
         break;
     case EWukongState::Dead:
         ResetCombo();
-        InputBuffer.Empty();
+        InputBuffer.Reset();
         if (UCharacterMovementComponent* Movement = GetCharacterMovement())
         {
             Movement->DisableMovement();
@@ -879,7 +893,7 @@ void AWukongCharacter::UpdateAttackingState(float DeltaTime)
     // 注意：这里不需要额外代码，因为在 Move() 函数里我们已经判断了 IsAttacking 就不处理 AddMovementInput
 
     // 调用刚刚存在缓冲区里面的Attack
-    if (AttackTimer < AttackDuration * 0.5f && InputBuffer.Num() > 0)
+    if (AttackTimer < AttackDuration * 0.5f && !InputBuffer.IsEmpty())
     {
         ProcessInputBuffer();
     }
@@ -968,7 +982,7 @@ void AWukongCharacter::PerformAttack()
     // 检查是否被状态效果禁止攻击（如中毒）
     if (StatusEffectComponent && StatusEffectComponent->IsAttackDisabled())
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformAttack: Blocked by status effect (attack disabled)"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformAttack: Blocked by status effect (attack disabled)"));
         return;
     }
 
@@ -979,35 +993,15 @@ void AWukongCharacter::PerformAttack()
     }
 
     // ========== 攻击间隔保护 (基于动画进度) ==========
-    // 如果正在攻击，检查当前蒙太奇播放进度
-    if (CurrentState == EWukongState::Attacking)
+    // 如果正在攻击且还没到连招窗口，缓冲输入
+    if (!IsAttackComboWindowOpen())
     {
-        if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+        if (InputBuffer.IsEmpty()) 
         {
-            if (UAnimMontage* CurrentMontage = AnimInstance->GetCurrentActiveMontage())
-            {
-                // 获取当前播放位置和总长度
-                float CurrentPos = AnimInstance->Montage_GetPosition(CurrentMontage);
-                // 注意：GetPlayLength() 返回的是原始长度，不包含 RateScale。
-                // 但 Montage_GetPosition 也是基于原始时间的，所以直接比对即可。
-                float TotalLength = CurrentMontage->GetPlayLength();
-
-                // 设定允许连招的阈值：动作播放了 80% 之后才允许打断
-                // 这样配合 1.5倍速播放，既能看清动作，手感又不会太粘滞
-                const float ComboWindowThreshold = 0.8f;
-
-                if (TotalLength > 0.0f && (CurrentPos / TotalLength) < ComboWindowThreshold)
-                {
-                    // 还没播到 80%，缓冲输入
-                    if (InputBuffer.Num() == 0) 
-                    {
-                        InputBuffer.Add(TEXT("Attack"));
-                        UE_LOG(LogTemp, Log, TEXT("PerformAttack: Input Buffered (Progress: %.2f%% < 80%%)"), (CurrentPos / TotalLength) * 100.0f);
-                    }
-                    return;
-                }
-            }
+            InputBuffer.Push(EWukongBufferedInput::Attack, GetWorld()->GetTimeSeconds());
+            UE_LOG(LogBMCombat, Verbose, TEXT("PerformAttack: Input Buffered (combo window not open)"));
         }
+        return;
     }
 
     // 消耗体力
@@ -1030,7 +1024,7 @@ void AWukongCharacter::PerformAttack()
         if (bIsInAir)
         {
             // ========== 空中攻击未实现 ==========
-            UE_LOG(LogTemp, Warning, TEXT("PerformAttack: Air attack not implemented"));
+            UE_LOG(LogBMCombat, Verbose, TEXT("PerformAttack: Air attack not implemented"));
             // 空中攻击不增加连击计数
         }
         else
@@ -1057,12 +1051,42 @@ void AWukongCharacter::PerformAttack()
             if (MontageToPlay)
             {
                 AnimInstance->Montage_Play(MontageToPlay, 1.0f);
-                UE_LOG(LogTemp, Log, TEXT("PerformAttack: Ground combo %d"), ComboIndex + 1);
+                UE_LOG(LogBMCombat, Verbose, TEXT("PerformAttack: Ground combo %d"), ComboIndex + 1);
             }
         }
     }
 }
 
+bool AWukongCharacter::IsAttackComboWindowOpen() const
+{
+    if (CurrentState != EWukongState::Attacking)
+    {
+        return true;
+    }
+
+    if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+    {
+        if (UAnimMontage* CurrentMontage = AnimInstance->GetCurrentActiveMontage())
+        {
+            // 获取当前播放位置和总长度
+            float CurrentPos = AnimInstance->Montage_GetPosition(CurrentMontage);
+            // 注意：GetPlayLength() 返回的是原始长度，不包含 RateScale。
+            // 但 Montage_GetPosition 也是基于原始时间的，所以直接比对即可。
+            float TotalLength = CurrentMontage->GetPlayLength();
+
+            // 设定允许连招的阈值：动作播放了 80% 之后才允许打断
+            // 这样配合 1.5倍速播放，既能看清动作，手感又不会太粘滞
+            const float ComboWindowThreshold = 0.8f;
+
+            if (TotalLength > 0.0f && (CurrentPos / TotalLength) < ComboWindowThreshold)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 void AWukongCharacter::ResetCombo()
 {
     if (CombatComponent)
@@ -1077,42 +1101,46 @@ void AWukongCharacter::ProcessInputBuffer()
     // 死亡状态下不处理任何输入缓冲
     if (CurrentState == EWukongState::Dead)
     {
-        InputBuffer.Empty();
+        InputBuffer.Reset();
         return;
     }
 
-    if (InputBuffer.Num() == 0)
+    // 攻击中：容错时间从连招缓冲开始处理的时刻（攻击进行到一半）算起，而不是按帧的当前时间
+    const double Now = GetWorld()->GetTimeSeconds();
+    const double WindowOpenTime = CurrentState == EWukongState::Attacking
+        ? AttackStartTime + AttackDuration * 0.5
+        : Now;
+    const double MinPressTime = FWukongInputBuffer::GetMinPressTime(Now, WindowOpenTime, InputBufferTime);
+
+    // 查看最早一条仍在容错时间内的输入，过期的一并丢弃
+    EWukongBufferedInput NextInput = EWukongBufferedInput::Attack;
+    if (!InputBuffer.PeekFresh(MinPressTime, NextInput))
     {
         return;
     }
 
-    // 清空缓冲
-    float CurrentTime = GetWorld()->GetTimeSeconds();
-    InputBuffer.RemoveAll([CurrentTime, this](const FString& Input) {
-        return (CurrentTime - LastAttackTime) > InputBufferTime;
-    });
-
-    // 执行缓冲区中的第一次攻击
-    if (InputBuffer.Num() > 0)
+    switch (NextInput)
     {
-        FString NextInput = InputBuffer[0];
-        InputBuffer.RemoveAt(0);
-
-        if (NextInput == TEXT("Attack"))
+    case EWukongBufferedInput::Attack:
+        // 动画还没到连招窗口：保留输入（按下时间不变），之后的帧再试
+        if (!IsAttackComboWindowOpen())
         {
-            PerformAttack();
+            return;
         }
+        InputBuffer.Pop();
+        PerformAttack();
+        break;
     }
 }
 
 void AWukongCharacter::PerformDodge()
 {
-    UE_LOG(LogTemp, Log, TEXT("PerformDodge() called"));
+    UE_LOG(LogBMCombat, Verbose, TEXT("PerformDodge() called"));
     
     // 检查是否有足够体力翻滚
     if (!StaminaComponent || !StaminaComponent->HasEnoughStamina(StaminaComponent->DodgeStaminaCost))
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformDodge: Not enough stamina! Current=%f, Required=%f"), 
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformDodge: Not enough stamina! Current=%f, Required=%f"), 
             StaminaComponent ? StaminaComponent->GetCurrentStamina() : 0.0f,
             StaminaComponent ? StaminaComponent->DodgeStaminaCost : 0.0f);
         return;
@@ -1187,7 +1215,7 @@ void AWukongCharacter::PerformHeavyAttack()
     // 检查是否被状态效果禁止攻击（如中毒）
     if (StatusEffectComponent && StatusEffectComponent->IsAttackDisabled())
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformHeavyAttack: Blocked by status effect (attack disabled)"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformHeavyAttack: Blocked by status effect (attack disabled)"));
         return;
     }
 
@@ -1206,7 +1234,7 @@ void AWukongCharacter::PerformHeavyAttack()
                 const float HeavyAttackWindowThreshold = 0.7f;
                 if (TotalLength > 0.0f && (CurrentPos / TotalLength) < HeavyAttackWindowThreshold)
                 {
-                    UE_LOG(LogTemp, Log, TEXT("PerformHeavyAttack: Blocked - animation at %.1f%%, need %.1f%%"), 
+                    UE_LOG(LogBMCombat, Verbose, TEXT("PerformHeavyAttack: Blocked - animation at %.1f%%, need %.1f%%"), 
                         (CurrentPos / TotalLength) * 100.0f, HeavyAttackWindowThreshold * 100.0f);
                     return;
                 }
@@ -1217,7 +1245,7 @@ void AWukongCharacter::PerformHeavyAttack()
     // 检查是否有足够体力重击
     if (!StaminaComponent || !StaminaComponent->HasEnoughStamina(StaminaComponent->HeavyAttackStaminaCost))
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformHeavyAttack: Not enough stamina!"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformHeavyAttack: Not enough stamina!"));
         return;
     }
 
@@ -1270,7 +1298,7 @@ void AWukongCharacter::PerformStaffSpin()
     // 检查是否有足够体力使用棍花
     if (!StaminaComponent || !StaminaComponent->HasEnoughStamina(StaminaComponent->StaffSpinStaminaCost))
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformStaffSpin: Not enough stamina!"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformStaffSpin: Not enough stamina!"));
         return;
     }
 
@@ -1323,7 +1351,7 @@ void AWukongCharacter::PerformPoleStance()
     // 检查是否有足够体力使用立棍法
     if (!StaminaComponent || !StaminaComponent->HasEnoughStamina(StaminaComponent->PoleStanceStaminaCost))
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformPoleStance: Not enough stamina!"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformPoleStance: Not enough stamina!"));
         return;
     }
 
@@ -1381,14 +1409,14 @@ void AWukongCharacter::ToggleInventory()
     // 不显示鼠标，保持游戏模式
     // 背包是被动信息显示，不需要鼠标交互
 
-    UE_LOG(LogTemp, Log, TEXT("Inventory %s"), bIsInventoryOpen ? TEXT("Opened") : TEXT("Closed"));
+    UE_LOG(LogTemp, Verbose, TEXT("Inventory %s"), bIsInventoryOpen ? TEXT("Opened") : TEXT("Closed"));
 }
 
 // ========== 影分身技能实现 ==========
 
 void AWukongCharacter::PerformShadowClone()
 {
-    UE_LOG(LogTemp, Warning, TEXT(">>> PerformShadowClone() CALLED! CurrentState=%d"), (int32)CurrentState);
+    UE_LOG(LogBMCombat, Verbose, TEXT(">>> PerformShadowClone() CALLED! CurrentState=%d"), (int32)CurrentState);
 
     // 背包打开时，使用槽位 0（血药）并播放动画
     if (bIsInventoryOpen)
@@ -1412,28 +1440,28 @@ void AWukongCharacter::PerformShadowClone()
         CurrentState == EWukongState::HitStun ||
         bIsInDialogue)
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformShadowClone: Blocked by state"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformShadowClone: Blocked by state"));
         return;
     }
 
     // 检查冷却
-    if (IsCooldownActive(TEXT("ShadowClone")))
+    if (IsCooldownActive(EWukongCooldown::ShadowClone))
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformShadowClone: On cooldown"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformShadowClone: On cooldown"));
         return;
     }
 
     // 检查是否设置了分身类
     if (!CloneClass)
     {
-        UE_LOG(LogTemp, Warning, TEXT("PerformShadowClone: CloneClass not set! Set it in BP_Wukong blueprint."));
+        UE_LOG(LogBMCombat, Warning, TEXT("PerformShadowClone: CloneClass not set! Set it in BP_Wukong blueprint."));
         return;
     }
 
-    UE_LOG(LogTemp, Log, TEXT("PerformShadowClone: Summoning %d clones!"), CloneCount);
+    UE_LOG(LogBMCombat, Verbose, TEXT("PerformShadowClone: Summoning %d clones!"), CloneCount);
 
     // 开始冷却
-    StartCooldown(TEXT("ShadowClone"), ShadowCloneCooldown);
+    StartCooldown(EWukongCooldown::ShadowClone, ShadowCloneCooldown);
 
     // 播放召唤动画（如果有的话）
     if (ShadowCloneMontage)
@@ -1444,7 +1472,8 @@ void AWukongCharacter::PerformShadowClone()
         }
     }
 
-    // 生成分身
+    // 生成分身（优先从对象池取出）
+    UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(this);
     FVector PlayerLocation = GetActorLocation();
     FRotator PlayerRotation = GetActorRotation();
 
@@ -1469,6 +1498,7 @@ void AWukongCharacter::PerformShadowClone()
         FCollisionQueryParams QueryParams;
         QueryParams.AddIgnoredActor(this);
         
+        BlackMythPerf::Add(BlackMythPerf::ECounter::PhysicsQueries);
         if (GetWorld()->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, ECC_Visibility, QueryParams))
         {
             // 找到地面，将生成点设置在地面上方一点
@@ -1484,22 +1514,19 @@ void AWukongCharacter::PerformShadowClone()
         SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
         // 生成分身
-        AWukongClone* Clone = GetWorld()->SpawnActor<AWukongClone>(
-            CloneClass,
-            SpawnLocation,
-            SpawnRotation,
-            SpawnParams
-        );
+        AWukongClone* Clone = Pool
+            ? Pool->Acquire<AWukongClone>(CloneClass, SpawnLocation, SpawnRotation, SpawnParams)
+            : GetWorld()->SpawnActor<AWukongClone>(CloneClass, SpawnLocation, SpawnRotation, SpawnParams);
 
         if (Clone)
         {
             // 初始化分身
             Clone->InitializeClone(this, CloneLifetime);
-            UE_LOG(LogTemp, Log, TEXT("PerformShadowClone: Spawned clone %d at %s"), i + 1, *SpawnLocation.ToString());
+            UE_LOG(LogBMCombat, Verbose, TEXT("PerformShadowClone: Spawned clone %d at %s"), i + 1, *SpawnLocation.ToString());
         }
         else
         {
-            UE_LOG(LogTemp, Warning, TEXT("PerformShadowClone: Failed to spawn clone %d"), i + 1);
+            UE_LOG(LogBMCombat, Warning, TEXT("PerformShadowClone: Failed to spawn clone %d"), i + 1);
         }
     }
 }
@@ -1508,7 +1535,7 @@ void AWukongCharacter::PerformShadowClone()
 
 void AWukongCharacter::PerformFreezeSpell()
 {
-    UE_LOG(LogTemp, Warning, TEXT(">>> PerformFreezeSpell() CALLED! CurrentState=%d"), (int32)CurrentState);
+    UE_LOG(LogBMCombat, Verbose, TEXT(">>> PerformFreezeSpell() CALLED! CurrentState=%d"), (int32)CurrentState);
 
     // 背包打开时，使用槽位 1（体力药）并播放动画
     if (bIsInventoryOpen)
@@ -1532,21 +1559,28 @@ void AWukongCharacter::PerformFreezeSpell()
         CurrentState == EWukongState::HitStun ||
         bIsInDialogue)
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformFreezeSpell: Blocked by state"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformFreezeSpell: Blocked by state"));
         return;
     }
 
     // 检查冷却
-    if (IsCooldownActive(TEXT("FreezeSpell")))
+    if (IsCooldownActive(EWukongCooldown::FreezeSpell))
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformFreezeSpell: On cooldown"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformFreezeSpell: On cooldown"));
+        return;
+    }
+
+    // 范围定身：一次查询，合批定身周围所有敌人
+    if (FreezeSpellRadius > 0.0f)
+    {
+        PerformAreaFreezeSpell();
         return;
     }
 
     // 检查是否有锁定目标
     if (!TargetingComponent || !TargetingComponent->IsTargeting())
     {
-        UE_LOG(LogTemp, Warning, TEXT("PerformFreezeSpell: No locked target! Lock onto an enemy first (Mouse Middle Button)."));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformFreezeSpell: No locked target! Lock onto an enemy first (Mouse Middle Button)."));
         return;
     }
 
@@ -1555,7 +1589,7 @@ void AWukongCharacter::PerformFreezeSpell()
     AActor* LockedTarget = TargetingComponent->GetLockedTarget();
     if (!LockedTarget)
     {
-        UE_LOG(LogTemp, Warning, TEXT("PerformFreezeSpell: Locked target is invalid!"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformFreezeSpell: Locked target is invalid!"));
         return;
     }
 
@@ -1563,28 +1597,28 @@ void AWukongCharacter::PerformFreezeSpell()
     AEnemyBase* TargetEnemy = Cast<AEnemyBase>(LockedTarget);
     if (!TargetEnemy)
     {
-        UE_LOG(LogTemp, Warning, TEXT("PerformFreezeSpell: Target is not an enemy! Cannot freeze."));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformFreezeSpell: Target is not an enemy! Cannot freeze."));
         return;
     }
 
     // 检查敌人是否已死亡
     if (TargetEnemy->IsDead())
     {
-        UE_LOG(LogTemp, Warning, TEXT("PerformFreezeSpell: Target is already dead!"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformFreezeSpell: Target is already dead!"));
         return;
     }
 
     // 检查敌人是否已被定身
     if (TargetEnemy->IsFrozen())
     {
-        UE_LOG(LogTemp, Log, TEXT("PerformFreezeSpell: Target is already frozen!"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformFreezeSpell: Target is already frozen!"));
         return;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("PerformFreezeSpell: Casting freeze on %s for %.1f seconds!"), *TargetEnemy->GetName(), FreezeSpellDuration);
+    UE_LOG(LogBMCombat, Verbose, TEXT("PerformFreezeSpell: Casting freeze on %s for %.1f seconds!"), *TargetEnemy->GetName(), FreezeSpellDuration);
 
     // 开始冷却
-    StartCooldown(TEXT("FreezeSpell"), FreezeSpellCooldown);
+    StartCooldown(EWukongCooldown::FreezeSpell, FreezeSpellCooldown);
 
     // 播放施法动画（如果有的话）
     if (FreezeSpellMontage)
@@ -1599,6 +1633,44 @@ void AWukongCharacter::PerformFreezeSpell()
     TargetEnemy->ApplyFreeze(FreezeSpellDuration);
 }
 
+void AWukongCharacter::PerformAreaFreezeSpell()
+{
+    UAreaEffectSubsystem* AreaEffects = UAreaEffectSubsystem::Get(this);
+    if (!AreaEffects)
+    {
+        return;
+    }
+
+    FAreaEffectRequest Request;
+    Request.Instigator = this;
+    Request.Center = GetActorLocation();
+    Request.Radius = FreezeSpellRadius;
+    Request.TeamMask = SpatialGrid::TeamBit(ETeam::Enemy);
+    Request.bSkipFrozen = true;
+    Request.FreezeDuration = FreezeSpellDuration;
+
+    const int32 NumFrozen = AreaEffects->Apply(Request);
+    if (NumFrozen == 0)
+    {
+        UE_LOG(LogBMCombat, Verbose, TEXT("PerformAreaFreezeSpell: No enemies to freeze within %.0f"), FreezeSpellRadius);
+        return;
+    }
+
+    UE_LOG(LogBMCombat, Log, TEXT("PerformAreaFreezeSpell: Froze %d enemies for %.1f seconds!"), NumFrozen, FreezeSpellDuration);
+
+    // 开始冷却
+    StartCooldown(EWukongCooldown::FreezeSpell, FreezeSpellCooldown);
+
+    // 播放施法动画（如果有的话）
+    if (FreezeSpellMontage)
+    {
+        if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
+        {
+            AnimInstance->Montage_Play(FreezeSpellMontage, 1.0f);
+        }
+    }
+}
+
 void AWukongCharacter::PlayMontage(UAnimMontage* MontageToPlay, FName SectionName)
 {
     if (UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance())
@@ -1610,7 +1682,7 @@ void AWukongCharacter::PlayMontage(UAnimMontage* MontageToPlay, FName SectionNam
             {
                 AnimInstance->Montage_JumpToSection(SectionName, MontageToPlay);
             }
-            UE_LOG(LogTemp, Log, TEXT("PlayMontage: Playing %s, Duration=%f"), *MontageToPlay->GetName(), Duration);
+            UE_LOG(LogBMCombat, Verbose, TEXT("PlayMontage: Playing %s, Duration=%f"), *MontageToPlay->GetName(), Duration);
         }
     }
 }
@@ -1639,21 +1711,20 @@ void AWukongCharacter::UpdateDodgeMovement(float DeltaTime)
 }
 
 // Cooldown Management
-bool AWukongCharacter::IsCooldownActive(const FString& CooldownName) const
+bool AWukongCharacter::IsCooldownActive(EWukongCooldown Cooldown) const
 {
-    const float* CooldownTime = CooldownMap.Find(CooldownName);
-    return (CooldownTime != nullptr && *CooldownTime > 0.0f);
+    return GetWorld()->GetTimeSeconds() < CooldownEndTimes[static_cast<int32>(Cooldown)];
 }
 
 float AWukongCharacter::GetTransformCooldownRemaining() const
 {
-    const float* CooldownTime = CooldownMap.Find(TEXT("Transform"));
-    return (CooldownTime != nullptr) ? *CooldownTime : 0.0f;
+    const double Remaining = CooldownEndTimes[static_cast<int32>(EWukongCooldown::Transform)] - GetWorld()->GetTimeSeconds();
+    return static_cast<float>(FMath::Max(Remaining, 0.0));
 }
 
-void AWukongCharacter::StartCooldown(const FString& CooldownName, float Duration)
+void AWukongCharacter::StartCooldown(EWukongCooldown Cooldown, float Duration)
 {
-    CooldownMap.Add(CooldownName, Duration);
+    CooldownEndTimes[static_cast<int32>(Cooldown)] = GetWorld()->GetTimeSeconds() + Duration;
 
     // 通知 HUD 更新技能冷却显示
     if (PlayerHUD)
@@ -1663,38 +1734,21 @@ void AWukongCharacter::StartCooldown(const FString& CooldownName, float Duration
         // 槽位1: 定身术 (按键2)
         // 槽位2: 变身术 (按键3)
         // 槽位3: 安息术 (按键4)
-        if (CooldownName == TEXT("ShadowClone"))
+        switch (Cooldown)
         {
+        case EWukongCooldown::ShadowClone:
             PlayerHUD->TriggerSkillCooldown(0, Duration);
-        }
-        else if (CooldownName == TEXT("FreezeSpell"))
-        {
+            break;
+        case EWukongCooldown::FreezeSpell:
             PlayerHUD->TriggerSkillCooldown(1, Duration);
-        }
-        else if (CooldownName == TEXT("Transform"))
-        {
+            break;
+        case EWukongCooldown::Transform:
             PlayerHUD->TriggerSkillCooldown(2, Duration);
+            break;
+        default:
+            // 可以继续添加更多技能映射
+            break;
         }
-        // 可以继续添加更多技能映射
-    }
-}
-
-void AWukongCharacter::UpdateCooldowns(float DeltaTime)
-{
-    TArray<FString> ExpiredCooldowns;
-
-    for (auto& Cooldown : CooldownMap)
-    {
-        Cooldown.Value -= DeltaTime;
-        if (Cooldown.Value <= 0.0f)
-        {
-            ExpiredCooldowns.Add(Cooldown.Key);
-        }
-    }
-
-    for (const FString& CooldownName : ExpiredCooldowns)
-    {
-        CooldownMap.Remove(CooldownName);
     }
 }
 
@@ -1756,7 +1810,7 @@ void AWukongCharacter::OnDamageDealtToEnemy(float Damage, AActor* Target, bool b
         );
     }
 
-    UE_LOG(LogTemp, Log, TEXT("OnDamageDealtToEnemy: Hit %s for %.1f damage, Combo: %d"),
+    UE_LOG(LogBMCombat, Verbose, TEXT("OnDamageDealtToEnemy: Hit %s for %.1f damage, Combo: %d"),
         Target ? *Target->GetName() : TEXT("None"), Damage, HitComboCount);
 }
 
@@ -1845,7 +1899,7 @@ void AWukongCharacter::OnJumped_Implementation()
     if (StaminaComponent)
     {
         StaminaComponent->ConsumeStamina(StaminaComponent->JumpStaminaCost);
-        UE_LOG(LogTemp, Log, TEXT("OnJumped: Consumed %f stamina, remaining=%f"), 
+        UE_LOG(LogTemp, Verbose, TEXT("OnJumped: Consumed %f stamina, remaining=%f"), 
             StaminaComponent->JumpStaminaCost, StaminaComponent->GetCurrentStamina());
     }
 
@@ -2102,7 +2156,7 @@ float AWukongCharacter::PlayAnimationAsMontageDynamic(UAnimSequence* AnimSequenc
 {
     if (!AnimSequence)
     {
-        UE_LOG(LogTemp, Warning, TEXT("PlayAnimationAsMontageDynamic: AnimSequence is null"));
+        UE_LOG(LogBMCombat, Warning, TEXT("PlayAnimationAsMontageDynamic: AnimSequence is null"));
         return 0.0f;
     }
 
@@ -2153,14 +2207,14 @@ float AWukongCharacter::PlayAnimationAsMontageDynamic(UAnimSequence* AnimSequenc
 
         if (Duration > 0.0f)
         {
-            UE_LOG(LogTemp, Log, TEXT("Playing dynamic montage: %s in slot %s, duration: %.2f"),
+            UE_LOG(LogBMCombat, Verbose, TEXT("Playing dynamic montage: %s in slot %s, duration: %.2f"),
                 *AnimSequence->GetName(), *CandidateSlot.ToString(), Duration);
             return Duration;
         }
     }
 
     // 如果所有候选 Slot 都失败，记录警告
-    UE_LOG(LogTemp, Warning, TEXT("PlayAnimationAsMontageDynamic: Failed to create/play montage for %s (tried slots)."), *AnimSequence->GetName());
+    UE_LOG(LogBMCombat, Warning, TEXT("PlayAnimationAsMontageDynamic: Failed to create/play montage for %s (tried slots)."), *AnimSequence->GetName());
     return 0.0f;
 }
 
@@ -2168,7 +2222,7 @@ float AWukongCharacter::PlayAnimationAsMontageDynamic(UAnimSequence* AnimSequenc
 
 void AWukongCharacter::OnAbilityPressed()
 {
-    UE_LOG(LogTemp, Warning, TEXT("OnAbilityPressed() called! CurrentState=%d"), (int32)CurrentState);
+    UE_LOG(LogBMCombat, Verbose, TEXT("OnAbilityPressed() called! CurrentState=%d"), (int32)CurrentState);
 
     // 检查状态 - 翻滚、硬直、死亡、使用技能时不能释放战技
     if (CurrentState == EWukongState::Dodging || 
@@ -2176,24 +2230,24 @@ void AWukongCharacter::OnAbilityPressed()
         CurrentState == EWukongState::Dead ||
         CurrentState == EWukongState::UsingAbility)
     {
-        UE_LOG(LogTemp, Warning, TEXT("OnAbilityPressed() blocked by state"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("OnAbilityPressed() blocked by state"));
         return;
     }
 
     // 检查战技冷却
-    if (IsCooldownActive(TEXT("Ability")))
+    if (IsCooldownActive(EWukongCooldown::Ability))
     {
-        UE_LOG(LogTemp, Warning, TEXT("OnAbilityPressed() blocked by cooldown"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("OnAbilityPressed() blocked by cooldown"));
         return;
     }
 
-    UE_LOG(LogTemp, Warning, TEXT("OnAbilityPressed() -> calling PerformAbility()"));
+    UE_LOG(LogBMCombat, Verbose, TEXT("OnAbilityPressed() -> calling PerformAbility()"));
     PerformAbility();
 }
 
 void AWukongCharacter::PerformAbility()
 {
-    UE_LOG(LogTemp, Log, TEXT("PerformAbility() called"));
+    UE_LOG(LogBMCombat, Verbose, TEXT("PerformAbility() called"));
 
     // 切换到使用战技状态
     ChangeState(EWukongState::UsingAbility);
@@ -2249,7 +2303,19 @@ void AWukongCharacter::UpdateAbilityState(float DeltaTime)
         bIsInvincible = false;
         
         // 在战技结束时造成 AOE 伤害（可选）
-        // TODO: 实现 AOE 伤害检测
+        if (bAbilityDealsAOE && AbilityDamage > 0.0f)
+        {
+            if (UAreaEffectSubsystem* AreaEffects = UAreaEffectSubsystem::Get(this))
+            {
+                FAreaEffectRequest Request;
+                Request.Instigator = this;
+                Request.Center = GetActorLocation();
+                Request.Radius = AbilityRadius;
+                Request.TeamMask = SpatialGrid::TeamBit(ETeam::Enemy);
+                Request.Damage = AbilityDamage;
+                AreaEffects->Apply(Request);
+            }
+        }
         
         // 根据是否有移动输入决定切换到什么状态
         FVector InputDirection = GetMovementInputDirection();
@@ -2267,7 +2333,7 @@ void AWukongCharacter::UpdateAbilityState(float DeltaTime)
 
 void AWukongCharacter::OnLockOnPressed()
 {
-    UE_LOG(LogTemp, Log, TEXT("OnLockOnPressed() called"));
+    UE_LOG(LogBMCombat, Verbose, TEXT("OnLockOnPressed() called"));
     
     if (TargetingComponent)
     {
@@ -2289,7 +2355,7 @@ void AWukongCharacter::OnSwitchTarget(const FInputActionValue& Value)
     {
         bool bSwitchRight = ScrollValue > 0.0f;
         TargetingComponent->SwitchTarget(bSwitchRight);
-        UE_LOG(LogTemp, Log, TEXT("SwitchTarget: %s"), bSwitchRight ? TEXT("Right") : TEXT("Left"));
+        UE_LOG(LogBMCombat, Verbose, TEXT("SwitchTarget: %s"), bSwitchRight ? TEXT("Right") : TEXT("Left"));
     }
 }
 
@@ -2339,69 +2405,47 @@ void AWukongCharacter::UpdateFacingTarget(float DeltaTime)
 
 void AWukongCharacter::CheckForNearbyNPC()
 {
-	// 使用OverlapMultiByObjectType检测所有Actor（避免碰撞通道问题）
-	TArray<FOverlapResult> OverlapResults;
-	FVector StartLocation = GetActorLocation();
-	FCollisionShape Sphere = FCollisionShape::MakeSphere(InteractionDistance);
-	
-	FCollisionQueryParams QueryParams;
-	QueryParams.AddIgnoredActor(this);
-	
-	// 使用WorldDynamic通道检测所有动态物体
-	FCollisionObjectQueryParams ObjectQueryParams;
-	ObjectQueryParams.AddObjectTypesToQuery(ECC_WorldDynamic);
-	ObjectQueryParams.AddObjectTypesToQuery(ECC_Pawn);
-	
-	bool bHit = GetWorld()->OverlapMultiByObjectType(
-		OverlapResults,
-		StartLocation,
-		FQuat::Identity,
-		ObjectQueryParams,
-		Sphere,
-		QueryParams
-	);
-
+	// 从空间网格中查询交互范围内的中立单位（NPC 以中立阵营注册），不再做物理重叠检测
+	const FVector StartLocation = GetActorLocation();
 	ANPCCharacter* ClosestNPC = nullptr;
-	float ClosestDistance = InteractionDistance;
 
-	if (bHit)
+	if (USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this))
 	{
-		UE_LOG(LogTemp, Verbose, TEXT("[Interaction] Found %d overlapping actors"), OverlapResults.Num());
-		
-		for (const FOverlapResult& Overlap : OverlapResults)
-		{
-			if (ANPCCharacter* NPC = Cast<ANPCCharacter>(Overlap.GetActor()))
+		ClosestNPC = Cast<ANPCCharacter>(Grid->FindNearest(
+			StartLocation,
+			InteractionDistance,
+			SpatialGrid::TeamBit(ETeam::Neutral),
+			[](AActor* Candidate)
 			{
-				// 只在Verbose级别输出,避免刷屏
-				UE_LOG(LogTemp, Verbose, TEXT("[Interaction] Checking NPC: %s, CanInteract: %d"), 
-					*NPC->GetName(), NPC->CanBeInteractedWith());
-				
-				if (NPC->CanBeInteractedWith())
-				{
-					float Distance = FVector::Dist(StartLocation, NPC->GetActorLocation());
-					if (Distance < ClosestDistance)
-					{
-						ClosestNPC = NPC;
-						ClosestDistance = Distance;
-					}
-				}
-			}
-		}
+				const ANPCCharacter* NPC = Cast<ANPCCharacter>(Candidate);
+				return NPC && NPC->CanBeInteractedWith();
+			}));
 	}
 
 	// 更新当前NPC
 	if (ClosestNPC != NearbyNPC)
 	{
+		// 离开的 NPC 释放预取的对话资源，新进入范围的 NPC 开始预取前几句
+		if (NearbyNPC && NearbyNPC->DialogueComponent)
+		{
+			NearbyNPC->DialogueComponent->ReleasePrefetchedDialogue();
+		}
+
 		NearbyNPC = ClosestNPC;
 		
+		if (NearbyNPC && NearbyNPC->DialogueComponent)
+		{
+			NearbyNPC->DialogueComponent->PrefetchDialogue();
+		}
+
 		if (NearbyNPC)
 		{
-			UE_LOG(LogTemp, Log, TEXT("[Interaction] NPC in range: %s"), *NearbyNPC->GetName());
+			UE_LOG(LogBMDialogue, Verbose, TEXT("[Interaction] NPC in range: %s"), *NearbyNPC->GetName());
 			ShowInteractionPrompt();
 		}
 		else
 		{
-			UE_LOG(LogTemp, Log, TEXT("[Interaction] NPC out of range"));
+			UE_LOG(LogBMDialogue, Verbose, TEXT("[Interaction] NPC out of range"));
 			HideInteractionPrompt();
 		}
 	}
@@ -2419,24 +2463,24 @@ void AWukongCharacter::ShowInteractionPrompt()
 				if (InteractionPromptWidget)
 				{
 					InteractionPromptWidget->AddToViewport(100); // 高优先级
-					UE_LOG(LogTemp, Log, TEXT("[Interaction] Created InteractionPromptWidget"));
+					UE_LOG(LogBMDialogue, Verbose, TEXT("[Interaction] Created InteractionPromptWidget"));
 				}
 				else
 				{
-					UE_LOG(LogTemp, Error, TEXT("[Interaction] Failed to create InteractionPromptWidget!"));
+					UE_LOG(LogBMDialogue, Error, TEXT("[Interaction] Failed to create InteractionPromptWidget!"));
 				}
 			}
 		}
 		else
 		{
-			UE_LOG(LogTemp, Error, TEXT("[Interaction] InteractionPromptWidgetClass is NULL! Set it in BP_Wukong!"));
+			UE_LOG(LogBMDialogue, Error, TEXT("[Interaction] InteractionPromptWidgetClass is NULL! Set it in BP_Wukong!"));
 		}
 	}
 
 	if (InteractionPromptWidget)
 	{
 		InteractionPromptWidget->ShowPrompt(FText::FromString(TEXT("按 [E] 对话")));
-		UE_LOG(LogTemp, Log, TEXT("[Interaction] Showing prompt"));
+		UE_LOG(LogBMDialogue, Verbose, TEXT("[Interaction] Showing prompt"));
 	}
 }
 
@@ -2458,7 +2502,7 @@ void AWukongCharacter::SetNearbyGold(AGoldPickup* Gold)
 		if (!NearbyGolds.Contains(Gold))
 		{
 			NearbyGolds.Add(Gold);
-			UE_LOG(LogTemp, Log, TEXT("[Pickup] Added gold to list, total: %d"), NearbyGolds.Num());
+			UE_LOG(LogTemp, Verbose, TEXT("[Pickup] Added gold to list, total: %d"), NearbyGolds.Num());
 		}
 
 		// 确保交互提示Widget已创建
@@ -2479,7 +2523,7 @@ void AWukongCharacter::SetNearbyGold(AGoldPickup* Gold)
 		{
 			FString PromptText = FString::Printf(TEXT("按 [F] 拾取 (%d)"), NearbyGolds.Num());
 			InteractionPromptWidget->ShowPrompt(FText::FromString(PromptText));
-			UE_LOG(LogTemp, Log, TEXT("[Pickup] Showing pickup prompt: %s"), *PromptText);
+			UE_LOG(LogTemp, Verbose, TEXT("[Pickup] Showing pickup prompt: %s"), *PromptText);
 		}
 	}
 	else
@@ -2489,26 +2533,26 @@ void AWukongCharacter::SetNearbyGold(AGoldPickup* Gold)
 		if (NearbyGolds.Num() == 0 && !NearbyNPC && InteractionPromptWidget)
 		{
 			InteractionPromptWidget->HidePrompt();
-			UE_LOG(LogTemp, Log, TEXT("[Pickup] Hiding pickup prompt"));
+			UE_LOG(LogTemp, Verbose, TEXT("[Pickup] Hiding pickup prompt"));
 		}
 	}
 }
 
 void AWukongCharacter::TryPickup()
 {
-	UE_LOG(LogTemp, Log, TEXT("[Pickup] TryPickup called, NearbyGolds count: %d"), NearbyGolds.Num());
+	UE_LOG(LogTemp, Verbose, TEXT("[Pickup] TryPickup called, NearbyGolds count: %d"), NearbyGolds.Num());
 
 	// 对话中不能拾取
 	if (bIsInDialogue)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[Pickup] Blocked - in dialogue"));
+		UE_LOG(LogTemp, Verbose, TEXT("[Pickup] Blocked - in dialogue"));
 		return;
 	}
 
 	// 拾取所有附近的金币
 	if (NearbyGolds.Num() > 0)
 	{
-		UE_LOG(LogTemp, Log, TEXT("[Pickup] Picking up %d golds"), NearbyGolds.Num());
+		UE_LOG(LogTemp, Verbose, TEXT("[Pickup] Picking up %d golds"), NearbyGolds.Num());
 
 		// 遍历所有金币并开始吸附
 		for (AGoldPickup* Gold : NearbyGolds)
@@ -2532,14 +2576,14 @@ void AWukongCharacter::TryPickup()
 
 void AWukongCharacter::OnInteract()
 {
-	UE_LOG(LogTemp, Log, TEXT("[Interaction] OnInteract called, ActiveDialogue: %s, NearbyNPC: %s"), 
+	UE_LOG(LogBMDialogue, Verbose, TEXT("[Interaction] OnInteract called, ActiveDialogue: %s, NearbyNPC: %s"), 
 		ActiveDialogueComponent ? *ActiveDialogueComponent->GetName() : TEXT("NULL"),
 		NearbyNPC ? *NearbyNPC->GetName() : TEXT("NULL"));
 	
 	// 1. 优先处理正在进行的对话 (解决 Boss 过场动画点击继续失败的问题)
 	if (ActiveDialogueComponent && ActiveDialogueComponent->IsDialoguePlaying())
 	{
-		UE_LOG(LogTemp, Log, TEXT("[Interaction] Active dialogue in progress, calling NextDialogue"));
+		UE_LOG(LogBMDialogue, Verbose, TEXT("[Interaction] Active dialogue in progress, calling NextDialogue"));
 		ActiveDialogueComponent->NextDialogue();
 		return;
 	}
@@ -2550,19 +2594,19 @@ void AWukongCharacter::OnInteract()
 		// 再次检查 NPC 的对话组件（双重保障）
 		if (NearbyNPC->DialogueComponent && NearbyNPC->DialogueComponent->IsDialoguePlaying())
 		{
-			UE_LOG(LogTemp, Log, TEXT("[Interaction] NPC Dialogue in progress, calling NextDialogue"));
+			UE_LOG(LogBMDialogue, Verbose, TEXT("[Interaction] NPC Dialogue in progress, calling NextDialogue"));
 			NearbyNPC->DialogueComponent->NextDialogue();
 		}
 		else
 		{
-			UE_LOG(LogTemp, Log, TEXT("[Interaction] Starting new NPC dialogue"));
+			UE_LOG(LogBMDialogue, Verbose, TEXT("[Interaction] Starting new NPC dialogue"));
 			HideInteractionPrompt();
 			NearbyNPC->StartDialogue();
 		}
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[Interaction] No active dialogue or nearby NPC!"));
+		UE_LOG(LogBMDialogue, Verbose, TEXT("[Interaction] No active dialogue or nearby NPC!"));
 	}
 }
 
@@ -2605,7 +2649,7 @@ void AWukongCharacter::PlayJumpSound()
 
 void AWukongCharacter::PerformTransform()
 {
-	UE_LOG(LogTemp, Warning, TEXT(">>> PerformTransform() CALLED! bIsTransformed=%d"), bIsTransformed);
+	UE_LOG(LogBMCombat, Verbose, TEXT(">>> PerformTransform() CALLED! bIsTransformed=%d"), bIsTransformed);
 
 	// 背包打开时，使用槽位 2（怒火丹）
 	if (bIsInventoryOpen)
@@ -2620,14 +2664,14 @@ void AWukongCharacter::PerformTransform()
 	// 如果已经变身了，不能再次变身
 	if (bIsTransformed)
 	{
-		UE_LOG(LogTemp, Log, TEXT("PerformTransform: Already transformed"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("PerformTransform: Already transformed"));
 		return;
 	}
 
 	// 检查冷却（使用统一的冷却系统）
-	if (IsCooldownActive(TEXT("Transform")))
+	if (IsCooldownActive(EWukongCooldown::Transform))
 	{
-		UE_LOG(LogTemp, Log, TEXT("PerformTransform: On cooldown"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("PerformTransform: On cooldown"));
 		return;
 	}
 
@@ -2637,14 +2681,14 @@ void AWukongCharacter::PerformTransform()
 		CurrentState == EWukongState::HitStun ||
 		CurrentState == EWukongState::Attacking)
 	{
-		UE_LOG(LogTemp, Log, TEXT("PerformTransform: Blocked by state"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("PerformTransform: Blocked by state"));
 		return;
 	}
 
 	// 对话中不能变身
 	if (bIsInDialogue)
 	{
-		UE_LOG(LogTemp, Log, TEXT("PerformTransform: Blocked by dialogue"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("PerformTransform: Blocked by dialogue"));
 		return;
 	}
 
@@ -2656,7 +2700,7 @@ void AWukongCharacter::PerformTransform()
 
 void AWukongCharacter::PerformSkill4()
 {
-	UE_LOG(LogTemp, Warning, TEXT(">>> PerformSkill4() CALLED - Resting Skill!"));
+	UE_LOG(LogBMCombat, Verbose, TEXT(">>> PerformSkill4() CALLED - Resting Skill!"));
 
 	// 背包打开时，使用槽位 3（金刚丹 - 防御Buff）
 	if (bIsInventoryOpen)
@@ -2674,35 +2718,35 @@ void AWukongCharacter::PerformSkill4()
 		CurrentState == EWukongState::HitStun ||
 		bIsInDialogue)
 	{
-		UE_LOG(LogTemp, Log, TEXT("PerformSkill4: Blocked by state"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("PerformSkill4: Blocked by state"));
 		return;
 	}
 
 	// 检查冷却
-	if (IsCooldownActive(TEXT("RestingSkill")))
+	if (IsCooldownActive(EWukongCooldown::RestingSkill))
 	{
-		UE_LOG(LogTemp, Log, TEXT("PerformSkill4: On cooldown"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("PerformSkill4: On cooldown"));
 		return;
 	}
 
 	// 检查是否设置了屏障类
 	if (!RestingBarrierClass)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PerformSkill4: RestingBarrierClass not set! Set it in BP_Wukong blueprint."));
+		UE_LOG(LogBMCombat, Warning, TEXT("PerformSkill4: RestingBarrierClass not set! Set it in BP_Wukong blueprint."));
 		return;
 	}
 
 	// 检查是否设置了动画
 	if (!RestingSkillMontage)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("PerformSkill4: RestingSkillMontage not set! Please assign animation in blueprint."));
+		UE_LOG(LogBMCombat, Warning, TEXT("PerformSkill4: RestingSkillMontage not set! Please assign animation in blueprint."));
 		return;
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("PerformSkill4: Casting Resting Skill - Playing animation"));
+	UE_LOG(LogBMCombat, Verbose, TEXT("PerformSkill4: Casting Resting Skill - Playing animation"));
 
 	// 开始冷却（接入UI系统 - 槽位3）
-	StartCooldown(TEXT("RestingSkill"), RestingSkillCooldown);
+	StartCooldown(EWukongCooldown::RestingSkill, RestingSkillCooldown);
 	
 	// 触发UI冷却显示
 	if (PlayerHUD)
@@ -2716,26 +2760,26 @@ void AWukongCharacter::PerformSkill4()
 
 void AWukongCharacter::TransformToButterfly()
 {
-	UE_LOG(LogTemp, Warning, TEXT(">>> TransformToButterfly() - Starting transformation!"));
+	UE_LOG(LogBMCombat, Verbose, TEXT(">>> TransformToButterfly() - Starting transformation!"));
 
 	// 解除锁定状态（变身后不应该保持锁定）
 	if (TargetingComponent && TargetingComponent->IsTargeting())
 	{
 		TargetingComponent->ClearTarget();
-		UE_LOG(LogTemp, Log, TEXT("TransformToButterfly: Cleared target lock"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("TransformToButterfly: Cleared target lock"));
 	}
 
 	// 检查蝴蝶Pawn类是否配置
 	if (!ButterflyPawnClass)
 	{
-		UE_LOG(LogTemp, Error, TEXT("TransformToButterfly: ButterflyPawnClass is NULL! Set it in BP_Wukong."));
+		UE_LOG(LogBMCombat, Error, TEXT("TransformToButterfly: ButterflyPawnClass is NULL! Set it in BP_Wukong."));
 		return;
 	}
 
 	APlayerController* PC = Cast<APlayerController>(GetController());
 	if (!PC)
 	{
-		UE_LOG(LogTemp, Error, TEXT("TransformToButterfly: No PlayerController!"));
+		UE_LOG(LogBMCombat, Error, TEXT("TransformToButterfly: No PlayerController!"));
 		return;
 	}
 
@@ -2756,7 +2800,7 @@ void AWukongCharacter::TransformToButterfly()
 
 	if (!ButterflyPawnInstance)
 	{
-		UE_LOG(LogTemp, Error, TEXT("TransformToButterfly: Failed to spawn butterfly!"));
+		UE_LOG(LogBMCombat, Error, TEXT("TransformToButterfly: Failed to spawn butterfly!"));
 		return;
 	}
 
@@ -2790,19 +2834,19 @@ void AWukongCharacter::TransformToButterfly()
 	if (AButterflyPawn* ButterflyPawn = Cast<AButterflyPawn>(ButterflyPawnInstance))
 	{
 		ButterflyPawn->InitializeTransform(this, TransformDuration);
-		UE_LOG(LogTemp, Log, TEXT("TransformToButterfly: Initialized butterfly timer with duration=%.1f"), TransformDuration);
+		UE_LOG(LogBMCombat, Verbose, TEXT("TransformToButterfly: Initialized butterfly timer with duration=%.1f"), TransformDuration);
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("TransformToButterfly: SUCCESS! Duration=%.1f seconds"), TransformDuration);
+	UE_LOG(LogBMCombat, Log, TEXT("TransformToButterfly: SUCCESS! Duration=%.1f seconds"), TransformDuration);
 }
 
 void AWukongCharacter::TransformBackToWukong()
 {
-	UE_LOG(LogTemp, Warning, TEXT(">>> TransformBackToWukong() - Reverting transformation!"));
+	UE_LOG(LogBMCombat, Verbose, TEXT(">>> TransformBackToWukong() - Reverting transformation!"));
 
 	if (!bIsTransformed)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("TransformBackToWukong: Not transformed, skipping"));
+		UE_LOG(LogBMCombat, Verbose, TEXT("TransformBackToWukong: Not transformed, skipping"));
 		return;
 	}
 
@@ -2822,7 +2866,7 @@ void AWukongCharacter::TransformBackToWukong()
 
 	if (!PC)
 	{
-		UE_LOG(LogTemp, Error, TEXT("TransformBackToWukong: No PlayerController found!"));
+		UE_LOG(LogBMCombat, Error, TEXT("TransformBackToWukong: No PlayerController found!"));
 		return;
 	}
 
@@ -2839,7 +2883,7 @@ void AWukongCharacter::TransformBackToWukong()
 		FinalRotation.Pitch = 0.0f;
 		FinalRotation.Roll = 0.0f;
 		
-		UE_LOG(LogTemp, Warning, TEXT("TransformBackToWukong: Wukong location after detach: X=%.1f, Y=%.1f, Z=%.1f"),
+		UE_LOG(LogBMCombat, Verbose, TEXT("TransformBackToWukong: Wukong location after detach: X=%.1f, Y=%.1f, Z=%.1f"),
 			CurrentLocation.X, CurrentLocation.Y, CurrentLocation.Z);
 		
 		// 销毁蝴蝶
@@ -2868,7 +2912,7 @@ void AWukongCharacter::TransformBackToWukong()
 	ChangeState(EWukongState::Idle);
 
 	// 启动冷却（同时触发UI更新）
-	StartCooldown(TEXT("Transform"), TransformCooldown);
+	StartCooldown(EWukongCooldown::Transform, TransformCooldown);
 
 	// 清除计时器
 	if (GetWorld())
@@ -2876,12 +2920,12 @@ void AWukongCharacter::TransformBackToWukong()
 		GetWorld()->GetTimerManager().ClearTimer(TransformTimerHandle);
 	}
 
-	UE_LOG(LogTemp, Warning, TEXT("TransformBackToWukong: SUCCESS! Cooldown=%.1f seconds"), TransformCooldown);
+	UE_LOG(LogBMCombat, Log, TEXT("TransformBackToWukong: SUCCESS! Cooldown=%.1f seconds"), TransformCooldown);
 }
 
 void AWukongCharacter::OnTransformDurationEnd()
 {
-	UE_LOG(LogTemp, Warning, TEXT(">>> OnTransformDurationEnd() - Transform duration expired!"));
+	UE_LOG(LogBMCombat, Verbose, TEXT(">>> OnTransformDurationEnd() - Transform duration expired!"));
 	TransformBackToWukong();
 }
 // ========== 对话系统 ==========
@@ -2894,14 +2938,14 @@ void AWukongCharacter::SetInDialogue(bool bInDialogue)
 	{
 		// 记录当前对话的NPC
 		CurrentDialogueNPC = NearbyNPC;
-		UE_LOG(LogTemp, Log, TEXT("[Dialogue] Entered dialogue mode with %s"), 
+		UE_LOG(LogBMDialogue, Verbose, TEXT("[Dialogue] Entered dialogue mode with %s"), 
 			CurrentDialogueNPC ? *CurrentDialogueNPC->GetName() : TEXT("NULL"));
 	}
 	else
 	{
 		// 对话结束，清空记录
 		CurrentDialogueNPC = nullptr;
-		UE_LOG(LogTemp, Log, TEXT("[Dialogue] Exited dialogue mode"));
+		UE_LOG(LogBMDialogue, Verbose, TEXT("[Dialogue] Exited dialogue mode"));
 	}
 }
 
@@ -2919,7 +2963,7 @@ void AWukongCharacter::CheckDialogueDistance()
 	// 超过阈值，自动结束对话
 	if (Distance > DialogueBreakDistance)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[Dialogue] Distance %.1f > %.1f, auto-ending dialogue"), 
+		UE_LOG(LogBMDialogue, Log, TEXT("[Dialogue] Distance %.1f > %.1f, auto-ending dialogue"), 
 			Distance, DialogueBreakDistance);
 		
 		// 调用NPC的DialogueComponent结束对话
@@ -2937,18 +2981,21 @@ void AWukongCharacter::CheckDialogueDistance()
 void AWukongCharacter::ClearAllEnemyAggro()
 {
 	// 获取所有敌人并清除他们的仇恨
-	TArray<AActor*> FoundEnemies;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AEnemyBase::StaticClass(), FoundEnemies);
+	UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this);
+	if (!Registry)
+	{
+		return;
+	}
 
-	for (AActor* Actor : FoundEnemies)
+	for (AEnemyBase* Enemy : Registry->GetEnemies())
 	{
-		if (AEnemyBase* Enemy = Cast<AEnemyBase>(Actor))
+		if (Enemy)
 		{
 			Enemy->ClearCombatTarget();
 		}
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[Transform] Cleared aggro from %d enemies"), FoundEnemies.Num());
+	UE_LOG(LogBMCombat, Verbose, TEXT("[Transform] Cleared aggro from %d enemies"), Registry->GetNumEnemies());
 }
 
 void AWukongCharacter::EnforceCameraMinDistance()
@@ -3041,13 +3088,10 @@ void AWukongCharacter::FullRestore()
 // ========== 土地庙传送系统 ==========
 void AWukongCharacter::TeleportToTemple(FName TempleID)
 {
-    for (TActorIterator<AInteractableActor> It(GetWorld()); It; ++It)
+    UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this);
+    if (AInteractableActor* Temple = Registry ? Registry->FindTempleByID(TempleID) : nullptr)
     {
-        if (It->TempleID == TempleID)
-        {
-            SetActorLocation(It->TeleportPoint->GetComponentLocation());
-            SetActorRotation(It->TeleportPoint->GetComponentRotation());
-            return;
-        }
+        SetActorLocation(Temple->TeleportPoint->GetComponentLocation());
+        SetActorRotation(Temple->TeleportPoint->GetComponentRotation());
     }
 }
\ No newline at end of file
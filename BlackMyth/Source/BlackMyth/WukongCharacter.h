@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "BlackMythCharacter.h"
+#include "Components/TeamMemberInterface.h"
+#include "Combat/CombatActorInterface.h"
 #include "WukongCharacter.generated.h"
 
 class UInputAction;
@@ -39,9 +41,103 @@ enum class EWukongState : uint8
 	Dead          // 死亡
 };
 
+// 带冷却的技能（冷却表下标）
+enum class EWukongCooldown : uint8
+{
+	Dodge,        // 翻滚
+	Ability,      // 战技
+	ShadowClone,  // 分身术
+	FreezeSpell,  // 定身术
+	Transform,    // 变身术
+	RestingSkill, // 安息术
+
+	Num
+};
+
+// 可缓冲的输入
+enum class EWukongBufferedInput : uint8
+{
+	Attack
+};
+
+/**
+ * 连击输入缓冲：定长环形队列，每条输入记录按下时的游戏时间（之后不再改写），
+ * 早于 GetMinPressTime 的输入在查看时丢弃；写满时覆盖最旧的输入
+ */
+struct FWukongInputBuffer
+{
+	static constexpr int32 Capacity = 4;
+
+	struct FEntry
+	{
+		EWukongBufferedInput Type = EWukongBufferedInput::Attack;
+		double Time = 0.0;
+	};
+
+	void Push(EWukongBufferedInput Type, double Time)
+	{
+		if (Count == Capacity)
+		{
+			Head = (Head + 1) % Capacity;
+			--Count;
+		}
+		Entries[(Head + Count) % Capacity] = { Type, Time };
+		++Count;
+	}
+
+	/**
+	 * 查看最早的一条未过期输入，不取出（MinTime 之前按下的视为过期并丢弃）
+	 * 输入暂时不能执行时留在缓冲中，按下时间保持不变，到期后自然丢弃
+	 */
+	bool PeekFresh(double MinTime, EWukongBufferedInput& OutType)
+	{
+		while (Count > 0)
+		{
+			const FEntry& Entry = Entries[Head];
+			if (Entry.Time >= MinTime)
+			{
+				OutType = Entry.Type;
+				return true;
+			}
+
+			Head = (Head + 1) % Capacity;
+			--Count;
+		}
+		return false;
+	}
+
+	/** 移除最早的一条输入（PeekFresh 返回的那条） */
+	void Pop()
+	{
+		if (Count > 0)
+		{
+			Head = (Head + 1) % Capacity;
+			--Count;
+		}
+	}
+
+	/**
+	 * 最早有效的按下时间
+	 * 容错时间从连招窗口打开时算起：窗口打开前 Tolerance 秒内按下的输入有效，
+	 * 窗口打开后按下的输入在被执行前一直有效。不在攻击中时 WindowOpenTime 传当前时间。
+	 */
+	static double GetMinPressTime(double Now, double WindowOpenTime, double Tolerance)
+	{
+		return FMath::Min(Now, WindowOpenTime) - Tolerance;
+	}
+
+	void Reset() { Head = 0; Count = 0; }
+	bool IsEmpty() const { return Count == 0; }
+
+private:
+	FEntry Entries[Capacity];
+	int32 Head = 0;
+	int32 Count = 0;
+};
+
 
 UCLASS()
-class BLACKMYTH_API AWukongCharacter : public ABlackMythCharacter
+class BLACKMYTH_API AWukongCharacter : public ABlackMythCharacter, public ITeamMember, public ICombatActor
 {
 	GENERATED_BODY()
 
@@ -109,6 +205,9 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Targeting")
 	UTargetingComponent* GetTargetingComponent() const { return TargetingComponent; }
 
+	/** 获取分身类 */
+	TSubclassOf<class AWukongClone> GetCloneClass() const { return CloneClass; }
+
 	/** 设置 HUD Widget 引用 */
 	UFUNCTION(BlueprintCallable, Category = "UI")
 	void SetPlayerHUD(UPlayerHUDWidget* InHUD) { PlayerHUD = InHUD; }
@@ -197,6 +296,19 @@ public:
 	UFUNCTION(BlueprintPure, Category = "RestingSkill")
 	float GetRestingBarrierDuration() const { return RestingBarrierDuration; }
 
+#if !UE_BUILD_SHIPPING
+	// ========== 自动化测试 ==========
+
+	/** 以按下攻击键的方式出招（基准测试脚本使用） */
+	void DebugAttack() { Attack(); }
+
+	/** 释放定身术（基准测试脚本使用） */
+	void DebugCastFreezeSpell() { PerformFreezeSpell(); }
+
+	/** 释放影分身（基准测试脚本使用） */
+	void DebugCastShadowClone() { PerformShadowClone(); }
+#endif
+
 protected:
 	// ========== 输入动作 ==========
 	
@@ -499,6 +611,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
 	float AbilityRadius = 300.0f;
 
+	/** 战技结束时是否对 AbilityRadius 内的敌人造成 AbilityDamage */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ability")
+	bool bAbilityDealsAOE = false;
+
 	// ========== 影分身配置 ==========
 
 	/** 分身类（在蓝图中设置为 BP_WukongClone） */
@@ -535,6 +651,10 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FreezeSpell")
 	float FreezeSpellCooldown = 15.0f;
 
+	/** 定身术范围（0 = 只定身锁定目标；大于 0 时定身周围所有未被定身的敌人，无需锁定） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "FreezeSpell", meta = (ClampMin = "0.0"))
+	float FreezeSpellRadius = 0.0f;
+
 	/** 定身术施放动画蒙太奇（可选） */
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "FreezeSpell")
 	TObjectPtr<UAnimMontage> FreezeSpellMontage;
@@ -583,15 +703,18 @@ private:
 	bool bIsDodging = false;             // 是否正在翻滚
 	float DodgeTimer = 0.0f;             // 翻滚计时器
 	FVector DodgeDirection;              // 翻滚方向
-	TMap<FString, float> CooldownMap;    // 冷却时间表
+
+	/** 各技能冷却结束的游戏时间（按 EWukongCooldown 索引），不需要每帧递减 */
+	double CooldownEndTimes[static_cast<int32>(EWukongCooldown::Num)] = {};
 
 	// ========== 攻击状态 ==========
 	float LastAttackTime = 0.0f;       // 上次攻击时间
 	int32 ComboCount = 0;              // 当前连击段数
 	float AttackTimer = 0.0f;          // 攻击计时器
+	double AttackStartTime = 0.0;      // 本段攻击开始的游戏时间（计算连招窗口）
 	float AttackCooldownTimer = 0.0f;  // 攻击冷却计时器
 	float CachedMaxWalkSpeed = 0.0f;   // 攻击时缓存的最大速度
-	TArray<FString> InputBuffer;       // 输入缓冲区
+	FWukongInputBuffer InputBuffer;    // 输入缓冲区
 
 	// ========== 硬直状态 ==========
 	float HitStunTimer = 0.0f;  // 硬直计时器
@@ -646,11 +769,13 @@ private:
 
 	// ========== 战斗函数 ==========
 	void PerformAttack();       // 执行攻击
+	bool IsAttackComboWindowOpen() const;  // 不在攻击中，或当前攻击动画已播放到可接续连招的位置
 	void PerformHeavyAttack();  // 执行重击
 	void PerformStaffSpin();    // 执行棍花
 	void PerformPoleStance();   // 执行立棍
 	void PerformShadowClone();  // 执行影分身
 	void PerformFreezeSpell();  // 执行定身术
+	void PerformAreaFreezeSpell();  // 范围定身（FreezeSpellRadius > 0）
 	void UseItem();             // 使用物品
 	void ResetCombo();          // 重置连击
 	void ProcessInputBuffer();  // 处理输入缓冲
@@ -666,9 +791,8 @@ private:
 	void PerformAbility();  // 执行战技
 
 	// ========== 冷却管理 ==========
-	bool IsCooldownActive(const FString& CooldownName) const;        // 检查冷却是否激活
-	void StartCooldown(const FString& CooldownName, float Duration); // 开始冷却
-	void UpdateCooldowns(float DeltaTime);                           // 更新冷却
+	bool IsCooldownActive(EWukongCooldown Cooldown) const;        // 检查冷却是否激活
+	void StartCooldown(EWukongCooldown Cooldown, float Duration); // 开始冷却
 
 	// ========== 辅助函数 ==========
 	
@@ -10,17 +10,19 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "EnemyBase.h"
-#include "AIController.h"
-#include "NavigationSystem.h"
+#include "Subsystems/ActorPoolSubsystem.h"
+#include "WukongCloneAIController.h"
 #include "Perception/AIPerceptionStimuliSourceComponent.h"
 #include "Perception/AISense_Sight.h"
 #include "Engine/SkeletalMesh.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "BlackMythLog.h"
 
 AWukongClone::AWukongClone()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	// AI 由控制器的定时器和行为树驱动，分身本身不需要 Tick
+	PrimaryActorTick.bCanEverTick = false;
 
 	// 创建生命组件
 	HealthComponent = CreateDefaultSubobject<UHealthComponent>(TEXT("HealthComponent"));
@@ -32,6 +34,9 @@ AWukongClone::AWukongClone()
 	TeamComponent = CreateDefaultSubobject<UTeamComponent>(TEXT("TeamComponent"));
 	TeamComponent->SetTeam(ETeam::Player);
 
+	// 登记战斗组件（分身没有状态效果组件）
+	SetCombatComponents(HealthComponent, TeamComponent, nullptr, CombatComponent);
+
 	// 创建武器碰撞检测组件
 	WeaponTraceHitbox = CreateDefaultSubobject<UTraceHitboxComponent>(TEXT("WeaponTraceHitbox"));
 
@@ -51,7 +56,11 @@ AWukongClone::AWukongClone()
 		Movement->MaxWalkSpeed = MoveSpeed;
 	}
 
-	// 默认使用AI控制
+	// 朝向跟随移动方向，攻击时由 FaceTarget 转向
+	bUseControllerRotationYaw = false;
+
+	// 默认使用分身 AI 控制器
+	AIControllerClass = AWukongCloneAIController::StaticClass();
 	AutoPossessAI = EAutoPossessAI::PlacedInWorldOrSpawned;
 }
 
@@ -66,95 +75,51 @@ void AWukongClone::BeginPlay()
 	}
 }
 
-void AWukongClone::HandleDeath(AActor* Killer)
+void AWukongClone::OnAcquiredFromPool()
 {
-	// 死亡时消失
-	Disappear();
+	// 生命值和阵营由各自组件的 IPoolable 回调恢复，这里重新加入 AI 感知
+	if (UAIPerceptionStimuliSourceComponent* StimuliSource = FindComponentByClass<UAIPerceptionStimuliSourceComponent>())
+	{
+		StimuliSource->RegisterWithPerceptionSystem();
+	}
 }
 
-void AWukongClone::Tick(float DeltaTime)
+void AWukongClone::OnReleasedToPool()
 {
-	Super::Tick(DeltaTime);
-
-	if (!bIsInitialized)
+	// 从 AI 感知中移除，避免敌人继续追踪池中的分身
+	if (UAIPerceptionStimuliSourceComponent* StimuliSource = FindComponentByClass<UAIPerceptionStimuliSourceComponent>())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("WukongClone::Tick - Not initialized yet!"));
-		return;
+		StimuliSource->UnregisterFromPerceptionSystem();
 	}
 
-	// 更新攻击冷却
-	if (AttackCooldownTimer > 0.0f)
+	if (AWukongCloneAIController* CloneAI = Cast<AWukongCloneAIController>(GetController()))
 	{
-		AttackCooldownTimer -= DeltaTime;
+		CloneAI->StopCloneAI();
 	}
 
-	// 如果正在攻击，等待攻击结束
-	if (bIsAttacking)
+	GetWorldTimerManager().ClearTimer(AttackEndTimerHandle);
+	StopAnimMontage();
+	if (WeaponTraceHitbox)
 	{
-		return;
+		WeaponTraceHitbox->DeactivateTrace();
+		WeaponTraceHitbox->ClearHitActors();
 	}
-
-	// 寻找目标
-	if (!CurrentTarget || !IsValid(CurrentTarget))
+	if (UCharacterMovementComponent* Movement = GetCharacterMovement())
 	{
-		CurrentTarget = FindNearestEnemy();
-		if (CurrentTarget)
-		{
-			UE_LOG(LogTemp, Log, TEXT("WukongClone: Found target: %s"), *CurrentTarget->GetName());
-		}
+		Movement->StopMovementImmediately();
 	}
 
-	// 如果有目标，执行AI逻辑
-	if (CurrentTarget && IsValid(CurrentTarget))
-	{
-		float DistanceToTarget = FVector::Dist(GetActorLocation(), CurrentTarget->GetActorLocation());
-
-		// 检查目标是否死亡（如果是敌人）
-		if (AEnemyBase* Enemy = Cast<AEnemyBase>(CurrentTarget))
-		{
-			if (Enemy->IsDead())
-			{
-				CurrentTarget = nullptr;
-				return;
-			}
-		}
-
-		if (DistanceToTarget <= AttackRange)
-		{
-			// 在攻击范围内，面向目标并攻击
-			FVector Direction = CurrentTarget->GetActorLocation() - GetActorLocation();
-			Direction.Z = 0.0f;
-			if (!Direction.IsNearlyZero())
-			{
-				FRotator TargetRotation = Direction.Rotation();
-				SetActorRotation(FMath::RInterpTo(GetActorRotation(), TargetRotation, DeltaTime, 10.0f));
-			}
+	CloneOwner = nullptr;
+	NextAttackTime = 0.0;
+	CurrentAttackIndex = 0;
+	bIsAttacking = false;
+	bIsInitialized = false;
+}
 
-			// 攻击
-			if (AttackCooldownTimer <= 0.0f)
-			{
-				UE_LOG(LogTemp, Log, TEXT("WukongClone: Attacking target!"));
-				PerformAttack();
-			}
-		}
-		else
-		{
-			// 不在攻击范围，移动到目标
-			MoveToTarget(CurrentTarget);
-		}
-	}
-	else
-	{
-		// 没有目标，跟随召唤者
-		if (CloneOwner && IsValid(CloneOwner))
-		{
-			float DistanceToOwner = FVector::Dist(GetActorLocation(), CloneOwner->GetActorLocation());
-			if (DistanceToOwner > 300.0f)
-			{
-				MoveToTarget(CloneOwner);
-			}
-		}
-	}
+void AWukongClone::HandleDeath(AActor* Killer)
+{
+	// 死亡时消失
+	Disappear();
 }
 
 void AWukongClone::InitializeClone(AActor* InOwner, float InLifetime)
@@ -217,14 +182,40 @@ void AWukongClone::InitializeClone(AActor* InOwner, float InLifetime)
 		false
 	);
 
+	// 启动 AI（尚未被附身时由控制器的 OnPossess 启动）
+	if (AWukongCloneAIController* CloneAI = Cast<AWukongCloneAIController>(GetController()))
+	{
+		CloneAI->StartCloneAI();
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("WukongClone: Initialized with lifetime %.1f seconds"), Lifetime);
 }
 
+bool AWukongClone::CanAttack() const
+{
+	return bIsInitialized && !bIsAttacking && GetWorld()->GetTimeSeconds() >= NextAttackTime;
+}
+
+void AWukongClone::FaceTarget(const AActor* Target)
+{
+	if (!Target)
+	{
+		return;
+	}
+
+	FVector Direction = Target->GetActorLocation() - GetActorLocation();
+	Direction.Z = 0.0f;
+	if (!Direction.IsNearlyZero())
+	{
+		SetActorRotation(Direction.Rotation());
+	}
+}
+
 void AWukongClone::PerformAttack()
 {
 	// 先设置攻击状态，防止重复触发
 	bIsAttacking = true;
-	AttackCooldownTimer = AttackCooldown;
+	NextAttackTime = GetWorld()->GetTimeSeconds() + AttackCooldown;
 
 	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
 	if (!AnimInstance)
@@ -268,9 +259,8 @@ void AWukongClone::PerformAttack()
 		}
 
 		// 设置攻击结束回调
-		FTimerHandle AttackEndTimer;
 		GetWorldTimerManager().SetTimer(
-			AttackEndTimer,
+			AttackEndTimerHandle,
 			[this]()
 			{
 				bIsAttacking = false;
@@ -290,9 +280,8 @@ void AWukongClone::PerformAttack()
 		// 没有蒙太奇可用，模拟攻击动作（只是延迟）
 		UE_LOG(LogTemp, Warning, TEXT("WukongClone: No attack montage available, simulating attack"));
 		
-		FTimerHandle AttackEndTimer;
 		GetWorldTimerManager().SetTimer(
-			AttackEndTimer,
+			AttackEndTimerHandle,
 			[this]()
 			{
 				bIsAttacking = false;
@@ -331,8 +320,8 @@ void AWukongClone::Disappear()
 		);
 	}
 
-	// 销毁自身
-	Destroy();
+	// 回收到对象池（不在池中时销毁）
+	UActorPoolSubsystem::ReleaseOrDestroy(this);
 }
 
 void AWukongClone::OnLifetimeExpired()
@@ -341,76 +330,74 @@ void AWukongClone::OnLifetimeExpired()
 	Disappear();
 }
 
-AActor* AWukongClone::FindNearestEnemy()
-{
-	TArray<AActor*> FoundEnemies;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AEnemyBase::StaticClass(), FoundEnemies);
+// ========== 压力测试 ==========
 
-	AActor* NearestEnemy = nullptr;
-	float NearestDistance = DetectionRange;
+#if !UE_BUILD_SHIPPING
 
-	for (AActor* Enemy : FoundEnemies)
+namespace WukongCloneStressTest
+{
+	/**
+	 * 控制台命令：BlackMyth.Clone.StressTest [数量=50] [存活时间=10]
+	 * 在玩家周围的圆环上一次性召唤大量分身（走对象池 + InitializeClone，与影分身技能相同），
+	 * 记录生成耗时。之后可用 stat BlackMyth 观察 Clone Target Reacquires 与 SpatialGrid Queries。
+	 */
+	static void Run(const TArray<FString>& Args, UWorld* World)
 	{
-		// 检查敌人是否存活
-		if (AEnemyBase* EnemyBase = Cast<AEnemyBase>(Enemy))
+		AWukongCharacter* Player = World ? Cast<AWukongCharacter>(UGameplayStatics::GetPlayerCharacter(World, 0)) : nullptr;
+		if (!Player)
 		{
-			if (EnemyBase->IsDead())
-			{
-				continue;
-			}
+			UE_LOG(LogBMCombat, Warning, TEXT("[CloneStress] No player character in the world"));
+			return;
 		}
 
-		float Distance = FVector::Dist(GetActorLocation(), Enemy->GetActorLocation());
-		if (Distance < NearestDistance)
+		const int32 NumClones = Args.Num() > 0 ? FMath::Max(FCString::Atoi(*Args[0]), 1) : 50;
+		const float CloneLifetime = Args.Num() > 1 ? FMath::Max(FCString::Atof(*Args[1]), 1.0f) : 10.0f;
+
+		TSubclassOf<AWukongClone> CloneClass = Player->GetCloneClass();
+		if (!CloneClass)
 		{
-			NearestDistance = Distance;
-			NearestEnemy = Enemy;
+			CloneClass = AWukongClone::StaticClass();
 		}
-	}
 
-	return NearestEnemy;
-}
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.Owner = Player;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-void AWukongClone::MoveToTarget(AActor* Target)
-{
-	if (!Target)
-	{
-		return;
-	}
+		UActorPoolSubsystem* Pool = UActorPoolSubsystem::Get(World);
+		const FVector Center = Player->GetActorLocation();
 
-	UCharacterMovementComponent* Movement = GetCharacterMovement();
-	if (!Movement)
-	{
-		return;
-	}
+		// 每圈 16 个，逐圈外扩
+		constexpr int32 ClonesPerRing = 16;
+		int32 NumSpawned = 0;
 
-	// 计算移动方向
-	FVector MyLocation = GetActorLocation();
-	FVector TargetLocation = Target->GetActorLocation();
-	FVector Direction = TargetLocation - MyLocation;
-	Direction.Z = 0.0f;
-	
-	float Distance = Direction.Size();
-	if (Distance < 10.0f) // 太近了就不移动
-	{
-		return;
-	}
-	
-	Direction.Normalize();
+		const double StartTime = FPlatformTime::Seconds();
+		for (int32 Index = 0; Index < NumClones; ++Index)
+		{
+			const int32 Ring = Index / ClonesPerRing;
+			const float Angle = 2.0f * PI * (Index % ClonesPerRing) / ClonesPerRing;
+			const float Distance = 200.0f + 150.0f * Ring;
+			const FVector Location = Center + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Distance;
 
-	// 直接使用 AddMovementInput 配合正确的控制旋转
-	// 关键：需要设置控制旋转让角色知道该往哪走
-	if (Controller)
-	{
-		Controller->SetControlRotation(Direction.Rotation());
+			AWukongClone* Clone = Pool
+				? Pool->Acquire<AWukongClone>(CloneClass, Location, Player->GetActorRotation(), SpawnParams)
+				: World->SpawnActor<AWukongClone>(CloneClass, Location, Player->GetActorRotation(), SpawnParams);
+
+			if (Clone)
+			{
+				Clone->InitializeClone(Player, CloneLifetime);
+				++NumSpawned;
+			}
+		}
+		const double SpawnTime = FPlatformTime::Seconds() - StartTime;
+
+		UE_LOG(LogBMCombat, Display, TEXT("[CloneStress] Spawned %d/%d clones (lifetime %.1fs) in %.2f ms (%.1f us/clone)"),
+			NumSpawned, NumClones, CloneLifetime, SpawnTime * 1000.0, NumSpawned > 0 ? SpawnTime * 1.0e6 / NumSpawned : 0.0);
 	}
-	
-	// 使用内置的移动输入系统
-	AddMovementInput(Direction, 1.0f);
-
-	// 面向移动方向（平滑旋转）
-	FRotator CurrentRotation = GetActorRotation();
-	FRotator TargetRotation = Direction.Rotation();
-	FRotator NewRotation = FMath::RInterpTo(CurrentRotation, TargetRotation, GetWorld()->GetDeltaSeconds(), 10.0f);
-	SetActorRotation(NewRotation);
+
+	static FAutoConsoleCommandWithWorldAndArgs StressTestCommand(
+		TEXT("BlackMyth.Clone.StressTest"),
+		TEXT("Spawn many shadow clones around the player at once. Args: [Count=50] [Lifetime=10]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&Run));
 }
+
+#endif
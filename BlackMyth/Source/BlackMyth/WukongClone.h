@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Character.h"
+#include "Subsystems/PoolableInterface.h"
+#include "Components/TeamMemberInterface.h"
+#include "Combat/CombatActorInterface.h"
 #include "WukongClone.generated.h"
 
 class UHealthComponent;
@@ -13,11 +16,11 @@ class UTraceHitboxComponent;
 
 /**
  * 悟空分身
- * 由AI控制，自动攻击附近敌人
+ * 由 AWukongCloneAIController 控制（定时索敌 + 行为树），自动攻击附近敌人，自身不 Tick
  * 有限生命周期后自动消失
  */
 UCLASS()
-class BLACKMYTH_API AWukongClone : public ACharacter
+class BLACKMYTH_API AWukongClone : public ACharacter, public IPoolable, public ITeamMember, public ICombatActor
 {
 	GENERATED_BODY()
 
@@ -27,9 +30,12 @@ public:
 protected:
 	virtual void BeginPlay() override;
 
-public:
-	virtual void Tick(float DeltaTime) override;
+	// ========== IPoolable ==========
+
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
 
+public:
 	/** 初始化分身（由召唤者调用） */
 	UFUNCTION(BlueprintCallable, Category = "Clone")
 	void InitializeClone(AActor* InOwner, float InLifetime = 20.0f);
@@ -38,11 +44,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Combat")
 	void PerformAttack();
 
+	/** 是否可以发动攻击（已初始化、不在攻击中且冷却结束） */
+	bool CanAttack() const;
+
+	/** 是否正在攻击 */
+	bool IsAttacking() const { return bIsAttacking; }
+
+	/** 是否已初始化且未回收 */
+	bool IsCloneActive() const { return bIsInitialized; }
+
+	/** 立即转向目标（只改水平朝向） */
+	void FaceTarget(const AActor* Target);
+
+	float GetAttackRange() const { return AttackRange; }
+	float GetDetectionRange() const { return DetectionRange; }
+
 	/** 获取召唤者 */
 	UFUNCTION(BlueprintPure, Category = "Clone")
 	AActor* GetCloneOwner() const { return CloneOwner; }
 
-	/** 分身消失（播放消失特效后销毁） */
+	/** 分身消失（播放消失特效后销毁，有对象池时回收） */
 	UFUNCTION(BlueprintCallable, Category = "Clone")
 	void Disappear();
 
@@ -54,12 +75,6 @@ protected:
 	UFUNCTION()
 	void HandleDeath(AActor* Killer);
 
-	/** 寻找最近的敌人 */
-	AActor* FindNearestEnemy();
-
-	/** 移动到目标位置 */
-	void MoveToTarget(AActor* Target);
-
 protected:
 	// ========== 组件 ==========
 
@@ -120,15 +135,14 @@ private:
 	UPROPERTY()
 	TObjectPtr<AActor> CloneOwner;
 
-	/** 当前目标 */
-	UPROPERTY()
-	TObjectPtr<AActor> CurrentTarget;
-
 	/** 生命周期计时器句柄 */
 	FTimerHandle LifetimeTimerHandle;
 
-	/** 攻击冷却计时器 */
-	float AttackCooldownTimer = 0.0f;
+	/** 攻击结束计时器句柄（回收时需要清除 lambda 计时器） */
+	FTimerHandle AttackEndTimerHandle;
+
+	/** 冷却结束的世界时间 */
+	double NextAttackTime = 0.0;
 
 	/** 当前攻击索引（用于连招） */
 	int32 CurrentAttackIndex = 0;
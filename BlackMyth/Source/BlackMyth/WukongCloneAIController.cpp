@@ -0,0 +1,161 @@
+// 悟空分身 AI 控制器实现
+
+#include "WukongCloneAIController.h"
+#include "WukongClone.h"
+#include "BehaviorTree/BehaviorTree.h"
+#include "BehaviorTree/BlackboardComponent.h"
+#include "Navigation/PathFollowingComponent.h"
+#include "Subsystems/SpatialGridSubsystem.h"
+#include "TimerManager.h"
+#include "BlackMythStats.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Clone Target Reacquires"), STAT_CloneTargetReacquires, STATGROUP_BlackMyth);
+
+const FName AWukongCloneAIController::TargetActorKey(TEXT("TargetActor"));
+const FName AWukongCloneAIController::CloneOwnerKey(TEXT("CloneOwner"));
+
+AWukongCloneAIController::AWukongCloneAIController()
+{
+	// 分身 AI 全部由定时器和行为树驱动
+	bStartAILogicOnPossess = false;
+}
+
+void AWukongCloneAIController::OnPossess(APawn* InPawn)
+{
+	Super::OnPossess(InPawn);
+
+	// 对象池取出的分身先初始化再被附身时，在这里补上启动
+	const AWukongClone* Clone = Cast<AWukongClone>(InPawn);
+	if (Clone && Clone->IsCloneActive())
+	{
+		StartCloneAI();
+	}
+}
+
+void AWukongCloneAIController::OnUnPossess()
+{
+	StopCloneAI();
+
+	Super::OnUnPossess();
+}
+
+void AWukongCloneAIController::StartCloneAI()
+{
+	AWukongClone* Clone = Cast<AWukongClone>(GetPawn());
+	if (!Clone)
+	{
+		return;
+	}
+
+	bUsingBehaviorTree = BehaviorTreeAsset && RunBehaviorTree(BehaviorTreeAsset);
+	if (bUsingBehaviorTree)
+	{
+		if (UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
+		{
+			BlackboardComp->SetValueAsObject(CloneOwnerKey, Clone->GetCloneOwner());
+		}
+	}
+
+	// 错开各分身的首次索敌，同一帧召唤的分身不会挤在同一帧查询
+	const float FirstDelay = FMath::FRandRange(0.0f, TargetReacquireInterval);
+	GetWorldTimerManager().SetTimer(ReacquireTimerHandle, this, &AWukongCloneAIController::ReacquireTarget, TargetReacquireInterval, true, FirstDelay);
+}
+
+void AWukongCloneAIController::StopCloneAI()
+{
+	GetWorldTimerManager().ClearTimer(ReacquireTimerHandle);
+	StopMovement();
+
+	if (bUsingBehaviorTree)
+	{
+		if (UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
+		{
+			BlackboardComp->ClearValue(TargetActorKey);
+			BlackboardComp->ClearValue(CloneOwnerKey);
+		}
+		CleanupBrainComponent();
+		bUsingBehaviorTree = false;
+	}
+
+	CurrentTarget = nullptr;
+	MoveGoal = nullptr;
+}
+
+void AWukongCloneAIController::ReacquireTarget()
+{
+	AWukongClone* Clone = Cast<AWukongClone>(GetPawn());
+	if (!Clone || !Clone->IsCloneActive())
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_CloneTargetReacquires);
+
+	// 每次都取最近的存活敌人：目标死亡、离开范围或出现更近的敌人时自动切换
+	AActor* Target = nullptr;
+	if (USpatialGridSubsystem* Grid = USpatialGridSubsystem::Get(this))
+	{
+		Target = Grid->FindNearestHostile(Clone, Clone->GetDetectionRange());
+	}
+	CurrentTarget = Target;
+
+	if (bUsingBehaviorTree)
+	{
+		if (UBlackboardComponent* BlackboardComp = GetBlackboardComponent())
+		{
+			BlackboardComp->SetValueAsObject(TargetActorKey, Target);
+		}
+		return;
+	}
+
+	UpdateFallbackBehavior(Clone, Target);
+}
+
+void AWukongCloneAIController::UpdateFallbackBehavior(AWukongClone* Clone, AActor* Target)
+{
+	// 攻击动作进行中，等待结束
+	if (Clone->IsAttacking())
+	{
+		return;
+	}
+
+	if (Target)
+	{
+		const float DistanceToTarget = FVector::Dist(Clone->GetActorLocation(), Target->GetActorLocation());
+		if (DistanceToTarget <= Clone->GetAttackRange())
+		{
+			// 在攻击范围内，停下并攻击
+			StopMovement();
+			MoveGoal = nullptr;
+			Clone->FaceTarget(Target);
+			if (Clone->CanAttack())
+			{
+				Clone->PerformAttack();
+			}
+		}
+		else
+		{
+			MoveToGoal(Target, Clone->GetAttackRange() * 0.8f);
+		}
+		return;
+	}
+
+	// 没有目标，跟随召唤者
+	AActor* CloneOwner = Clone->GetCloneOwner();
+	if (CloneOwner && FVector::Dist(Clone->GetActorLocation(), CloneOwner->GetActorLocation()) > FollowOwnerDistance)
+	{
+		MoveToGoal(CloneOwner, FollowOwnerDistance * 0.5f);
+	}
+}
+
+void AWukongCloneAIController::MoveToGoal(AActor* Goal, float AcceptanceRadius)
+{
+	// 寻路会持续跟踪目标 Actor，不需要每次定时器都重新请求
+	if (MoveGoal.Get() == Goal && GetMoveStatus() == EPathFollowingStatus::Moving)
+	{
+		return;
+	}
+
+	MoveGoal = Goal;
+	MoveToActor(Goal, AcceptanceRadius);
+}
@@ -0,0 +1,78 @@
+// 悟空分身 AI 控制器 - 定时索敌写入黑板，移动与攻击交给轻量行为树
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AIController.h"
+#include "WukongCloneAIController.generated.h"
+
+class AWukongClone;
+class UBehaviorTree;
+
+/**
+ * 悟空分身 AI 控制器
+ * - 分身本身不再 Tick：控制器以 TargetReacquireInterval 的频率（默认 4Hz）
+ *   通过空间网格的共享最近敌对查询重新选择目标，写入黑板 TargetActor
+ * - 行为树只负责执行，推荐结构：
+ *   Selector
+ *     ├─ [Blackboard: TargetActor Is Set] Sequence { MoveTo(TargetActor), CloneAttack }
+ *     └─ MoveTo(CloneOwner)
+ * - 未配置 BehaviorTreeAsset 时，在同一个定时器里执行等价的追击/攻击/跟随逻辑
+ */
+UCLASS()
+class BLACKMYTH_API AWukongCloneAIController : public AAIController
+{
+	GENERATED_BODY()
+
+public:
+	AWukongCloneAIController();
+
+	/** 开始运行分身 AI（分身初始化完成后调用） */
+	void StartCloneAI();
+
+	/** 停止分身 AI（分身消失或回收到对象池时调用） */
+	void StopCloneAI();
+
+	/** 当前目标（可能为空） */
+	AActor* GetCurrentTarget() const { return CurrentTarget.Get(); }
+
+	/** 黑板键名 */
+	static const FName TargetActorKey;
+	static const FName CloneOwnerKey;
+
+protected:
+	virtual void OnPossess(APawn* InPawn) override;
+	virtual void OnUnPossess() override;
+
+	/** 分身行为树（可选，黑板需包含 TargetActor 和 CloneOwner 两个 Object 键） */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
+	TObjectPtr<UBehaviorTree> BehaviorTreeAsset;
+
+	/** 重新索敌的间隔（秒） */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI", meta = (ClampMin = "0.05"))
+	float TargetReacquireInterval = 0.25f;
+
+	/** 没有目标时，距离召唤者超过此距离才跟随（仅无行为树时使用） */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "AI")
+	float FollowOwnerDistance = 300.0f;
+
+private:
+	/** 定时器回调：重新索敌，无行为树时顺带驱动分身 */
+	void ReacquireTarget();
+
+	/** 无行为树时的追击/攻击/跟随 */
+	void UpdateFallbackBehavior(AWukongClone* Clone, AActor* Target);
+
+	/** 移动到 Goal，已经在向同一目标移动时不重复请求寻路 */
+	void MoveToGoal(AActor* Goal, float AcceptanceRadius);
+
+	FTimerHandle ReacquireTimerHandle;
+
+	TWeakObjectPtr<AActor> CurrentTarget;
+
+	/** 当前寻路目标 */
+	TWeakObjectPtr<AActor> MoveGoal;
+
+	/** 是否由行为树驱动 */
+	bool bUsingBehaviorTree = false;
+};
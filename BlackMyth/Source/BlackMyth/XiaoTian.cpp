@@ -6,6 +6,8 @@
 #include "TimerManager.h"
 #include "WukongCharacter.h"
 #include "DrawDebugHelpers.h"
+#include "Subsystems/ActorRegistrySubsystem.h"
+#include "Subsystems/ActorPoolSubsystem.h"
 #include "NiagaraFunctionLibrary.h"
 #include "NiagaraComponent.h"
 
@@ -29,6 +31,38 @@ void AXiaoTian::BeginPlay()
 
 	CollisionBox->OnComponentBeginOverlap.AddDynamic(this, &AXiaoTian::OnOverlapBegin);
 
+	StartPounce();
+}
+
+void AXiaoTian::OnAcquiredFromPool()
+{
+	StartPounce();
+}
+
+void AXiaoTian::OnReleasedToPool()
+{
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterSummon(this);
+	}
+
+	GetWorldTimerManager().ClearTimer(TransitionTimer);
+	if (Mesh && Mesh->GetAnimInstance())
+	{
+		Mesh->GetAnimInstance()->StopAllMontages(0.0f);
+	}
+
+	CurrentState = EXiaoTianState::Spawning;
+}
+
+void AXiaoTian::StartPounce()
+{
+	// 注册为召唤物（Boss 死亡时按 Owner 清理）
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->RegisterSummon(this);
+	}
+
 	// 确保忽略召唤者（防止飞出门前撞到二郎神自己）
 	if (GetOwner())
 	{
@@ -71,6 +105,16 @@ void AXiaoTian::BeginPlay()
 	GetWorldTimerManager().SetTimer(LifeTimer, this, &AXiaoTian::FinishAndDestroy, 5.0f, false);
 }
 
+void AXiaoTian::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UActorRegistrySubsystem* Registry = UActorRegistrySubsystem::Get(this))
+	{
+		Registry->UnregisterSummon(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void AXiaoTian::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
@@ -207,13 +251,13 @@ void AXiaoTian::FinishAndDestroy()
 	}
 	else
 	{
-		Destroy();
+		UActorPoolSubsystem::ReleaseOrDestroy(this);
 	}
 }
 
 void AXiaoTian::DestroyActor()
 {
-	Destroy();
+	UActorPoolSubsystem::ReleaseOrDestroy(this);
 }
 
 void AXiaoTian::PlayEndAndVanish()
@@ -226,7 +270,6 @@ void AXiaoTian::PlayEndAndVanish()
 		float Duration = Mesh->GetAnimInstance()->Montage_Play(PounceStartMontage);
 		
 		// 动作播完后再执行咬(End)和后续流程
-		FTimerHandle TransitionTimer;
 		GetWorldTimerManager().SetTimer(TransitionTimer, [this]()
 		{
 			this->TriggerBite(nullptr);
@@ -2,6 +2,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Subsystems/PoolableInterface.h"
 #include "XiaoTian.generated.h"
 
 class USkeletalMeshComponent;
@@ -18,7 +19,7 @@ enum class EXiaoTianState : uint8
 };
 
 UCLASS()
-class BLACKMYTH_API AXiaoTian : public AActor
+class BLACKMYTH_API AXiaoTian : public AActor, public IPoolable
 {
 	GENERATED_BODY()
 	
@@ -27,6 +28,12 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// ========== IPoolable ==========
+
+	virtual void OnAcquiredFromPool() override;
+	virtual void OnReleasedToPool() override;
 
 public:	
 	virtual void Tick(float DeltaTime) override;
@@ -34,9 +41,12 @@ public:
 	void PlayEndAndVanish();
 
 protected:
-	/** 彻底销毁的回调 (用于相机混合后的延迟销毁) */
+	/** 彻底销毁的回调 (用于相机混合后的延迟销毁，有对象池时回收) */
 	void DestroyActor();
 
+	/** 注册召唤物、朝向玩家并开始扑击 (生成或从对象池复用时调用) */
+	void StartPounce();
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Components")
 	TObjectPtr<USkeletalMeshComponent> Mesh;
 
@@ -87,4 +97,7 @@ protected:
 	FVector TargetDirection;
 	FVector SpawnLocation;
 	FTimerHandle LifeTimer;
+
+	/** 过场模式起跳→咬的过渡计时器 (lambda 计时器，回收时需要单独清除) */
+	FTimerHandle TransitionTimer;
 };
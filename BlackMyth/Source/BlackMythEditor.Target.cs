@@ -11,5 +11,6 @@ public class BlackMythEditorTarget : TargetRules
 		DefaultBuildSettings = BuildSettingsVersion.V5;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_4;
 		ExtraModuleNames.Add("BlackMyth");
+		ExtraModuleNames.Add("BlackMythTests");
 	}
 }
@@ -0,0 +1,5 @@
+// 测试模块 - 自动化测试与基准测试（不进入 Shipping 构建）
+
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_MODULE(FDefaultModuleImpl, BlackMythTests);
@@ -0,0 +1,225 @@
+// 战斗基准测试记录器实现
+
+#include "CombatBenchmarkRecorder.h"
+#include "BlackMythPerfCounters.h"
+#include "Components/ActorComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace CombatBenchmark
+{
+	/** 回归判定的绝对余量：帧耗时 0.25ms，计数 1 次/个，内存 8MB */
+	static const TPair<const TCHAR*, double> RegressionSlack[] =
+	{
+		{ TEXT("AvgGameThreadMs"), 0.25 },
+		{ TEXT("P95GameThreadMs"), 0.25 },
+		{ TEXT("AvgPhysicsQueries"), 1.0 },
+		{ TEXT("AvgSpatialQueries"), 1.0 },
+		{ TEXT("AvgTickingActors"), 1.0 },
+		{ TEXT("AvgTickingComponents"), 1.0 },
+		{ TEXT("MemoryGrowthMB"), 8.0 },
+	};
+
+	static double BytesToMB(uint64 Bytes)
+	{
+		return static_cast<double>(Bytes) / (1024.0 * 1024.0);
+	}
+}
+
+double FCombatBenchmarkSummary::Find(const FString& Metric) const
+{
+	for (const TPair<FString, double>& Entry : Metrics)
+	{
+		if (Entry.Key == Metric)
+		{
+			return Entry.Value;
+		}
+	}
+	return 0.0;
+}
+
+FCombatBenchmarkRecorder::FCombatBenchmarkRecorder()
+{
+	BeginFrameHandle = FCoreDelegates::OnBeginFrame.AddRaw(this, &FCombatBenchmarkRecorder::OnBeginFrame);
+	EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FCombatBenchmarkRecorder::OnEndFrame);
+}
+
+FCombatBenchmarkRecorder::~FCombatBenchmarkRecorder()
+{
+	FCoreDelegates::OnBeginFrame.Remove(BeginFrameHandle);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+}
+
+void FCombatBenchmarkRecorder::OnBeginFrame()
+{
+	FrameStartSeconds = FPlatformTime::Seconds();
+	ExcludedSeconds = 0.0;
+	BlackMythPerf::Reset();
+}
+
+void FCombatBenchmarkRecorder::OnEndFrame()
+{
+	// 注册后的第一帧没有经过 OnBeginFrame
+	if (FrameStartSeconds <= 0.0)
+	{
+		return;
+	}
+
+	CompletedFrame.GameThreadMs = (FPlatformTime::Seconds() - FrameStartSeconds - ExcludedSeconds) * 1000.0;
+	CompletedFrame.PhysicsQueries = BlackMythPerf::Get(BlackMythPerf::ECounter::PhysicsQueries);
+	CompletedFrame.SpatialQueries = BlackMythPerf::Get(BlackMythPerf::ECounter::SpatialQueries);
+	CompletedFrame.UsedMemoryMB = CombatBenchmark::BytesToMB(FPlatformMemory::GetStats().UsedPhysical);
+	bHasCompletedFrame = true;
+}
+
+void FCombatBenchmarkRecorder::SampleFrame(UWorld* World)
+{
+	const double SampleStart = FPlatformTime::Seconds();
+
+	if (bHasCompletedFrame && World)
+	{
+		FCombatBenchmarkSample& Sample = Samples.Add_GetRef(CompletedFrame);
+
+		for (TActorIterator<AActor> It(World); It; ++It)
+		{
+			const AActor* Actor = *It;
+			if (Actor->IsActorTickEnabled())
+			{
+				++Sample.TickingActors;
+			}
+
+			for (const UActorComponent* Component : Actor->GetComponents())
+			{
+				if (Component && Component->IsComponentTickEnabled())
+				{
+					++Sample.TickingComponents;
+				}
+			}
+		}
+
+		bHasCompletedFrame = false;
+	}
+
+	// 遍历世界的开销不属于被测代码
+	ExcludedSeconds += FPlatformTime::Seconds() - SampleStart;
+}
+
+FCombatBenchmarkSummary FCombatBenchmarkRecorder::Summarize() const
+{
+	FCombatBenchmarkSummary Summary;
+	if (Samples.Num() == 0)
+	{
+		return Summary;
+	}
+
+	TArray<double> FrameMs;
+	FrameMs.Reserve(Samples.Num());
+
+	double SumMs = 0.0;
+	double SumPhysics = 0.0;
+	double SumSpatial = 0.0;
+	double SumActors = 0.0;
+	double SumComponents = 0.0;
+	for (const FCombatBenchmarkSample& Sample : Samples)
+	{
+		FrameMs.Add(Sample.GameThreadMs);
+		SumMs += Sample.GameThreadMs;
+		SumPhysics += Sample.PhysicsQueries;
+		SumSpatial += Sample.SpatialQueries;
+		SumActors += Sample.TickingActors;
+		SumComponents += Sample.TickingComponents;
+	}
+	FrameMs.Sort();
+
+	const double Count = Samples.Num();
+	const int32 P95Index = FMath::Min(FMath::FloorToInt32(Count * 0.95), Samples.Num() - 1);
+
+	Summary.Metrics.Emplace(TEXT("Frames"), Count);
+	Summary.Metrics.Emplace(TEXT("AvgGameThreadMs"), SumMs / Count);
+	Summary.Metrics.Emplace(TEXT("P95GameThreadMs"), FrameMs[P95Index]);
+	Summary.Metrics.Emplace(TEXT("MaxGameThreadMs"), FrameMs.Last());
+	Summary.Metrics.Emplace(TEXT("AvgPhysicsQueries"), SumPhysics / Count);
+	Summary.Metrics.Emplace(TEXT("AvgSpatialQueries"), SumSpatial / Count);
+	Summary.Metrics.Emplace(TEXT("AvgTickingActors"), SumActors / Count);
+	Summary.Metrics.Emplace(TEXT("AvgTickingComponents"), SumComponents / Count);
+	Summary.Metrics.Emplace(TEXT("MemoryGrowthMB"), Samples.Last().UsedMemoryMB - Samples[0].UsedMemoryMB);
+	return Summary;
+}
+
+bool FCombatBenchmarkRecorder::WriteFrameCsv(const FString& FilePath) const
+{
+	FString Csv = TEXT("Frame,GameThreadMs,PhysicsQueries,SpatialQueries,TickingActors,TickingComponents,UsedMemoryMB\n");
+	for (int32 Index = 0; Index < Samples.Num(); ++Index)
+	{
+		const FCombatBenchmarkSample& Sample = Samples[Index];
+		Csv += FString::Printf(TEXT("%d,%.4f,%d,%d,%d,%d,%.2f\n"),
+			Index, Sample.GameThreadMs, Sample.PhysicsQueries, Sample.SpatialQueries,
+			Sample.TickingActors, Sample.TickingComponents, Sample.UsedMemoryMB);
+	}
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+TMap<FString, double> FCombatBenchmarkRecorder::LoadBaseline(const FString& FilePath)
+{
+	TMap<FString, double> Baseline;
+
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+	{
+		return Baseline;
+	}
+
+	for (const FString& Line : Lines)
+	{
+		TArray<FString> Fields;
+		if (Line.ParseIntoArray(Fields, TEXT(",")) != 3 || Fields[0] == TEXT("Scenario"))
+		{
+			continue;
+		}
+		Baseline.Add(Fields[0] + TEXT(",") + Fields[1], FCString::Atod(*Fields[2]));
+	}
+	return Baseline;
+}
+
+bool FCombatBenchmarkRecorder::SaveBaseline(const FString& FilePath, const FString& Scenario, const FCombatBenchmarkSummary& Summary)
+{
+	FString Csv = TEXT("Scenario,Metric,Value\n");
+
+	// 保留其他场景的行
+	TArray<FString> Lines;
+	if (FFileHelper::LoadFileToStringArray(Lines, *FilePath))
+	{
+		for (const FString& Line : Lines)
+		{
+			if (Line.IsEmpty() || Line.StartsWith(TEXT("Scenario,")) || Line.StartsWith(Scenario + TEXT(",")))
+			{
+				continue;
+			}
+			Csv += Line + TEXT("\n");
+		}
+	}
+
+	for (const TPair<FString, double>& Entry : Summary.Metrics)
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%.4f\n"), *Scenario, *Entry.Key, Entry.Value);
+	}
+	return FFileHelper::SaveStringToFile(Csv, *FilePath);
+}
+
+bool FCombatBenchmarkRecorder::GetRegressionSlack(const FString& Metric, double& OutAbsoluteSlack)
+{
+	for (const TPair<const TCHAR*, double>& Entry : CombatBenchmark::RegressionSlack)
+	{
+		if (Metric == Entry.Key)
+		{
+			OutAbsoluteSlack = Entry.Value;
+			return true;
+		}
+	}
+	return false;
+}
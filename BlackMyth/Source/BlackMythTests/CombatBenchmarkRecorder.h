@@ -0,0 +1,84 @@
+// 战斗基准测试记录器 - 逐帧采集游戏线程耗时、物理查询、Tick 数和内存，输出 CSV 并与基线比较
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UWorld;
+
+/** 单帧采样 */
+struct FCombatBenchmarkSample
+{
+	/** 游戏线程一帧的耗时（已扣除记录器自身的采样开销） */
+	double GameThreadMs = 0.0;
+
+	int32 PhysicsQueries = 0;
+	int32 SpatialQueries = 0;
+
+	/** 开启 Tick 的 Actor / 组件数 */
+	int32 TickingActors = 0;
+	int32 TickingComponents = 0;
+
+	/** 进程占用的物理内存（MB，FPlatformMemory::GetStats().UsedPhysical）；衡量的是常驻内存增长，不是分配次数 */
+	double UsedMemoryMB = 0.0;
+};
+
+/** 一个场景的汇总指标（Metric 名 -> 值，顺序即 CSV 中的顺序） */
+struct FCombatBenchmarkSummary
+{
+	TArray<TPair<FString, double>> Metrics;
+
+	double Find(const FString& Metric) const;
+};
+
+/**
+ * 战斗基准测试记录器
+ * - 通过 FCoreDelegates::OnBeginFrame/OnEndFrame 计量整帧游戏线程耗时
+ * - 每帧开始时清零 BlackMythPerf 计数器，帧结束时读取
+ * - Tick 数在 SampleFrame 中遍历世界统计，这部分开销从帧耗时中扣除
+ */
+class FCombatBenchmarkRecorder
+{
+public:
+	FCombatBenchmarkRecorder();
+	~FCombatBenchmarkRecorder();
+
+	/** 记录上一帧的数据（每帧调用一次；开始后的第一帧没有完整数据，不记录） */
+	void SampleFrame(UWorld* World);
+
+	int32 GetNumSamples() const { return Samples.Num(); }
+
+	/** 汇总：平均/P95/最大帧耗时，各计数的平均值，内存增长（首末帧 UsedPhysical 之差，不是分配次数） */
+	FCombatBenchmarkSummary Summarize() const;
+
+	/** 写出逐帧 CSV */
+	bool WriteFrameCsv(const FString& FilePath) const;
+
+	// ========== 基线 ==========
+
+	/** 读取基线 CSV（Scenario,Metric,Value），键为 "Scenario,Metric" */
+	static TMap<FString, double> LoadBaseline(const FString& FilePath);
+
+	/** 用本次结果替换基线中该场景的行，其余场景保留 */
+	static bool SaveBaseline(const FString& FilePath, const FString& Scenario, const FCombatBenchmarkSummary& Summary);
+
+	/** 参与回归判定的指标及各自的绝对余量（避免接近 0 的基线因噪声失败）；其余指标只记录 */
+	static bool GetRegressionSlack(const FString& Metric, double& OutAbsoluteSlack);
+
+private:
+	void OnBeginFrame();
+	void OnEndFrame();
+
+	FDelegateHandle BeginFrameHandle;
+	FDelegateHandle EndFrameHandle;
+
+	/** 当前帧开始时间和需要扣除的采样开销 */
+	double FrameStartSeconds = 0.0;
+	double ExcludedSeconds = 0.0;
+
+	/** 最近完成的一帧 */
+	bool bHasCompletedFrame = false;
+	FCombatBenchmarkSample CompletedFrame;
+
+	TArray<FCombatBenchmarkSample> Samples;
+};
@@ -0,0 +1,25 @@
+// 战斗基准测试配置实现
+
+#include "CombatBenchmarkSettings.h"
+#include "WukongCharacter.h"
+#include "RegularEnemy.h"
+#include "RangedEnemy.h"
+#include "BossEnemy.h"
+
+UCombatBenchmarkSettings::UCombatBenchmarkSettings()
+{
+	// 默认使用游戏中实际配置了网格、动画和行为树的蓝图
+	Map = FSoftObjectPath(TEXT("/Game/ThirdPerson/Maps/ThirdPersonMap.ThirdPersonMap"));
+	PlayerClass = TSoftClassPtr<AWukongCharacter>(FSoftObjectPath(TEXT("/Game/_BlackMythGame/Blueprints/Characters/BP_Wukong.BP_Wukong_C")));
+	RegularEnemyClass = TSoftClassPtr<ARegularEnemy>(FSoftObjectPath(TEXT("/Game/_BlackMythGame/Blueprints/Characters/Enemy/BP_RegularEnemy.BP_RegularEnemy_C")));
+	RangedEnemyClass = TSoftClassPtr<ARangedEnemy>(FSoftObjectPath(TEXT("/Game/_BlackMythGame/Blueprints/Characters/Enemy/BP_RangedEnemy.BP_RangedEnemy_C")));
+	BossEnemyClass = TSoftClassPtr<ABossEnemy>(FSoftObjectPath(TEXT("/Game/_BlackMythGame/Blueprints/Characters/Enemy/BP_BossEnemy.BP_BossEnemy_C")));
+}
+
+const FCombatBenchmarkScenario* UCombatBenchmarkSettings::FindScenario(const FString& Name) const
+{
+	return Scenarios.FindByPredicate([&Name](const FCombatBenchmarkScenario& Scenario)
+	{
+		return Scenario.Name == Name;
+	});
+}
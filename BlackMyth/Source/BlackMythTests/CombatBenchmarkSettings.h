@@ -0,0 +1,110 @@
+// 战斗基准测试配置 - 地图、参与的角色类、各场景的敌人数量和玩家脚本节奏（DefaultGame.ini 中配置）
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "UObject/SoftObjectPath.h"
+#include "CombatBenchmarkSettings.generated.h"
+
+class AWukongCharacter;
+class ARegularEnemy;
+class ARangedEnemy;
+class ABossEnemy;
+
+/** 一个基准测试场景：围绕玩家生成的敌人数量和采样帧数 */
+USTRUCT()
+struct FCombatBenchmarkScenario
+{
+	GENERATED_BODY()
+
+	/** 场景名（自动化测试名 BlackMyth.Benchmark.Combat.<Name>，也是基线 CSV 中的键） */
+	UPROPERTY(Config)
+	FString Name;
+
+	UPROPERTY(Config)
+	int32 NumRegular = 0;
+
+	UPROPERTY(Config)
+	int32 NumRanged = 0;
+
+	UPROPERTY(Config)
+	int32 NumBoss = 0;
+
+	/** 敌人生成在玩家周围此半径的圆环上 */
+	UPROPERTY(Config)
+	float SpawnRadius = 1500.0f;
+
+	/** 生成后不计入统计的预热帧数（AI 感知、对象池、着色器等稳定下来） */
+	UPROPERTY(Config)
+	int32 WarmupFrames = 120;
+
+	/** 采样帧数 */
+	UPROPERTY(Config)
+	int32 MeasureFrames = 900;
+};
+
+/**
+ * 战斗基准测试配置
+ * 位于 DefaultGame.ini 的 [/Script/BlackMythTests.CombatBenchmarkSettings]
+ * 命令行 -BMScale=<倍数> 按比例缩放所有场景的敌人数量
+ */
+UCLASS(Config = Game)
+class UCombatBenchmarkSettings : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	UCombatBenchmarkSettings();
+
+	/** 测试地图（需要有导航网格，否则敌人不会移动） */
+	UPROPERTY(Config)
+	FSoftObjectPath Map;
+
+	/** 地图默认 Pawn 不是悟空时生成的玩家类 */
+	UPROPERTY(Config)
+	TSoftClassPtr<AWukongCharacter> PlayerClass;
+
+	UPROPERTY(Config)
+	TSoftClassPtr<ARegularEnemy> RegularEnemyClass;
+
+	UPROPERTY(Config)
+	TSoftClassPtr<ARangedEnemy> RangedEnemyClass;
+
+	UPROPERTY(Config)
+	TSoftClassPtr<ABossEnemy> BossEnemyClass;
+
+	UPROPERTY(Config)
+	TArray<FCombatBenchmarkScenario> Scenarios;
+
+	// ========== 玩家脚本（秒） ==========
+
+	/** 普通攻击输入间隔（攻击中的输入进入缓冲，形成连击） */
+	UPROPERTY(Config)
+	float AttackInterval = 0.3f;
+
+	/** 锁定目标左右切换间隔 */
+	UPROPERTY(Config)
+	float SwitchTargetInterval = 1.5f;
+
+	/** 定身术施放间隔（仍受技能冷却限制） */
+	UPROPERTY(Config)
+	float FreezeSpellInterval = 5.0f;
+
+	/** 影分身施放间隔（仍受技能冷却限制） */
+	UPROPERTY(Config)
+	float ShadowCloneInterval = 8.0f;
+
+	// ========== 基线 ==========
+
+	/** 基线 CSV（相对项目目录），每行 Scenario,Metric,Value */
+	UPROPERTY(Config)
+	FString BaselineFile = TEXT("Build/Benchmarks/CombatBaseline.csv");
+
+	/** 超过基线的相对容差（0.15 = 15%） */
+	UPROPERTY(Config)
+	float RegressionTolerance = 0.15f;
+
+	/** 查找场景（未找到返回空） */
+	const FCombatBenchmarkScenario* FindScenario(const FString& Name) const;
+};
@@ -0,0 +1,391 @@
+// 战斗基准测试 - 在玩家周围生成敌群，脚本驱动悟空连击、定身术、影分身和切换锁定，逐帧记录并与基线比较
+//
+// 无 GPU 的 Linux 机器上运行：
+//   UnrealEditor-Cmd BlackMyth.uproject -game -nullrhi -nosound -unattended -benchmark -fps=60
+//     -ExecCmds="Automation RunTests BlackMyth.Benchmark.Combat; Quit"
+// 可选参数：-BMScale=<倍数> 缩放敌人数量，-BMUpdateBaseline 用本次结果写入/覆盖基线
+// 缺少基线时只给出警告、不做回归判定：先带 -BMUpdateBaseline 在目标机器上跑一次，再提交生成的基线文件
+// 逐帧 CSV 写到 Saved/Benchmarks/，基线见 UCombatBenchmarkSettings::BaselineFile
+
+#include "CombatBenchmarkSettings.h"
+#include "CombatBenchmarkRecorder.h"
+#include "WukongCharacter.h"
+#include "RegularEnemy.h"
+#include "RangedEnemy.h"
+#include "BossEnemy.h"
+#include "Components/TargetingComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_AUTOMATION_TESTS
+
+/**
+ * 基准测试中的玩家脚本
+ * 按配置的间隔输入普通攻击（攻击中的输入进入连击缓冲）、左右切换锁定目标、施放定身术和影分身；
+ * 技能仍受角色自身的冷却和状态限制
+ */
+class FCombatBenchmarkPlayerScript
+{
+public:
+	FCombatBenchmarkPlayerScript(AWukongCharacter* InPlayer, const UCombatBenchmarkSettings& InSettings)
+		: Player(InPlayer)
+		, Settings(InSettings)
+	{
+	}
+
+	void Tick(double Now)
+	{
+		AWukongCharacter* Wukong = Player.Get();
+		if (!Wukong || Wukong->IsDead())
+		{
+			return;
+		}
+
+		// 定身术需要锁定目标；锁定的敌人死亡后重新锁定
+		UTargetingComponent* Targeting = Wukong->GetTargetingComponent();
+		if (Targeting && !Targeting->IsTargeting())
+		{
+			Targeting->ToggleLockOn();
+		}
+
+		if (Now >= NextAttackTime)
+		{
+			Wukong->DebugAttack();
+			NextAttackTime = Now + Settings.AttackInterval;
+		}
+
+		if (Targeting && Targeting->IsTargeting() && Now >= NextSwitchTargetTime)
+		{
+			Targeting->SwitchTarget(bSwitchRight);
+			bSwitchRight = !bSwitchRight;
+			NextSwitchTargetTime = Now + Settings.SwitchTargetInterval;
+		}
+
+		if (Now >= NextFreezeSpellTime)
+		{
+			Wukong->DebugCastFreezeSpell();
+			NextFreezeSpellTime = Now + Settings.FreezeSpellInterval;
+		}
+
+		if (Now >= NextShadowCloneTime)
+		{
+			Wukong->DebugCastShadowClone();
+			NextShadowCloneTime = Now + Settings.ShadowCloneInterval;
+		}
+	}
+
+private:
+	TWeakObjectPtr<AWukongCharacter> Player;
+	const UCombatBenchmarkSettings& Settings;
+
+	double NextAttackTime = 0.0;
+	double NextSwitchTargetTime = 0.0;
+	double NextFreezeSpellTime = 0.0;
+	double NextShadowCloneTime = 0.0;
+	bool bSwitchRight = true;
+};
+
+/**
+ * 基准测试的潜在命令：生成 -> 预热 -> 采样 -> 输出与比较
+ * 每帧执行一次 Update，返回 true 时结束
+ */
+class FCombatBenchmarkCommand : public IAutomationLatentCommand
+{
+public:
+	FCombatBenchmarkCommand(FAutomationTestBase* InTest, const FCombatBenchmarkScenario& InScenario)
+		: Test(InTest)
+		, Scenario(InScenario)
+	{
+	}
+
+	virtual ~FCombatBenchmarkCommand() override
+	{
+		DestroySpawnedActors();
+	}
+
+	virtual bool Update() override
+	{
+		UWorld* World = AutomationCommon::GetAnyGameWorld();
+		if (!World)
+		{
+			Test->AddError(TEXT("No game world. Run with -game so the benchmark map opens as a game world."));
+			return true;
+		}
+
+		switch (Phase)
+		{
+		case EPhase::Setup:
+			if (!SetupScenario(World))
+			{
+				return true;
+			}
+			Phase = EPhase::Warmup;
+			return false;
+
+		case EPhase::Warmup:
+			Script->Tick(World->GetTimeSeconds());
+			if (++FrameCounter >= Scenario.WarmupFrames)
+			{
+				// 记录器从此刻开始监听帧边界
+				Recorder = MakeUnique<FCombatBenchmarkRecorder>();
+				FrameCounter = 0;
+				Phase = EPhase::Measure;
+			}
+			return false;
+
+		case EPhase::Measure:
+			Script->Tick(World->GetTimeSeconds());
+			Recorder->SampleFrame(World);
+			if (Recorder->GetNumSamples() < Scenario.MeasureFrames)
+			{
+				return false;
+			}
+			FinishScenario();
+			return true;
+		}
+
+		return true;
+	}
+
+private:
+	enum class EPhase : uint8
+	{
+		Setup,
+		Warmup,
+		Measure
+	};
+
+	bool SetupScenario(UWorld* World)
+	{
+		const UCombatBenchmarkSettings* Settings = GetDefault<UCombatBenchmarkSettings>();
+
+		AWukongCharacter* Player = FindOrSpawnPlayer(World, *Settings);
+		if (!Player)
+		{
+			Test->AddError(TEXT("Could not find or spawn the Wukong player."));
+			return false;
+		}
+
+		// 玩家不能死，否则脚本停止、负载变化
+		Player->SetInvincible(true);
+
+		float Scale = 1.0f;
+		FParse::Value(FCommandLine::Get(), TEXT("BMScale="), Scale);
+
+		const int32 NumRegular = FMath::RoundToInt32(Scenario.NumRegular * Scale);
+		const int32 NumRanged = FMath::RoundToInt32(Scenario.NumRanged * Scale);
+		const int32 NumBoss = FMath::RoundToInt32(Scenario.NumBoss * Scale);
+		const int32 Total = NumRegular + NumRanged + NumBoss;
+
+		int32 SpawnIndex = 0;
+		SpawnEnemies(World, Player, Settings->RegularEnemyClass.LoadSynchronous(), NumRegular, Total, SpawnIndex);
+		SpawnEnemies(World, Player, Settings->RangedEnemyClass.LoadSynchronous(), NumRanged, Total, SpawnIndex);
+		SpawnEnemies(World, Player, Settings->BossEnemyClass.LoadSynchronous(), NumBoss, Total, SpawnIndex);
+
+		if (SpawnedEnemies.Num() != Total)
+		{
+			Test->AddError(FString::Printf(TEXT("Spawned %d of %d enemies. Check the enemy classes in CombatBenchmarkSettings."), SpawnedEnemies.Num(), Total));
+			return false;
+		}
+
+		Script = MakeUnique<FCombatBenchmarkPlayerScript>(Player, *Settings);
+
+		Test->AddInfo(FString::Printf(TEXT("Scenario %s: %d regular, %d ranged, %d boss, radius %.0f"),
+			*Scenario.Name, NumRegular, NumRanged, NumBoss, Scenario.SpawnRadius));
+		return true;
+	}
+
+	AWukongCharacter* FindOrSpawnPlayer(UWorld* World, const UCombatBenchmarkSettings& Settings)
+	{
+		APlayerController* PlayerController = UGameplayStatics::GetPlayerController(World, 0);
+		if (!PlayerController)
+		{
+			return nullptr;
+		}
+
+		if (AWukongCharacter* Existing = Cast<AWukongCharacter>(PlayerController->GetPawn()))
+		{
+			return Existing;
+		}
+
+		UClass* PlayerClass = Settings.PlayerClass.LoadSynchronous();
+		if (!PlayerClass)
+		{
+			return nullptr;
+		}
+
+		FVector Location = FVector::ZeroVector;
+		FRotator Rotation = FRotator::ZeroRotator;
+		if (APawn* OldPawn = PlayerController->GetPawn())
+		{
+			Location = OldPawn->GetActorLocation();
+			Rotation = OldPawn->GetActorRotation();
+			OldPawn->Destroy();
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		AWukongCharacter* Player = World->SpawnActor<AWukongCharacter>(PlayerClass, Location, Rotation, SpawnParams);
+		if (Player)
+		{
+			PlayerController->Possess(Player);
+			SpawnedPlayer = Player;
+		}
+		return Player;
+	}
+
+	void SpawnEnemies(UWorld* World, const AActor* Player, UClass* EnemyClass, int32 Count, int32 Total, int32& SpawnIndex)
+	{
+		if (!EnemyClass || Count <= 0)
+		{
+			return;
+		}
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+		const FVector Center = Player->GetActorLocation();
+		for (int32 i = 0; i < Count; ++i, ++SpawnIndex)
+		{
+			// 均匀分布在圆环上，面向玩家
+			const float Angle = 2.0f * PI * SpawnIndex / FMath::Max(Total, 1);
+			const FVector Location = Center + FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.0f) * Scenario.SpawnRadius + FVector(0.0f, 0.0f, 100.0f);
+			const FRotator Rotation = (Center - Location).GetSafeNormal2D().Rotation();
+
+			AEnemyBase* Enemy = World->SpawnActor<AEnemyBase>(EnemyClass, Location, Rotation, SpawnParams);
+			if (Enemy)
+			{
+				SpawnedEnemies.Add(Enemy);
+			}
+		}
+	}
+
+	void FinishScenario()
+	{
+		const UCombatBenchmarkSettings* Settings = GetDefault<UCombatBenchmarkSettings>();
+		const FCombatBenchmarkSummary Summary = Recorder->Summarize();
+
+		const FString FrameCsvPath = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("Combat_%s.csv"), *Scenario.Name);
+		if (!Recorder->WriteFrameCsv(FrameCsvPath))
+		{
+			Test->AddWarning(FString::Printf(TEXT("Could not write %s"), *FrameCsvPath));
+		}
+		Recorder.Reset();
+
+		for (const TPair<FString, double>& Metric : Summary.Metrics)
+		{
+			Test->AddInfo(FString::Printf(TEXT("%s %s = %.3f"), *Scenario.Name, *Metric.Key, Metric.Value));
+		}
+
+		const FString BaselinePath = FPaths::ProjectDir() / Settings->BaselineFile;
+		const TMap<FString, double> Baseline = FCombatBenchmarkRecorder::LoadBaseline(BaselinePath);
+		const bool bUpdateBaseline = FParse::Param(FCommandLine::Get(), TEXT("BMUpdateBaseline"));
+
+		bool bHasBaseline = false;
+		for (const TPair<FString, double>& Metric : Summary.Metrics)
+		{
+			const double* BaselineValue = Baseline.Find(Scenario.Name + TEXT(",") + Metric.Key);
+			double AbsoluteSlack = 0.0;
+			if (!BaselineValue || !FCombatBenchmarkRecorder::GetRegressionSlack(Metric.Key, AbsoluteSlack))
+			{
+				continue;
+			}
+			bHasBaseline = true;
+
+			const double Limit = *BaselineValue * (1.0 + Settings->RegressionTolerance) + AbsoluteSlack;
+			if (Metric.Value > Limit && !bUpdateBaseline)
+			{
+				Test->AddError(FString::Printf(TEXT("%s %s regressed: %.3f > %.3f (baseline %.3f)"),
+					*Scenario.Name, *Metric.Key, Metric.Value, Limit, *BaselineValue));
+			}
+		}
+
+		if (!bHasBaseline && !bUpdateBaseline)
+		{
+			Test->AddWarning(FString::Printf(TEXT("No baseline for %s in %s; regression check skipped. Run with -BMUpdateBaseline and commit the file"),
+				*Scenario.Name, *BaselinePath));
+		}
+
+		// 只在显式要求时写入基线
+		if (bUpdateBaseline)
+		{
+			if (FCombatBenchmarkRecorder::SaveBaseline(BaselinePath, Scenario.Name, Summary))
+			{
+				Test->AddInfo(FString::Printf(TEXT("Baseline for %s written to %s"), *Scenario.Name, *BaselinePath));
+			}
+			else
+			{
+				Test->AddWarning(FString::Printf(TEXT("Could not write baseline %s"), *BaselinePath));
+			}
+		}
+
+		DestroySpawnedActors();
+	}
+
+	void DestroySpawnedActors()
+	{
+		for (const TWeakObjectPtr<AEnemyBase>& Enemy : SpawnedEnemies)
+		{
+			if (Enemy.IsValid())
+			{
+				Enemy->Destroy();
+			}
+		}
+		SpawnedEnemies.Reset();
+
+		if (SpawnedPlayer.IsValid())
+		{
+			SpawnedPlayer->Destroy();
+		}
+		SpawnedPlayer.Reset();
+	}
+
+	FAutomationTestBase* Test;
+	FCombatBenchmarkScenario Scenario;
+
+	EPhase Phase = EPhase::Setup;
+	int32 FrameCounter = 0;
+
+	TUniquePtr<FCombatBenchmarkPlayerScript> Script;
+	TUniquePtr<FCombatBenchmarkRecorder> Recorder;
+
+	TArray<TWeakObjectPtr<AEnemyBase>> SpawnedEnemies;
+	TWeakObjectPtr<AWukongCharacter> SpawnedPlayer;
+};
+
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FCombatBenchmarkTest, "BlackMyth.Benchmark.Combat",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+void FCombatBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	for (const FCombatBenchmarkScenario& Scenario : GetDefault<UCombatBenchmarkSettings>()->Scenarios)
+	{
+		OutBeautifiedNames.Add(Scenario.Name);
+		OutTestCommands.Add(Scenario.Name);
+	}
+}
+
+bool FCombatBenchmarkTest::RunTest(const FString& Parameters)
+{
+	const UCombatBenchmarkSettings* Settings = GetDefault<UCombatBenchmarkSettings>();
+	const FCombatBenchmarkScenario* Scenario = Settings->FindScenario(Parameters);
+	if (!Scenario)
+	{
+		AddError(FString::Printf(TEXT("Unknown benchmark scenario '%s'"), *Parameters));
+		return false;
+	}
+
+	// 每个场景重新加载地图，场景之间互不影响
+	AutomationOpenMap(Settings->Map.GetLongPackageName(), true);
+	ADD_LATENT_AUTOMATION_COMMAND(FWaitLatentCommand(1.0f));
+	ADD_LATENT_AUTOMATION_COMMAND(FCombatBenchmarkCommand(this, *Scenario));
+	return true;
+}
+
+#endif // WITH_AUTOMATION_TESTS
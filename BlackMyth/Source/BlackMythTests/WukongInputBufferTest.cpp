@@ -0,0 +1,100 @@
+// 连击输入缓冲测试 - 早按、晚按和过期输入的有效期
+
+#include "WukongCharacter.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_AUTOMATION_TESTS
+
+namespace WukongInputBufferTest
+{
+	// 与 AWukongCharacter 的默认值一致：攻击 0.6 秒，进行到一半开始处理缓冲，容错 0.3 秒
+	constexpr double AttackDuration = 0.6;
+	constexpr double InputBufferTime = 0.3;
+	constexpr double AttackStart = 10.0;
+	constexpr double WindowOpen = AttackStart + AttackDuration * 0.5;
+
+	double MinPressTimeWhileAttacking(double Now)
+	{
+		return FWukongInputBuffer::GetMinPressTime(Now, WindowOpen, InputBufferTime);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWukongInputBufferTest, "BlackMyth.Combat.InputBuffer",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FWukongInputBufferTest::RunTest(const FString& Parameters)
+{
+	using namespace WukongInputBufferTest;
+
+	EWukongBufferedInput Input = EWukongBufferedInput::Attack;
+
+	// 早按：攻击刚开始就按下，缓冲在第一次处理时（窗口打开后的第一帧）仍然有效
+	{
+		FWukongInputBuffer Buffer;
+		Buffer.Push(EWukongBufferedInput::Attack, AttackStart);
+		TestTrue(TEXT("Press at swing start is fresh on the first frame after the window opens"),
+			Buffer.PeekFresh(MinPressTimeWhileAttacking(WindowOpen + 1.0 / 60.0), Input));
+
+		FWukongInputBuffer LaterBuffer;
+		LaterBuffer.Push(EWukongBufferedInput::Attack, AttackStart + 0.05);
+		TestTrue(TEXT("Press shortly after swing start is fresh when the window opens"),
+			LaterBuffer.PeekFresh(MinPressTimeWhileAttacking(WindowOpen + 0.02), Input));
+	}
+
+	// 晚按：窗口打开后按下，动画未到连招位置时保留，按下时间不被刷新，执行后才移除
+	{
+		FWukongInputBuffer Buffer;
+		const double PressTime = WindowOpen + 0.1;
+		Buffer.Push(EWukongBufferedInput::Attack, PressTime);
+
+		for (double Now = PressTime; Now < AttackStart + AttackDuration; Now += 1.0 / 60.0)
+		{
+			if (!Buffer.PeekFresh(MinPressTimeWhileAttacking(Now), Input))
+			{
+				AddError(FString::Printf(TEXT("Late press expired while waiting for the combo window (t=%.3f)"), Now));
+				break;
+			}
+		}
+
+		Buffer.Pop();
+		TestTrue(TEXT("Buffer is empty once the input is executed"), Buffer.IsEmpty());
+	}
+
+	// 过期：攻击前很早就按下的输入，以及空闲时超过容错时间的输入都被丢弃
+	{
+		FWukongInputBuffer Buffer;
+		Buffer.Push(EWukongBufferedInput::Attack, AttackStart - 0.5);
+		TestFalse(TEXT("Press long before the swing is stale when the window opens"),
+			Buffer.PeekFresh(MinPressTimeWhileAttacking(WindowOpen), Input));
+		TestTrue(TEXT("Stale input is discarded by PeekFresh"), Buffer.IsEmpty());
+
+		const double Now = 20.0;
+		Buffer.Push(EWukongBufferedInput::Attack, Now - InputBufferTime - 0.1);
+		Buffer.Push(EWukongBufferedInput::Attack, Now - 0.1);
+		TestTrue(TEXT("Fresh idle press behind a stale one is found"),
+			Buffer.PeekFresh(FWukongInputBuffer::GetMinPressTime(Now, Now, InputBufferTime), Input));
+		Buffer.Pop();
+		TestTrue(TEXT("Only the fresh press remained in the buffer"), Buffer.IsEmpty());
+	}
+
+	// 写满时覆盖最旧的输入：压入 Capacity + 1 条后只剩后 Capacity 条
+	{
+		FWukongInputBuffer Buffer;
+		for (int32 Index = 0; Index <= FWukongInputBuffer::Capacity; ++Index)
+		{
+			Buffer.Push(EWukongBufferedInput::Attack, static_cast<double>(Index));
+		}
+
+		int32 NumFresh = 0;
+		while (Buffer.PeekFresh(0.0, Input))
+		{
+			Buffer.Pop();
+			++NumFresh;
+		}
+		TestEqual(TEXT("Full buffer keeps Capacity entries"), NumFresh, FWukongInputBuffer::Capacity);
+	}
+
+	return true;
+}
+
+#endif